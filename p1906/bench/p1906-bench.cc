@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/*
+ * Description:
+ * micro-benchmarks of the geometry kernels of the molecular motor model and of the EM path loss lookup
+ *
+ * Each kernel is timed over enough iterations to last at least minTime seconds. The kernels scanning
+ * the tube network (findClosestPoint, findNearestTube, getOverlap3D) are run for each network size
+ * from minSegments to maxSegments, by powers of 10. Results are printed one line per kernel and size:
+ *
+ *   kernel,segments,iterations,ns_per_op,allocs_per_op,ops_per_s,segments_per_s
+ *
+ * or as one JSON object per line with --format=json. Allocations count every malloc, calloc and
+ * realloc call made by the kernel, including those made by GSL (glibc only).
+ *
+ * Example: ./waf --run "p1906-bench --minSegments=100 --maxSegments=1000000 --format=json"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-medium.h"
+
+#include "ns3/p1906-em-perturbation.h"
+#include "ns3/p1906-em-field.h"
+#include "ns3/p1906-em-motion.h"
+#include "ns3/p1906-em-specificity.h"
+#include "ns3/p1906-em-communication-interface.h"
+#include "ns3/p1906-em-message-carrier.h"
+#include "ns3/spectrum-value.h"
+
+#include "ns3/p1906-mol-motor-field.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-motor-rng.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+using namespace ns3;
+
+/*
+ * Allocation counting: the program interposes the glibc allocator, so the calls
+ * made by the p1906 library and by GSL are counted as well
+ */
+static std::atomic<uint64_t> g_allocations (0);
+
+#ifdef __GLIBC__
+extern "C" {
+void * __libc_malloc (size_t size);
+void * __libc_calloc (size_t n, size_t size);
+void * __libc_realloc (void *p, size_t size);
+
+void *
+malloc (size_t size)
+{
+  g_allocations.fetch_add (1, std::memory_order_relaxed);
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n, size_t size)
+{
+  g_allocations.fetch_add (1, std::memory_order_relaxed);
+  return __libc_calloc (n, size);
+}
+
+void *
+realloc (void *p, size_t size)
+{
+  g_allocations.fetch_add (1, std::memory_order_relaxed);
+  return __libc_realloc (p, size);
+}
+}
+#endif
+
+struct BenchResult
+{
+  std::string kernel;
+  uint64_t segments;
+  uint64_t iterations;
+  double seconds;
+  uint64_t allocations;
+};
+
+static std::string g_format = "csv";
+static double g_minTime = 0.2;
+
+/*
+ * Run op repeatedly, doubling the iterations until the run lasts minTime
+ */
+static BenchResult
+Measure (std::string kernel, uint64_t segments, std::function<void ()> op)
+{
+  BenchResult r;
+  r.kernel = kernel;
+  r.segments = segments;
+
+  // warm up caches and lazily allocated structures
+  op ();
+
+  uint64_t n = 1;
+  while (true)
+    {
+      uint64_t a0 = g_allocations.load ();
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+      for (uint64_t i = 0; i < n; i++)
+        {
+          op ();
+        }
+      std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now ();
+      r.allocations = g_allocations.load () - a0;
+      r.seconds = std::chrono::duration<double> (t1 - t0).count ();
+      r.iterations = n;
+      if (r.seconds >= g_minTime || n >= (1ULL << 40))
+        {
+          break;
+        }
+      n *= 2;
+    }
+  return r;
+}
+
+static void
+Report (const BenchResult &r)
+{
+  double nsPerOp = r.seconds * 1e9 / r.iterations;
+  double allocsPerOp = (double) r.allocations / r.iterations;
+  double opsPerS = r.iterations / r.seconds;
+  double segmentsPerS = opsPerS * r.segments;
+
+  if (g_format == "json")
+    {
+      std::cout << "{\"kernel\":\"" << r.kernel << "\",\"segments\":" << r.segments
+                << ",\"iterations\":" << r.iterations << ",\"ns_per_op\":" << nsPerOp
+                << ",\"allocs_per_op\":" << allocsPerOp << ",\"ops_per_s\":" << opsPerS
+                << ",\"segments_per_s\":" << segmentsPerS << "}" << std::endl;
+    }
+  else
+    {
+      std::cout << r.kernel << "," << r.segments << "," << r.iterations << "," << nsPerOp << ","
+                << allocsPerOp << "," << opsPerS << "," << segmentsPerS << std::endl;
+    }
+}
+
+/*
+ * A random tube network: n segments of length segLength with uniformly distributed
+ * start points in a cube keeping a constant segment density, and the matching vector field
+ */
+static void
+RandomTubes (gsl_rng *r, size_t n, double segLength, gsl_matrix *tubes, gsl_matrix *vf)
+{
+  double side = 10. * cbrt ((double) n);
+  for (size_t i = 0; i < n; i++)
+    {
+      double d[3];
+      P1906MOL_MOTOR_Rng::gaussian (r, 1., d, 3);
+      double norm = sqrt (d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      double *t = gsl_matrix_ptr (tubes, i, 0);
+      double *v = gsl_matrix_ptr (vf, i, 0);
+      for (int k = 0; k < 3; k++)
+        {
+          t[k] = side * gsl_rng_uniform (r);
+          t[k + 3] = t[k] + segLength * d[k] / norm;
+          v[k] = t[k];
+          v[k + 3] = d[k] / norm;
+        }
+    }
+}
+
+static void
+BenchPointKernels (gsl_rng *r)
+{
+  gsl_vector *u = gsl_vector_alloc (3);
+  gsl_vector *v = gsl_vector_alloc (3);
+  gsl_vector *w = gsl_vector_alloc (3);
+  gsl_vector *pt = gsl_vector_alloc (3);
+  gsl_vector *segment = gsl_vector_alloc (6);
+
+  P1906MOL_MOTOR_Field::point (u, 1., 2., 3.);
+  P1906MOL_MOTOR_Field::point (v, -2., .5, 4.);
+  P1906MOL_MOTOR_Field::point (pt, 3., 1., -2.);
+  for (int k = 0; k < 6; k++)
+    {
+      gsl_vector_set (segment, k, 10. * gsl_rng_uniform (r));
+    }
+
+  Report (Measure ("cross_product", 0, [&] () { P1906MOL_MOTOR_Field::cross_product (u, v, w); }));
+  Report (Measure ("distance", 0, [&] () { P1906MOL_MOTOR_Field::distance (pt, segment); }));
+
+  // a unit sphere crossed by a trajectory from its center
+  P1906MOL_MOTOR_VolSurface vs;
+  P1906MOL_MOTOR_Pos center, inside, outside;
+  center.setPos (0., 0., 0.);
+  vs.setVolume (center, 1.);
+  vs.setType (P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+  inside.setPos (0.1, 0.2, 0.);
+  outside.setPos (1.5, 0.3, 0.2);
+  gsl_vector *trajectory = gsl_vector_alloc (6);
+  P1906MOL_MOTOR_Field::line (trajectory, inside, outside);
+  std::vector<P1906MOL_MOTOR_Pos> ipt;
+
+  Report (Measure ("sphereIntersections", 0, [&] () { ipt.clear (); vs.sphereIntersections (trajectory, ipt); }));
+  Report (Measure ("reflect", 0, [&] () { P1906MOL_MOTOR_Pos p; p.setPos (outside); vs.reflect (inside, p); }));
+
+  gsl_vector_free (u);
+  gsl_vector_free (v);
+  gsl_vector_free (w);
+  gsl_vector_free (pt);
+  gsl_vector_free (segment);
+  gsl_vector_free (trajectory);
+}
+
+static void
+BenchTubeKernels (gsl_rng *r, size_t n)
+{
+  gsl_matrix *tubes = gsl_matrix_alloc (n, 6);
+  gsl_matrix *vf = gsl_matrix_alloc (n, 6);
+  gsl_matrix *pts = gsl_matrix_alloc (n, 3);
+  gsl_vector *tubeSegments = gsl_vector_alloc (n);
+  gsl_vector *pt = gsl_vector_alloc (3);
+  gsl_vector *result = gsl_vector_alloc (6);
+  gsl_vector *segment = gsl_vector_alloc (6);
+  RandomTubes (r, n, 10., tubes, vf);
+
+  double side = 10. * cbrt ((double) n);
+  P1906MOL_MOTOR_Field::point (pt, side / 2, side / 2, side / 2);
+  P1906MOL_MOTOR_Field::line (segment, tubes, n / 2);
+  P1906MOL_MOTOR_Field field;
+
+  Report (Measure ("findClosestPoint", n, [&] () { P1906MOL_MOTOR_Field::findClosestPoint (pt, vf, result); }));
+  Report (Measure ("findNearestTube", n, [&] () { P1906MOL_MOTOR_Field::findNearestTube (pt, tubes, 10.); }));
+  Report (Measure ("getOverlap3D", n, [&] () { field.getOverlap3D (segment, tubes, pts, tubeSegments); }));
+
+  gsl_matrix_free (tubes);
+  gsl_matrix_free (vf);
+  gsl_matrix_free (pts);
+  gsl_vector_free (tubeSegments);
+  gsl_vector_free (pt);
+  gsl_vector_free (result);
+  gsl_vector_free (segment);
+}
+
+static void
+BenchEmPathLoss (void)
+{
+  double centralFrequency = 1e12 * (0.45 + (1.55 - 0.45)/2.);
+  double bandwidth = 1e12 * (1.55 - 0.45);
+  double subChannel = 1e12 * 0.1;
+
+  P1906Helper helper;
+  NodeContainer n;
+  n.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (0.001, 0, 0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (n);
+
+  Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
+  Ptr<P1906EMMotion> motion = CreateObject<P1906EMMotion> ();
+  motion->SetWaveSpeed (3e8);
+  medium->SetP1906Motion (motion);
+
+  Ptr<P1906EMCommunicationInterface> c[2];
+  Ptr<P1906EMField> fi;
+  Ptr<P1906EMPerturbation> p;
+  for (int i = 0; i < 2; i++)
+    {
+      c[i] = CreateObject<P1906EMCommunicationInterface> ();
+      fi = CreateObject<P1906EMField> ();
+      p = CreateObject<P1906EMPerturbation> ();
+      p->SetBandwidth (bandwidth);
+      p->SetCentralFrequency (centralFrequency);
+      p->SetSubChannel (subChannel);
+      p->SetPowerTransmission (5000);
+      p->SetPulseDuration (FemtoSeconds (100));
+      p->SetPulseInterval (PicoSeconds (100));
+      helper.Connect (n.Get (i), CreateObject<P1906NetDevice> (), medium, c[i], fi, p, CreateObject<P1906EMSpecificity> ());
+    }
+
+  Ptr<P1906EMMessageCarrier> carrier = DynamicCast<P1906EMMessageCarrier> (p->CreateMessageCarrier (Create<Packet> (1)));
+  Ptr<SpectrumValue> sv = carrier->GetSpectrumValue ();
+  SpectrumValue txPsd = *sv;
+
+  // the path loss is applied in place: restore the transmitted PSD before each lookup
+  Report (Measure ("em-pathloss", 0, [&] () {
+    *sv = txPsd;
+    motion->CalculateReceivedMessageCarrier (c[0], c[1], carrier, fi);
+  }));
+
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  // the em kernel uses 100 fs pulses, as in em-example
+  Time::SetResolution (Time::FS);
+
+  uint32_t minSegments = 100;
+  uint32_t maxSegments = 1000000;
+  std::string kernels = "all";
+
+  CommandLine cmd;
+  cmd.AddValue ("minSegments", "smallest tube network [segments]", minSegments);
+  cmd.AddValue ("maxSegments", "largest tube network [segments]", maxSegments);
+  cmd.AddValue ("minTime", "minimum measured time per kernel [s]", g_minTime);
+  cmd.AddValue ("kernels", "all, point, tubes or em", kernels);
+  cmd.AddValue ("format", "csv or json", g_format);
+  cmd.Parse (argc, argv);
+
+  gsl_rng *r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::User);
+
+  if (g_format != "json")
+    {
+      std::cout << "kernel,segments,iterations,ns_per_op,allocs_per_op,ops_per_s,segments_per_s" << std::endl;
+    }
+
+  if (kernels == "all" || kernels == "point")
+    {
+      BenchPointKernels (r);
+    }
+  if (kernels == "all" || kernels == "tubes")
+    {
+      for (uint64_t s = minSegments; s <= maxSegments; s *= 10)
+        {
+          BenchTubeKernels (r, s);
+        }
+    }
+  if (kernels == "all" || kernels == "em")
+    {
+      BenchEmPathLoss ();
+    }
+
+  gsl_rng_free (r);
+  return 0;
+}
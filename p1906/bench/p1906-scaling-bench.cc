@@ -0,0 +1,460 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+
+/*
+ * Description:
+ * end-to-end scaling benchmark of EM, MOL and molecular motor networks
+ *
+ * A network of nodes is placed at random positions in a cube and attached to a single P1906Medium.
+ * A number of senders transmit packets at a fixed interval; every transmission is fanned out by the
+ * medium to all the other nodes, so each run exercises the Motion component (n - 1) times per packet.
+ * The number of nodes is swept from minNodes to maxNodes by powers of 10; for the motor model the
+ * tube density of the shared microtubule network is swept from minTubeDensity to maxTubeDensity.
+ * Results are printed one line per run:
+ *
+ *   model,nodes,senders,packets,tube_density,wall_s,events,events_per_s,peak_rss_kb,
+ *   setup_s,tx_s,motion_s,fanout_s,rx_s,specificity_s
+ *
+ * or as one JSON object per line with --format=json. The breakdown is measured as follows:
+ *   setup_s       building nodes, components and fields (tube generation for the motor model)
+ *   tx_s          transmitter calls, i.e., Perturbation plus the medium fan-out
+ *   motion_s      ComputePropagationDelay and CalculateReceivedMessageCarrier, part of tx_s
+ *   fanout_s      tx_s - motion_s, i.e., Perturbation, medium loop and delivery scheduling
+ *   rx_s          the rest of the run: delivery events and the receivers
+ *   specificity_s CheckRxCompatibility, part of rx_s
+ * Events count transmissions and deliveries. The peak RSS is the high-water mark of the process,
+ * so run one size per process to compare memory across releases. With --flow the nodes drift along
+ * the x axis with the Poiseuille profile of a vessel filling the cube (see P1906FlowMobilityModel).
+ *
+ * Example: ./waf --run "p1906-scaling-bench --model=em --minNodes=10 --maxNodes=100000 --senders=10"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-motion.h"
+
+#include "ns3/p1906-em-perturbation.h"
+#include "ns3/p1906-em-field.h"
+#include "ns3/p1906-em-motion.h"
+#include "ns3/p1906-em-specificity.h"
+#include "ns3/p1906-em-communication-interface.h"
+
+#include "ns3/p1906-mol-perturbation.h"
+#include "ns3/p1906-mol-field.h"
+#include "ns3/p1906-mol-motion.h"
+#include "ns3/p1906-mol-specificity.h"
+#include "ns3/p1906-mol-communication-interface.h"
+
+#include "ns3/p1906-mol-motor-perturbation.h"
+#include "ns3/p1906-mol-motor-microtubule.h"
+#include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor-communication-interface.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <stdint.h>
+
+using namespace ns3;
+
+typedef std::chrono::steady_clock Clock;
+
+static double
+Elapsed (Clock::time_point t0)
+{
+  return std::chrono::duration<double> (Clock::now () - t0).count ();
+}
+
+/*
+ * Time and event counters of a single run
+ */
+struct ScalingResult
+{
+  std::string model;
+  uint32_t nodes;
+  uint32_t senders;
+  uint32_t packets;
+  double tubeDensity;
+  double wall;
+  double setup;
+  double tx;
+  double motion;
+  double specificity;
+  uint64_t transmissions;
+  uint64_t deliveries;
+  long peakRss;
+};
+
+static ScalingResult g_result;
+static std::string g_format = "csv";
+static double g_flow = 0.;               // [m/s]
+
+/*
+ * Motion wrapper: delegates to the Motion of the model under test and accounts for its time
+ */
+class BenchMotion : public P1906Motion
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::BenchMotion")
+      .SetParent<P1906Motion> ();
+    return tid;
+  }
+
+  void SetMotion (Ptr<P1906Motion> m)
+  {
+    m_motion = m;
+  }
+
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+                                          Ptr<P1906CommunicationInterface> dst,
+                                          Ptr<P1906MessageCarrier> message,
+                                          Ptr<P1906Field> field)
+  {
+    Clock::time_point t0 = Clock::now ();
+    double delay = m_motion->ComputePropagationDelay (src, dst, message, field);
+    g_result.motion += Elapsed (t0);
+    return delay;
+  }
+
+  virtual Ptr<P1906MessageCarrier> CalculateReceivedMessageCarrier (Ptr<P1906CommunicationInterface> src,
+                                                                    Ptr<P1906CommunicationInterface> dst,
+                                                                    Ptr<P1906MessageCarrier> message,
+                                                                    Ptr<P1906Field> field)
+  {
+    Clock::time_point t0 = Clock::now ();
+    Ptr<P1906MessageCarrier> carrier = m_motion->CalculateReceivedMessageCarrier (src, dst, message, field);
+    g_result.motion += Elapsed (t0);
+    g_result.deliveries++;
+    return carrier;
+  }
+
+protected:
+  virtual void DoDispose (void)
+  {
+    m_motion = 0;
+    P1906Motion::DoDispose ();
+  }
+
+private:
+  Ptr<P1906Motion> m_motion;
+};
+
+/*
+ * Specificity subclasses: the receivers look their Specificity up by model type,
+ * so the time of CheckRxCompatibility is accounted for by overriding it
+ */
+class BenchEMSpecificity : public P1906EMSpecificity
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::BenchEMSpecificity")
+      .SetParent<P1906EMSpecificity> ();
+    return tid;
+  }
+
+  virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
+  {
+    Clock::time_point t0 = Clock::now ();
+    bool ok = P1906EMSpecificity::CheckRxCompatibility (src, dst, message);
+    g_result.specificity += Elapsed (t0);
+    return ok;
+  }
+};
+
+class BenchMOLSpecificity : public P1906MOLSpecificity
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::BenchMOLSpecificity")
+      .SetParent<P1906MOLSpecificity> ();
+    return tid;
+  }
+
+  virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
+  {
+    Clock::time_point t0 = Clock::now ();
+    bool ok = P1906MOLSpecificity::CheckRxCompatibility (src, dst, message);
+    g_result.specificity += Elapsed (t0);
+    return ok;
+  }
+};
+
+static void
+Transmit (Ptr<P1906CommunicationInterface> c)
+{
+  Clock::time_point t0 = Clock::now ();
+  c->HandleTransmission (Create<Packet> (1));
+  g_result.tx += Elapsed (t0);
+  g_result.transmissions++;
+}
+
+static long
+PeakRss (void)
+{
+  struct rusage u;
+  getrusage (RUSAGE_SELF, &u);
+  return u.ru_maxrss; // [kB] on Linux
+}
+
+static void
+Report (const ScalingResult &r)
+{
+  uint64_t events = r.transmissions + r.deliveries;
+  double run = r.wall - r.setup;
+  double eventsPerS = run > 0 ? events / run : 0.;
+  double fanout = r.tx - r.motion;
+  double rx = run - r.tx;
+
+  if (g_format == "json")
+    {
+      std::cout << "{\"model\":\"" << r.model << "\",\"nodes\":" << r.nodes
+                << ",\"senders\":" << r.senders << ",\"packets\":" << r.packets
+                << ",\"tube_density\":" << r.tubeDensity << ",\"wall_s\":" << r.wall
+                << ",\"events\":" << events << ",\"events_per_s\":" << eventsPerS
+                << ",\"peak_rss_kb\":" << r.peakRss << ",\"setup_s\":" << r.setup
+                << ",\"tx_s\":" << r.tx << ",\"motion_s\":" << r.motion
+                << ",\"fanout_s\":" << fanout << ",\"rx_s\":" << rx
+                << ",\"specificity_s\":" << r.specificity << "}" << std::endl;
+    }
+  else
+    {
+      std::cout << r.model << "," << r.nodes << "," << r.senders << "," << r.packets << ","
+                << r.tubeDensity << "," << r.wall << "," << events << "," << eventsPerS << ","
+                << r.peakRss << "," << r.setup << "," << r.tx << "," << r.motion << ","
+                << fanout << "," << rx << "," << r.specificity << std::endl;
+    }
+}
+
+/*
+ * Build a network of the given model, run the traffic to completion and report it
+ */
+static void
+RunScenario (std::string model, uint32_t nodes, uint32_t senders, uint32_t packets,
+             Time interval, double side, double tubeDensity)
+{
+  g_result = ScalingResult ();
+  g_result.model = model;
+  g_result.nodes = nodes;
+  g_result.senders = (senders == 0 || senders > nodes) ? nodes : senders;
+  g_result.packets = packets;
+  g_result.tubeDensity = model == "motor" ? tubeDensity : 0.;
+
+  Clock::time_point t0 = Clock::now ();
+
+  P1906Helper helper;
+  NodeContainer n;
+  n.Create (nodes);
+
+  // keep the nodes away from the origin: the motor model derives its surfaces from the x coordinate
+  Ptr<UniformRandomVariable> u = CreateObject<UniformRandomVariable> ();
+  u->SetAttribute ("Min", DoubleValue (side / 10));
+  u->SetAttribute ("Max", DoubleValue (side));
+  Ptr<RandomBoxPositionAllocator> positionAlloc = CreateObject<RandomBoxPositionAllocator> ();
+  positionAlloc->SetX (u);
+  positionAlloc->SetY (u);
+  positionAlloc->SetZ (u);
+  MobilityHelper mobility;
+  if (g_flow > 0.)
+    {
+      mobility.SetMobilityModel ("ns3::P1906FlowMobilityModel",
+                                 "VesselOrigin", VectorValue (Vector (0, side * 0.55, side * 0.55)),
+                                 "VesselRadius", DoubleValue (side * 0.45 * std::sqrt (2.)),
+                                 "MaxVelocity", DoubleValue (g_flow));
+    }
+  else
+    {
+      mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (n);
+
+  Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
+  Ptr<BenchMotion> motion = CreateObject<BenchMotion> ();
+  medium->SetP1906Motion (motion);
+
+  std::vector< Ptr<P1906CommunicationInterface> > c (nodes);
+  if (model == "em")
+    {
+      Ptr<P1906EMMotion> m = CreateObject<P1906EMMotion> ();
+      m->SetWaveSpeed (3e8);
+      motion->SetMotion (m);
+      for (uint32_t i = 0; i < nodes; i++)
+        {
+          c[i] = CreateObject<P1906EMCommunicationInterface> ();
+          Ptr<P1906EMPerturbation> p = CreateObject<P1906EMPerturbation> ();
+          p->SetBandwidth (1e12 * (1.55 - 0.45));
+          p->SetCentralFrequency (1e12 * (0.45 + (1.55 - 0.45)/2.));
+          p->SetSubChannel (1e12 * 0.1);
+          p->SetPowerTransmission (5000);
+          p->SetPulseDuration (FemtoSeconds (100));
+          p->SetPulseInterval (PicoSeconds (100));
+          helper.Connect (n.Get (i), CreateObject<P1906NetDevice> (), medium, c[i],
+                          CreateObject<P1906EMField> (), p, CreateObject<BenchEMSpecificity> ());
+        }
+    }
+  else if (model == "mol")
+    {
+      Ptr<P1906MOLMotion> m = CreateObject<P1906MOLMotion> ();
+      m->SetDiffusionCoefficient (1);
+      motion->SetMotion (m);
+      for (uint32_t i = 0; i < nodes; i++)
+        {
+          c[i] = CreateObject<P1906MOLCommunicationInterface> ();
+          Ptr<P1906MOLPerturbation> p = CreateObject<P1906MOLPerturbation> ();
+          p->SetPulseInterval (MilliSeconds (1));
+          p->SetMolecules (50000);
+          Ptr<BenchMOLSpecificity> s = CreateObject<BenchMOLSpecificity> ();
+          s->SetDiffusionCoefficient (1);
+          helper.Connect (n.Get (i), CreateObject<P1906NetDevice> (), medium, c[i],
+                          CreateObject<P1906MOLField> (), p, s);
+        }
+    }
+  else
+    {
+      Ptr<P1906MOL_MOTOR_Motion> m = CreateObject<P1906MOL_MOTOR_Motion> ();
+      m->SetDiffusionCoefficient (1);
+      motion->SetMotion (m);
+
+      // a single microtubule network is shared by all the nodes, regenerated at the requested density
+      Ptr<P1906MOL_MOTOR_MicrotubulesField> fi = CreateObject<P1906MOL_MOTOR_MicrotubulesField> ();
+      fi->setTubeDensity (tubeDensity);
+      fi->setTubeSegments (fi->ts.segPerTube);
+      gsl_matrix_free (fi->tubeMatrix);
+      gsl_matrix_free (fi->vf);
+      fi->tubeMatrix = gsl_matrix_alloc (fi->ts.numTubes * fi->ts.segPerTube, 6);
+      fi->vf = gsl_matrix_alloc (fi->ts.numTubes * fi->ts.segPerTube, 6);
+      fi->genTubes ();
+      fi->tubes2VectorField (fi->tubeMatrix, fi->vf);
+
+      for (uint32_t i = 0; i < nodes; i++)
+        {
+          c[i] = CreateObject<P1906MOL_MOTOR_CommunicationInterface> ();
+          Ptr<P1906MOL_MOTOR_Perturbation> p = CreateObject<P1906MOL_MOTOR_Perturbation> ();
+          p->SetPulseInterval (MilliSeconds (1));
+          p->SetMolecules (50000);
+          Ptr<BenchMOLSpecificity> s = CreateObject<BenchMOLSpecificity> ();
+          s->SetDiffusionCoefficient (1);
+          helper.Connect (n.Get (i), CreateObject<P1906NetDevice> (), medium, c[i], fi, p, s);
+        }
+    }
+
+  // the senders start at random offsets within the first interval
+  Ptr<UniformRandomVariable> offset = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < g_result.senders; i++)
+    {
+      Time start = NanoSeconds (offset->GetValue (0, interval.GetNanoSeconds ()));
+      for (uint32_t k = 0; k < packets; k++)
+        {
+          Simulator::Schedule (start + NanoSeconds (k * interval.GetNanoSeconds ()), &Transmit, c[i]);
+        }
+    }
+
+  g_result.setup = Elapsed (t0);
+  Simulator::Run ();
+  g_result.wall = Elapsed (t0);
+  g_result.peakRss = PeakRss ();
+
+  Simulator::Destroy ();
+  Report (g_result);
+}
+
+int main (int argc, char *argv[])
+{
+  std::string model = "em";
+  uint32_t minNodes = 10;
+  uint32_t maxNodes = 100000;
+  uint32_t senders = 10;
+  uint32_t packets = 1;
+  double interval = 1.;                  // [ms]
+  double side = 0.;                      // [m]
+  double minTubeDensity = 10;            // [tube segments/nm^3]
+  double maxTubeDensity = 10;            // [tube segments/nm^3]
+
+  CommandLine cmd;
+  cmd.AddValue ("model", "em, mol or motor", model);
+  cmd.AddValue ("minNodes", "smallest network [nodes]", minNodes);
+  cmd.AddValue ("maxNodes", "largest network [nodes]", maxNodes);
+  cmd.AddValue ("senders", "transmitting nodes, 0 for all the nodes", senders);
+  cmd.AddValue ("packets", "packets per sender", packets);
+  cmd.AddValue ("interval", "interval between the packets of a sender [ms]", interval);
+  cmd.AddValue ("side", "side of the cube holding the nodes [m], 0 for the model default", side);
+  cmd.AddValue ("minTubeDensity", "lowest tube density of the motor model [tube segments/nm^3]", minTubeDensity);
+  cmd.AddValue ("maxTubeDensity", "highest tube density of the motor model [tube segments/nm^3]", maxTubeDensity);
+  cmd.AddValue ("format", "csv or json", g_format);
+  cmd.AddValue ("flow", "velocity of the flow carrying the nodes [m/s], 0 for static nodes", g_flow);
+  cmd.Parse (argc, argv);
+
+  if (model != "em" && model != "mol" && model != "motor")
+    {
+      std::cerr << "unknown model " << model << std::endl;
+      return 1;
+    }
+  if (side <= 0.)
+    {
+      // the motor walk is simulated step by step: keep the distances within a few hundred nm
+      side = model == "motor" ? 1e-7 : 0.001;
+    }
+
+  // the em model uses 100 fs pulses and ps propagation delays, as in em-example: a coarser
+  // resolution rounds them to zero; femtoseconds still cover runs of over two hours
+  Time::SetResolution (Time::FS);
+
+  if (g_format != "json")
+    {
+      std::cout << "model,nodes,senders,packets,tube_density,wall_s,events,events_per_s,peak_rss_kb,"
+                << "setup_s,tx_s,motion_s,fanout_s,rx_s,specificity_s" << std::endl;
+    }
+
+  for (uint64_t nodes = minNodes; nodes <= maxNodes; nodes *= 10)
+    {
+      if (model == "motor")
+        {
+          for (double d = minTubeDensity; d <= maxTubeDensity; d *= 10)
+            {
+              RunScenario (model, nodes, senders, packets, Seconds (interval / 1000.), side, d);
+            }
+        }
+      else
+        {
+          RunScenario (model, nodes, senders, packets, Seconds (interval / 1000.), side, 0.);
+        }
+    }
+
+  return 0;
+}
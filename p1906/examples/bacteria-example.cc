@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+/*
+ * Description:
+ * this file models a chain of three nodes communicating with bacteria.
+ * The first node releases a population carrying the message in a
+ * plasmid; the bacteria swim by chemotaxis towards the attractant of
+ * the other nodes. The second node relays the message by conjugation,
+ * releasing its own bacteria towards the third one, which few bacteria
+ * of the first population reach. Use --P1906Threads to move the
+ * bacteria with several threads, e.g.,
+ *
+ *   ./waf --run "scratch/bacteria-example --bacteria=1000000 --P1906Threads=0"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-relay.h"
+#include "ns3/p1906-bacteria-perturbation.h"
+#include "ns3/p1906-bacteria-field.h"
+#include "ns3/p1906-bacteria-motion.h"
+#include "ns3/p1906-bacteria-specificity.h"
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-bacteria-communication-interface.h"
+#include "ns3/p1906-bacteria-transmitter-communication-interface.h"
+#include "ns3/p1906-bacteria-receiver-communication-interface.h"
+
+using namespace ns3;
+
+
+int main (int argc, char *argv[])
+{
+
+  //set of parameters
+  uint32_t nodes = 3;
+  double nodeDistance = 150;						//  [um]
+  uint32_t bacteria = 10000;
+  double attractantRate = 1e-15;					//  [mol/s]
+  double maxTime = 1800;							//  [s]
+
+  CommandLine cmd;
+  cmd.AddValue("nodes", "nodes", nodes);
+  cmd.AddValue("nodeDistance", "nodeDistance", nodeDistance);
+  cmd.AddValue("bacteria", "bacteria", bacteria);
+  cmd.AddValue("attractantRate", "attractantRate", attractantRate);
+  cmd.AddValue("maxTime", "maxTime", maxTime);
+  cmd.Parse(argc, argv);
+
+
+  Time::SetResolution(Time::NS);
+
+  // Create P1906 Helper
+  P1906Helper helper;
+  helper.EnableLogComponents ();
+
+  // Create nodes (typical operation of ns-3)
+  NodeContainer n;
+  n.Create (nodes);
+
+  //set devices positions, on a line
+  Ptr<ListPositionAllocator> positionAlloc =
+		  CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      positionAlloc->Add (Vector(i * nodeDistance * 1e-6, 0, 0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator(positionAlloc);
+  mobility.Install(n);
+
+  // Create a medium and the Motion component
+  Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
+  Ptr<P1906BacteriaMotion> motion = CreateObject<P1906BacteriaMotion> ();
+  motion->SetAttribute ("MaxTime", TimeValue (Seconds (maxTime)));
+  medium->SetP1906Motion (motion);
+
+  // Create the devices, each one relaying by conjugation what it receives
+  std::vector< Ptr<P1906NetDevice> > devices;
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      Ptr<P1906NetDevice> dev = CreateObject<P1906NetDevice> ();
+      Ptr<P1906BacteriaCommunicationInterface> c = CreateObject<P1906BacteriaCommunicationInterface> ();
+      Ptr<P1906BacteriaSpecificity> s = CreateObject<P1906BacteriaSpecificity> ();
+      Ptr<P1906BacteriaField> fi = CreateObject<P1906BacteriaField> ();
+      Ptr<P1906BacteriaPerturbation> p = CreateObject<P1906BacteriaPerturbation> ();
+      fi->SetAttractantRate (attractantRate);
+      p->SetBacteria (bacteria);
+
+      helper.Connect(n.Get (i),dev,medium,c,fi, p,s);
+      dev->SetP1906Relay (CreateObject<P1906Relay> ());
+      devices.push_back (dev);
+    }
+
+
+  // Create a message to sent into the network
+  int pktSize = 16; //bytes
+  uint8_t *buffer  = new uint8_t[pktSize];
+  for (int i = 0; i < pktSize; i++)
+    {
+	  buffer[i] = 0; //empty information
+    }
+  Ptr<Packet> message = Create<Packet>(buffer, pktSize);
+
+
+  devices[0]->Send (message, devices[0]->GetBroadcast (), 0);
+
+
+  Simulator::Stop (Seconds (nodes * (maxTime + 60)));
+  Simulator::Run ();
+
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      P1906Relay::RelayStatistics s = devices[i]->GetP1906Relay ()->GetRelayStatistics ();
+      std::cout << "[node,received,forwarded] " << i << " " << s.received << " " << s.forwarded << std::endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+/*
+ * Description:
+ * this file models calcium signalling between two cells of a tissue
+ * connected by gap junctions. The tissue is a cubic lattice of
+ * side^3 cells (e.g., --side=100 for 10^6 cells); the transmitter is
+ * in the corner of the lattice and the receiver nodeDistance cells
+ * away along the x axis. Use --P1906Threads to integrate the tissue
+ * with several threads.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-calcium-perturbation.h"
+#include "ns3/p1906-calcium-field.h"
+#include "ns3/p1906-calcium-motion.h"
+#include "ns3/p1906-calcium-specificity.h"
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-calcium-communication-interface.h"
+#include "ns3/p1906-calcium-transmitter-communication-interface.h"
+#include "ns3/p1906-calcium-receiver-communication-interface.h"
+
+using namespace ns3;
+
+
+int main (int argc, char *argv[])
+{
+
+  //set of parameters
+  uint32_t side = 20;							//  [cells]
+  uint32_t nodeDistance = 3;					//  [cells]
+  double cellSize = 10;							//  [um]
+  double coupling = 1.;							//  [1/s]
+  double calcium = 1.;							//  [uM]
+  double threshold = 0.005;					//  [uM]
+  double pulseInterval = 10.;					//  [s]
+
+  CommandLine cmd;
+  cmd.AddValue("side", "side", side);
+  cmd.AddValue("nodeDistance", "nodeDistance", nodeDistance);
+  cmd.AddValue("cellSize", "cellSize", cellSize);
+  cmd.AddValue("coupling", "coupling", coupling);
+  cmd.AddValue("calcium", "calcium", calcium);
+  cmd.AddValue("threshold", "threshold", threshold);
+  cmd.AddValue("pulseInterval", "pulseInterval", pulseInterval);
+  cmd.Parse(argc, argv);
+
+
+  Time::SetResolution(Time::NS);
+
+  // Create P1906 Helper
+  P1906Helper helper;
+  helper.EnableLogComponents ();
+
+  // Create nodes (typical operation of ns-3)
+  NodeContainer n;
+  NetDeviceContainer d;
+  n.Create (2);
+
+  // Create a medium and the Motion component
+  Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
+  Ptr<P1906CalciumMotion> motion = CreateObject<P1906CalciumMotion> ();
+  medium->SetP1906Motion (motion);
+
+  // the tissue is a single Field shared by the two devices
+  Ptr<P1906CalciumField> tissue = CreateObject<P1906CalciumField> ();
+  tissue->BuildLattice (side, side, side, cellSize * 1e-6, coupling);
+
+  // Create Device 1 and related components/entities
+  Ptr<P1906NetDevice> dev1 = CreateObject<P1906NetDevice> ();
+  Ptr<P1906CalciumCommunicationInterface> c1 = CreateObject<P1906CalciumCommunicationInterface> ();
+  Ptr<P1906CalciumSpecificity> s1 = CreateObject<P1906CalciumSpecificity> ();
+  Ptr<P1906CalciumPerturbation> p1 = CreateObject<P1906CalciumPerturbation> ();
+  p1->SetPulseInterval (Seconds (pulseInterval));
+  p1->SetCalcium (calcium);
+  s1->SetThreshold (threshold);
+
+  // Create Device 2 and related components/entities
+  Ptr<P1906NetDevice> dev2 = CreateObject<P1906NetDevice> ();
+  Ptr<P1906CalciumCommunicationInterface> c2 = CreateObject<P1906CalciumCommunicationInterface> ();
+  Ptr<P1906CalciumSpecificity> s2 = CreateObject<P1906CalciumSpecificity> ();
+  Ptr<P1906CalciumPerturbation> p2 = CreateObject<P1906CalciumPerturbation> ();
+  p2->SetPulseInterval (Seconds (pulseInterval));
+  p2->SetCalcium (calcium);
+  s2->SetThreshold (threshold);
+
+
+  //set devices positions
+  Ptr<ListPositionAllocator> positionAlloc =
+		  CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector(0, 0, 0));
+  positionAlloc->Add (Vector(nodeDistance * cellSize * 1e-6, 0, 0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator(positionAlloc);
+  mobility.Install(n);
+
+
+  // Connect devices, nodes, medium, components and entities
+  d.Add (dev1);
+  d.Add (dev2);
+  helper.Connect(n.Get (0),dev1,medium,c1,tissue, p1,s1);
+  helper.Connect(n.Get (1),dev2,medium,c2,tissue, p2,s2);
+
+
+  // Create a message to sent into the network
+  int pktSize = 1; //bytes
+  uint8_t *buffer  = new uint8_t[pktSize];
+  for (int i = 0; i < pktSize; i++)
+    {
+	  buffer[i] = 0; //empty information
+    }
+  Ptr<Packet> message = Create<Packet>(buffer, pktSize);
+
+
+  c1->HandleTransmission (message);
+
+
+  Simulator::Stop (Seconds (120));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+  return 0;
+}
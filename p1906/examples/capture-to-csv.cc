@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+/*
+ * Description:
+ * this file converts a capture written by P1906Capture into CSV, one line
+ * per transmitted, received or rejected message carrier, e.g.,
+ *
+ *   ./waf --run "scratch/capture-to-csv --input=p1906.cap --output=p1906.csv"
+ *
+ * The CSV is written to the standard output when no output is given.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/p1906-capture.h"
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+
+int main (int argc, char *argv[])
+{
+
+  //set of parameters
+  std::string input = "p1906.cap";
+  std::string output = "";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "capture file", input);
+  cmd.AddValue("output", "CSV file", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is (input.c_str (), std::ios::in | std::ios::binary);
+  if (!is)
+    {
+      std::cerr << "cannot open " << input << std::endl;
+      return 1;
+    }
+
+  std::ofstream file;
+  if (output != "")
+    {
+      file.open (output.c_str ());
+      if (!file)
+        {
+          std::cerr << "cannot create " << output << std::endl;
+          return 1;
+        }
+    }
+  std::ostream &os = output != "" ? file : std::cout;
+
+  if (!P1906Capture::ConvertToCsv (is, os))
+    {
+      std::cerr << input << " is not a P1906 capture, or is truncated" << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+/*
+ * Description:
+ * this file models a grid of side x side fluorophore nodes exchanging
+ * messages by Foerster resonance energy transfer. Donors (fluorescein)
+ * and acceptors (tetramethylrhodamine) alternate as on a chessboard;
+ * the donor in the corner transmits, and every acceptor receives the
+ * excitons that reach it, all the acceptors competing for them. The
+ * FRET tables of the whole network are computed once, before the
+ * simulation.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/p1906-helper.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-fret-perturbation.h"
+#include "ns3/p1906-fret-field.h"
+#include "ns3/p1906-fret-motion.h"
+#include "ns3/p1906-fret-specificity.h"
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-fret-communication-interface.h"
+#include "ns3/p1906-fret-transmitter-communication-interface.h"
+#include "ns3/p1906-fret-receiver-communication-interface.h"
+#include <iostream>
+
+using namespace ns3;
+
+
+int main (int argc, char *argv[])
+{
+
+  //set of parameters
+  uint32_t side = 4;
+  double nodeDistance = 5;						//  [nm]
+  double excitons = 1000;
+  double pulseInterval = 100;					//  [ns]
+  double overlap = 6e15;						//  [M^-1 cm^-1 nm^4]
+
+  CommandLine cmd;
+  cmd.AddValue("side", "side", side);
+  cmd.AddValue("nodeDistance", "nodeDistance", nodeDistance);
+  cmd.AddValue("excitons", "excitons", excitons);
+  cmd.AddValue("pulseInterval", "pulseInterval", pulseInterval);
+  cmd.AddValue("overlap", "overlap", overlap);
+  cmd.Parse(argc, argv);
+
+
+  Time::SetResolution(Time::FS);
+
+  // Create P1906 Helper
+  P1906Helper helper;
+  helper.EnableLogComponents ();
+
+  // Create nodes (typical operation of ns-3)
+  NodeContainer n;
+  n.Create (side * side);
+
+  //set devices positions, on a grid
+  Ptr<ListPositionAllocator> positionAlloc =
+		  CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < side * side; i++)
+    {
+      positionAlloc->Add (Vector((i % side) * nodeDistance * 1e-9, (i / side) * nodeDistance * 1e-9, 0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator(positionAlloc);
+  mobility.Install(n);
+
+  // Create a medium and the Motion component
+  Ptr<P1906Medium> medium = CreateObject<P1906Medium> ();
+  Ptr<P1906FRETMotion> motion = CreateObject<P1906FRETMotion> ();
+  medium->SetP1906Motion (motion);
+
+  // the fluorophores are a single Field shared by the devices
+  Ptr<P1906FRETField> fret = CreateObject<P1906FRETField> ();
+  uint32_t donor = fret->AddSpecies (4.1e-9, 0.92);
+  uint32_t acceptor = fret->AddSpecies (2.2e-9, 0.28);
+  fret->SetOverlapIntegral (donor, acceptor, overlap);
+
+  std::vector< Ptr<P1906FRETCommunicationInterface> > interfaces;
+  for (uint32_t i = 0; i < side * side; i++)
+    {
+      Ptr<P1906NetDevice> dev = CreateObject<P1906NetDevice> ();
+      Ptr<P1906FRETCommunicationInterface> c = CreateObject<P1906FRETCommunicationInterface> ();
+      Ptr<P1906FRETSpecificity> s = CreateObject<P1906FRETSpecificity> ();
+      Ptr<P1906FRETPerturbation> p = CreateObject<P1906FRETPerturbation> ();
+      p->SetPulseInterval (NanoSeconds (pulseInterval));
+      p->SetExcitons (excitons);
+
+      bool isDonor = ((i % side) + (i / side)) % 2 == 0;
+      fret->AttachNode (n.Get (i)->GetId (), isDonor ? donor : acceptor, Vector (0, 0, 0));
+      helper.Connect(n.Get (i),dev,medium,c,fret, p,s);
+      interfaces.push_back (c);
+    }
+  fret->BuildTables ();
+
+  std::vector<double> received;
+  fret->EvaluatePulse (n.Get (0)->GetId (), excitons, received);
+  for (uint32_t i = 0; i < received.size (); i++)
+    {
+      if (received[i] > 0.)
+        {
+          uint32_t node = fret->GetNodeAt (i);
+          std::cout << "[acceptor,R0,efficiency,excitons] " << node << " "
+                    << fret->GetFoersterRadius (n.Get (0)->GetId (), node) << " "
+                    << fret->GetEfficiency (n.Get (0)->GetId (), node) << " "
+                    << received[i] << std::endl;
+        }
+    }
+
+
+  // Create a message to sent into the network
+  int pktSize = 1; //bytes
+  uint8_t *buffer  = new uint8_t[pktSize];
+  for (int i = 0; i < pktSize; i++)
+    {
+	  buffer[i] = 0; //empty information
+    }
+  Ptr<Packet> message = Create<Packet>(buffer, pktSize);
+
+
+  interfaces[0]->HandleTransmission (message);
+
+
+  Simulator::Stop (MicroSeconds (10));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+  return 0;
+}
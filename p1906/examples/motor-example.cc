@@ -141,6 +141,7 @@ int main (int argc, char *argv[])
   double mean_tube_density = 10; 							// [tube segments/nm^3]
   double tube_persistenceLength = 50; 						// [nm]
   size_t segPerTube = 10; 									// [segments/microtubule]
+  double accuracyTarget = 0;								// relative delay error, 0: full Brownian stepping
 
   CommandLine cmd;
   cmd.AddValue("nodeDistance", "nodeDistance", nodeDistance);
@@ -153,6 +154,7 @@ int main (int argc, char *argv[])
   cmd.AddValue("mean_tube_density", "mean_tube_density", mean_tube_density);
   cmd.AddValue("tube_persistenceLength", "tube_persistenceLength", tube_persistenceLength);
   cmd.AddValue("segPerTube", "tube_persistenceLength", segPerTube);
+  cmd.AddValue("accuracyTarget", "accuracyTarget", accuracyTarget);
   cmd.Parse(argc, argv);
     
   Time::SetResolution(Time::NS);
@@ -172,6 +174,8 @@ int main (int argc, char *argv[])
   Ptr<P1906MOL_MOTOR_Motion> motion = CreateObject<P1906MOL_MOTOR_Motion> ();
   
   motion->SetDiffusionCoefficient (diffusionCoefficient);
+  //! the cheapest engine whose delay error is within accuracyTarget moves the motor, see the "[engine]" log
+  motion->setAccuracyTarget (accuracyTarget);
   medium->SetP1906Motion (motion);
 
   // Create Device 1 and related components/entities
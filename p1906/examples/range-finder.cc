@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+/*
+ * Description:
+ * this file finds the maximum reliable range, i.e., the distance at which
+ * the channel capacity falls below the pulse rate, of a set of EM, MOL or
+ * motor configurations with pulse intervals spaced logarithmically between
+ * minPulseInterval and maxPulseInterval. It replaces the fixed distance
+ * sweeps of the _RUN_*_CHANNEL_CAPACITY_ scripts when only the crossover
+ * is needed, e.g.,
+ *
+ *   ./waf --run "scratch/range-finder --model=mol --configurations=64 --P1906Threads=0"
+ *
+ * The other parameters are those of em-example, mol-example and motor-example.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/p1906-channel-query.h"
+#include "ns3/p1906-range-finder.h"
+#include <iostream>
+#include <cmath>
+
+using namespace ns3;
+
+
+int main (int argc, char *argv[])
+{
+
+  //set of parameters
+  std::string model = "em";
+  uint32_t configurations = 16;
+  double minPulseInterval = 1.;		//  [ps] (em), [ms] (mol), motor time units (motor)
+  double maxPulseInterval = 1000.;	//  [ps] (em), [ms] (mol), motor time units (motor)
+  double minDistance = 1e-6;		//  [m]
+  double maxDistance = 0.5;			//  [m]
+  double tolerance = 1e-3;			//  relative to the range
+  double confidence = 1.96;			//  standard errors
+  uint32_t journeys = 16;			//  motor journeys per round
+  uint32_t maxJourneys = 1024;		//  motor journeys per probed distance
+
+  double waveSpeed = 3e8; 								//  [m/s]
+  double pulseEnergy = 500; 							//  [pJ]
+  double pulseDuration = 100;							//  [fs]
+  double diffusionCoefficient = 1;						//  [nm^2/ns]
+
+  CommandLine cmd;
+  cmd.AddValue("model", "em, mol or motor", model);
+  cmd.AddValue("configurations", "configurations", configurations);
+  cmd.AddValue("minPulseInterval", "minPulseInterval", minPulseInterval);
+  cmd.AddValue("maxPulseInterval", "maxPulseInterval", maxPulseInterval);
+  cmd.AddValue("minDistance", "minDistance", minDistance);
+  cmd.AddValue("maxDistance", "maxDistance", maxDistance);
+  cmd.AddValue("tolerance", "tolerance", tolerance);
+  cmd.AddValue("confidence", "confidence", confidence);
+  cmd.AddValue("journeys", "journeys", journeys);
+  cmd.AddValue("maxJourneys", "maxJourneys", maxJourneys);
+  cmd.AddValue("pulseEnergy", "pulseEnergy", pulseEnergy);
+  cmd.AddValue("pulseDuration", "pulseDuration", pulseDuration);
+  cmd.AddValue("diffusionCoefficient", "diffusionCoefficient", diffusionCoefficient);
+  cmd.Parse(argc, argv);
+
+  double powerTx = pulseEnergy/(pulseDuration/1000.);	//  [W]
+  double bandwidth = 1e12 * (1.55 - 0.45);				//  [Hz]
+  double subChannel = 1e12 * 0.1; 						//  [Hz]
+
+  std::vector<P1906RangeFinder::Configuration> c (configurations);
+  for (uint32_t i = 0; i < configurations; i++)
+    {
+      double x = configurations > 1 ? double (i) / (configurations - 1) : 0.;
+      double pulseInterval = minPulseInterval * pow (maxPulseInterval / minPulseInterval, x);
+
+      c[i].minDistance = minDistance;
+      c[i].maxDistance = maxDistance;
+      c[i].em.distance = 0.;
+      c[i].em.waveSpeed = waveSpeed;
+      c[i].em.powerTx = powerTx;
+      c[i].em.bandwidth = bandwidth;
+      c[i].em.subChannel = subChannel;
+      c[i].em.pulseInterval = pulseInterval * 1e-12;
+      c[i].mol.distance = 0.;
+      c[i].mol.diffusionCoefficient = diffusionCoefficient;
+      c[i].mol.journeys = journeys;
+      if (model == "motor")
+        {
+          c[i].model = P1906RangeFinder::MOTOR;
+          c[i].mol.pulseInterval = pulseInterval;
+        }
+      else if (model == "mol")
+        {
+          c[i].model = P1906RangeFinder::MOL;
+          c[i].mol.pulseInterval = pulseInterval * 1e-3;
+        }
+      else
+        {
+          c[i].model = P1906RangeFinder::EM;
+        }
+    }
+
+  P1906RangeFinder finder;
+  finder.SetTolerance (tolerance);
+  finder.SetConfidence (confidence);
+  finder.SetJourneys (journeys, maxJourneys);
+
+  std::vector<P1906RangeFinder::Range> ranges = finder.FindRanges (c);
+  P1906RangeFinder::Print (std::cout, c, ranges);
+
+  return 0;
+}
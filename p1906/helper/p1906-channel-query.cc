@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "p1906-channel-query.h"
+#include "ns3/log.h"
+#include "ns3/vector.h"
+#include "../model-core/p1906-task-pool.h"
+#include "../model-em/p1906-em-motion.h"
+#include "../model-em/p1906-em-specificity.h"
+#include "../model-mol/p1906-mol-motion.h"
+#include "../model-mol/p1906-mol-specificity.h"
+#include "../model-motor/p1906-mol-motor.h"
+#include "../model-motor/p1906-mol-motor-motion.h"
+#include "../model-motor/p1906-mol-motor-rng.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906ChannelQuery");
+
+// closed form links are cheap: hand them to the pool in large chunks
+static const size_t CLOSED_FORM_GRAIN = 1024;
+// time step of the motor journeys, as in P1906MOL_MOTOR_Motion::ComputePropagationDelay
+static const double MOTOR_TIME_PERIOD = 100;
+
+static uint32_t g_nextStream = 0;
+
+P1906ChannelQuery::Result
+P1906ChannelQuery::QueryEM (const EMLink &link)
+{
+  int nbOfSubChannels = link.bandwidth / link.subChannel;
+  double txPowerDensity = (link.powerTx / nbOfSubChannels) / link.subChannel;
+  double psd[P1906EMMotion::NUM_BANDS];
+  for (int i = 0; i < P1906EMMotion::NUM_BANDS; i++)
+    {
+      psd[i] = txPowerDensity;
+    }
+  P1906EMMotion::ComputeReceivedPsd (link.distance, psd, psd);
+
+  Result r;
+  r.delay = P1906EMMotion::ComputeDelay (link.distance, link.waveSpeed);
+  r.delayStdDev = 0.;
+  r.rxPower = 0.;
+  for (int i = 0; i < P1906EMMotion::NUM_BANDS; i++)
+    {
+      r.rxPower += psd[i] * link.subChannel;
+    }
+  r.capacity = P1906EMSpecificity::ComputeCapacity (link.distance, psd, link.subChannel);
+  r.margin = r.capacity - 1. / link.pulseInterval;
+  r.ok = r.margin >= 0;
+  return r;
+}
+
+P1906ChannelQuery::Result
+P1906ChannelQuery::QueryMOL (const MOLLink &link)
+{
+  Result r;
+  r.delay = P1906MOLMotion::ComputeDelay (link.distance, link.diffusionCoefficient);
+  r.delayStdDev = 0.;
+  r.rxPower = 0.;
+  r.capacity = P1906MOLSpecificity::ComputeCapacity (link.distance, link.diffusionCoefficient);
+  r.margin = r.capacity - 1. / link.pulseInterval;
+  r.ok = r.margin >= 0;
+  return r;
+}
+
+void
+P1906ChannelQuery::QueryEM (const std::vector<EMLink> &links, std::vector<Result> &results)
+{
+  NS_LOG_FUNCTION (links.size ());
+  results.resize (links.size ());
+  const EMLink *in = links.empty () ? 0 : &links[0];
+  Result *out = results.empty () ? 0 : &results[0];
+  P1906TaskPool::ParallelFor (0, links.size (), CLOSED_FORM_GRAIN,
+                              [in, out] (size_t b, size_t e)
+                              {
+                                for (size_t i = b; i < e; i++)
+                                  {
+                                    out[i] = QueryEM (in[i]);
+                                  }
+                              });
+}
+
+void
+P1906ChannelQuery::QueryMOL (const std::vector<MOLLink> &links, std::vector<Result> &results)
+{
+  NS_LOG_FUNCTION (links.size ());
+  results.resize (links.size ());
+  const MOLLink *in = links.empty () ? 0 : &links[0];
+  Result *out = results.empty () ? 0 : &results[0];
+  P1906TaskPool::ParallelFor (0, links.size (), CLOSED_FORM_GRAIN,
+                              [in, out] (size_t b, size_t e)
+                              {
+                                for (size_t i = b; i < e; i++)
+                                  {
+                                    out[i] = QueryMOL (in[i]);
+                                  }
+                              });
+}
+
+void
+P1906ChannelQuery::QueryMotor (const std::vector<MOLLink> &links, std::vector<Result> &results)
+{
+  NS_LOG_FUNCTION (links.size ());
+
+  // objects are created here, in link and journey order, and each task only
+  // touches its own motor: no Ptr is shared between tasks
+  std::vector< Ptr<P1906MOL_MOTOR_Motion> > motions (links.size ());
+  std::vector<size_t> first (links.size () + 1, 0);
+  for (size_t l = 0; l < links.size (); l++)
+    {
+      motions[l] = CreateObject<P1906MOL_MOTOR_Motion> ();
+      motions[l]->SetDiffusionCoefficient (links[l].diffusionCoefficient);
+      first[l + 1] = first[l] + std::max (links[l].journeys, (uint32_t) 1);
+    }
+
+  size_t nJourneys = first[links.size ()];
+  std::vector< Ptr<P1906MOL_Motor> > motors (nJourneys);
+  std::vector<P1906MOL_MOTOR_Motion *> motion (nJourneys);
+  std::vector<double> distance (nJourneys);
+  for (size_t l = 0; l < links.size (); l++)
+    {
+      for (size_t j = first[l]; j < first[l + 1]; j++)
+        {
+          // the ChannelQuery component keeps the Motor carrier ids, and so the streams of the
+          // simulated motors, independent of the queries
+          motors[j] = CreateObject<P1906MOL_Motor> (P1906MOL_MOTOR_Rng::ChannelQuery);
+          P1906MOL_MOTOR_Rng::setStream (motors[j]->r, P1906MOL_MOTOR_Rng::ChannelQuery, g_nextStream++);
+          motion[j] = PeekPointer (motions[l]);
+          distance[j] = links[l].distance;
+        }
+    }
+
+  std::vector<double> time (nJourneys);
+  P1906TaskPool::ParallelFor (0, nJourneys, 1,
+                              [&] (size_t b, size_t e)
+                              {
+                                for (size_t j = b; j < e; j++)
+                                  {
+                                    time[j] = motion[j]->float2Receiver (motors[j], Vector (0, 0, 0),
+                                                                         Vector (distance[j], 0, 0),
+                                                                         MOTOR_TIME_PERIOD);
+                                    motors[j]->pos_history.clear ();
+                                  }
+                              });
+
+  results.resize (links.size ());
+  for (size_t l = 0; l < links.size (); l++)
+    {
+      Result r = QueryMOL (links[l]);
+      size_t n = first[l + 1] - first[l];
+      double sum = 0.;
+      for (size_t j = first[l]; j < first[l + 1]; j++)
+        {
+          sum += time[j];
+        }
+      r.delay = sum / n;
+      double var = 0.;
+      for (size_t j = first[l]; j < first[l + 1]; j++)
+        {
+          var += (time[j] - r.delay) * (time[j] - r.delay);
+        }
+      r.delayStdDev = n > 1 ? sqrt (var / (n - 1)) : 0.;
+      results[l] = r;
+    }
+}
+
+uint32_t
+P1906ChannelQuery::GetNextStream (void)
+{
+  return g_nextStream;
+}
+
+void
+P1906ChannelQuery::SetNextStream (uint32_t stream)
+{
+  NS_LOG_FUNCTION (stream);
+  g_nextStream = stream;
+}
+
+} // namespace ns3
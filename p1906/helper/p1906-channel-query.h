@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_CHANNEL_QUERY_H
+#define P1906_CHANNEL_QUERY_H
+
+#include <stdint.h>
+#include <vector>
+
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ * \brief evaluates the channel models of the EM, MOL and motor examples for
+ * arrays of links, without nodes, devices, medium or simulator
+ *
+ * Each query maps an array of link parameters to an array of results with
+ * the same models used by the Motion and Specificity components during a
+ * simulation (P1906EMMotion, P1906EMSpecificity, P1906MOLMotion,
+ * P1906MOLSpecificity and the Brownian journey of P1906MOL_MOTOR_Motion),
+ * so that parameter sweeps, range searches and external tools obtain delay,
+ * received power, capacity and decision margin of many links in one call.
+ *
+ * Links are evaluated in parallel on the P1906TaskPool. The EM and MOL
+ * models are closed form; the motor delay is the mean of independent
+ * journeys, each drawing from its own P1906MOL_MOTOR_Rng stream of the
+ * ChannelQuery component, so results do not depend on the number of threads.
+ */
+class P1906ChannelQuery
+{
+public:
+  /**
+   * The parameters of an EM link; transmitter and receiver are tuned on the same band
+   */
+  struct EMLink
+  {
+    double distance;        //!< [m]
+    double waveSpeed;       //!< [m/s]
+    double powerTx;         //!< [W]
+    double bandwidth;       //!< [Hz]
+    double subChannel;      //!< [Hz]
+    double pulseInterval;   //!< [s]
+  };
+
+  /**
+   * The parameters of a MOL or motor link
+   */
+  struct MOLLink
+  {
+    double distance;              //!< [m]
+    double diffusionCoefficient;  //!< [m^2/s]
+    double pulseInterval;         //!< [s]
+    uint32_t journeys;            //!< motor journeys averaged for the delay (motor links only)
+  };
+
+  /**
+   * The result of a link
+   */
+  struct Result
+  {
+    double delay;         //!< propagation delay [s]; the mean over the journeys for motor links
+    double delayStdDev;   //!< the standard deviation of the journeys, 0 for closed form models
+    double rxPower;       //!< received power summed over the sub-bands [W], 0 for MOL and motor links
+    double capacity;      //!< channel capacity of the Specificity component
+    double margin;        //!< capacity minus the transmission rate 1/pulseInterval
+    bool ok;              //!< the receiver accepts the message, i.e., margin >= 0
+  };
+
+  /**
+   * \param links the links to evaluate
+   * \param results resized to links.size () and filled in the same order
+   */
+  static void QueryEM (const std::vector<EMLink> &links, std::vector<Result> &results);
+  static void QueryMOL (const std::vector<MOLLink> &links, std::vector<Result> &results);
+  static void QueryMotor (const std::vector<MOLLink> &links, std::vector<Result> &results);
+
+  /**
+   * Evaluate a single link
+   */
+  static Result QueryEM (const EMLink &link);
+  static Result QueryMOL (const MOLLink &link);
+
+  /**
+   * The first carrier id of the ChannelQuery streams used by the next
+   * QueryMotor call; every journey advances it by one
+   */
+  static uint32_t GetNextStream (void);
+  static void SetNextStream (uint32_t stream);
+};
+
+} // namespace ns3
+
+#endif /* P1906_CHANNEL_QUERY_H */
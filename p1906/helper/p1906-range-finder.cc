@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "p1906-range-finder.h"
+#include "ns3/log.h"
+#include <cmath>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906RangeFinder");
+
+P1906RangeFinder::P1906RangeFinder (void)
+  : m_tolerance (1e-3),
+    m_confidence (1.96),
+    m_roundJourneys (16),
+    m_maxJourneys (1024),
+    m_maxIterations (64)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906RangeFinder::SetTolerance (double tolerance)
+{
+  NS_LOG_FUNCTION (this << tolerance);
+  m_tolerance = tolerance;
+}
+
+double
+P1906RangeFinder::GetTolerance (void) const
+{
+  return m_tolerance;
+}
+
+void
+P1906RangeFinder::SetConfidence (double z)
+{
+  NS_LOG_FUNCTION (this << z);
+  m_confidence = z;
+}
+
+double
+P1906RangeFinder::GetConfidence (void) const
+{
+  return m_confidence;
+}
+
+void
+P1906RangeFinder::SetJourneys (uint32_t round, uint32_t max)
+{
+  NS_LOG_FUNCTION (this << round << max);
+  m_roundJourneys = round < 2 ? 2 : round;
+  m_maxJourneys = max < m_roundJourneys ? m_roundJourneys : max;
+}
+
+void
+P1906RangeFinder::SetMaxIterations (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_maxIterations = n;
+}
+
+void
+P1906RangeFinder::Evaluate (const std::vector<Configuration> &configurations,
+                            const std::vector<size_t> &active,
+                            const std::vector<double> &distance,
+                            std::vector<int> &decision,
+                            std::vector<Range> &ranges)
+{
+  NS_LOG_FUNCTION (this << active.size ());
+  decision.assign (active.size (), 0);
+
+  // the deterministic models: one query each for all the configurations
+  std::vector<P1906ChannelQuery::EMLink> emLinks;
+  std::vector<P1906ChannelQuery::MOLLink> molLinks;
+  std::vector<size_t> emIndex, molIndex, motorIndex;
+  for (size_t a = 0; a < active.size (); a++)
+    {
+      const Configuration &c = configurations[active[a]];
+      ranges[active[a]].evaluations++;
+      if (c.model == EM)
+        {
+          emLinks.push_back (c.em);
+          emLinks.back ().distance = distance[a];
+          emIndex.push_back (a);
+        }
+      else if (c.model == MOL)
+        {
+          molLinks.push_back (c.mol);
+          molLinks.back ().distance = distance[a];
+          molIndex.push_back (a);
+        }
+      else
+        {
+          motorIndex.push_back (a);
+        }
+    }
+
+  std::vector<P1906ChannelQuery::Result> results;
+  P1906ChannelQuery::QueryEM (emLinks, results);
+  for (size_t i = 0; i < emIndex.size (); i++)
+    {
+      decision[emIndex[i]] = results[i].ok ? 1 : -1;
+    }
+  P1906ChannelQuery::QueryMOL (molLinks, results);
+  for (size_t i = 0; i < molIndex.size (); i++)
+    {
+      decision[molIndex[i]] = results[i].ok ? 1 : -1;
+    }
+
+  // the motor model: add rounds of journeys to the undecided distances
+  std::vector<double> n (motorIndex.size (), 0.);
+  std::vector<double> mean (motorIndex.size (), 0.);
+  std::vector<double> m2 (motorIndex.size (), 0.);
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < motorIndex.size (); i++)
+    {
+      pending.push_back (i);
+    }
+  while (!pending.empty ())
+    {
+      std::vector<P1906ChannelQuery::MOLLink> links;
+      for (size_t p = 0; p < pending.size (); p++)
+        {
+          size_t a = motorIndex[pending[p]];
+          links.push_back (configurations[active[a]].mol);
+          links.back ().distance = distance[a];
+          links.back ().journeys = m_roundJourneys;
+        }
+      P1906ChannelQuery::QueryMotor (links, results);
+
+      std::vector<size_t> undecided;
+      for (size_t p = 0; p < pending.size (); p++)
+        {
+          size_t i = pending[p];
+          size_t a = motorIndex[i];
+          ranges[active[a]].journeys += m_roundJourneys;
+
+          // merge the round into the running mean and sum of squared deviations
+          double nb = m_roundJourneys;
+          double m2b = results[p].delayStdDev * results[p].delayStdDev * (nb - 1);
+          double delta = results[p].delay - mean[i];
+          double total = n[i] + nb;
+          mean[i] += delta * nb / total;
+          m2[i] += m2b + delta * delta * n[i] * nb / total;
+          n[i] = total;
+
+          double halfWidth = m_confidence * sqrt (m2[i] / (n[i] - 1) / n[i]);
+          double pulseInterval = configurations[active[a]].mol.pulseInterval;
+          NS_LOG_FUNCTION (this << "[distance,journeys,mean,halfWidth]" << distance[a] << n[i] << mean[i] << halfWidth);
+          if (mean[i] + halfWidth <= pulseInterval)
+            {
+              decision[a] = 1;
+            }
+          else if (mean[i] - halfWidth > pulseInterval)
+            {
+              decision[a] = -1;
+            }
+          else if (n[i] < m_maxJourneys)
+            {
+              undecided.push_back (i);
+            }
+        }
+      pending.swap (undecided);
+    }
+}
+
+std::vector<P1906RangeFinder::Range>
+P1906RangeFinder::FindRanges (const std::vector<Configuration> &configurations)
+{
+  NS_LOG_FUNCTION (this << configurations.size ());
+  size_t nConfigurations = configurations.size ();
+  std::vector<Range> ranges (nConfigurations);
+  std::vector<double> low (nConfigurations), high (nConfigurations);
+  std::vector<size_t> active;
+  std::vector<double> distance;
+  std::vector<int> decision;
+
+  for (size_t c = 0; c < nConfigurations; c++)
+    {
+      ranges[c].status = FOUND;
+      ranges[c].range = 0.;
+      ranges[c].upper = configurations[c].minDistance;
+      ranges[c].evaluations = 0;
+      ranges[c].journeys = 0;
+      active.push_back (c);
+      distance.push_back (configurations[c].minDistance);
+    }
+
+  // bracket: the configurations must be reliable at minDistance and not at maxDistance
+  Evaluate (configurations, active, distance, decision, ranges);
+  std::vector<size_t> next;
+  std::vector<double> nextDistance;
+  for (size_t a = 0; a < active.size (); a++)
+    {
+      size_t c = active[a];
+      if (decision[a] < 0)
+        {
+          ranges[c].status = BELOW_MIN;
+        }
+      else if (decision[a] == 0)
+        {
+          ranges[c].status = UNRESOLVED;
+          ranges[c].range = ranges[c].upper = distance[a];
+        }
+      else
+        {
+          low[c] = distance[a];
+          next.push_back (c);
+          nextDistance.push_back (configurations[c].maxDistance);
+        }
+    }
+  active.swap (next);
+  distance.swap (nextDistance);
+
+  Evaluate (configurations, active, distance, decision, ranges);
+  next.clear ();
+  for (size_t a = 0; a < active.size (); a++)
+    {
+      size_t c = active[a];
+      if (decision[a] > 0)
+        {
+          ranges[c].status = ABOVE_MAX;
+          ranges[c].range = ranges[c].upper = distance[a];
+        }
+      else if (decision[a] == 0)
+        {
+          ranges[c].status = UNRESOLVED;
+          ranges[c].range = ranges[c].upper = distance[a];
+        }
+      else
+        {
+          high[c] = distance[a];
+          next.push_back (c);
+        }
+    }
+  active.swap (next);
+
+  // bisect the brackets of all the configurations together
+  for (uint32_t it = 0; it < m_maxIterations && !active.empty (); it++)
+    {
+      next.clear ();
+      distance.clear ();
+      for (size_t a = 0; a < active.size (); a++)
+        {
+          size_t c = active[a];
+          if (high[c] - low[c] > m_tolerance * low[c])
+            {
+              next.push_back (c);
+              distance.push_back (sqrt (low[c] * high[c]));
+            }
+        }
+      active.swap (next);
+
+      Evaluate (configurations, active, distance, decision, ranges);
+      next.clear ();
+      for (size_t a = 0; a < active.size (); a++)
+        {
+          size_t c = active[a];
+          if (decision[a] > 0)
+            {
+              low[c] = distance[a];
+              next.push_back (c);
+            }
+          else if (decision[a] < 0)
+            {
+              high[c] = distance[a];
+              next.push_back (c);
+            }
+          else
+            {
+              ranges[c].status = UNRESOLVED;
+              low[c] = high[c] = distance[a];
+            }
+        }
+      active.swap (next);
+    }
+
+  for (size_t c = 0; c < nConfigurations; c++)
+    {
+      if (ranges[c].status == FOUND || (ranges[c].status == UNRESOLVED && high[c] > 0))
+        {
+          ranges[c].range = low[c];
+          ranges[c].upper = high[c];
+        }
+    }
+  return ranges;
+}
+
+void
+P1906RangeFinder::Print (std::ostream &os, const std::vector<Configuration> &configurations,
+                         const std::vector<Range> &ranges)
+{
+  static const char *models[] = { "EM", "MOL", "MOTOR" };
+  static const char *status[] = { "FOUND", "BELOW_MIN", "ABOVE_MAX", "UNRESOLVED" };
+  for (size_t c = 0; c < ranges.size (); c++)
+    {
+      double pulseInterval = configurations[c].model == EM ?
+        configurations[c].em.pulseInterval : configurations[c].mol.pulseInterval;
+      os << "[configuration,model,pulseInterval,status,range,upper,evaluations,journeys] "
+         << c << " " << models[configurations[c].model] << " " << pulseInterval << " "
+         << status[ranges[c].status] << " " << ranges[c].range << " " << ranges[c].upper << " "
+         << ranges[c].evaluations << " " << ranges[c].journeys << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_RANGE_FINDER_H
+#define P1906_RANGE_FINDER_H
+
+#include <stdint.h>
+#include <vector>
+#include <ostream>
+#include "p1906-channel-query.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ * \brief finds the maximum reliable range of a set of link configurations,
+ * i.e., the distance at which the channel capacity falls below the
+ * transmission rate 1/pulseInterval
+ *
+ * The range of each configuration is bracketed between its minimum and
+ * maximum distance and bisected (at the geometric mean, since ranges span
+ * decades) until the bracket is narrower than the relative tolerance.
+ * The decision margin of the EM and MOL models is deterministic: one
+ * evaluation per probed distance is enough.
+ *
+ * The motor model is stochastic: a probed distance is reliable when the
+ * motors are delivered at least at the pulse rate, i.e., the mean journey
+ * time does not exceed the pulse interval. Journeys are added in rounds
+ * until the confidence interval of the mean excludes the pulse interval;
+ * if it still contains it after the maximum number of journeys, the probed
+ * distance cannot be told apart from the range and the search stops there
+ * (status UNRESOLVED).
+ *
+ * All the configurations advance together: at each step the probed
+ * distances of the configurations still searching are evaluated with a
+ * single P1906ChannelQuery call, which runs them in parallel.
+ */
+class P1906RangeFinder
+{
+public:
+  enum Model
+  {
+    EM = 0,
+    MOL,
+    MOTOR
+  };
+
+  /**
+   * A configuration; the distance of the link is ignored
+   */
+  struct Configuration
+  {
+    Model model;
+    P1906ChannelQuery::EMLink em;     //!< EM parameters
+    P1906ChannelQuery::MOLLink mol;   //!< MOL and motor parameters, journeys ignored
+    double minDistance;               //!< [m], > 0
+    double maxDistance;               //!< [m]
+  };
+
+  enum Status
+  {
+    FOUND = 0,      //!< the range is within [range, upper]
+    BELOW_MIN,      //!< not reliable at minDistance
+    ABOVE_MAX,      //!< still reliable at maxDistance
+    UNRESOLVED      //!< motor only: the range is at range within the statistical resolution
+  };
+
+  struct Range
+  {
+    Status status;
+    double range;           //!< the largest distance found reliable [m]
+    double upper;           //!< the smallest distance found not reliable [m]
+    uint32_t evaluations;   //!< the number of probed distances
+    uint32_t journeys;      //!< the motor journeys simulated
+  };
+
+  P1906RangeFinder (void);
+
+  /**
+   * \param tolerance the bracket width at which the search stops, relative to the range
+   */
+  void SetTolerance (double tolerance);
+  double GetTolerance (void) const;
+  /**
+   * \param z the width of the confidence interval of the mean journey time, in standard errors
+   */
+  void SetConfidence (double z);
+  double GetConfidence (void) const;
+  /**
+   * \param round the motor journeys added to a probed distance at a time
+   * \param max the motor journeys after which a probed distance is UNRESOLVED
+   */
+  void SetJourneys (uint32_t round, uint32_t max);
+  void SetMaxIterations (uint32_t n);
+
+  /**
+   * \param configurations the configurations to search
+   * \return the range of each configuration, in the same order
+   */
+  std::vector<Range> FindRanges (const std::vector<Configuration> &configurations);
+
+  static void Print (std::ostream &os, const std::vector<Configuration> &configurations,
+                     const std::vector<Range> &ranges);
+
+private:
+  /**
+   * The decision for one probed distance of every configuration still searching:
+   * 1 reliable, -1 not reliable, 0 unresolved
+   */
+  void Evaluate (const std::vector<Configuration> &configurations,
+                 const std::vector<size_t> &active,
+                 const std::vector<double> &distance,
+                 std::vector<int> &decision,
+                 std::vector<Range> &ranges);
+
+  double m_tolerance;
+  double m_confidence;
+  uint32_t m_roundJourneys;
+  uint32_t m_maxJourneys;
+  uint32_t m_maxIterations;
+};
+
+} // namespace ns3
+
+#endif /* P1906_RANGE_FINDER_H */
@@ -0,0 +1,753 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "p1906-snapshot-helper.h"
+#include "p1906-helper.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "../model-core/p1906-net-device.h"
+#include "../model-core/p1906-medium.h"
+#include "../model-core/p1906-perturbation.h"
+#include "../model-core/p1906-field.h"
+#include "../model-core/p1906-motion.h"
+#include "../model-core/p1906-specificity.h"
+#include "../model-core/p1906-communication-interface.h"
+#include "../model-core/p1906-transmitter-communication-interface.h"
+#include "../model-core/p1906-receiver-communication-interface.h"
+#include "../model-em/p1906-em-perturbation.h"
+#include "../model-em/p1906-em-motion.h"
+#include "../model-em/p1906-em-field.h"
+#include "../model-em/p1906-em-specificity.h"
+#include "../model-em/p1906-em-communication-interface.h"
+#include "../model-mol/p1906-mol-perturbation.h"
+#include "../model-mol/p1906-mol-motion.h"
+#include "../model-mol/p1906-mol-field.h"
+#include "../model-mol/p1906-mol-specificity.h"
+#include "../model-mol/p1906-mol-communication-interface.h"
+#include "../model-motor/p1906-mol-motor-perturbation.h"
+#include "../model-motor/p1906-mol-motor-motion.h"
+#include "../model-motor/p1906-mol-motor-field.h"
+#include "../model-motor/p1906-mol-motor-microtubule.h"
+#include "../model-motor/p1906-mol-motor-communication-interface.h"
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+NS_LOG_COMPONENT_DEFINE ("P1906SnapshotHelper");
+
+namespace ns3 {
+
+/*
+ * Snapshot layout (native byte order, all records 8-byte aligned):
+ *
+ *   SnapshotHeader
+ *   ComponentRecord      motion of the medium      \
+ *   InterfaceRecord[n]   communication interfaces   |  payload, covered
+ *   FieldRecord[m]       fields                     |  by the hash
+ *   double[]             tubes and vector fields   /
+ */
+
+static const char SNAPSHOT_MAGIC[8] = { 'P', '1', '9', '0', '6', 'S', 'N', 'P' };
+static const uint32_t SNAPSHOT_VERSION = 2;
+static const uint32_t SNAPSHOT_PARAMS = 12;
+static const uint32_t SNAPSHOT_TIMES = 2;
+static const uint32_t SNAPSHOT_NO_FIELD = 0xffffffff;
+
+enum SnapshotKind
+{
+  SNAPSHOT_NONE = 0,
+  SNAPSHOT_CORE,
+  SNAPSHOT_EM,
+  SNAPSHOT_MOL,
+  SNAPSHOT_MOL_MOTOR,
+  SNAPSHOT_MOL_MOTOR_MICROTUBULES
+};
+
+struct SnapshotHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t nInterfaces;
+  uint32_t nFields;
+  uint32_t reserved;
+  uint64_t hash;
+  uint64_t payloadSize;
+};
+
+struct ComponentRecord
+{
+  uint32_t kind;
+  uint32_t resolution;  // the Time::Unit of the time steps
+  double params[SNAPSHOT_PARAMS];
+  int64_t times[SNAPSHOT_TIMES];
+};
+
+struct InterfaceRecord
+{
+  uint32_t kind;
+  uint32_t field;
+  uint32_t hasPosition;
+  uint32_t reserved;
+  double position[3];
+  ComponentRecord perturbation;
+  ComponentRecord specificity;
+};
+
+struct FieldRecord
+{
+  ComponentRecord field;
+  uint64_t dataOffset;
+  uint64_t rows;
+};
+
+/*
+ * Components -> records
+ */
+
+// times are kept as integer time steps, e.g., the 100 fs pulses of a FS resolution run
+static void
+SaveTime (Time t, ComponentRecord &r, uint32_t i)
+{
+  r.resolution = Time::GetResolution ();
+  r.times[i] = t.GetTimeStep ();
+}
+
+static void
+SavePerturbation (Ptr<P1906Perturbation> p, ComponentRecord &r)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  r.kind = SNAPSHOT_CORE;
+  if (Ptr<P1906EMPerturbation> em = DynamicCast<P1906EMPerturbation> (p))
+    {
+      r.kind = SNAPSHOT_EM;
+      r.params[0] = em->GetPowerTransmission ();
+      SaveTime (em->GetPulseDuration (), r, 0);
+      SaveTime (em->GetPulseInterval (), r, 1);
+      r.params[3] = em->GetCentralFrequency ();
+      r.params[4] = em->GetBandwidth ();
+      r.params[5] = em->GetSubChannel ();
+    }
+  else if (Ptr<P1906MOLPerturbation> mol = DynamicCast<P1906MOLPerturbation> (p))
+    {
+      r.kind = SNAPSHOT_MOL;
+      SaveTime (mol->GetPulseInterval (), r, 0);
+      r.params[1] = mol->GetMolecules ();
+      r.params[2] = mol->GetSynthesisEnergy ();
+    }
+  else if (Ptr<P1906MOL_MOTOR_Perturbation> motor = DynamicCast<P1906MOL_MOTOR_Perturbation> (p))
+    {
+      r.kind = SNAPSHOT_MOL_MOTOR;
+      SaveTime (motor->GetPulseInterval (), r, 0);
+      r.params[1] = motor->GetMolecules ();
+    }
+}
+
+static void
+SaveSpecificity (Ptr<P1906Specificity> s, ComponentRecord &r)
+{
+  if (s == 0)
+    {
+      return;
+    }
+  r.kind = SNAPSHOT_CORE;
+  if (DynamicCast<P1906EMSpecificity> (s))
+    {
+      r.kind = SNAPSHOT_EM;
+    }
+  else if (Ptr<P1906MOLSpecificity> mol = DynamicCast<P1906MOLSpecificity> (s))
+    {
+      r.kind = SNAPSHOT_MOL;
+      r.params[0] = mol->GetDiffusionConefficient ();
+    }
+}
+
+static void
+SaveMotion (Ptr<P1906Motion> m, ComponentRecord &r)
+{
+  if (m == 0)
+    {
+      return;
+    }
+  r.kind = SNAPSHOT_CORE;
+  if (Ptr<P1906EMMotion> em = DynamicCast<P1906EMMotion> (m))
+    {
+      r.kind = SNAPSHOT_EM;
+      r.params[0] = em->GetWaveSpeed ();
+    }
+  else if (Ptr<P1906MOL_MOTOR_Motion> motor = DynamicCast<P1906MOL_MOTOR_Motion> (m))
+    {
+      r.kind = SNAPSHOT_MOL_MOTOR;
+      r.params[0] = motor->GetDiffusionConefficient ();
+      r.params[1] = motor->getAccuracyTarget ();
+    }
+  else if (Ptr<P1906MOLMotion> mol = DynamicCast<P1906MOLMotion> (m))
+    {
+      r.kind = SNAPSHOT_MOL;
+      r.params[0] = mol->GetDiffusionConefficient ();
+    }
+}
+
+static void
+SaveField (Ptr<P1906Field> f, FieldRecord &r, std::vector<double> &data)
+{
+  r.field.kind = SNAPSHOT_CORE;
+  if (Ptr<P1906MOL_MOTOR_MicrotubulesField> mt = DynamicCast<P1906MOL_MOTOR_MicrotubulesField> (f))
+    {
+      r.field.kind = SNAPSHOT_MOL_MOTOR_MICROTUBULES;
+      r.field.params[0] = mt->ts.volume;
+      r.field.params[1] = mt->ts.mean_tube_length;
+      r.field.params[2] = mt->ts.mean_intra_tube_angle;
+      r.field.params[3] = mt->ts.mean_inter_tube_angle;
+      r.field.params[4] = mt->ts.mean_tube_density;
+      r.field.params[5] = mt->ts.segLength;
+      r.field.params[6] = mt->ts.numSegments;
+      r.field.params[7] = mt->ts.persistenceLength;
+      r.field.params[8] = mt->ts.segPerTube;
+      r.field.params[9] = mt->ts.numTubes;
+      r.field.params[10] = mt->ts.se;
+
+      // tubes followed by the vector field, row-major
+      r.dataOffset = data.size ();
+      r.rows = mt->tubeMatrix->size1;
+      for (size_t i = 0; i < mt->tubeMatrix->size1; i++)
+        {
+          const double *row = gsl_matrix_const_ptr (mt->tubeMatrix, i, 0);
+          data.insert (data.end (), row, row + 6);
+        }
+      for (size_t i = 0; i < mt->vf->size1; i++)
+        {
+          const double *row = gsl_matrix_const_ptr (mt->vf, i, 0);
+          data.insert (data.end (), row, row + 6);
+        }
+    }
+  else if (DynamicCast<P1906MOL_MOTOR_Field> (f))
+    {
+      r.field.kind = SNAPSHOT_MOL_MOTOR;
+    }
+  else if (DynamicCast<P1906MOLField> (f))
+    {
+      r.field.kind = SNAPSHOT_MOL;
+    }
+  else if (DynamicCast<P1906EMField> (f))
+    {
+      r.field.kind = SNAPSHOT_EM;
+    }
+}
+
+static uint32_t
+InterfaceKind (Ptr<P1906CommunicationInterface> c)
+{
+  if (DynamicCast<P1906EMCommunicationInterface> (c))
+    {
+      return SNAPSHOT_EM;
+    }
+  if (DynamicCast<P1906MOLCommunicationInterface> (c))
+    {
+      return SNAPSHOT_MOL;
+    }
+  if (DynamicCast<P1906MOL_MOTOR_CommunicationInterface> (c))
+    {
+      return SNAPSHOT_MOL_MOTOR;
+    }
+  return SNAPSHOT_CORE;
+}
+
+/*
+ * Records -> components
+ */
+
+// exact when the snapshot was saved with the current resolution
+static Time
+RestoreTime (const ComponentRecord &r, uint32_t i)
+{
+  return Time::FromInteger (r.times[i], (Time::Unit) r.resolution);
+}
+
+static Ptr<P1906Perturbation>
+RestorePerturbation (const ComponentRecord &r)
+{
+  switch (r.kind)
+    {
+    case SNAPSHOT_EM:
+      {
+        Ptr<P1906EMPerturbation> em = CreateObject<P1906EMPerturbation> ();
+        em->SetPowerTransmission (r.params[0]);
+        em->SetPulseDuration (RestoreTime (r, 0));
+        em->SetPulseInterval (RestoreTime (r, 1));
+        em->SetCentralFrequency (r.params[3]);
+        em->SetBandwidth (r.params[4]);
+        em->SetSubChannel (r.params[5]);
+        return em;
+      }
+    case SNAPSHOT_MOL:
+      {
+        Ptr<P1906MOLPerturbation> mol = CreateObject<P1906MOLPerturbation> ();
+        mol->SetPulseInterval (RestoreTime (r, 0));
+        mol->SetMolecules (r.params[1]);
+        mol->SetSynthesisEnergy (r.params[2]);
+        return mol;
+      }
+    case SNAPSHOT_MOL_MOTOR:
+      {
+        Ptr<P1906MOL_MOTOR_Perturbation> motor = CreateObject<P1906MOL_MOTOR_Perturbation> ();
+        motor->SetPulseInterval (RestoreTime (r, 0));
+        motor->SetMolecules (r.params[1]);
+        return motor;
+      }
+    case SNAPSHOT_CORE:
+      return CreateObject<P1906Perturbation> ();
+    default:
+      return 0;
+    }
+}
+
+static Ptr<P1906Specificity>
+RestoreSpecificity (const ComponentRecord &r)
+{
+  switch (r.kind)
+    {
+    case SNAPSHOT_EM:
+      return CreateObject<P1906EMSpecificity> ();
+    case SNAPSHOT_MOL:
+      {
+        Ptr<P1906MOLSpecificity> mol = CreateObject<P1906MOLSpecificity> ();
+        mol->SetDiffusionCoefficient (r.params[0]);
+        return mol;
+      }
+    default:
+      // P1906Helper::Connect requires a Specificity component
+      return CreateObject<P1906Specificity> ();
+    }
+}
+
+static Ptr<P1906Motion>
+RestoreMotion (const ComponentRecord &r)
+{
+  switch (r.kind)
+    {
+    case SNAPSHOT_EM:
+      {
+        Ptr<P1906EMMotion> em = CreateObject<P1906EMMotion> ();
+        em->SetWaveSpeed (r.params[0]);
+        return em;
+      }
+    case SNAPSHOT_MOL:
+      {
+        Ptr<P1906MOLMotion> mol = CreateObject<P1906MOLMotion> ();
+        mol->SetDiffusionCoefficient (r.params[0]);
+        return mol;
+      }
+    case SNAPSHOT_MOL_MOTOR:
+      {
+        Ptr<P1906MOL_MOTOR_Motion> motor = CreateObject<P1906MOL_MOTOR_Motion> ();
+        motor->SetDiffusionCoefficient (r.params[0]);
+        motor->setAccuracyTarget (r.params[1]);
+        return motor;
+      }
+    case SNAPSHOT_CORE:
+      return CreateObject<P1906Motion> ();
+    default:
+      return 0;
+    }
+}
+
+static Ptr<P1906Field>
+RestoreField (const FieldRecord &r, const double *data)
+{
+  switch (r.field.kind)
+    {
+    case SNAPSHOT_EM:
+      return CreateObject<P1906EMField> ();
+    case SNAPSHOT_MOL:
+      return CreateObject<P1906MOLField> ();
+    case SNAPSHOT_MOL_MOTOR:
+      return CreateObject<P1906MOL_MOTOR_Field> ();
+    case SNAPSHOT_MOL_MOTOR_MICROTUBULES:
+      {
+        tubeCharacteristcs_t ts;
+        ts.volume = r.field.params[0];
+        ts.mean_tube_length = r.field.params[1];
+        ts.mean_intra_tube_angle = r.field.params[2];
+        ts.mean_inter_tube_angle = r.field.params[3];
+        ts.mean_tube_density = r.field.params[4];
+        ts.segLength = r.field.params[5];
+        ts.numSegments = r.field.params[6];
+        ts.persistenceLength = r.field.params[7];
+        ts.segPerTube = r.field.params[8];
+        ts.numTubes = r.field.params[9];
+        ts.se = r.field.params[10];
+        const double *tubes = data + r.dataOffset;
+        return CreateObject<P1906MOL_MOTOR_MicrotubulesField> (ts, tubes, tubes + r.rows * 6);
+      }
+    default:
+      return CreateObject<P1906Field> ();
+    }
+}
+
+static Ptr<P1906CommunicationInterface>
+RestoreInterface (uint32_t kind)
+{
+  switch (kind)
+    {
+    case SNAPSHOT_EM:
+      return CreateObject<P1906EMCommunicationInterface> ();
+    case SNAPSHOT_MOL:
+      return CreateObject<P1906MOLCommunicationInterface> ();
+    case SNAPSHOT_MOL_MOTOR:
+      return CreateObject<P1906MOL_MOTOR_CommunicationInterface> ();
+    default:
+      return CreateObject<P1906CommunicationInterface> ();
+    }
+}
+
+P1906SnapshotHelper::P1906SnapshotHelper (void)
+  : m_hash (0)
+{}
+
+P1906SnapshotHelper::~P1906SnapshotHelper (void)
+{}
+
+uint64_t
+P1906SnapshotHelper::ComputeHash (const uint8_t *data, uint64_t size)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (uint64_t i = 0; i < size; i++)
+    {
+      h ^= data[i];
+      h *= 1099511628211ULL;
+    }
+  return h;
+}
+
+uint64_t
+P1906SnapshotHelper::Save (Ptr<P1906Medium> medium, std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  P1906Medium::P1906CommunicationInterfaces *interfaces = medium->GetP1906CommunicationInterfaces ();
+
+  ComponentRecord motion;
+  memset (&motion, 0, sizeof (motion));
+  SaveMotion (medium->GetP1906Motion (), motion);
+
+  std::vector<InterfaceRecord> interfaceRecords (interfaces->size ());
+  std::vector<FieldRecord> fieldRecords;
+  std::vector<double> data;
+  std::map<P1906Field *, uint32_t> fieldIndex;
+
+  for (uint32_t i = 0; i < interfaces->size (); i++)
+    {
+      Ptr<P1906CommunicationInterface> c = interfaces->at (i);
+      InterfaceRecord &r = interfaceRecords[i];
+      memset (&r, 0, sizeof (r));
+      r.kind = InterfaceKind (c);
+
+      Ptr<MobilityModel> mobility = 0;
+      if (c->GetP1906NetDevice () != 0 && c->GetP1906NetDevice ()->GetNode () != 0)
+        {
+          mobility = c->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ();
+        }
+      if (mobility != 0)
+        {
+          Vector v = mobility->GetPosition ();
+          r.hasPosition = 1;
+          r.position[0] = v.x;
+          r.position[1] = v.y;
+          r.position[2] = v.z;
+        }
+
+      SavePerturbation (c->GetP1906TransmitterCommunicationInterface ()->GetP1906Perturbation (), r.perturbation);
+      SaveSpecificity (c->GetP1906ReceiverCommunicationInterface ()->GetP1906Specificity (), r.specificity);
+
+      // fields shared by several interfaces are stored once
+      Ptr<P1906Field> field = c->GetP1906TransmitterCommunicationInterface ()->GetP1906Field ();
+      r.field = SNAPSHOT_NO_FIELD;
+      if (field != 0)
+        {
+          std::map<P1906Field *, uint32_t>::iterator it = fieldIndex.find (PeekPointer (field));
+          if (it != fieldIndex.end ())
+            {
+              r.field = it->second;
+            }
+          else
+            {
+              FieldRecord f;
+              memset (&f, 0, sizeof (f));
+              SaveField (field, f, data);
+              r.field = fieldRecords.size ();
+              fieldIndex[PeekPointer (field)] = r.field;
+              fieldRecords.push_back (f);
+            }
+        }
+    }
+
+  // lay out the payload in a single buffer
+  uint64_t payloadSize = sizeof (ComponentRecord)
+    + interfaceRecords.size () * sizeof (InterfaceRecord)
+    + fieldRecords.size () * sizeof (FieldRecord)
+    + data.size () * sizeof (double);
+  std::vector<uint8_t> payload (payloadSize);
+  uint8_t *out = payload.empty () ? 0 : &payload[0];
+  memcpy (out, &motion, sizeof (motion));
+  out += sizeof (motion);
+  if (!interfaceRecords.empty ())
+    {
+      memcpy (out, &interfaceRecords[0], interfaceRecords.size () * sizeof (InterfaceRecord));
+      out += interfaceRecords.size () * sizeof (InterfaceRecord);
+    }
+  if (!fieldRecords.empty ())
+    {
+      memcpy (out, &fieldRecords[0], fieldRecords.size () * sizeof (FieldRecord));
+      out += fieldRecords.size () * sizeof (FieldRecord);
+    }
+  if (!data.empty ())
+    {
+      memcpy (out, &data[0], data.size () * sizeof (double));
+    }
+
+  SnapshotHeader header;
+  memset (&header, 0, sizeof (header));
+  memcpy (header.magic, SNAPSHOT_MAGIC, sizeof (header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.nInterfaces = interfaceRecords.size ();
+  header.nFields = fieldRecords.size ();
+  header.payloadSize = payloadSize;
+  header.hash = ComputeHash (&payload[0], payloadSize);
+
+  FILE *f = fopen (fileName.c_str (), "wb");
+  if (f == 0)
+    {
+      NS_LOG_WARN ("cannot create the snapshot " << fileName);
+      return 0;
+    }
+  bool ok = fwrite (&header, sizeof (header), 1, f) == 1
+    && fwrite (&payload[0], 1, payloadSize, f) == payloadSize;
+  ok = (fclose (f) == 0) && ok;
+  if (!ok)
+    {
+      NS_LOG_WARN ("cannot write the snapshot " << fileName);
+      return 0;
+    }
+
+  NS_LOG_INFO ("saved snapshot " << fileName << " [interfaces,fields,bytes] "
+               << header.nInterfaces << " " << header.nFields << " " << payloadSize);
+  m_hash = header.hash;
+  return m_hash;
+}
+
+std::string
+P1906SnapshotHelper::SaveToStore (Ptr<P1906Medium> medium, std::string directory)
+{
+  NS_LOG_FUNCTION (this << directory);
+
+  // the hash is only known once the content is built: write, then rename; the temporary file
+  // is unique, since runs sharing the store may save at the same time
+  std::string tmpName = directory + "/.snapshot.XXXXXX";
+  std::vector<char> tmpPath (tmpName.begin (), tmpName.end ());
+  tmpPath.push_back ('\0');
+  int fd = mkstemp (&tmpPath[0]);
+  if (fd < 0)
+    {
+      NS_LOG_WARN ("cannot create a temporary snapshot in " << directory);
+      return "";
+    }
+  // mkstemp creates the file readable by its owner only
+  fchmod (fd, 0644);
+  close (fd);
+  tmpName = &tmpPath[0];
+  uint64_t hash = Save (medium, tmpName);
+  if (hash == 0)
+    {
+      remove (tmpName.c_str ());
+      return "";
+    }
+
+  std::ostringstream name;
+  name << directory << "/" << std::hex << std::setw (16) << std::setfill ('0') << hash << ".p1906snap";
+  if (rename (tmpName.c_str (), name.str ().c_str ()) != 0)
+    {
+      NS_LOG_WARN ("cannot store the snapshot as " << name.str ());
+      remove (tmpName.c_str ());
+      return "";
+    }
+  return name.str ();
+}
+
+Ptr<P1906Medium>
+P1906SnapshotHelper::Restore (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_LOG_WARN ("cannot open the snapshot " << fileName);
+      return 0;
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || (uint64_t) st.st_size < sizeof (SnapshotHeader))
+    {
+      NS_LOG_WARN ("invalid snapshot " << fileName);
+      close (fd);
+      return 0;
+    }
+  void *map = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (map == MAP_FAILED)
+    {
+      NS_LOG_WARN ("cannot map the snapshot " << fileName);
+      return 0;
+    }
+
+  const uint8_t *base = (const uint8_t *) map;
+  const SnapshotHeader *header = (const SnapshotHeader *) base;
+  const uint8_t *payload = base + sizeof (SnapshotHeader);
+
+  uint64_t recordsSize = sizeof (ComponentRecord)
+    + (uint64_t) header->nInterfaces * sizeof (InterfaceRecord)
+    + (uint64_t) header->nFields * sizeof (FieldRecord);
+  if (memcmp (header->magic, SNAPSHOT_MAGIC, sizeof (header->magic)) != 0
+      || header->version != SNAPSHOT_VERSION
+      || header->payloadSize != st.st_size - sizeof (SnapshotHeader)
+      || header->payloadSize < recordsSize
+      || ComputeHash (payload, header->payloadSize) != header->hash)
+    {
+      NS_LOG_WARN ("invalid or corrupted snapshot " << fileName);
+      munmap (map, st.st_size);
+      return 0;
+    }
+
+  const ComponentRecord *motion = (const ComponentRecord *) payload;
+  const InterfaceRecord *interfaceRecords = (const InterfaceRecord *) (motion + 1);
+  const FieldRecord *fieldRecords = (const FieldRecord *) (interfaceRecords + header->nInterfaces);
+  const double *data = (const double *) (fieldRecords + header->nFields);
+  uint64_t dataSize = (header->payloadSize - recordsSize) / sizeof (double);
+
+  m_medium = CreateObject<P1906Medium> ();
+  m_medium->SetP1906Motion (RestoreMotion (*motion));
+  m_nodes = NodeContainer ();
+  m_devices = NetDeviceContainer ();
+  m_interfaces.clear ();
+
+  std::vector< Ptr<P1906Field> > fields (header->nFields);
+  for (uint32_t i = 0; i < header->nFields; i++)
+    {
+      const FieldRecord &f = fieldRecords[i];
+      if (f.field.kind == SNAPSHOT_MOL_MOTOR_MICROTUBULES && f.dataOffset + 12 * f.rows > dataSize)
+        {
+          NS_LOG_WARN ("truncated field data in snapshot " << fileName);
+          munmap (map, st.st_size);
+          m_medium = 0;
+          return 0;
+        }
+      fields[i] = RestoreField (f, data);
+    }
+
+  P1906Helper helper;
+  for (uint32_t i = 0; i < header->nInterfaces; i++)
+    {
+      const InterfaceRecord &r = interfaceRecords[i];
+
+      Ptr<Node> n = CreateObject<Node> ();
+      if (r.hasPosition)
+        {
+          Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (Vector (r.position[0], r.position[1], r.position[2]));
+          n->AggregateObject (mobility);
+        }
+
+      Ptr<P1906NetDevice> d = CreateObject<P1906NetDevice> ();
+      Ptr<P1906CommunicationInterface> c = RestoreInterface (r.kind);
+      Ptr<P1906Field> field = (r.field < fields.size ()) ? fields[r.field] : Ptr<P1906Field> (0);
+
+      helper.Connect (n, d, m_medium, c, field, RestorePerturbation (r.perturbation), RestoreSpecificity (r.specificity));
+
+      m_nodes.Add (n);
+      m_devices.Add (d);
+      m_interfaces.push_back (c);
+    }
+
+  m_hash = header->hash;
+  NS_LOG_INFO ("restored snapshot " << fileName << " [interfaces,fields] "
+               << header->nInterfaces << " " << header->nFields);
+  munmap (map, st.st_size);
+  return m_medium;
+}
+
+Ptr<P1906Medium>
+P1906SnapshotHelper::GetMedium (void)
+{
+  return m_medium;
+}
+
+NodeContainer
+P1906SnapshotHelper::GetNodes (void)
+{
+  return m_nodes;
+}
+
+NetDeviceContainer
+P1906SnapshotHelper::GetDevices (void)
+{
+  return m_devices;
+}
+
+uint32_t
+P1906SnapshotHelper::GetNCommunicationInterfaces (void)
+{
+  return m_interfaces.size ();
+}
+
+Ptr<P1906CommunicationInterface>
+P1906SnapshotHelper::GetCommunicationInterface (uint32_t i)
+{
+  return m_interfaces.at (i);
+}
+
+uint64_t
+P1906SnapshotHelper::GetHash (void)
+{
+  return m_hash;
+}
+
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_SNAPSHOT_HELPER_H
+#define P1906_SNAPSHOT_HELPER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+
+
+namespace ns3 {
+
+class P1906Medium;
+class P1906CommunicationInterface;
+
+/**
+ * \ingroup P1906 framework
+ * \brief saves a fully built P1906 scenario into a binary snapshot and restores it
+ *
+ * The snapshot stores, for every communication interface attached to the medium,
+ * the node position and the parameters of the Perturbation and Specificity
+ * components, the Fields (shared Fields are stored once and referenced by index,
+ * microtubule networks include their tubes and vector field) and the Motion
+ * component of the medium.
+ *
+ * The file is a header followed by fixed-size records and the raw field data,
+ * all 8-byte aligned, so that it is restored by memory mapping it and copying
+ * the arrays without parsing. The header carries a 64-bit FNV-1a hash of the
+ * content, which is verified on restore and used to name content-addressed
+ * snapshots (see SaveToStore).
+ *
+ * After Restore, parameters can be overridden through the components returned
+ * by GetCommunicationInterface and GetMedium.
+ */
+class P1906SnapshotHelper
+{
+public:
+  P1906SnapshotHelper (void);
+  ~P1906SnapshotHelper (void);
+
+  /**
+   * \param medium the medium the scenario is attached to
+   * \param fileName the snapshot file
+   * \return the content hash of the snapshot, 0 if it cannot be written
+   */
+  uint64_t Save (Ptr<P1906Medium> medium, std::string fileName);
+
+  /**
+   * \param medium the medium the scenario is attached to
+   * \param directory the directory of the snapshot store
+   * \return the file directory/<content hash>.p1906snap, empty if it cannot be written
+   */
+  std::string SaveToStore (Ptr<P1906Medium> medium, std::string directory);
+
+  /**
+   * Create nodes, devices, components and fields as stored in the snapshot
+   * and connect them to a new medium
+   *
+   * \param fileName the snapshot file
+   * \return the new medium, 0 if the file is not a valid snapshot
+   */
+  Ptr<P1906Medium> Restore (std::string fileName);
+
+  Ptr<P1906Medium> GetMedium (void);
+  NodeContainer GetNodes (void);
+  NetDeviceContainer GetDevices (void);
+  uint32_t GetNCommunicationInterfaces (void);
+  Ptr<P1906CommunicationInterface> GetCommunicationInterface (uint32_t i);
+
+  /**
+   * \return the content hash of the last saved or restored snapshot
+   */
+  uint64_t GetHash (void);
+
+  /**
+   * \return the 64-bit FNV-1a hash of size bytes
+   */
+  static uint64_t ComputeHash (const uint8_t *data, uint64_t size);
+
+private:
+  Ptr<P1906Medium> m_medium;
+  NodeContainer m_nodes;
+  NetDeviceContainer m_devices;
+  std::vector< Ptr<P1906CommunicationInterface> > m_interfaces;
+  uint64_t m_hash;
+};
+
+} // namespace ns3
+
+#endif /* P1906_SNAPSHOT_HELPER_H */
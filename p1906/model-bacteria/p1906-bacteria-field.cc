@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+
+#include "p1906-bacteria-field.h"
+#include "ns3/p1906-field.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906BacteriaField");
+
+TypeId P1906BacteriaField::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906BacteriaField")
+    .SetParent<P1906Field> ();
+  return tid;
+}
+
+P1906BacteriaField::P1906BacteriaField ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << "Created BACTERIA Field Component");
+  m_attractantRate = 1e-15;         // [mol/s]
+  m_attractantDiffusion = 1e-9;     // [m^2/s], a small molecule in water
+  m_receptorDissociation = 1e-3;    // [mol/m^3], 1 uM
+}
+
+P1906BacteriaField::~P1906BacteriaField ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906BacteriaField::SetAttractantRate (double q)
+{
+  NS_LOG_FUNCTION (this << q);
+  m_attractantRate = q;
+}
+
+double
+P1906BacteriaField::GetAttractantRate (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_attractantRate;
+}
+
+void
+P1906BacteriaField::SetAttractantDiffusion (double d)
+{
+  NS_LOG_FUNCTION (this << d);
+  m_attractantDiffusion = d;
+}
+
+double
+P1906BacteriaField::GetAttractantDiffusion (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_attractantDiffusion;
+}
+
+void
+P1906BacteriaField::SetReceptorDissociation (double kd)
+{
+  NS_LOG_FUNCTION (this << kd);
+  m_receptorDissociation = kd;
+}
+
+double
+P1906BacteriaField::GetReceptorDissociation (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_receptorDissociation;
+}
+
+double
+P1906BacteriaField::GetAttractant (double r)
+{
+  NS_LOG_FUNCTION (this << r);
+  return m_attractantRate / (4. * M_PI * m_attractantDiffusion * r);
+}
+
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_BACTERIA_FIELD
+#define P1906_BACTERIA_FIELD
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-field.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906BacteriaField
+ *
+ * \brief Class implementing the Field component of the P1906
+ * framework for the BACTERIA Example: the attractant emitted by
+ * each receiver, which diffuses into a steady concentration
+ * C (r) = Q / (4 pi D r) guiding the bacteria towards it, and the
+ * dissociation constant of the receptors sensing it
+ */
+
+class P1906BacteriaField : public P1906Field
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906BacteriaField ();
+  virtual ~P1906BacteriaField ();
+
+  /**
+   * \param q the attractant emitted by a receiver [mol/s]
+   */
+  void SetAttractantRate (double q);
+  double GetAttractantRate (void);
+
+  /**
+   * \param d the diffusion coefficient of the attractant [m^2/s]
+   */
+  void SetAttractantDiffusion (double d);
+  double GetAttractantDiffusion (void);
+
+  /**
+   * \param kd the dissociation constant of the receptors [mol/m^3]
+   */
+  void SetReceptorDissociation (double kd);
+  double GetReceptorDissociation (void);
+
+  /**
+   * \return the attractant at distance r from a receiver [mol/m^3]
+   */
+  double GetAttractant (double r);
+
+private:
+  double m_attractantRate;
+  double m_attractantDiffusion;
+  double m_receptorDissociation;
+};
+
+}
+
+#endif /* P1906_BACTERIA_FIELD */
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_BACTERIA_MESSAGE_CARRIER
+#define P1906_BACTERIA_MESSAGE_CARRIER
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-message-carrier.h"
+
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906BacteriaMessageCarrier
+ *
+ * \brief Class implementing the Message Carrier component of the
+ * P1906 framework for the BACTERIA Example: a population of bacteria
+ * carrying the message in a plasmid. The bacteria are those released
+ * by the transmitter when the carrier is created, those that reached
+ * the receiver once it has been propagated by the Motion component.
+ */
+
+class P1906BacteriaMessageCarrier : public P1906MessageCarrier
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906BacteriaMessageCarrier ();
+  virtual ~P1906BacteriaMessageCarrier ();
+
+  void SetStartTime (Time t);
+  Time GetStartTime (void);
+
+  void SetBacteria (uint32_t n);
+  uint32_t GetBacteria (void);
+
+  /**
+   * \param r the radius of the sphere the bacteria are released in [m]
+   */
+  void SetReleaseRadius (double r);
+  double GetReleaseRadius (void);
+
+  virtual CaptureMetadata GetCaptureMetadata (void);
+
+private:
+  Time m_startTime;
+  uint32_t m_bacteria;
+  double m_releaseRadius;
+};
+
+}
+
+#endif /* P1906_BACTERIA_MESSAGE_CARRIER */
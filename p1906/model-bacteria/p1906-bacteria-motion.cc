@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+
+#include "p1906-bacteria-motion.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-transmitter-communication-interface.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "p1906-bacteria-field.h"
+#include "p1906-bacteria-message-carrier.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906BacteriaMotion");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906BacteriaMotion);
+
+TypeId P1906BacteriaMotion::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906BacteriaMotion")
+    .SetParent<P1906Motion> ()
+    .AddConstructor<P1906BacteriaMotion> ()
+    .AddAttribute ("RunSpeed",
+                   "The swimming speed of a bacterium [m/s]",
+                   DoubleValue (20e-6),
+                   MakeDoubleAccessor (&P1906BacteriaMotion::m_runSpeed),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("TumbleRate",
+                   "The tumble rate of a bacterium without attractant [1/s]",
+                   DoubleValue (1.),
+                   MakeDoubleAccessor (&P1906BacteriaMotion::m_tumbleRate),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("Sensitivity",
+                   "The gain of the chemotactic response to the change of the attractant [s]",
+                   DoubleValue (5.),
+                   MakeDoubleAccessor (&P1906BacteriaMotion::m_sensitivity),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("CaptureRadius",
+                   "The distance from the receiver at which a bacterium is captured [m]",
+                   DoubleValue (20e-6),
+                   MakeDoubleAccessor (&P1906BacteriaMotion::m_captureRadius),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("TimeStep",
+                   "The step of the simulation of the population",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&P1906BacteriaMotion::m_timeStep),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxTime",
+                   "The longest simulation of a population",
+                   TimeValue (Seconds (3600)),
+                   MakeTimeAccessor (&P1906BacteriaMotion::m_maxTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("CaptureWindow",
+                   "How long after the Quorum captured bacteria still count towards the received carrier",
+                   TimeValue (Seconds (60)),
+                   MakeTimeAccessor (&P1906BacteriaMotion::m_captureWindow),
+                   MakeTimeChecker ())
+    .AddAttribute ("Quorum",
+                   "The captured bacteria marking the arrival of the message",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&P1906BacteriaMotion::m_quorum),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Grain",
+                   "The number of bacteria updated by a task of the P1906TaskPool",
+                   UintegerValue (16384),
+                   MakeUintegerAccessor (&P1906BacteriaMotion::m_grain),
+                   MakeUintegerChecker<uint32_t> (1));
+  return tid;
+}
+
+P1906BacteriaMotion::P1906BacteriaMotion ()
+{
+  NS_LOG_FUNCTION (this);
+  m_captured = 0;
+  m_delay = 0.;
+  m_simulations = 0;
+}
+
+P1906BacteriaMotion::~P1906BacteriaMotion ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+double
+P1906BacteriaMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+		                                     Ptr<P1906CommunicationInterface> dst,
+		                                     Ptr<P1906MessageCarrier> message,
+		                                     Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this << "run and tumble");
+  if (message != m_lastMessage || dst != m_lastDst)
+    {
+      Simulate (src, dst, message, field);
+    }
+  return m_delay;
+}
+
+
+Ptr<P1906MessageCarrier>
+P1906BacteriaMotion::CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+		                                            Ptr<P1906CommunicationInterface> dst,
+		                                            Ptr<P1906MessageCarrier> message,
+		                                            Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this);
+  if (message != m_lastMessage || dst != m_lastDst)
+    {
+      Simulate (src, dst, message, field);
+    }
+
+  Ptr<P1906BacteriaMessageCarrier> m = message->GetObject<P1906BacteriaMessageCarrier> ();
+  Ptr<P1906BacteriaMessageCarrier> received = CreateObject<P1906BacteriaMessageCarrier> ();
+  received->SetMessage (m->GetMessage ());
+  received->SetStartTime (m->GetStartTime ());
+  received->SetReleaseRadius (m->GetReleaseRadius ());
+  received->SetBacteria (m_captured);
+  return received;
+}
+
+void
+P1906BacteriaMotion::Simulate (Ptr<P1906CommunicationInterface> src,
+                               Ptr<P1906CommunicationInterface> dst,
+                               Ptr<P1906MessageCarrier> message,
+                               Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906BacteriaMessageCarrier> m = message->GetObject<P1906BacteriaMessageCarrier> ();
+
+  // the attractant is the one emitted by the receiver
+  Ptr<P1906BacteriaField> attractant = 0;
+  Ptr<P1906TransmitterCommunicationInterface> dstTx = dst->GetP1906TransmitterCommunicationInterface ();
+  if (dstTx && dstTx->GetP1906Field ())
+    {
+      attractant = dstTx->GetP1906Field ()->GetObject<P1906BacteriaField> ();
+    }
+  if (!attractant)
+    {
+      attractant = field->GetObject<P1906BacteriaField> ();
+    }
+
+  Ptr<Node> srcNode = src->GetP1906NetDevice ()->GetNode ();
+  Ptr<Node> dstNode = dst->GetP1906NetDevice ()->GetNode ();
+  Vector origin = srcNode->GetObject<MobilityModel> ()->GetPosition ();
+
+  P1906BacteriaPopulation::Parameters p;
+  p.source = dstNode->GetObject<MobilityModel> ()->GetPosition ();
+  p.captureRadius = m_captureRadius;
+  p.runSpeed = m_runSpeed;
+  p.tumbleRate = m_tumbleRate;
+  p.sensitivity = m_sensitivity;
+  p.attractantRate = attractant->GetAttractantRate ();
+  p.attractantDiffusion = attractant->GetAttractantDiffusion ();
+  p.dissociation = attractant->GetReceptorDissociation ();
+  p.timeStep = m_timeStep.GetSeconds ();
+
+  // the random numbers of a population depend on the message and the receiver only
+  uint32_t stream0 = (uint32_t) m->GetMessage ()->GetUid ();
+  uint32_t stream1 = (dstNode->GetId () << 8) | P1906MOL_MOTOR_Rng::Bacteria;
+  m_population.SetGrain (m_grain);
+  m_population.Release (m->GetBacteria (), origin, m->GetReleaseRadius (), stream0, stream1);
+
+  // the population is followed up to the capture window after the quorum, not up to MaxTime
+  uint32_t maxSteps = std::ceil (m_maxTime.GetSeconds () / p.timeStep);
+  uint32_t windowSteps = std::ceil (m_captureWindow.GetSeconds () / p.timeStep);
+  uint32_t quorumStep = maxSteps;
+  uint32_t lastStep = maxSteps;
+  m_captured = 0;
+  while (m_population.GetSteps () < lastStep && m_population.GetSwimming () > 0)
+    {
+      m_captured += m_population.Step (p);
+      if (quorumStep == maxSteps && m_captured >= m_quorum)
+        {
+          quorumStep = m_population.GetSteps ();
+          lastStep = std::min (maxSteps, quorumStep + windowSteps);
+        }
+    }
+
+  m_delay = quorumStep * p.timeStep;
+  m_lastMessage = message;
+  m_lastDst = dst;
+  m_simulations++;
+
+  NS_LOG_FUNCTION (this << "[released,captured,steps,delay]" << m->GetBacteria () << m_captured
+                   << m_population.GetSteps () << m_delay);
+}
+
+uint64_t
+P1906BacteriaMotion::GetSimulations (void) const
+{
+  return m_simulations;
+}
+
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_BACTERIA_MOTION
+#define P1906_BACTERIA_MOTION
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-motion.h"
+#include "p1906-bacteria-population.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906BacteriaMotion
+ *
+ * \brief Class implementing the Motion component of the P1906
+ * framework for the BACTERIA Example: the bacteria released by the
+ * transmitter swim by run-and-tumble chemotaxis up the attractant
+ * gradient of the receiver (see P1906BacteriaPopulation and
+ * P1906BacteriaField, the Field of the receiver). The propagation
+ * delay is the time at which Quorum bacteria were captured (MaxTime if
+ * they never were). The population is followed CaptureWindow longer,
+ * the time the first ones stay in contact with the receiver (see
+ * P1906BacteriaSpecificity::SetContactTime), and the received carrier
+ * holds the bacteria captured by then.
+ *
+ * The medium asks for the delay and the received carrier of the same
+ * receiver in turn, so the last simulated population is reused.
+ */
+
+class P1906BacteriaMotion : public P1906Motion
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906BacteriaMotion ();
+  virtual ~P1906BacteriaMotion ();
+
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+  		                                  Ptr<P1906CommunicationInterface> dst,
+  		                                  Ptr<P1906MessageCarrier> message,
+  		                                  Ptr<P1906Field> field);
+
+  virtual Ptr<P1906MessageCarrier> CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+  		                                                           Ptr<P1906CommunicationInterface> dst,
+  		                                                           Ptr<P1906MessageCarrier> message,
+  		                                                           Ptr<P1906Field> field);
+
+  /**
+   * \return the number of populations simulated so far
+   */
+  uint64_t GetSimulations (void) const;
+
+private:
+  void Simulate (Ptr<P1906CommunicationInterface> src,
+                 Ptr<P1906CommunicationInterface> dst,
+                 Ptr<P1906MessageCarrier> message,
+                 Ptr<P1906Field> field);
+
+  double m_runSpeed;
+  double m_tumbleRate;
+  double m_sensitivity;
+  double m_captureRadius;
+  Time m_timeStep;
+  Time m_maxTime;
+  Time m_captureWindow;
+  uint32_t m_quorum;
+  uint32_t m_grain;
+
+  P1906BacteriaPopulation m_population;
+  Ptr<P1906MessageCarrier> m_lastMessage;
+  Ptr<P1906CommunicationInterface> m_lastDst;
+  uint32_t m_captured;
+  double m_delay;
+  uint64_t m_simulations;
+};
+
+}
+
+#endif /* P1906_BACTERIA_MOTION */
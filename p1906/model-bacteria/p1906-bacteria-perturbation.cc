@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "p1906-bacteria-perturbation.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-perturbation.h"
+#include "p1906-bacteria-message-carrier.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906BacteriaPerturbation");
+
+TypeId P1906BacteriaPerturbation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906BacteriaPerturbation")
+    .SetParent<P1906Perturbation> ();
+  return tid;
+}
+
+P1906BacteriaPerturbation::P1906BacteriaPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+  m_bacteria = 10000;
+  m_releaseRadius = 10e-6;          // [m]
+  m_releaseTime = Seconds (60);
+  m_energyPerBacterium = 1e-12;     // [J], growing a bacterium and its plasmid
+}
+
+P1906BacteriaPerturbation::~P1906BacteriaPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906BacteriaPerturbation::SetBacteria (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_bacteria = n;
+}
+
+uint32_t
+P1906BacteriaPerturbation::GetBacteria (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_bacteria;
+}
+
+void
+P1906BacteriaPerturbation::SetReleaseRadius (double r)
+{
+  NS_LOG_FUNCTION (this << r);
+  m_releaseRadius = r;
+}
+
+double
+P1906BacteriaPerturbation::GetReleaseRadius (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_releaseRadius;
+}
+
+void
+P1906BacteriaPerturbation::SetReleaseTime (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_releaseTime = t;
+}
+
+Time
+P1906BacteriaPerturbation::GetReleaseTime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_releaseTime;
+}
+
+void
+P1906BacteriaPerturbation::SetEnergyPerBacterium (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_energyPerBacterium = e;
+}
+
+double
+P1906BacteriaPerturbation::GetEnergyPerBacterium (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_energyPerBacterium;
+}
+
+Ptr<P1906MessageCarrier>
+P1906BacteriaPerturbation::CreateMessageCarrier (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906BacteriaMessageCarrier> carrier = CreateObject<P1906BacteriaMessageCarrier> ();
+
+  NS_LOG_FUNCTION (this << "[t,bits,bacteria,releaseRadius]" << Simulator::Now ().GetSeconds ()
+		  << p->GetSize() * 8 << m_bacteria << m_releaseRadius);
+
+  carrier->SetStartTime (Simulator::Now ());
+  carrier->SetBacteria (m_bacteria);
+  carrier->SetReleaseRadius (m_releaseRadius);
+  carrier->SetMessage (p);
+
+  return carrier;
+}
+
+double
+P1906BacteriaPerturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  // the whole message fits in a plasmid, the cost is the population
+  return m_energyPerBacterium * m_bacteria;
+}
+
+Time
+P1906BacteriaPerturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  return m_releaseTime;
+}
+
+} // namespace ns3
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+
+#include "p1906-bacteria-population.h"
+#include "ns3/p1906-task-pool.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906BacteriaPopulation");
+
+// the bacteria are drawn in batches, so that the update loop runs over plain arrays
+static const size_t BACTERIA_BATCH = 256;
+// the counter step of the random numbers placing the bacteria at their release
+static const uint32_t RELEASE_STEP = 0xffffffff;
+
+P1906BacteriaPopulation::P1906BacteriaPopulation ()
+{
+  NS_LOG_FUNCTION (this);
+  m_key[0] = 0;
+  m_key[1] = 0;
+  m_stream[0] = 0;
+  m_stream[1] = 0;
+  m_steps = 0;
+  m_released = 0;
+  m_nSwimming = 0;
+  m_grain = 16384;
+}
+
+void
+P1906BacteriaPopulation::SetGrain (uint32_t grain)
+{
+  NS_LOG_FUNCTION (this << grain);
+  m_grain = std::max (grain, 1u);
+}
+
+void
+P1906BacteriaPopulation::Draw (uint32_t step, size_t i, double u[4]) const
+{
+  uint32_t ctr[4] = { step, (uint32_t) i, m_stream[0], m_stream[1] };
+  uint32_t block[4];
+  P1906MOL_MOTOR_Rng::philox4x32 (m_key, ctr, block);
+  for (int k = 0; k < 4; k++)
+    {
+      u[k] = (block[k] + 0.5) * (1. / 4294967296.);
+    }
+}
+
+void
+P1906BacteriaPopulation::Release (uint32_t n, Vector origin, double radius, uint32_t stream0, uint32_t stream1)
+{
+  NS_LOG_FUNCTION (this << n << origin << radius);
+  uint64_t run = RngSeedManager::GetRun ();
+  m_key[0] = RngSeedManager::GetSeed ();
+  m_key[1] = (uint32_t) run ^ (uint32_t) (run >> 32) ^ (uint32_t) P1906MOL_MOTOR_Rng::Bacteria;
+  m_stream[0] = stream0;
+  m_stream[1] = stream1;
+  m_steps = 0;
+  m_released = n;
+  m_nSwimming = n;
+
+  m_x.resize (n);
+  m_y.resize (n);
+  m_z.resize (n);
+  m_ux.resize (n);
+  m_uy.resize (n);
+  m_uz.resize (n);
+  m_swimming.assign (n, 1.);
+  m_id.resize (n);
+
+  P1906TaskPool::ParallelFor (0, n, m_grain, [&] (size_t b, size_t e)
+    {
+      for (size_t i = b; i < e; i++)
+        {
+          double u[4];
+          Draw (RELEASE_STEP, i, u);
+          double r = radius * std::cbrt (u[0]);
+          double cz = 2. * u[1] - 1.;
+          double st = std::sqrt (std::max (0., 1. - cz * cz));
+          double phi = 2. * M_PI * u[2];
+          m_x[i] = origin.x + r * st * std::cos (phi);
+          m_y[i] = origin.y + r * st * std::sin (phi);
+          m_z[i] = origin.z + r * cz;
+
+          Draw (0, i, u);
+          cz = 2. * u[1] - 1.;
+          st = std::sqrt (std::max (0., 1. - cz * cz));
+          phi = 2. * M_PI * u[2];
+          m_ux[i] = st * std::cos (phi);
+          m_uy[i] = st * std::sin (phi);
+          m_uz[i] = cz;
+          m_id[i] = i;
+        }
+    });
+}
+
+uint32_t
+P1906BacteriaPopulation::Step (const Parameters &p)
+{
+  uint32_t step = ++m_steps;
+  size_t n = m_x.size ();
+  if (m_nSwimming == 0)
+    {
+      return 0;
+    }
+
+  double *x = &m_x[0];
+  double *y = &m_y[0];
+  double *z = &m_z[0];
+  double *ux = &m_ux[0];
+  double *uy = &m_uy[0];
+  double *uz = &m_uz[0];
+  double *swimming = &m_swimming[0];
+  const uint32_t *id = &m_id[0];
+
+  const double sx = p.source.x;
+  const double sy = p.source.y;
+  const double sz = p.source.z;
+  const double dt = p.timeStep;
+  const double v = p.runSpeed;
+  const double emission = p.attractantRate / (4. * M_PI * p.attractantDiffusion);
+  const double kd = p.dissociation;
+  const double r2Capture = p.captureRadius * p.captureRadius;
+
+  double captured = P1906TaskPool::ParallelReduce (0, n, m_grain, 0.,
+    [&] (size_t b, size_t e)
+    {
+      double uTumble[BACTERIA_BATCH];
+      double uTheta[BACTERIA_BATCH];
+      double uPhi[BACTERIA_BATCH];
+      double sum = 0.;
+      for (size_t b0 = b; b0 < e; b0 += BACTERIA_BATCH)
+        {
+          size_t m = std::min (BACTERIA_BATCH, e - b0);
+          for (size_t k = 0; k < m; k++)
+            {
+              double u[4];
+              Draw (step, id[b0 + k], u);
+              uTumble[k] = u[0];
+              uTheta[k] = u[1];
+              uPhi[k] = u[2];
+            }
+
+          // branch-free: tumbles and captures are selected arithmetically
+          for (size_t k = 0; k < m; k++)
+            {
+              size_t i = b0 + k;
+              double s = swimming[i];
+              double dx = x[i] - sx;
+              double dy = y[i] - sy;
+              double dz = z[i] - sz;
+              double r = std::sqrt (dx * dx + dy * dy + dz * dz) + 1e-12;
+
+              // C ~ 1 / r, so dlnC/dt = - (dr/dt) / r
+              double dlnC = -v * (ux[i] * dx + uy[i] * dy + uz[i] * dz) / (r * r);
+              double occupancy = kd / (kd + emission / r);
+              double rate = p.tumbleRate * std::exp (-p.sensitivity * occupancy * dlnC);
+              double tumble = uTumble[k] < 1. - std::exp (-rate * dt) ? 1. : 0.;
+
+              double cz = 2. * uTheta[k] - 1.;
+              double st = std::sqrt (std::max (0., 1. - cz * cz));
+              double phi = 2. * M_PI * uPhi[k];
+              ux[i] += tumble * (st * std::cos (phi) - ux[i]);
+              uy[i] += tumble * (st * std::sin (phi) - uy[i]);
+              uz[i] += tumble * (cz - uz[i]);
+
+              double run = s * v * dt;
+              x[i] += run * ux[i];
+              y[i] += run * uy[i];
+              z[i] += run * uz[i];
+
+              dx = x[i] - sx;
+              dy = y[i] - sy;
+              dz = z[i] - sz;
+              double caught = dx * dx + dy * dy + dz * dz < r2Capture ? s : 0.;
+              swimming[i] = s - caught;
+              sum += caught;
+            }
+        }
+      return sum;
+    },
+    [] (double a, double b)
+    {
+      return a + b;
+    });
+
+  uint32_t c = (uint32_t) (captured + 0.5);
+  m_nSwimming -= c;
+  if (4 * (n - m_nSwimming) > n)
+    {
+      Compact ();
+    }
+  return c;
+}
+
+void
+P1906BacteriaPopulation::Compact (void)
+{
+  NS_LOG_FUNCTION (this << m_x.size () << m_nSwimming);
+  size_t n = m_x.size ();
+  size_t j = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      if (m_swimming[i] == 0.)
+        {
+          continue;
+        }
+      m_x[j] = m_x[i];
+      m_y[j] = m_y[i];
+      m_z[j] = m_z[i];
+      m_ux[j] = m_ux[i];
+      m_uy[j] = m_uy[i];
+      m_uz[j] = m_uz[i];
+      m_swimming[j] = m_swimming[i];
+      m_id[j] = m_id[i];
+      j++;
+    }
+  m_x.resize (j);
+  m_y.resize (j);
+  m_z.resize (j);
+  m_ux.resize (j);
+  m_uy.resize (j);
+  m_uz.resize (j);
+  m_swimming.resize (j);
+  m_id.resize (j);
+}
+
+uint32_t
+P1906BacteriaPopulation::GetSize (void) const
+{
+  return m_released;
+}
+
+uint32_t
+P1906BacteriaPopulation::GetHeld (void) const
+{
+  return m_x.size ();
+}
+
+uint32_t
+P1906BacteriaPopulation::GetSwimming (void) const
+{
+  return m_nSwimming;
+}
+
+uint32_t
+P1906BacteriaPopulation::GetSteps (void) const
+{
+  return m_steps;
+}
+
+Vector
+P1906BacteriaPopulation::GetPosition (uint32_t i) const
+{
+  return Vector (m_x[i], m_y[i], m_z[i]);
+}
+
+} // namespace ns3
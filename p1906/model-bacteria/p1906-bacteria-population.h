@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_BACTERIA_POPULATION
+#define P1906_BACTERIA_POPULATION
+
+#include "ns3/vector.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906BacteriaPopulation
+ *
+ * \brief This class holds a population of bacteria swimming by run and
+ * tumble towards a point source of attractant. Agents are stored as
+ * structures of arrays and advanced by branch-free loops over the
+ * arrays, which the compiler vectorizes, split among the threads of the
+ * P1906TaskPool.
+ *
+ * A bacterium runs straight at RunSpeed and tumbles into a uniformly
+ * random direction at the rate
+ *
+ *   TumbleRate exp (-Sensitivity Kd / (Kd + C) dlnC/dt)
+ *
+ * where dlnC/dt is the change of the attractant it senses along its run
+ * and Kd / (Kd + C) the occupancy of free receptors: runs up the
+ * gradient are longer. The attractant diffuses from the source in steady
+ * state, C (r) = Q / (4 pi D r). A bacterium stops when it comes within
+ * the capture radius of the source. Captured bacteria are removed from
+ * the arrays once they make up a quarter of them, so that the steps
+ * update the swimming ones.
+ *
+ * The random numbers of a bacterium for a step are one Philox block
+ * (see P1906MOL_MOTOR_Rng) of the counter (step, bacterium, stream), so
+ * the population does not depend on the number of threads nor on when
+ * the arrays are compacted.
+ */
+
+class P1906BacteriaPopulation
+{
+public:
+  struct Parameters
+  {
+    Vector source;              //!< the position of the attractant source [m]
+    double captureRadius;       //!< [m]
+    double runSpeed;            //!< [m/s]
+    double tumbleRate;          //!< the tumble rate without attractant [1/s]
+    double sensitivity;         //!< the gain of the chemotactic response [s]
+    double attractantRate;      //!< Q [mol/s]
+    double attractantDiffusion; //!< D [m^2/s]
+    double dissociation;        //!< Kd of the receptors [mol/m^3]
+    double timeStep;            //!< [s]
+  };
+
+  P1906BacteriaPopulation ();
+
+  /**
+   * Release n bacteria uniformly in a sphere, swimming in random directions
+   *
+   * \param stream two numbers identifying the random numbers of the population
+   */
+  void Release (uint32_t n, Vector origin, double radius, uint32_t stream0, uint32_t stream1);
+
+  /**
+   * Advance the swimming bacteria by one time step
+   *
+   * \return the number of bacteria captured by the source during the step
+   */
+  uint32_t Step (const Parameters &p);
+
+  /**
+   * \return the number of bacteria released
+   */
+  uint32_t GetSize (void) const;
+  uint32_t GetSwimming (void) const;
+  uint32_t GetSteps (void) const;
+  /**
+   * \return the number of bacteria held in the arrays: the swimming ones and those
+   * captured since the last compaction
+   */
+  uint32_t GetHeld (void) const;
+  /**
+   * \param i a bacterium held in the arrays, i < GetHeld ()
+   */
+  Vector GetPosition (uint32_t i) const;
+
+  /**
+   * The number of bacteria updated by a task of the P1906TaskPool
+   */
+  void SetGrain (uint32_t grain);
+
+private:
+  void Draw (uint32_t step, size_t i, double u[4]) const;
+  //! remove the captured bacteria from the arrays
+  void Compact (void);
+
+  // one array per coordinate, so that each step reads and writes them with unit stride
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_z;
+  std::vector<double> m_ux;
+  std::vector<double> m_uy;
+  std::vector<double> m_uz;
+  std::vector<double> m_swimming;   //!< 1 while swimming, 0 once captured
+  std::vector<uint32_t> m_id;       //!< the bacterium, which numbers its random numbers
+
+  uint32_t m_key[2];
+  uint32_t m_stream[2];
+  uint32_t m_steps;
+  uint32_t m_released;
+  uint32_t m_nSwimming;
+  uint32_t m_grain;
+};
+
+}
+
+#endif /* P1906_BACTERIA_POPULATION */
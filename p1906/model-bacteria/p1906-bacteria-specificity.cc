@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+
+#include "p1906-bacteria-specificity.h"
+#include "ns3/p1906-specificity.h"
+#include "p1906-bacteria-message-carrier.h"
+#include <cmath>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906BacteriaSpecificity");
+
+TypeId P1906BacteriaSpecificity::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906BacteriaSpecificity")
+    .SetParent<P1906Specificity> ();
+  return tid;
+}
+
+P1906BacteriaSpecificity::P1906BacteriaSpecificity ()
+{
+  NS_LOG_FUNCTION (this << "BACTERIA Specificity Component");
+  m_conjugationRate = 0.01;         // [1/s]
+  m_contactTime = Seconds (60);
+  m_threshold = 1.;
+}
+
+P1906BacteriaSpecificity::~P1906BacteriaSpecificity ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+P1906BacteriaSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906BacteriaMessageCarrier> m = message->GetObject <P1906BacteriaMessageCarrier>();
+
+  double transconjugants = m->GetBacteria () * GetConjugationProbability ();
+  SetDecisionMargin (transconjugants - m_threshold);
+
+  NS_LOG_FUNCTION (this << "[captured,transconjugants,threshold]" << m->GetBacteria ()
+                   << transconjugants << m_threshold);
+
+  if (transconjugants >= m_threshold)
+    {
+      NS_LOG_FUNCTION (this << "plasmid transferred to the receiver");
+      return true;
+    }
+  else
+    {
+      NS_LOG_FUNCTION (this << "too few transconjugants --> transmission failed");
+      return false;
+    }
+}
+
+double
+P1906BacteriaSpecificity::GetConjugationProbability (void)
+{
+  NS_LOG_FUNCTION (this);
+  return 1. - std::exp (-m_conjugationRate * m_contactTime.GetSeconds ());
+}
+
+void
+P1906BacteriaSpecificity::SetConjugationRate (double rate)
+{
+  NS_LOG_FUNCTION (this << rate);
+  m_conjugationRate = rate;
+}
+
+double
+P1906BacteriaSpecificity::GetConjugationRate (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_conjugationRate;
+}
+
+void
+P1906BacteriaSpecificity::SetContactTime (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_contactTime = t;
+}
+
+Time
+P1906BacteriaSpecificity::GetContactTime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_contactTime;
+}
+
+void
+P1906BacteriaSpecificity::SetThreshold (double transconjugants)
+{
+  NS_LOG_FUNCTION (this << transconjugants);
+  m_threshold = transconjugants;
+}
+
+double
+P1906BacteriaSpecificity::GetThreshold (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_threshold;
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_BACTERIA_SPECIFICITY
+#define P1906_BACTERIA_SPECIFICITY
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-specificity.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906BacteriaSpecificity
+ *
+ * \brief Class implementing the Specificity component of the P1906
+ * framework for the BACTERIA Example: the captured bacteria transfer
+ * their plasmid by conjugation to the resident bacteria of the
+ * receiver, each one with probability 1 - exp (-ConjugationRate
+ * ContactTime). The message is received when the expected number of
+ * transconjugants reaches the threshold; the decision margin is their
+ * number minus the threshold.
+ *
+ * The transconjugants carry the message further when the device of the
+ * receiver has a P1906Relay: the relay hands it back to the
+ * Perturbation, which releases the resident population towards the
+ * next nodes, i.e., conjugation-based multi-hop relaying.
+ */
+
+class P1906BacteriaSpecificity : public P1906Specificity
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906BacteriaSpecificity ();
+  virtual ~P1906BacteriaSpecificity ();
+
+  virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message);
+
+  /**
+   * \param rate the rate of conjugation of a donor in contact with the resident bacteria [1/s]
+   */
+  void SetConjugationRate (double rate);
+  double GetConjugationRate (void);
+
+  void SetContactTime (Time t);
+  Time GetContactTime (void);
+
+  void SetThreshold (double transconjugants);
+  double GetThreshold (void);
+
+  /**
+   * \return the probability that a captured bacterium transfers its plasmid
+   */
+  double GetConjugationProbability (void);
+
+private:
+  double m_conjugationRate;
+  Time m_contactTime;
+  double m_threshold;
+};
+
+}
+
+#endif /* P1906_BACTERIA_SPECIFICITY */
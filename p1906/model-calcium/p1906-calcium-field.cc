@@ -0,0 +1,273 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+
+#include "p1906-calcium-field.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-net-device.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906CalciumField");
+
+TypeId P1906CalciumField::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906CalciumField")
+    .SetParent<P1906Field> ();
+  return tid;
+}
+
+P1906CalciumField::P1906CalciumField ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << "Created CALCIUM Field Component");
+  m_version = 0;
+  Clear (0);
+}
+
+P1906CalciumField::~P1906CalciumField ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906CalciumField::Clear (uint32_t nCells)
+{
+  m_rowOffsets.assign (nCells + 1, 0);
+  m_columns.clear ();
+  m_couplings.clear ();
+  m_maxCoupling = 0.;
+  m_nx = 0;
+  m_ny = 0;
+  m_nz = 0;
+  m_spacing = 0.;
+}
+
+void
+P1906CalciumField::Finish (void)
+{
+  m_maxCoupling = 0.;
+  for (uint32_t i = 0; i + 1 < m_rowOffsets.size (); i++)
+    {
+      double total = 0.;
+      for (uint32_t k = m_rowOffsets[i]; k < m_rowOffsets[i + 1]; k++)
+        {
+          total += m_couplings[k];
+        }
+      m_maxCoupling = std::max (m_maxCoupling, total);
+    }
+  m_version++;
+}
+
+void
+P1906CalciumField::BuildLattice (uint32_t nx, uint32_t ny, uint32_t nz, double spacing, double coupling)
+{
+  NS_LOG_FUNCTION (this << nx << ny << nz << spacing << coupling);
+  uint64_t nCells = uint64_t (nx) * ny * nz;
+  NS_ASSERT_MSG (nCells > 0 && nCells * 6 < NO_CELL, "the lattice is empty or too large");
+  Clear (nCells);
+  m_columns.reserve (nCells * 6);
+  m_couplings.reserve (nCells * 6);
+
+  // the neighbours are visited in increasing index order, so that rows are sorted
+  uint32_t plane = nx * ny;
+  uint32_t i = 0;
+  for (uint32_t z = 0; z < nz; z++)
+    {
+      for (uint32_t y = 0; y < ny; y++)
+        {
+          for (uint32_t x = 0; x < nx; x++, i++)
+            {
+              if (z > 0)
+                {
+                  m_columns.push_back (i - plane);
+                }
+              if (y > 0)
+                {
+                  m_columns.push_back (i - nx);
+                }
+              if (x > 0)
+                {
+                  m_columns.push_back (i - 1);
+                }
+              if (x + 1 < nx)
+                {
+                  m_columns.push_back (i + 1);
+                }
+              if (y + 1 < ny)
+                {
+                  m_columns.push_back (i + nx);
+                }
+              if (z + 1 < nz)
+                {
+                  m_columns.push_back (i + plane);
+                }
+              m_rowOffsets[i + 1] = m_columns.size ();
+            }
+        }
+    }
+  m_couplings.assign (m_columns.size (), coupling);
+
+  m_nx = nx;
+  m_ny = ny;
+  m_nz = nz;
+  m_spacing = spacing;
+  Finish ();
+}
+
+void
+P1906CalciumField::BuildGraph (uint32_t nCells, const std::vector<Junction> &junctions)
+{
+  NS_LOG_FUNCTION (this << nCells << junctions.size ());
+  NS_ASSERT_MSG (uint64_t (junctions.size ()) * 2 < NO_CELL, "too many junctions");
+  Clear (nCells);
+
+  for (uint32_t k = 0; k < junctions.size (); k++)
+    {
+      const Junction &j = junctions[k];
+      NS_ASSERT_MSG (j.a < nCells && j.b < nCells, "junction between missing cells");
+      if (j.a != j.b)
+        {
+          m_rowOffsets[j.a + 1]++;
+          m_rowOffsets[j.b + 1]++;
+        }
+    }
+  for (uint32_t i = 0; i < nCells; i++)
+    {
+      m_rowOffsets[i + 1] += m_rowOffsets[i];
+    }
+
+  std::vector<std::pair<uint32_t, double> > entries (m_rowOffsets[nCells]);
+  std::vector<uint32_t> next (m_rowOffsets.begin (), m_rowOffsets.end () - 1);
+  for (uint32_t k = 0; k < junctions.size (); k++)
+    {
+      const Junction &j = junctions[k];
+      if (j.a != j.b)
+        {
+          entries[next[j.a]++] = std::make_pair (j.b, j.coupling);
+          entries[next[j.b]++] = std::make_pair (j.a, j.coupling);
+        }
+    }
+  for (uint32_t i = 0; i < nCells; i++)
+    {
+      std::sort (entries.begin () + m_rowOffsets[i], entries.begin () + m_rowOffsets[i + 1]);
+    }
+
+  m_columns.resize (entries.size ());
+  m_couplings.resize (entries.size ());
+  for (uint32_t k = 0; k < entries.size (); k++)
+    {
+      m_columns[k] = entries[k].first;
+      m_couplings[k] = entries[k].second;
+    }
+  Finish ();
+}
+
+void
+P1906CalciumField::AttachNode (uint32_t node, uint32_t cell)
+{
+  NS_LOG_FUNCTION (this << node << cell);
+  m_nodeCells[node] = cell;
+}
+
+uint32_t
+P1906CalciumField::GetCell (Ptr<P1906CommunicationInterface> c) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<Node> node = c->GetP1906NetDevice ()->GetNode ();
+  std::map<uint32_t, uint32_t>::const_iterator it = m_nodeCells.find (node->GetId ());
+  if (it != m_nodeCells.end ())
+    {
+      return it->second < GetCellCount () ? it->second : NO_CELL;
+    }
+
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel> ();
+  if (m_spacing <= 0. || !mobility)
+    {
+      return NO_CELL;
+    }
+  Vector p = mobility->GetPosition ();
+  double x = std::floor (p.x / m_spacing + 0.5);
+  double y = std::floor (p.y / m_spacing + 0.5);
+  double z = std::floor (p.z / m_spacing + 0.5);
+  x = std::min (std::max (x, 0.), m_nx - 1.);
+  y = std::min (std::max (y, 0.), m_ny - 1.);
+  z = std::min (std::max (z, 0.), m_nz - 1.);
+  return uint32_t (x) + m_nx * (uint32_t (y) + m_ny * uint32_t (z));
+}
+
+uint32_t
+P1906CalciumField::GetCellCount (void) const
+{
+  return m_rowOffsets.size () - 1;
+}
+
+uint32_t
+P1906CalciumField::GetJunctionCount (void) const
+{
+  return m_columns.size () / 2;
+}
+
+const std::vector<uint32_t> &
+P1906CalciumField::GetRowOffsets (void) const
+{
+  return m_rowOffsets;
+}
+
+const std::vector<uint32_t> &
+P1906CalciumField::GetColumns (void) const
+{
+  return m_columns;
+}
+
+const std::vector<double> &
+P1906CalciumField::GetCouplings (void) const
+{
+  return m_couplings;
+}
+
+double
+P1906CalciumField::GetMaxCoupling (void) const
+{
+  return m_maxCoupling;
+}
+
+uint32_t
+P1906CalciumField::GetVersion (void) const
+{
+  return m_version;
+}
+
+} // namespace ns3
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_CALCIUM_FIELD
+#define P1906_CALCIUM_FIELD
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-field.h"
+#include <stdint.h>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+class P1906CommunicationInterface;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906CalciumField
+ *
+ * \brief Class implementing the Field component of the P1906
+ * framework for the CALCIUM signalling Example: the tissue of cells
+ * connected by gap junctions, through which calcium flows from a cell
+ * to its neighbours. The tissue is a sparse graph stored in compressed
+ * sparse row (CSR) form: the junctions of cell i are
+ * GetColumns ()[GetRowOffsets ()[i] .. GetRowOffsets ()[i + 1]), each
+ * with the coupling of GetCouplings () [1/s], i.e., the fraction of the
+ * concentration difference exchanged per second.
+ *
+ * A single Field is shared by all the devices of a tissue. Nodes are
+ * placed in cells with AttachNode; the nodes of a lattice that have not
+ * been attached are placed in the cell nearest to their position.
+ */
+
+class P1906CalciumField : public P1906Field
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906CalciumField ();
+  virtual ~P1906CalciumField ();
+
+  struct Junction
+  {
+    uint32_t a;
+    uint32_t b;
+    double coupling;    //!< [1/s], the same in both directions
+  };
+
+  /**
+   * Build a lattice of nx * ny * nz cells, each one connected to its
+   * (up to) 6 face neighbours; cell x + nx * (y + ny * z) is centred in
+   * (x, y, z) * spacing
+   *
+   * \param spacing the distance between neighbouring cells [m]
+   * \param coupling the coupling of every gap junction [1/s]
+   */
+  void BuildLattice (uint32_t nx, uint32_t ny, uint32_t nz, double spacing, double coupling);
+  /**
+   * Build an arbitrary tissue of nCells cells
+   */
+  void BuildGraph (uint32_t nCells, const std::vector<Junction> &junctions);
+
+  void AttachNode (uint32_t node, uint32_t cell);
+  /**
+   * \return the cell of the node of a communication interface, or NO_CELL
+   */
+  uint32_t GetCell (Ptr<P1906CommunicationInterface> c) const;
+
+  uint32_t GetCellCount (void) const;
+  uint32_t GetJunctionCount (void) const;
+  const std::vector<uint32_t> &GetRowOffsets (void) const;
+  const std::vector<uint32_t> &GetColumns (void) const;
+  const std::vector<double> &GetCouplings (void) const;
+  /**
+   * \return the largest total coupling of a cell [1/s], which bounds the
+   * time step of an explicit integration of the tissue
+   */
+  double GetMaxCoupling (void) const;
+  /**
+   * \return a counter incremented whenever the tissue is rebuilt
+   */
+  uint32_t GetVersion (void) const;
+
+  static const uint32_t NO_CELL = 0xffffffff;
+
+private:
+  void Clear (uint32_t nCells);
+  void Finish (void);
+
+  std::vector<uint32_t> m_rowOffsets;
+  std::vector<uint32_t> m_columns;
+  std::vector<double> m_couplings;
+  double m_maxCoupling;
+  uint32_t m_version;
+
+  uint32_t m_nx;
+  uint32_t m_ny;
+  uint32_t m_nz;
+  double m_spacing;       //!< 0 if the tissue is not a lattice
+  std::map<uint32_t, uint32_t> m_nodeCells;
+};
+
+}
+
+#endif /* P1906_CALCIUM_FIELD */
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "p1906-calcium-message-carrier.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-memory-tracker.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906CalciumMessageCarrier");
+
+TypeId P1906CalciumMessageCarrier::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906CalciumMessageCarrier")
+    .SetParent<P1906MessageCarrier> ();
+  return tid;
+}
+
+P1906CalciumMessageCarrier::P1906CalciumMessageCarrier ()
+{
+  NS_LOG_FUNCTION (this);
+  SetMessage (0);
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906CalciumMessageCarrier));
+    }
+}
+
+P1906CalciumMessageCarrier::~P1906CalciumMessageCarrier ()
+{
+  NS_LOG_FUNCTION (this);
+  SetMessage (0);
+}
+
+void
+P1906CalciumMessageCarrier::SetDuration (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_duration = t;
+}
+
+Time
+P1906CalciumMessageCarrier::GetDuration (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_duration;
+}
+
+void
+P1906CalciumMessageCarrier::SetPulseInterval (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_pulseInterval = t;
+}
+
+Time
+P1906CalciumMessageCarrier::GetPulseInterval (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_pulseInterval;
+}
+
+void
+P1906CalciumMessageCarrier::SetStartTime (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_startTime = t;
+}
+
+Time
+P1906CalciumMessageCarrier::GetStartTime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_startTime;
+}
+
+void
+P1906CalciumMessageCarrier::SetCalcium (double c)
+{
+  NS_LOG_FUNCTION (this << c);
+  m_calcium = c;
+}
+
+double
+P1906CalciumMessageCarrier::GetCalcium (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_calcium;
+}
+
+P1906MessageCarrier::CaptureMetadata
+P1906CalciumMessageCarrier::GetCaptureMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  CaptureMetadata m;
+  m.model = CALCIUM_CARRIER;
+  m.start = m_startTime;
+  m.nValues = 1;
+  m.values[0] = m_calcium;
+  return m;
+}
+
+} // namespace ns3
@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+#include "p1906-calcium-motion.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-task-pool.h"
+#include "p1906-calcium-field.h"
+#include "p1906-calcium-message-carrier.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906CalciumMotion");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906CalciumMotion);
+
+TypeId P1906CalciumMotion::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906CalciumMotion")
+    .SetParent<P1906Motion> ()
+    .AddConstructor<P1906CalciumMotion> ()
+    .AddAttribute ("TimeStep",
+                   "The largest integration step; it is shortened when the tissue requires it",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&P1906CalciumMotion::m_timeStep),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxTime",
+                   "The longest integration of a pulse",
+                   TimeValue (Seconds (60)),
+                   MakeTimeAccessor (&P1906CalciumMotion::m_maxTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("DecayRate",
+                   "The rate at which calcium is pumped out of the cytosol [1/s]",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&P1906CalciumMotion::m_decayRate),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("MinResponse",
+                   "The integration stops when no cell holds more than this fraction of the pulse",
+                   DoubleValue (1e-6),
+                   MakeDoubleAccessor (&P1906CalciumMotion::m_minResponse),
+                   MakeDoubleChecker<double> (0.))
+    .AddAttribute ("CachedResponses",
+                   "The number of source cells whose response is kept",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&P1906CalciumMotion::m_cachedResponses),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Grain",
+                   "The number of cells updated by a task of the P1906TaskPool",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&P1906CalciumMotion::m_grain),
+                   MakeUintegerChecker<uint32_t> (1));
+  return tid;
+}
+
+P1906CalciumMotion::P1906CalciumMotion ()
+{
+  NS_LOG_FUNCTION (this);
+  m_integrations = 0;
+}
+
+P1906CalciumMotion::~P1906CalciumMotion ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+double
+P1906CalciumMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+		                                    Ptr<P1906CommunicationInterface> dst,
+		                                    Ptr<P1906MessageCarrier> message,
+		                                    Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this << "calcium wave");
+
+  Ptr<P1906CalciumField> tissue = field->GetObject<P1906CalciumField> ();
+  uint32_t srcCell = tissue->GetCell (src);
+  uint32_t dstCell = tissue->GetCell (dst);
+  if (srcCell == P1906CalciumField::NO_CELL || dstCell == P1906CalciumField::NO_CELL)
+    {
+      NS_LOG_FUNCTION (this << "node outside the tissue");
+      return 0.;
+    }
+
+  const Response &r = GetResponse (tissue, srcCell);
+  // a cell the pulse never reaches peaks at the end of the integration
+  uint32_t step = r.peak[dstCell] > 0. ? r.peakStep[dstCell] : r.steps;
+  double delay = step * r.timeStep;
+
+  NS_LOG_FUNCTION (this << "[srcCell,dstCell,delay]" << srcCell << dstCell << delay);
+  return delay;
+}
+
+
+Ptr<P1906MessageCarrier>
+P1906CalciumMotion::CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+		                                           Ptr<P1906CommunicationInterface> dst,
+		                                           Ptr<P1906MessageCarrier> message,
+		                                           Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<P1906CalciumMessageCarrier> m = message->GetObject<P1906CalciumMessageCarrier> ();
+  Ptr<P1906CalciumField> tissue = field->GetObject<P1906CalciumField> ();
+  uint32_t srcCell = tissue->GetCell (src);
+  uint32_t dstCell = tissue->GetCell (dst);
+
+  double peak = 0.;
+  if (srcCell != P1906CalciumField::NO_CELL && dstCell != P1906CalciumField::NO_CELL)
+    {
+      peak = GetResponse (tissue, srcCell).peak[dstCell];
+    }
+
+  // each receiver sees its own concentration, the transmitted carrier is left untouched
+  Ptr<P1906CalciumMessageCarrier> received = CreateObject<P1906CalciumMessageCarrier> ();
+  received->SetMessage (m->GetMessage ());
+  received->SetDuration (m->GetDuration ());
+  received->SetPulseInterval (m->GetPulseInterval ());
+  received->SetStartTime (m->GetStartTime ());
+  received->SetCalcium (m->GetCalcium () * peak);
+
+  NS_LOG_FUNCTION (this << "[released,received]" << m->GetCalcium () << received->GetCalcium ());
+  return received;
+}
+
+const P1906CalciumMotion::Response &
+P1906CalciumMotion::GetResponse (Ptr<P1906CalciumField> field, uint32_t source)
+{
+  NS_LOG_FUNCTION (this << source);
+  std::deque<Response>::iterator it;
+  for (it = m_responses.begin (); it != m_responses.end (); it++)
+    {
+      if (it->field == field && it->version == field->GetVersion () && it->source == source)
+        {
+          return *it;
+        }
+    }
+
+  while (m_responses.size () >= m_cachedResponses)
+    {
+      m_responses.pop_front ();
+    }
+  m_responses.push_back (Response ());
+  Response &r = m_responses.back ();
+  r.field = field;
+  r.version = field->GetVersion ();
+  r.source = source;
+  Integrate (r);
+  return r;
+}
+
+void
+P1906CalciumMotion::Integrate (Response &r)
+{
+  NS_LOG_FUNCTION (this << r.source);
+  const P1906CalciumField &tissue = *r.field;
+  uint32_t n = tissue.GetCellCount ();
+  const uint32_t *offsets = &tissue.GetRowOffsets ()[0];
+  const uint32_t *columns = tissue.GetColumns ().empty () ? 0 : &tissue.GetColumns ()[0];
+  const double *couplings = tissue.GetCouplings ().empty () ? 0 : &tissue.GetCouplings ()[0];
+
+  // explicit steps keep the concentrations positive only below 1 / (coupling + decay)
+  double decay = m_decayRate;
+  r.timeStep = m_timeStep.GetSeconds ();
+  if (tissue.GetMaxCoupling () + decay > 0.)
+    {
+      r.timeStep = std::min (r.timeStep, 1. / (tissue.GetMaxCoupling () + decay));
+    }
+  double dt = r.timeStep;
+  uint32_t maxSteps = std::ceil (m_maxTime.GetSeconds () / dt);
+
+  std::vector<double> c (n, 0.);
+  std::vector<double> next (n, 0.);
+  r.peak.assign (n, 0.);
+  r.peakStep.assign (n, 0);
+  c[r.source] = 1.;
+  r.peak[r.source] = 1.;
+
+  double minResponse = m_minResponse;
+  uint32_t step = 0;
+  while (step < maxSteps)
+    {
+      step++;
+      const double *cur = &c[0];
+      double *nxt = &next[0];
+      double *peak = &r.peak[0];
+      uint32_t *peakStep = &r.peakStep[0];
+      uint32_t s = step;
+
+      // one sparse matrix-vector product, fused with the update of the peaks
+      double largest = P1906TaskPool::ParallelReduce (0, n, m_grain, 0.,
+        [=] (size_t b, size_t e)
+        {
+          double m = 0.;
+          for (size_t i = b; i < e; i++)
+            {
+              double ci = cur[i];
+              double flux = 0.;
+              for (uint32_t k = offsets[i]; k < offsets[i + 1]; k++)
+                {
+                  flux += couplings[k] * (cur[columns[k]] - ci);
+                }
+              double v = ci + dt * (flux - decay * ci);
+              nxt[i] = v;
+              if (v > peak[i])
+                {
+                  peak[i] = v;
+                  peakStep[i] = s;
+                }
+              m = std::max (m, v);
+            }
+          return m;
+        },
+        [] (double a, double b)
+        {
+          return std::max (a, b);
+        });
+
+      c.swap (next);
+      if (largest < minResponse)
+        {
+          break;
+        }
+    }
+  r.steps = step;
+  m_integrations++;
+
+  NS_LOG_FUNCTION (this << "[cells,junctions,timeStep,steps]" << n << tissue.GetJunctionCount ()
+                   << dt << step);
+}
+
+uint64_t
+P1906CalciumMotion::GetIntegrations (void) const
+{
+  return m_integrations;
+}
+
+
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_CALCIUM_MOTION
+#define P1906_CALCIUM_MOTION
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-motion.h"
+#include <stdint.h>
+#include <vector>
+#include <deque>
+
+namespace ns3 {
+
+class P1906CalciumField;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906CalciumMotion
+ *
+ * \brief Class implementing the Motion component of the P1906
+ * framework for the CALCIUM signalling Example. A calcium pulse
+ * released in a cell spreads through the gap junctions of the tissue
+ * (see P1906CalciumField) and is pumped out of the cytosol:
+ *
+ *   dc_i/dt = sum_j k_ij (c_j - c_i) - DecayRate c_i
+ *
+ * The system is integrated with explicit steps, each one a sparse
+ * matrix-vector product over the whole tissue, split among the threads
+ * of the P1906TaskPool. Being linear, the system is solved once per
+ * source cell for a unit pulse; the received calcium is the peak of
+ * that response scaled by the released calcium, and the propagation
+ * delay is the time of the peak. The last CachedResponses responses
+ * are kept, so the receivers of a carrier share a single integration.
+ */
+
+class P1906CalciumMotion : public P1906Motion
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906CalciumMotion ();
+  virtual ~P1906CalciumMotion ();
+
+  virtual double ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+  		                                  Ptr<P1906CommunicationInterface> dst,
+  		                                  Ptr<P1906MessageCarrier> message,
+  		                                  Ptr<P1906Field> field);
+
+  virtual Ptr<P1906MessageCarrier> CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+  		                                                           Ptr<P1906CommunicationInterface> dst,
+  		                                                           Ptr<P1906MessageCarrier> message,
+  		                                                           Ptr<P1906Field> field);
+
+  /**
+   * The response of the tissue to a unit pulse released in a cell
+   */
+  struct Response
+  {
+    Ptr<P1906CalciumField> field;
+    uint32_t version;
+    uint32_t source;
+    double timeStep;                    //!< [s]
+    uint32_t steps;                     //!< the integration steps
+    std::vector<double> peak;           //!< the peak concentration of each cell, per unit of released calcium
+    std::vector<uint32_t> peakStep;     //!< the step of the peak of each cell
+  };
+
+  /**
+   * \return the response of the tissue to a unit pulse released in a cell,
+   * integrated now if not cached
+   */
+  const Response &GetResponse (Ptr<P1906CalciumField> field, uint32_t source);
+
+  /**
+   * \return the number of integrations run so far
+   */
+  uint64_t GetIntegrations (void) const;
+
+private:
+  void Integrate (Response &r);
+
+  Time m_timeStep;
+  Time m_maxTime;
+  double m_decayRate;
+  double m_minResponse;
+  uint32_t m_cachedResponses;
+  uint32_t m_grain;
+
+  std::deque<Response> m_responses;
+  uint64_t m_integrations;
+};
+
+}
+
+#endif /* P1906_CALCIUM_MOTION */
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "p1906-calcium-perturbation.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-perturbation.h"
+#include "p1906-calcium-message-carrier.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906CalciumPerturbation");
+
+TypeId P1906CalciumPerturbation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906CalciumPerturbation")
+    .SetParent<P1906Perturbation> ();
+  return tid;
+}
+
+P1906CalciumPerturbation::P1906CalciumPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+  m_pulseInterval = Seconds (10);
+  m_calcium = 1.;               // [uM], about ten times the resting concentration
+  m_releaseEnergy = 1e-15;      // [J/pulse], the IP3 and the pumps restoring the stores
+}
+
+P1906CalciumPerturbation::~P1906CalciumPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906CalciumPerturbation::SetPulseInterval (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_pulseInterval = t;
+}
+
+Time
+P1906CalciumPerturbation::GetPulseInterval (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_pulseInterval;
+}
+
+void
+P1906CalciumPerturbation::SetCalcium (double c)
+{
+  NS_LOG_FUNCTION (this << c);
+  m_calcium = c;
+}
+
+double
+P1906CalciumPerturbation::GetCalcium (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_calcium;
+}
+
+void
+P1906CalciumPerturbation::SetReleaseEnergy (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_releaseEnergy = e;
+}
+
+double
+P1906CalciumPerturbation::GetReleaseEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_releaseEnergy;
+}
+
+Ptr<P1906MessageCarrier>
+P1906CalciumPerturbation::CreateMessageCarrier (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906CalciumMessageCarrier> carrier = CreateObject<P1906CalciumMessageCarrier> ();
+
+  double duration = m_pulseInterval.GetSeconds () * p->GetSize () * 8;
+
+  NS_LOG_FUNCTION (this << "[t,bits,pulseI,duration,calcium]" << Simulator::Now ().GetSeconds ()
+		  << p->GetSize() * 8 << m_pulseInterval << duration << m_calcium);
+
+  carrier->SetPulseInterval (m_pulseInterval);
+  carrier->SetDuration (Seconds (duration));
+  carrier->SetStartTime (Simulator::Now ());
+  carrier->SetCalcium (m_calcium);
+  carrier->SetMessage (p);
+
+  return carrier;
+}
+
+double
+P1906CalciumPerturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  // one release for each transmitted bit
+  return m_releaseEnergy * p->GetSize () * 8;
+}
+
+Time
+P1906CalciumPerturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  return Seconds (m_pulseInterval.GetSeconds () * p->GetSize () * 8);
+}
+
+} // namespace ns3
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+
+#include "p1906-calcium-specificity.h"
+#include "ns3/p1906-specificity.h"
+#include "p1906-calcium-message-carrier.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906CalciumSpecificity");
+
+TypeId P1906CalciumSpecificity::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906CalciumSpecificity")
+    .SetParent<P1906Specificity> ();
+  return tid;
+}
+
+P1906CalciumSpecificity::P1906CalciumSpecificity ()
+{
+  NS_LOG_FUNCTION (this << "CALCIUM Specificity Component");
+  m_threshold = 0.1;                    // [uM]
+  m_refractoryPeriod = Seconds (5);
+}
+
+P1906CalciumSpecificity::~P1906CalciumSpecificity ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+P1906CalciumSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906CalciumMessageCarrier> m = message->GetObject <P1906CalciumMessageCarrier>();
+
+  double calcium = m->GetCalcium ();
+  SetDecisionMargin (calcium - m_threshold);
+
+  NS_LOG_FUNCTION (this << "[calcium,threshold,pulseI,refractory]" << calcium << m_threshold
+                   << m->GetPulseInterval () << m_refractoryPeriod);
+
+  if (m->GetPulseInterval () < m_refractoryPeriod)
+    {
+      NS_LOG_FUNCTION (this << "pulses faster than the refractory period --> transmission failed");
+      return false;
+    }
+  if (calcium >= m_threshold)
+    {
+      NS_LOG_FUNCTION (this << "calcium above the threshold");
+      return true;
+    }
+  else
+    {
+      NS_LOG_FUNCTION (this << "calcium below the threshold --> transmission failed");
+      return false;
+    }
+}
+
+void
+P1906CalciumSpecificity::SetThreshold (double c)
+{
+  NS_LOG_FUNCTION (this << c);
+  m_threshold = c;
+}
+
+double
+P1906CalciumSpecificity::GetThreshold (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_threshold;
+}
+
+void
+P1906CalciumSpecificity::SetRefractoryPeriod (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_refractoryPeriod = t;
+}
+
+Time
+P1906CalciumSpecificity::GetRefractoryPeriod (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_refractoryPeriod;
+}
+
+} // namespace ns3
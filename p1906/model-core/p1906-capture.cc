@@ -0,0 +1,405 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "p1906-capture.h"
+#include "p1906-communication-interface.h"
+#include "p1906-net-device.h"
+#include "p1906-message-carrier.h"
+#include "p1906-specificity.h"
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906Capture");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906Capture);
+
+bool P1906Capture::m_enabled = false;
+
+static const char g_captureMagic[8] = { 'P', '1', '9', '0', '6', 'C', 'A', 'P' };
+static const uint32_t NO_CAPTURE_NODE = 0xffffffff;
+
+TypeId P1906Capture::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906Capture")
+    .SetParent<Object> ()
+    .AddConstructor<P1906Capture> ()
+    .AddAttribute ("BufferSize",
+                   "The size of the buffers handed to the writer thread [bytes]",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&P1906Capture::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> (1024))
+    .AddAttribute ("MaxPendingBuffers",
+                   "The number of full buffers queued before the simulation waits for the writer",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&P1906Capture::m_maxPendingBuffers),
+                   MakeUintegerChecker<uint32_t> (1));
+  return tid;
+}
+
+P1906Capture::P1906Capture ()
+  : m_bufferSize (1 << 20),
+    m_maxPendingBuffers (8),
+    m_records (0),
+    m_bytes (0),
+    m_scheduled (false),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906Capture::~P1906Capture ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+Ptr<P1906Capture>
+P1906Capture::GetCapture (void)
+{
+  static Ptr<P1906Capture> capture = CreateObject<P1906Capture> ();
+  return capture;
+}
+
+void
+P1906Capture::CloseCapture (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Ptr<P1906Capture> capture = GetCapture ();
+  capture->Close ();
+  capture->m_scheduled = false;
+}
+
+bool
+P1906Capture::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file)
+    {
+      NS_LOG_FUNCTION (this << "cannot create the capture" << filename);
+      return false;
+    }
+
+  uint16_t version = VERSION;
+  uint16_t reserved16 = 0;
+  uint32_t reserved32 = 0;
+  uint64_t stepsPerSecond = Seconds (1).GetTimeStep ();
+  m_file.write (g_captureMagic, sizeof (g_captureMagic));
+  m_file.write ((const char *) &version, sizeof (version));
+  m_file.write ((const char *) &reserved16, sizeof (reserved16));
+  m_file.write ((const char *) &reserved32, sizeof (reserved32));
+  m_file.write ((const char *) &stepsPerSecond, sizeof (stepsPerSecond));
+
+  m_records = 0;
+  m_bytes = HEADER_SIZE;
+  m_buffer.clear ();
+  m_buffer.reserve (m_bufferSize);
+  m_stop = false;
+  m_writer = std::thread (&P1906Capture::WriterLoop, this);
+
+  if (!m_scheduled)
+    {
+      m_scheduled = true;
+      Simulator::ScheduleDestroy (&P1906Capture::CloseCapture);
+    }
+  m_enabled = true;
+  return true;
+}
+
+void
+P1906Capture::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_writer.joinable ())
+    {
+      return;
+    }
+  m_enabled = false;
+  Submit ();
+  {
+    std::unique_lock<std::mutex> lock (m_lock);
+    m_stop = true;
+  }
+  m_jobAvailable.notify_one ();
+  m_writer.join ();
+  m_file.close ();
+}
+
+void
+P1906Capture::NotifyTransmission (Ptr<P1906CommunicationInterface> src,
+                                  Ptr<Packet> p,
+                                  Ptr<P1906MessageCarrier> carrier)
+{
+  uint32_t node = NO_CAPTURE_NODE;
+  if (src->GetP1906NetDevice () && src->GetP1906NetDevice ()->GetNode ())
+    {
+      node = src->GetP1906NetDevice ()->GetNode ()->GetId ();
+    }
+  AddRecord (TX_RECORD, node, NO_CAPTURE_NODE, p, carrier,
+             std::numeric_limits<double>::quiet_NaN ());
+}
+
+void
+P1906Capture::NotifyReception (Ptr<P1906CommunicationInterface> src,
+                               Ptr<P1906CommunicationInterface> dst,
+                               Ptr<P1906MessageCarrier> carrier,
+                               Ptr<P1906Specificity> specificity,
+                               bool accepted)
+{
+  uint32_t node = NO_CAPTURE_NODE;
+  uint32_t peer = NO_CAPTURE_NODE;
+  if (dst->GetP1906NetDevice () && dst->GetP1906NetDevice ()->GetNode ())
+    {
+      node = dst->GetP1906NetDevice ()->GetNode ()->GetId ();
+    }
+  if (src->GetP1906NetDevice () && src->GetP1906NetDevice ()->GetNode ())
+    {
+      peer = src->GetP1906NetDevice ()->GetNode ()->GetId ();
+    }
+  double margin = std::numeric_limits<double>::quiet_NaN ();
+  if (specificity->HasDecisionMargin ())
+    {
+      margin = specificity->GetDecisionMargin ();
+    }
+  AddRecord (accepted ? RX_RECORD : REJECT_RECORD, node, peer,
+             carrier->GetMessage (), carrier, margin);
+}
+
+void
+P1906Capture::AddRecord (RecordType type, uint32_t node, uint32_t peer, Ptr<Packet> p,
+                         Ptr<P1906MessageCarrier> carrier, double margin)
+{
+  P1906MessageCarrier::CaptureMetadata meta = carrier->GetCaptureMetadata ();
+  uint8_t nValues = meta.nValues;
+  if (nValues > P1906MessageCarrier::MAX_CAPTURE_VALUES)
+    {
+      nValues = P1906MessageCarrier::MAX_CAPTURE_VALUES;
+    }
+  // a transmission has no delay yet; a reception is timed from the start of its carrier
+  double delay = 0.;
+  if (type != TX_RECORD)
+    {
+      delay = (Simulator::Now () - meta.start).GetSeconds ();
+    }
+
+  uint16_t length = FIXED_PAYLOAD_SIZE + nValues * sizeof (double);
+  Put<uint8_t> (type);
+  Put<uint8_t> (meta.model);
+  Put<uint16_t> (length);
+  Put<uint64_t> (Simulator::Now ().GetTimeStep ());
+  Put<uint32_t> (node);
+  Put<uint32_t> (peer);
+  Put<uint64_t> (p ? p->GetUid () : 0);
+  Put<uint32_t> (p ? p->GetSize () : 0);
+  Put<double> (delay);
+  Put<double> (margin);
+  for (uint8_t i = 0; i < nValues; i++)
+    {
+      Put<double> (meta.values[i]);
+    }
+
+  m_records++;
+  m_bytes += FRAME_SIZE + length;
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Submit ();
+    }
+}
+
+void
+P1906Capture::Submit (void)
+{
+  if (m_buffer.empty ())
+    {
+      return;
+    }
+  {
+    std::unique_lock<std::mutex> lock (m_lock);
+    while (m_queue.size () >= m_maxPendingBuffers)
+      {
+        m_spaceAvailable.wait (lock);
+      }
+    m_queue.push_back (std::string ());
+    m_queue.back ().swap (m_buffer);
+  }
+  m_jobAvailable.notify_one ();
+  m_buffer.reserve (m_bufferSize);
+}
+
+void
+P1906Capture::WriterLoop (void)
+{
+  std::string buffer;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_lock);
+        while (m_queue.empty () && !m_stop)
+          {
+            m_jobAvailable.wait (lock);
+          }
+        if (m_queue.empty ())
+          {
+            return;
+          }
+        buffer.swap (m_queue.front ());
+        m_queue.pop_front ();
+      }
+      m_spaceAvailable.notify_one ();
+      m_file.write (buffer.data (), buffer.size ());
+      buffer.clear ();
+    }
+}
+
+uint64_t
+P1906Capture::GetRecords (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_records;
+}
+
+uint64_t
+P1906Capture::GetBytes (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bytes;
+}
+
+template <typename T>
+static T
+GetField (const char *&c)
+{
+  T v;
+  std::memcpy (&v, c, sizeof (T));
+  c += sizeof (T);
+  return v;
+}
+
+bool
+P1906Capture::ConvertToCsv (std::istream &is, std::ostream &os)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  char header[HEADER_SIZE];
+  is.read (header, HEADER_SIZE);
+  if (!is || std::memcmp (header, g_captureMagic, sizeof (g_captureMagic)) != 0)
+    {
+      return false;
+    }
+  const char *c = header + sizeof (g_captureMagic);
+  uint16_t version = GetField<uint16_t> (c);
+  if (version != VERSION)
+    {
+      return false;
+    }
+  GetField<uint16_t> (c);
+  GetField<uint32_t> (c);
+  double stepsPerSecond = GetField<uint64_t> (c);
+
+  static const char *types[] = { "", "tx", "rx", "reject" };
+  static const char *models[] = { "generic", "em", "mol", "motor", "calcium", "bacteria", "fret" };
+
+  os << "type,time,node,peer,uid,size,delay,margin,model,value0,value1,value2" << std::endl;
+  std::vector<char> payload;
+  char frame[FRAME_SIZE];
+  while (is.read (frame, FRAME_SIZE))
+    {
+      c = frame;
+      uint8_t type = GetField<uint8_t> (c);
+      uint8_t model = GetField<uint8_t> (c);
+      uint16_t length = GetField<uint16_t> (c);
+      if (type < TX_RECORD || type > REJECT_RECORD || length < FIXED_PAYLOAD_SIZE)
+        {
+          return false;
+        }
+      payload.resize (length);
+      if (!is.read (&payload[0], length))
+        {
+          return false;
+        }
+
+      c = &payload[0];
+      uint64_t time = GetField<uint64_t> (c);
+      uint32_t node = GetField<uint32_t> (c);
+      uint32_t peer = GetField<uint32_t> (c);
+      uint64_t uid = GetField<uint64_t> (c);
+      uint32_t size = GetField<uint32_t> (c);
+      double delay = GetField<double> (c);
+      double margin = GetField<double> (c);
+
+      os << types[type] << "," << time / stepsPerSecond << ",";
+      if (node != NO_CAPTURE_NODE)
+        {
+          os << node;
+        }
+      os << ",";
+      if (peer != NO_CAPTURE_NODE)
+        {
+          os << peer;
+        }
+      os << "," << uid << "," << size << "," << delay << ",";
+      if (margin == margin)
+        {
+          os << margin;
+        }
+      os << ",";
+      if (model <= P1906MessageCarrier::FRET_CARRIER)
+        {
+          os << models[model];
+        }
+      else
+        {
+          os << (uint32_t) model;
+        }
+      // records written by a newer version may carry more values than the columns
+      uint32_t nValues = (length - FIXED_PAYLOAD_SIZE) / sizeof (double);
+      for (uint32_t i = 0; i < P1906MessageCarrier::MAX_CAPTURE_VALUES; i++)
+        {
+          os << ",";
+          if (i < nValues)
+            {
+              os << GetField<double> (c);
+            }
+        }
+      os << std::endl;
+    }
+  return is.eof () && is.gcount () == 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_CAPTURE
+#define P1906_CAPTURE
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace ns3 {
+
+class Packet;
+class P1906CommunicationInterface;
+class P1906MessageCarrier;
+class P1906Specificity;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906Capture
+ *
+ * \brief This class records the message carriers transmitted and received
+ * by the P1906 communication interfaces into a binary capture file, with
+ * the physical parameters of each carrier (see
+ * P1906MessageCarrier::GetCaptureMetadata), the propagation delay and the
+ * decision margin of the receiver. Records are appended to a memory
+ * buffer; full buffers are written by a background thread, so the
+ * simulation waits on the file only when MaxPendingBuffers are queued.
+ * A disabled capture costs one branch per carrier.
+ *
+ * The file starts with a 24-byte header: the magic "P1906CAP", the format
+ * version (uint16), two reserved fields (uint16, uint32) and the time
+ * steps per second (uint64). Each record is framed by its type (uint8),
+ * the carrier model (uint8) and the length of the payload (uint16); the
+ * payload holds the time [time steps] (uint64), the node (uint32), the
+ * peer node (uint32, the sender of a received carrier), the packet uid
+ * (uint64), the packet size [bytes] (uint32), the delay [s] (double), the
+ * decision margin (double, NaN if none) and the carrier values (double),
+ * as many as the length allows. Numbers are in the byte order of the host.
+ *
+ * ConvertToCsv turns a capture into CSV (see examples/capture-to-csv.cc).
+ */
+
+class P1906Capture : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906Capture ();
+  virtual ~P1906Capture ();
+
+  /**
+   * \return the capture shared by all the communication interfaces of the simulation
+   */
+  static Ptr<P1906Capture> GetCapture (void);
+
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+
+  /**
+   * Start recording into a file; the capture is closed at Simulator::Destroy
+   *
+   * \return false if the file cannot be created
+   */
+  bool Open (std::string filename);
+  /**
+   * Write the pending records and close the file
+   */
+  void Close (void);
+
+  enum RecordType
+  {
+    TX_RECORD = 1,
+    RX_RECORD,        //!< a carrier accepted by the Specificity of the receiver
+    REJECT_RECORD     //!< a carrier rejected by the Specificity of the receiver
+  };
+
+  static const uint16_t VERSION = 1;
+  static const uint32_t HEADER_SIZE = 24;
+  static const uint32_t FRAME_SIZE = 4;
+  static const uint32_t FIXED_PAYLOAD_SIZE = 44;
+
+  void NotifyTransmission (Ptr<P1906CommunicationInterface> src,
+                           Ptr<Packet> p,
+                           Ptr<P1906MessageCarrier> carrier);
+  void NotifyReception (Ptr<P1906CommunicationInterface> src,
+                        Ptr<P1906CommunicationInterface> dst,
+                        Ptr<P1906MessageCarrier> carrier,
+                        Ptr<P1906Specificity> specificity,
+                        bool accepted);
+
+  uint64_t GetRecords (void) const;
+  uint64_t GetBytes (void) const;
+
+  /**
+   * Write a capture as CSV, one line per record
+   *
+   * \return false if the input is not a capture, or is truncated
+   */
+  static bool ConvertToCsv (std::istream &is, std::ostream &os);
+
+private:
+  void AddRecord (RecordType type, uint32_t node, uint32_t peer, Ptr<Packet> p,
+                  Ptr<P1906MessageCarrier> carrier, double margin);
+  template <typename T>
+  void Put (T v)
+  {
+    m_buffer.append ((const char *) &v, sizeof (T));
+  }
+  void Submit (void);
+  void WriterLoop (void);
+  static void CloseCapture (void);
+
+  static bool m_enabled;
+
+  uint32_t m_bufferSize;
+  uint32_t m_maxPendingBuffers;
+  uint64_t m_records;
+  uint64_t m_bytes;
+  bool m_scheduled;
+
+  std::ofstream m_file;
+  std::string m_buffer;
+  std::deque<std::string> m_queue;
+  bool m_stop;
+  std::mutex m_lock;
+  std::condition_variable m_jobAvailable;
+  std::condition_variable m_spaceAvailable;
+  std::thread m_writer;
+};
+
+}
+
+#endif /* P1906_CAPTURE */
@@ -121,7 +121,10 @@ P1906CommunicationInterface::HandleTransmission (Ptr<Packet> p)
 void P1906CommunicationInterface::HandleReception (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << "Receiving a packet [id,size]" << p->GetUid() << p->GetSize ());
-  //XXX: forward the message to upper layers
+  if (m_dev != 0)
+    {
+      m_dev->Receive (p);
+    }
 }
 
 void
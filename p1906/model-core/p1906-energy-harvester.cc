@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "p1906-energy-harvester.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906EnergyHarvester");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906EnergyHarvester);
+
+TypeId P1906EnergyHarvester::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906EnergyHarvester")
+    .SetParent<Object> ()
+    .AddConstructor<P1906EnergyHarvester> ()
+    .AddAttribute ("Power",
+                   "The harvested power [W]",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&P1906EnergyHarvester::m_power),
+                   MakeDoubleChecker<double> (0.0));
+  return tid;
+}
+
+P1906EnergyHarvester::P1906EnergyHarvester ()
+{
+  NS_LOG_FUNCTION (this);
+  m_power = 0.;
+}
+
+P1906EnergyHarvester::~P1906EnergyHarvester ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+double
+P1906EnergyHarvester::GetHarvestedEnergy (Time from, Time to)
+{
+  NS_LOG_FUNCTION (this << from << to);
+  return m_power * (to - from).GetSeconds ();
+}
+
+Time
+P1906EnergyHarvester::GetHarvestingTime (Time from, double joules)
+{
+  NS_LOG_FUNCTION (this << from << joules);
+  if (joules <= 0)
+    {
+      return Seconds (0);
+    }
+  if (m_power <= 0)
+    {
+      return Time::Max ();
+    }
+  return Seconds (joules / m_power);
+}
+
+void
+P1906EnergyHarvester::SetPower (double watts)
+{
+  NS_LOG_FUNCTION (this << watts);
+  m_power = watts;
+}
+
+double
+P1906EnergyHarvester::GetPower (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_power;
+}
+
+} // namespace ns3
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_ENERGY_HARVESTER
+#define P1906_ENERGY_HARVESTER
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906EnergyHarvester
+ *
+ * \brief Base class of the models charging a P1906EnergyStore. A model
+ * gives the energy harvested over any interval, and the time needed to
+ * harvest a given energy, in closed form, so that the store is updated
+ * only when it is used. This base class harvests a constant power.
+ */
+
+class P1906EnergyHarvester : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906EnergyHarvester ();
+  virtual ~P1906EnergyHarvester ();
+
+  /**
+   * \return the energy harvested from time from to time to [J]
+   */
+  virtual double GetHarvestedEnergy (Time from, Time to);
+  /**
+   * \return the time needed to harvest joules starting at time from,
+   * or Time::Max () if they are never harvested
+   */
+  virtual Time GetHarvestingTime (Time from, double joules);
+
+  void SetPower (double watts);
+  double GetPower (void);
+
+private:
+  double m_power;
+};
+
+}
+
+#endif /* P1906_ENERGY_HARVESTER */
@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/trace-source-accessor.h"
+#include "p1906-energy-ledger.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906EnergyLedger");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906EnergyLedger);
+
+TypeId P1906EnergyLedger::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906EnergyLedger")
+    .SetParent<Object> ()
+    .AddConstructor<P1906EnergyLedger> ()
+    .AddAttribute ("TrackMessages",
+                   "Keep an energy record for each message until its receptions end.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&P1906EnergyLedger::m_trackMessages),
+                   MakeBooleanChecker ())
+    .AddTraceSource ("MessageEnergy",
+                     "The energy and delivered bits of a message whose receptions ended.",
+                     MakeTraceSourceAccessor (&P1906EnergyLedger::m_messageTrace));
+  return tid;
+}
+
+P1906EnergyLedger::P1906EnergyLedger ()
+  : m_trackMessages (false)
+{
+  NS_LOG_FUNCTION (this);
+  Reset ();
+}
+
+P1906EnergyLedger::~P1906EnergyLedger ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ptr<P1906EnergyLedger>
+P1906EnergyLedger::GetLedger (void)
+{
+  static Ptr<P1906EnergyLedger> ledger = CreateObject<P1906EnergyLedger> ();
+  return ledger;
+}
+
+void
+P1906EnergyLedger::AddEnergy (uint32_t node, uint64_t message, EnergyComponent c, double joules)
+{
+  // called on the hot path of every component: plain counter increments only
+  m_componentEnergy[c] += joules;
+
+  if (node != NO_NODE)
+    {
+      if (node >= m_nodeEnergy.size ())
+        {
+          m_nodeEnergy.resize (node + 1, 0.);
+        }
+      m_nodeEnergy[node] += joules;
+    }
+
+  if (m_trackMessages)
+    {
+      m_messages[message].energy += joules;
+    }
+}
+
+void
+P1906EnergyLedger::NotifyDelivery (uint64_t message, uint32_t bits)
+{
+  m_deliveredBits += bits;
+  if (m_trackMessages)
+    {
+      std::map<uint64_t, MessageRecord>::iterator it = m_messages.find (message);
+      if (it != m_messages.end ())
+        {
+          it->second.deliveredBits += bits;
+        }
+    }
+}
+
+void
+P1906EnergyLedger::ExpectReceptions (uint64_t message, uint32_t receptions)
+{
+  if (!m_trackMessages)
+    {
+      return;
+    }
+  std::map<uint64_t, MessageRecord>::iterator it = m_messages.find (message);
+  if (it == m_messages.end ())
+    {
+      // no energy was reported for the message
+      return;
+    }
+  it->second.pendingReceptions += receptions;
+  if (it->second.pendingReceptions == 0)
+    {
+      CompleteMessage (it);
+    }
+}
+
+void
+P1906EnergyLedger::NotifyReceptionEnd (uint64_t message)
+{
+  if (!m_trackMessages)
+    {
+      return;
+    }
+  std::map<uint64_t, MessageRecord>::iterator it = m_messages.find (message);
+  if (it == m_messages.end () || it->second.pendingReceptions == 0)
+    {
+      return;
+    }
+  if (--it->second.pendingReceptions == 0)
+    {
+      CompleteMessage (it);
+    }
+}
+
+void
+P1906EnergyLedger::CompleteMessage (std::map<uint64_t, MessageRecord>::iterator it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  m_messageTrace (it->first, it->second.energy, it->second.deliveredBits);
+  m_messages.erase (it);
+}
+
+void
+P1906EnergyLedger::SetTrackMessages (bool track)
+{
+  NS_LOG_FUNCTION (this << track);
+  m_trackMessages = track;
+  if (!track)
+    {
+      m_messages.clear ();
+    }
+}
+
+bool
+P1906EnergyLedger::GetTrackMessages (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_trackMessages;
+}
+
+double
+P1906EnergyLedger::GetTotalEnergy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  double total = 0.;
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      total += m_componentEnergy[i];
+    }
+  return total;
+}
+
+double
+P1906EnergyLedger::GetComponentEnergy (EnergyComponent c) const
+{
+  NS_LOG_FUNCTION (this << c);
+  return m_componentEnergy[c];
+}
+
+double
+P1906EnergyLedger::GetNodeEnergy (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  if (node >= m_nodeEnergy.size ())
+    {
+      return 0.;
+    }
+  return m_nodeEnergy[node];
+}
+
+double
+P1906EnergyLedger::GetMessageEnergy (uint64_t message) const
+{
+  NS_LOG_FUNCTION (this << message);
+  std::map<uint64_t, MessageRecord>::const_iterator it = m_messages.find (message);
+  if (it == m_messages.end ())
+    {
+      return 0.;
+    }
+  return it->second.energy;
+}
+
+uint64_t
+P1906EnergyLedger::GetDeliveredBits (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_deliveredBits;
+}
+
+double
+P1906EnergyLedger::GetEnergyPerBit (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_deliveredBits == 0)
+    {
+      return 0.;
+    }
+  return GetTotalEnergy () / m_deliveredBits;
+}
+
+double
+P1906EnergyLedger::GetMessageEnergyPerBit (uint64_t message) const
+{
+  NS_LOG_FUNCTION (this << message);
+  std::map<uint64_t, MessageRecord>::const_iterator it = m_messages.find (message);
+  if (it == m_messages.end () || it->second.deliveredBits == 0)
+    {
+      return 0.;
+    }
+  return it->second.energy / it->second.deliveredBits;
+}
+
+void
+P1906EnergyLedger::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      m_componentEnergy[i] = 0.;
+    }
+  m_nodeEnergy.clear ();
+  m_messages.clear ();
+  m_deliveredBits = 0;
+}
+
+void
+P1906EnergyLedger::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  os << "[perturbation,motion,specificity,total] "
+     << m_componentEnergy[PERTURBATION] << " "
+     << m_componentEnergy[MOTION] << " "
+     << m_componentEnergy[SPECIFICITY] << " "
+     << GetTotalEnergy () << " J" << std::endl;
+  for (uint32_t i = 0; i < m_nodeEnergy.size (); i++)
+    {
+      os << "[node,energy] " << i << " " << m_nodeEnergy[i] << " J" << std::endl;
+    }
+  os << "[bits,energyPerBit] " << m_deliveredBits << " " << GetEnergyPerBit () << " J/bit" << std::endl;
+}
+
+void
+P1906EnergyLedger::SaveState (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t nNodes = m_nodeEnergy.size ();
+  uint64_t nMessages = m_messages.size ();
+  os.write ((const char *) m_componentEnergy, sizeof (m_componentEnergy));
+  os.write ((const char *) &m_deliveredBits, sizeof (m_deliveredBits));
+  os.write ((const char *) &nNodes, sizeof (nNodes));
+  if (nNodes > 0)
+    {
+      os.write ((const char *) &m_nodeEnergy[0], nNodes * sizeof (double));
+    }
+  os.write ((const char *) &nMessages, sizeof (nMessages));
+  std::map<uint64_t, MessageRecord>::const_iterator it;
+  for (it = m_messages.begin (); it != m_messages.end (); it++)
+    {
+      os.write ((const char *) &it->first, sizeof (it->first));
+      os.write ((const char *) &it->second, sizeof (it->second));
+    }
+}
+
+bool
+P1906EnergyLedger::RestoreState (std::istream &is)
+{
+  NS_LOG_FUNCTION (this);
+  Reset ();
+  uint64_t nNodes = 0;
+  uint64_t nMessages = 0;
+  is.read ((char *) m_componentEnergy, sizeof (m_componentEnergy));
+  is.read ((char *) &m_deliveredBits, sizeof (m_deliveredBits));
+  is.read ((char *) &nNodes, sizeof (nNodes));
+  if (!is)
+    {
+      Reset ();
+      return false;
+    }
+  m_nodeEnergy.resize (nNodes);
+  if (nNodes > 0)
+    {
+      is.read ((char *) &m_nodeEnergy[0], nNodes * sizeof (double));
+    }
+  is.read ((char *) &nMessages, sizeof (nMessages));
+  for (uint64_t i = 0; i < nMessages && is; i++)
+    {
+      uint64_t message;
+      MessageRecord r;
+      is.read ((char *) &message, sizeof (message));
+      is.read ((char *) &r, sizeof (r));
+      m_messages[message] = r;
+    }
+  if (!is)
+    {
+      Reset ();
+      return false;
+    }
+  return true;
+}
+
+} // namespace ns3
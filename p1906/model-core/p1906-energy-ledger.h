@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_ENERGY_LEDGER
+#define P1906_ENERGY_LEDGER
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+#include <vector>
+#include <map>
+#include <ostream>
+#include <istream>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906EnergyLedger
+ *
+ * \brief This class collects the energy spent by the components of
+ * the P1906 framework. Components report energy with a single
+ * counter increment; the ledger aggregates it per component and per
+ * node and relates it to the delivered bits, as required by the
+ * Information and Communication Energy metric.
+ *
+ * Per-message records are kept only when the TrackMessages attribute
+ * is set. The medium announces how many receptions a message will
+ * have and reports the end of each of them, delivered or dropped;
+ * once the last one ends, the record is passed to the MessageEnergy
+ * trace source and deleted.
+ */
+
+class P1906EnergyLedger : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906EnergyLedger ();
+  virtual ~P1906EnergyLedger ();
+
+  /**
+   * \return the ledger shared by all the components of the simulation
+   */
+  static Ptr<P1906EnergyLedger> GetLedger (void);
+
+  /**
+   * The component of the framework that spent the energy
+   */
+  enum EnergyComponent
+  {
+    PERTURBATION = 0,
+    MOTION,
+    SPECIFICITY,
+    NUM_COMPONENTS
+  };
+
+  /**
+   * Node identifier used when the energy cannot be attributed to a node
+   */
+  static const uint32_t NO_NODE = 0xffffffff;
+
+  /**
+   * \param node the id of the node spending the energy (or NO_NODE)
+   * \param message the uid of the packet the energy was spent for
+   * \param c the component spending the energy
+   * \param joules the energy spent [J]
+   */
+  void AddEnergy (uint32_t node, uint64_t message, EnergyComponent c, double joules);
+
+  /**
+   * \param message the uid of the delivered packet
+   * \param bits the number of bits delivered to the receiver
+   */
+  void NotifyDelivery (uint64_t message, uint32_t bits);
+
+  /**
+   * \param message the uid of the transmitted packet
+   * \param receptions the number of receivers the message was scheduled for
+   */
+  void ExpectReceptions (uint64_t message, uint32_t receptions);
+  /**
+   * \param message the uid of a packet whose reception ended, either
+   * delivered or dropped
+   */
+  void NotifyReceptionEnd (uint64_t message);
+
+  void SetTrackMessages (bool track);
+  bool GetTrackMessages (void) const;
+
+  double GetTotalEnergy (void) const;
+  double GetComponentEnergy (EnergyComponent c) const;
+  double GetNodeEnergy (uint32_t node) const;
+  double GetMessageEnergy (uint64_t message) const;
+  uint64_t GetDeliveredBits (void) const;
+
+  /**
+   * \return the total energy divided by the total delivered bits [J/bit]
+   */
+  double GetEnergyPerBit (void) const;
+  /**
+   * \return the energy of a message still in flight divided by its delivered bits [J/bit]
+   */
+  double GetMessageEnergyPerBit (uint64_t message) const;
+
+  void Reset (void);
+  void Print (std::ostream &os) const;
+
+  /**
+   * Write the accumulated energy and bits in binary form, e.g., into a checkpoint
+   */
+  void SaveState (std::ostream &os) const;
+  /**
+   * Replace the accumulated energy and bits with those written by SaveState
+   * \return false if the state cannot be read
+   */
+  bool RestoreState (std::istream &is);
+
+private:
+  struct MessageRecord
+  {
+    double energy;
+    uint64_t deliveredBits;
+    uint64_t pendingReceptions;
+  };
+
+  void CompleteMessage (std::map<uint64_t, MessageRecord>::iterator it);
+
+  double m_componentEnergy[NUM_COMPONENTS];
+  std::vector<double> m_nodeEnergy;
+  std::map<uint64_t, MessageRecord> m_messages;
+  uint64_t m_deliveredBits;
+  bool m_trackMessages;
+
+  /**
+   * The uid, energy [J] and delivered bits of a completed message
+   */
+  TracedCallback<uint64_t, double, uint64_t> m_messageTrace;
+};
+
+}
+
+#endif /* P1906_ENERGY_LEDGER */
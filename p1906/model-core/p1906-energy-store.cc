@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/trace-source-accessor.h"
+#include "p1906-energy-store.h"
+#include "p1906-energy-harvester.h"
+#include <algorithm>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906EnergyStore");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906EnergyStore);
+
+TypeId P1906EnergyStore::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906EnergyStore")
+    .SetParent<Object> ()
+    .AddConstructor<P1906EnergyStore> ()
+    .AddAttribute ("Capacity",
+                   "The largest energy the store can hold [J]",
+                   DoubleValue (1e-9),
+                   MakeDoubleAccessor (&P1906EnergyStore::m_capacity),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("InitialEnergy",
+                   "The energy stored at the beginning of the simulation [J]",
+                   DoubleValue (1e-9),
+                   MakeDoubleAccessor (&P1906EnergyStore::m_energy),
+                   MakeDoubleChecker<double> (0.0))
+    .AddTraceSource ("Energy",
+                     "The stored energy before and after a message has been paid for",
+                     MakeTraceSourceAccessor (&P1906EnergyStore::m_energyTrace))
+  ;
+  return tid;
+}
+
+P1906EnergyStore::P1906EnergyStore ()
+{
+  NS_LOG_FUNCTION (this);
+  m_harvester = 0;
+  m_capacity = 1e-9;
+  m_energy = 1e-9;
+  m_lastUpdate = Seconds (0);
+  m_harvested = 0.;
+  m_consumed = 0.;
+  m_refused = 0;
+}
+
+P1906EnergyStore::~P1906EnergyStore ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906EnergyStore::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_harvester = 0;
+  Object::DoDispose ();
+}
+
+void
+P1906EnergyStore::SetP1906EnergyHarvester (Ptr<P1906EnergyHarvester> h)
+{
+  NS_LOG_FUNCTION (this << h);
+  // the energy harvested so far belongs to the previous harvester
+  Update ();
+  m_harvester = h;
+}
+
+Ptr<P1906EnergyHarvester>
+P1906EnergyStore::GetP1906EnergyHarvester (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_harvester;
+}
+
+void
+P1906EnergyStore::Update (void)
+{
+  Time now = Simulator::Now ();
+  if (m_harvester != 0 && now > m_lastUpdate)
+    {
+      double harvested = m_harvester->GetHarvestedEnergy (m_lastUpdate, now);
+      m_harvested += harvested;
+      m_energy = std::min (m_capacity, m_energy + harvested);
+    }
+  m_lastUpdate = now;
+}
+
+double
+P1906EnergyStore::GetEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  Update ();
+  return m_energy;
+}
+
+double
+P1906EnergyStore::GetCapacity (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_capacity;
+}
+
+bool
+P1906EnergyStore::Consume (double joules)
+{
+  NS_LOG_FUNCTION (this << joules);
+  Update ();
+  // tolerate the rounding of the harvesting time to the time resolution
+  if (m_energy < joules * (1 - 1e-9))
+    {
+      NS_LOG_FUNCTION (this << "not enough energy [stored,needed]" << m_energy << joules);
+      m_refused++;
+      return false;
+    }
+  double before = m_energy;
+  m_energy = std::max (0., m_energy - joules);
+  m_consumed += joules;
+  m_energyTrace (before, m_energy);
+  return true;
+}
+
+Time
+P1906EnergyStore::GetTimeToEnergy (double joules)
+{
+  NS_LOG_FUNCTION (this << joules);
+  Update ();
+  if (m_energy >= joules * (1 - 1e-9))
+    {
+      return Seconds (0);
+    }
+  if (joules > m_capacity || m_harvester == 0)
+    {
+      return Time::Max ();
+    }
+  // the store cannot fill up before holding the energy, so the capacity plays no role
+  return m_harvester->GetHarvestingTime (Simulator::Now (), joules - m_energy);
+}
+
+double
+P1906EnergyStore::GetHarvestedEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  Update ();
+  return m_harvested;
+}
+
+double
+P1906EnergyStore::GetConsumedEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_consumed;
+}
+
+uint64_t
+P1906EnergyStore::GetRefused (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_refused;
+}
+
+} // namespace ns3
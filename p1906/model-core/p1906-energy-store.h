@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_ENERGY_STORE
+#define P1906_ENERGY_STORE
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+class P1906EnergyHarvester;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906EnergyStore
+ *
+ * \brief This class models the energy stored by a nanonode, e.g., in the
+ * capacitor of a nanogenerator. The store is charged by a
+ * P1906EnergyHarvester, up to its capacity, and debited by the messages
+ * transmitted, for the energy given by
+ * P1906Perturbation::ComputeMessageEnergy. The harvested energy is
+ * computed in closed form when the store is used, so an idle store costs
+ * no events.
+ *
+ * A P1906TransmitterCommunicationInterface refuses the messages its store
+ * cannot pay for; the P1906NetDevice holds them in its queue until the
+ * energy has been harvested.
+ */
+
+class P1906EnergyStore : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906EnergyStore ();
+  virtual ~P1906EnergyStore ();
+
+  virtual void DoDispose (void);
+
+  void SetP1906EnergyHarvester (Ptr<P1906EnergyHarvester> h);
+  Ptr<P1906EnergyHarvester> GetP1906EnergyHarvester (void);
+
+  /**
+   * \return the stored energy [J]
+   */
+  double GetEnergy (void);
+  double GetCapacity (void);
+
+  /**
+   * \param joules the energy to be spent
+   * \return false, with no energy spent, if the stored energy is not enough
+   */
+  bool Consume (double joules);
+
+  /**
+   * \param joules the energy to be spent
+   * \return the time after which the energy is stored, zero if it is
+   * already, or Time::Max () if it will never be
+   */
+  Time GetTimeToEnergy (double joules);
+
+  /**
+   * \return the energy harvested so far [J], including what was lost with the store full
+   */
+  double GetHarvestedEnergy (void);
+  double GetConsumedEnergy (void);
+  /**
+   * \return the number of requests refused by Consume
+   */
+  uint64_t GetRefused (void);
+
+private:
+  void Update (void);
+
+  Ptr<P1906EnergyHarvester> m_harvester;
+  double m_capacity;
+  double m_energy;
+  Time m_lastUpdate;
+  double m_harvested;
+  double m_consumed;
+  uint64_t m_refused;
+
+  TracedCallback<double, double> m_energyTrace;
+};
+
+}
+
+#endif /* P1906_ENERGY_STORE */
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "p1906-flow-mobility-model.h"
+#include <cmath>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FlowMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906FlowMobilityModel);
+
+TypeId P1906FlowMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FlowMobilityModel")
+    .SetParent<MobilityModel> ()
+    .AddConstructor<P1906FlowMobilityModel> ()
+    .AddAttribute ("Profile",
+                   "The velocity field of the flow",
+                   EnumValue (P1906FlowMobilityModel::POISEUILLE),
+                   MakeEnumAccessor (&P1906FlowMobilityModel::m_profile),
+                   MakeEnumChecker (P1906FlowMobilityModel::UNIFORM, "Uniform",
+                                    P1906FlowMobilityModel::POISEUILLE, "Poiseuille"))
+    .AddAttribute ("VesselOrigin",
+                   "A point of the vessel axis",
+                   VectorValue (Vector (0, 0, 0)),
+                   MakeVectorAccessor (&P1906FlowMobilityModel::m_vesselOrigin),
+                   MakeVectorChecker ())
+    .AddAttribute ("VesselDirection",
+                   "The direction of the flow, along the vessel axis",
+                   VectorValue (Vector (1, 0, 0)),
+                   MakeVectorAccessor (&P1906FlowMobilityModel::m_vesselDirection),
+                   MakeVectorChecker ())
+    .AddAttribute ("VesselRadius",
+                   "The radius of the vessel (Poiseuille profile) [m]",
+                   DoubleValue (1e-3),
+                   MakeDoubleAccessor (&P1906FlowMobilityModel::m_vesselRadius),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MaxVelocity",
+                   "The velocity on the vessel axis, or everywhere (Uniform profile) [m/s]",
+                   DoubleValue (1e-3),
+                   MakeDoubleAccessor (&P1906FlowMobilityModel::m_maxVelocity),
+                   MakeDoubleChecker<double> ());
+  return tid;
+}
+
+P1906FlowMobilityModel::P1906FlowMobilityModel ()
+{
+  NS_LOG_FUNCTION (this);
+  m_profile = POISEUILLE;
+  m_vesselOrigin = Vector (0, 0, 0);
+  m_vesselDirection = Vector (1, 0, 0);
+  m_vesselRadius = 1e-3;
+  m_maxVelocity = 1e-3;
+}
+
+P1906FlowMobilityModel::~P1906FlowMobilityModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Vector
+P1906FlowMobilityModel::GetFlowVelocity (Vector position) const
+{
+  NS_LOG_FUNCTION (this << position);
+  Vector d = m_vesselDirection;
+  double norm = std::sqrt (d.x * d.x + d.y * d.y + d.z * d.z);
+  if (norm == 0)
+    {
+      return Vector (0, 0, 0);
+    }
+  d = Vector (d.x / norm, d.y / norm, d.z / norm);
+
+  double speed = m_maxVelocity;
+  if (m_profile == POISEUILLE)
+    {
+      // the distance from the axis
+      Vector w (position.x - m_vesselOrigin.x, position.y - m_vesselOrigin.y, position.z - m_vesselOrigin.z);
+      double along = w.x * d.x + w.y * d.y + w.z * d.z;
+      Vector r (w.x - along * d.x, w.y - along * d.y, w.z - along * d.z);
+      double r2 = r.x * r.x + r.y * r.y + r.z * r.z;
+      double R2 = m_vesselRadius * m_vesselRadius;
+      speed = r2 < R2 ? m_maxVelocity * (1 - r2 / R2) : 0;
+    }
+  return Vector (speed * d.x, speed * d.y, speed * d.z);
+}
+
+Vector
+P1906FlowMobilityModel::DoGetPosition (void) const
+{
+  double t = (Simulator::Now () - m_baseTime).GetSeconds ();
+  return Vector (m_basePosition.x + m_velocity.x * t,
+                 m_basePosition.y + m_velocity.y * t,
+                 m_basePosition.z + m_velocity.z * t);
+}
+
+void
+P1906FlowMobilityModel::DoSetPosition (const Vector &position)
+{
+  NS_LOG_FUNCTION (this << position);
+  m_basePosition = position;
+  m_baseTime = Simulator::Now ();
+  m_velocity = GetFlowVelocity (position);
+  NotifyCourseChange ();
+}
+
+Vector
+P1906FlowMobilityModel::DoGetVelocity (void) const
+{
+  return m_velocity;
+}
+
+} // namespace ns3
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_FLOW_MOBILITY_MODEL
+#define P1906_FLOW_MOBILITY_MODEL
+
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906FlowMobilityModel
+ *
+ * \brief This class moves a node with the flow of a fluid, e.g., a node
+ * drifting in a blood vessel. The velocity field is either uniform or the
+ * Poiseuille profile of a straight vessel: along the vessel axis, MaxVelocity
+ * on the axis and decreasing with the square of the distance from it, down
+ * to zero at the vessel wall and outside the vessel.
+ *
+ * In both fields the streamlines are straight and the velocity is constant
+ * along them, so the position is computed analytically from the last
+ * position set: the model schedules no events, and positions are exact at
+ * any time. The velocity changes only when the position is set, which is
+ * notified as a course change (see P1906Medium::BuildSpatialIndex).
+ */
+
+class P1906FlowMobilityModel : public MobilityModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906FlowMobilityModel ();
+  virtual ~P1906FlowMobilityModel ();
+
+  enum Profile
+  {
+    UNIFORM = 0,
+    POISEUILLE
+  };
+
+  /**
+   * \param position a point of the fluid
+   * \return the velocity of the fluid at that point [m/s]
+   */
+  Vector GetFlowVelocity (Vector position) const;
+
+private:
+  virtual Vector DoGetPosition (void) const;
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+
+  Profile m_profile;
+  Vector m_vesselOrigin;
+  Vector m_vesselDirection;
+  double m_vesselRadius;
+  double m_maxVelocity;
+
+  Vector m_basePosition;   //!< the position at m_baseTime
+  Time m_baseTime;
+  Vector m_velocity;
+};
+
+}
+
+#endif /* P1906_FLOW_MOBILITY_MODEL */
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "p1906-mac-timer-wheel.h"
+#include "p1906-mac.h"
+#include <map>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MacTimerWheel");
+
+namespace {
+
+struct WheelRegistry
+{
+  std::map<int64_t, P1906MacTimerWheel *> wheels;
+  bool scheduled;
+
+  WheelRegistry () : scheduled (false) {}
+};
+
+// never destroyed: the wheels are released at Simulator::Destroy
+WheelRegistry &
+GetRegistry (void)
+{
+  static WheelRegistry *registry = new WheelRegistry ();
+  return *registry;
+}
+
+}
+
+P1906MacTimerWheel *
+P1906MacTimerWheel::Get (Time tick)
+{
+  NS_LOG_FUNCTION (tick);
+  int64_t steps = tick.GetTimeStep ();
+  NS_ASSERT_MSG (steps > 0, "the tick of a timer wheel must be positive");
+  WheelRegistry &r = GetRegistry ();
+  std::map<int64_t, P1906MacTimerWheel *>::iterator it = r.wheels.find (steps);
+  if (it != r.wheels.end ())
+    {
+      return it->second;
+    }
+  if (!r.scheduled)
+    {
+      r.scheduled = true;
+      Simulator::ScheduleDestroy (&P1906MacTimerWheel::DestroyAll);
+    }
+  P1906MacTimerWheel *w = new P1906MacTimerWheel (steps);
+  r.wheels[steps] = w;
+  return w;
+}
+
+void
+P1906MacTimerWheel::DestroyAll (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  WheelRegistry &r = GetRegistry ();
+  std::map<int64_t, P1906MacTimerWheel *>::iterator it;
+  for (it = r.wheels.begin (); it != r.wheels.end (); it++)
+    {
+      delete it->second;
+    }
+  r.wheels.clear ();
+  r.scheduled = false;
+}
+
+P1906MacTimerWheel::P1906MacTimerWheel (int64_t tick)
+{
+  NS_LOG_FUNCTION (this << tick);
+  m_tick = tick;
+  for (uint32_t i = 0; i < NUM_BUCKETS; i++)
+    {
+      m_buckets[i].next = NO_TICK;
+    }
+  m_pending = 0;
+  m_expirations = 0;
+  m_scheduledTick = NO_TICK;
+  m_expiring = false;
+}
+
+P1906MacTimerWheel::~P1906MacTimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+}
+
+void
+P1906MacTimerWheel::Schedule (Time delay, Ptr<P1906Mac> mac, uint32_t token)
+{
+  NS_LOG_FUNCTION (this << delay << token);
+  uint64_t now = Simulator::Now ().GetTimeStep ();
+  uint64_t current = now / m_tick;
+  uint64_t due = (now + delay.GetTimeStep () + m_tick - 1) / m_tick;
+  if (due <= current)
+    {
+      due = current + 1;
+    }
+
+  Bucket &b = m_buckets[due % NUM_BUCKETS];
+  Entry e;
+  e.mac = mac;
+  e.due = due;
+  e.token = token;
+  b.entries.push_back (e);
+  if (due < b.next)
+    {
+      b.next = due;
+    }
+  m_pending++;
+
+  // while expiring, the wheel is rescheduled once all the timers of the tick are served
+  if (!m_expiring && due < m_scheduledTick)
+    {
+      m_event.Cancel ();
+      m_scheduledTick = due;
+      m_event = Simulator::Schedule (TimeStep (due * m_tick - now), &P1906MacTimerWheel::Expire, this);
+    }
+}
+
+void
+P1906MacTimerWheel::Expire (void)
+{
+  NS_LOG_FUNCTION (this << m_scheduledTick);
+  uint64_t current = m_scheduledTick;
+  m_scheduledTick = NO_TICK;
+  m_expiring = true;
+  m_expirations++;
+
+  // take the expired entries out first, since the handlers schedule new ones
+  Bucket &b = m_buckets[current % NUM_BUCKETS];
+  std::vector<Entry> expired;
+  uint32_t kept = 0;
+  b.next = NO_TICK;
+  for (uint32_t i = 0; i < b.entries.size (); i++)
+    {
+      if (b.entries[i].due == current)
+        {
+          expired.push_back (b.entries[i]);
+        }
+      else
+        {
+          if (b.entries[i].due < b.next)
+            {
+              b.next = b.entries[i].due;
+            }
+          b.entries[kept++] = b.entries[i];
+        }
+    }
+  b.entries.resize (kept);
+  m_pending -= expired.size ();
+
+  for (uint32_t i = 0; i < expired.size (); i++)
+    {
+      expired[i].mac->HandleTimer (expired[i].token);
+    }
+
+  m_expiring = false;
+  Reschedule ();
+}
+
+void
+P1906MacTimerWheel::Reschedule (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t next = NO_TICK;
+  for (uint32_t i = 0; i < NUM_BUCKETS; i++)
+    {
+      if (m_buckets[i].next < next)
+        {
+          next = m_buckets[i].next;
+        }
+    }
+  if (next == NO_TICK)
+    {
+      return;
+    }
+  uint64_t now = Simulator::Now ().GetTimeStep ();
+  m_scheduledTick = next;
+  m_event = Simulator::Schedule (TimeStep (next * m_tick - now), &P1906MacTimerWheel::Expire, this);
+}
+
+Time
+P1906MacTimerWheel::GetTick (void) const
+{
+  return TimeStep (m_tick);
+}
+
+uint32_t
+P1906MacTimerWheel::GetPendingTimers (void) const
+{
+  return m_pending;
+}
+
+uint64_t
+P1906MacTimerWheel::GetExpirations (void) const
+{
+  return m_expirations;
+}
+
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_MAC_TIMER_WHEEL
+#define P1906_MAC_TIMER_WHEEL
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/event-id.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+class P1906Mac;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906MacTimerWheel
+ *
+ * \brief This class keeps the timers of the P1906 MAC protocols. Timers
+ * expire on multiples of the tick of the wheel and are hashed into a fixed
+ * number of buckets by their expiration tick; the wheel holds a single
+ * simulator event, at the earliest pending tick, so the cost of the
+ * scheduler does not grow with the number of contending nodes. All the
+ * timers expiring at the same tick are served by one event.
+ *
+ * MAC protocols sharing the same tick share the same wheel (see Get).
+ */
+
+class P1906MacTimerWheel
+{
+public:
+  /**
+   * \param tick the granularity of the timers
+   * \return the wheel of the given tick, created at the first call
+   */
+  static P1906MacTimerWheel *Get (Time tick);
+
+  /**
+   * Call mac->HandleTimer (token) at the first tick not earlier than
+   * now + delay, and at least one tick from now
+   */
+  void Schedule (Time delay, Ptr<P1906Mac> mac, uint32_t token);
+
+  Time GetTick (void) const;
+  /**
+   * \return the timers not expired yet
+   */
+  uint32_t GetPendingTimers (void) const;
+  /**
+   * \return the simulator events used by the wheel so far
+   */
+  uint64_t GetExpirations (void) const;
+
+private:
+  static const uint32_t NUM_BUCKETS = 256;
+  static const uint64_t NO_TICK = 0xffffffffffffffffULL;
+
+  struct Entry
+  {
+    Ptr<P1906Mac> mac;
+    uint64_t due;
+    uint32_t token;
+  };
+
+  struct Bucket
+  {
+    std::vector<Entry> entries;
+    uint64_t next;   //!< the earliest due tick in the bucket
+  };
+
+  P1906MacTimerWheel (int64_t tick);
+  ~P1906MacTimerWheel ();
+
+  void Expire (void);
+  void Reschedule (void);
+  static void DestroyAll (void);
+
+  int64_t m_tick;             //!< in time steps
+  Bucket m_buckets[NUM_BUCKETS];
+  uint32_t m_pending;
+  uint64_t m_expirations;
+  uint64_t m_scheduledTick;   //!< the tick of m_event, or NO_TICK
+  bool m_expiring;
+  EventId m_event;
+};
+
+}
+
+#endif /* P1906_MAC_TIMER_WHEEL */
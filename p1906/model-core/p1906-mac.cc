@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "p1906-mac.h"
+#include "p1906-mac-timer-wheel.h"
+#include "p1906-net-device.h"
+#include "p1906-communication-interface.h"
+#include "p1906-transmitter-communication-interface.h"
+#include "p1906-perturbation.h"
+#include "p1906-medium.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906Mac");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906Mac);
+
+TypeId P1906Mac::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906Mac")
+    .SetParent<Object> ()
+    .AddConstructor<P1906Mac> ()
+    .AddAttribute ("TimerTick",
+                   "The granularity of the timers of the MAC",
+                   TimeValue (NanoSeconds (1)),
+                   MakeTimeAccessor (&P1906Mac::m_tick),
+                   MakeTimeChecker ());
+  return tid;
+}
+
+P1906Mac::P1906Mac ()
+{
+  NS_LOG_FUNCTION (this);
+  m_dev = 0;
+  m_tick = NanoSeconds (1);
+  ResetMacStatistics ();
+}
+
+P1906Mac::~P1906Mac ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906Mac::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_dev = 0;
+  Object::DoDispose ();
+}
+
+void
+P1906Mac::SetP1906NetDevice (Ptr<P1906NetDevice> d)
+{
+  NS_LOG_FUNCTION (this << d);
+  m_dev = d;
+}
+
+Ptr<P1906NetDevice>
+P1906Mac::GetP1906NetDevice (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_dev;
+}
+
+void
+P1906Mac::StartTransmission (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_accessStart = Simulator::Now ();
+  DoStartTransmission (p);
+}
+
+void
+P1906Mac::DoStartTransmission (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  Transmit (p);
+}
+
+void
+P1906Mac::HandleTimer (uint32_t token)
+{
+  NS_LOG_FUNCTION (this << token);
+  if (token == TX_COMPLETE && m_dev != 0)
+    {
+      m_dev->NotifyTransmissionComplete ();
+    }
+}
+
+Time
+P1906Mac::GetTimerTick (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_tick;
+}
+
+void
+P1906Mac::Transmit (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_macStats.transmitted++;
+  m_macStats.accessDelay += Simulator::Now () - m_accessStart;
+  m_dev->GetP1906CommunicationInterface ()->HandleTransmission (p);
+  ScheduleTimer (GetTransmissionTime (p), TX_COMPLETE);
+}
+
+void
+P1906Mac::Drop (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_macStats.dropped++;
+  m_dev->NotifyTransmissionComplete ();
+}
+
+void
+P1906Mac::ScheduleTimer (Time delay, uint32_t token)
+{
+  NS_LOG_FUNCTION (this << delay << token);
+  P1906MacTimerWheel::Get (GetTimerTick ())->Schedule (delay, this, token);
+}
+
+Ptr<P1906Medium>
+P1906Mac::GetP1906Medium (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_dev->GetP1906CommunicationInterface ()->GetP1906Medium ();
+}
+
+Ptr<P1906Perturbation>
+P1906Mac::GetP1906Perturbation (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_dev->GetP1906CommunicationInterface ()->GetP1906TransmitterCommunicationInterface ()->GetP1906Perturbation ();
+}
+
+Time
+P1906Mac::GetTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  return GetP1906Perturbation ()->ComputeTransmissionTime (p);
+}
+
+P1906Mac::MacStatistics
+P1906Mac::GetMacStatistics (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_macStats;
+}
+
+void
+P1906Mac::ResetMacStatistics (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_macStats.transmitted = 0;
+  m_macStats.collisions = 0;
+  m_macStats.dropped = 0;
+  m_macStats.accessDelay = Seconds (0);
+}
+
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_MAC
+#define P1906_MAC
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Packet;
+class P1906NetDevice;
+class P1906Medium;
+class P1906Perturbation;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906Mac
+ *
+ * \brief Base class implementing the medium access control between the
+ * P1906NetDevice and its communication interface. The device hands the
+ * message at the head of its transmit queue to StartTransmission; the MAC
+ * protocol decides when the message is transmitted, or dropped, and then
+ * lets the device go on with its queue. This base class transmits at once.
+ *
+ * The timers of the MAC protocols are kept by a P1906MacTimerWheel rather
+ * than by one simulator event per message.
+ */
+
+class P1906Mac : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906Mac ();
+  virtual ~P1906Mac ();
+
+  virtual void DoDispose (void);
+
+  void SetP1906NetDevice (Ptr<P1906NetDevice> d);
+  Ptr<P1906NetDevice> GetP1906NetDevice (void);
+
+  /**
+   * Called by the device for the message at the head of its transmit
+   * queue. The MAC must call Transmit or Drop exactly once for it.
+   *
+   * \param p the message to be transmitted
+   */
+  void StartTransmission (Ptr<Packet> p);
+
+  /**
+   * Called by the timer wheel when a timer of this MAC expires
+   *
+   * \param token the token given to ScheduleTimer
+   */
+  virtual void HandleTimer (uint32_t token);
+
+  /**
+   * \return the granularity of the timers of the protocol
+   */
+  virtual Time GetTimerTick (void);
+
+  /**
+   * The statistics of the medium access
+   */
+  struct MacStatistics
+  {
+    uint64_t transmitted;    //!< messages handed to the communication interface
+    uint64_t collisions;     //!< access attempts that failed because of contention
+    uint64_t dropped;        //!< messages given up by the protocol
+    Time accessDelay;        //!< the total time from StartTransmission to Transmit
+  };
+
+  MacStatistics GetMacStatistics (void) const;
+  void ResetMacStatistics (void);
+
+protected:
+  /**
+   * Implemented by the MAC protocols; this base class transmits at once
+   */
+  virtual void DoStartTransmission (Ptr<Packet> p);
+
+  /**
+   * Token of the timer notifying the device that the Perturbation has
+   * sent the last pulse of the message. Derived classes use larger tokens.
+   */
+  static const uint32_t TX_COMPLETE = 0;
+
+  /**
+   * Hand the message to the communication interface now; the device is
+   * notified when its transmission is complete
+   */
+  void Transmit (Ptr<Packet> p);
+  /**
+   * Give up the message; the device goes on with its queue
+   */
+  void Drop (Ptr<Packet> p);
+
+  void ScheduleTimer (Time delay, uint32_t token);
+
+  Ptr<P1906Medium> GetP1906Medium (void);
+  Ptr<P1906Perturbation> GetP1906Perturbation (void);
+  /**
+   * \return the time the Perturbation needs to transmit the message
+   */
+  Time GetTransmissionTime (Ptr<Packet> p);
+
+  MacStatistics m_macStats;
+
+private:
+  Ptr<P1906NetDevice> m_dev;
+  Time m_tick;
+  Time m_accessStart;
+};
+
+}
+
+#endif /* P1906_MAC */
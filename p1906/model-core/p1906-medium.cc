@@ -34,13 +34,19 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/mobility-model.h"
 #include "p1906-medium.h"
+#include "p1906-net-device.h"
 #include "p1906-communication-interface.h"
 #include "p1906-field.h"
 #include "p1906-message-carrier.h"
 #include "p1906-receiver-communication-interface.h"
 #include "p1906-specificity.h"
 #include "p1906-motion.h"
+#include "p1906-profiler.h"
+#include "p1906-energy-ledger.h"
+#include <cmath>
+#include <algorithm>
 
 
 NS_LOG_COMPONENT_DEFINE ("P1906Medium");
@@ -65,6 +71,10 @@ P1906Medium::P1906Medium ()
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces = new P1906CommunicationInterfaces ();
   m_motion = 0;
+  m_trackDeliveries = false;
+  m_nextDelivery = 0;
+  m_deliveriesVersion = 0;
+  m_cellSize = 0;
 }
 
 P1906Medium::~P1906Medium ()
@@ -78,8 +88,21 @@ void
 P1906Medium::DoDispose ()
 {
   Channel::DoDispose ();
+  CancelPendingDeliveries ();
+  // the mobility models may outlive the medium, e.g., after a snapshot restore creates a new one
+  std::set<Ptr<MobilityModel> >::iterator it;
+  for (it = m_tracked.begin (); it != m_tracked.end (); it++)
+    {
+      (*it)->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&P1906Medium::CourseChanged, this));
+    }
+  m_tracked.clear ();
   m_communicationInterfaces = 0;
   m_motion = 0;
+  m_cellSize = 0;
+  m_cells.clear ();
+  m_mobility.clear ();
+  m_leaving.clear ();
+  m_mobilityIndex.clear ();
   NS_LOG_FUNCTION (this);
 }
 
@@ -117,7 +140,9 @@ P1906Medium::HandleTransmission (Ptr<P1906CommunicationInterface> src,
                                  Ptr<P1906Field> field)
 {
   NS_LOG_FUNCTION (this);
+  P1906ProfilerScope scope (P1906Profiler::HANDLE_TRANSMISSION);
 
+  uint32_t receptions = 0;
   std::vector< Ptr<P1906CommunicationInterface> >::iterator it;
   for (it = m_communicationInterfaces->begin (); it != m_communicationInterfaces->end (); it++)
     {
@@ -129,8 +154,14 @@ P1906Medium::HandleTransmission (Ptr<P1906CommunicationInterface> src,
 
           if (m_motion)
             {
-        	   delay = m_motion->ComputePropagationDelay (src, dst, message, field);
-               receivedMessageCarrier = m_motion->CalculateReceivedMessageCarrier(src, dst, message, field);
+              {
+                P1906ProfilerScope delayScope (P1906Profiler::COMPUTE_PROPAGATION_DELAY);
+                delay = m_motion->ComputePropagationDelay (src, dst, message, field);
+              }
+              {
+                P1906ProfilerScope carrierScope (P1906Profiler::CALCULATE_RECEIVED_MESSAGE_CARRIER);
+                receivedMessageCarrier = m_motion->CalculateReceivedMessageCarrier (src, dst, message, field);
+              }
             }
           else
             {
@@ -139,9 +170,11 @@ P1906Medium::HandleTransmission (Ptr<P1906CommunicationInterface> src,
               delay = 0.;
             }
 
-          Simulator::Schedule(Seconds (delay), &P1906Medium::HandleReception, this, src, dst, receivedMessageCarrier);
+          ScheduleDelivery (src, dst, receivedMessageCarrier, Seconds (delay));
+          receptions++;
 	    }
     }
+  P1906EnergyLedger::GetLedger ()->ExpectReceptions (message->GetMessage ()->GetUid (), receptions);
 }
 
 void
@@ -150,6 +183,85 @@ P1906Medium::HandleReception (Ptr<P1906CommunicationInterface> src, Ptr<P1906Com
   NS_LOG_FUNCTION (this);
   Ptr<P1906ReceiverCommunicationInterface> rx = dst->GetP1906ReceiverCommunicationInterface ();
   rx->HandleReception (src, dst, message);
+  P1906EnergyLedger::GetLedger ()->NotifyReceptionEnd (message->GetMessage ()->GetUid ());
+}
+
+void
+P1906Medium::ScheduleDelivery (Ptr<P1906CommunicationInterface> src,
+                               Ptr<P1906CommunicationInterface> dst,
+                               Ptr<P1906MessageCarrier> message,
+                               Time delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  if (!m_trackDeliveries)
+    {
+      Simulator::Schedule (delay, &P1906Medium::HandleReception, this, src, dst, message);
+      return;
+    }
+  m_deliveriesVersion++;
+  uint64_t id = m_nextDelivery++;
+  PendingDelivery &d = m_pendingDeliveries[id];
+  d.src = src;
+  d.dst = dst;
+  d.message = message;
+  d.deliveryTime = Simulator::Now () + delay;
+  d.event = Simulator::Schedule (delay, &P1906Medium::DeliverPending, this, id);
+}
+
+void
+P1906Medium::DeliverPending (uint64_t id)
+{
+  NS_LOG_FUNCTION (this << id);
+  PendingDeliveries::iterator it = m_pendingDeliveries.find (id);
+  if (it == m_pendingDeliveries.end ())
+    {
+      return;
+    }
+  PendingDelivery d = it->second;
+  m_pendingDeliveries.erase (it);
+  m_deliveriesVersion++;
+  HandleReception (d.src, d.dst, d.message);
+}
+
+const P1906Medium::PendingDeliveries &
+P1906Medium::GetPendingDeliveries (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_pendingDeliveries;
+}
+
+void
+P1906Medium::CancelPendingDeliveries (void)
+{
+  NS_LOG_FUNCTION (this);
+  PendingDeliveries::iterator it;
+  for (it = m_pendingDeliveries.begin (); it != m_pendingDeliveries.end (); it++)
+    {
+      Simulator::Cancel (it->second.event);
+    }
+  m_pendingDeliveries.clear ();
+  m_deliveriesVersion++;
+}
+
+void
+P1906Medium::SetTrackDeliveries (bool track)
+{
+  NS_LOG_FUNCTION (this << track);
+  m_trackDeliveries = track;
+}
+
+bool
+P1906Medium::GetTrackDeliveries (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_trackDeliveries;
+}
+
+uint64_t
+P1906Medium::GetDeliveriesVersion (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_deliveriesVersion;
 }
 
 void
@@ -157,6 +269,8 @@ P1906Medium::AddP1906CommunicationInterface (Ptr<P1906CommunicationInterface> i)
 {
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces->push_back (i);
+  // the index no longer covers all the interfaces
+  m_cellSize = 0;
 }
 
 void
@@ -164,6 +278,7 @@ P1906Medium::SetP1906CommunicationInterfaces (P1906CommunicationInterfaces* i)
 {
   NS_LOG_FUNCTION (this);
   m_communicationInterfaces = i;
+  m_cellSize = 0;
 }
 
 P1906Medium::P1906CommunicationInterfaces*
@@ -175,4 +290,174 @@ P1906Medium::GetP1906CommunicationInterfaces ()
 
 
 
+uint64_t
+P1906Medium::GetCellKey (int64_t x, int64_t y, int64_t z) const
+{
+  // 21 bits per coordinate
+  return ((uint64_t) (x & 0x1fffff) << 42) | ((uint64_t) (y & 0x1fffff) << 21) | (uint64_t) (z & 0x1fffff);
+}
+
+void
+P1906Medium::BuildSpatialIndex (double cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT_MSG (cellSize > 0, "the cells of the spatial index must have a positive size");
+  m_cellSize = cellSize;
+  m_cells.clear ();
+  m_leaving.clear ();
+  m_mobilityIndex.clear ();
+  uint32_t n = m_communicationInterfaces->size ();
+  m_mobility.assign (n, 0);
+  m_cellKeys.assign (n, 0);
+  m_leaveTimes.assign (n, -1);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> m = (*m_communicationInterfaces)[i]->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ();
+      if (m == 0)
+        {
+          continue;
+        }
+      m_mobility[i] = m;
+      m_mobilityIndex[PeekPointer (m)] = i;
+      if (m_tracked.insert (m).second)
+        {
+          m->TraceConnectWithoutContext ("CourseChange", MakeCallback (&P1906Medium::CourseChanged, this));
+        }
+      IndexNode (i, false);
+    }
+}
+
+void
+P1906Medium::IndexNode (uint32_t i, bool indexed)
+{
+  Vector p = m_mobility[i]->GetPosition ();
+  Vector v = m_mobility[i]->GetVelocity ();
+  int64_t cx = (int64_t) std::floor (p.x / m_cellSize);
+  int64_t cy = (int64_t) std::floor (p.y / m_cellSize);
+  int64_t cz = (int64_t) std::floor (p.z / m_cellSize);
+  uint64_t key = GetCellKey (cx, cy, cz);
+
+  if (!indexed || key != m_cellKeys[i])
+    {
+      if (indexed)
+        {
+          std::vector<uint32_t> &old = m_cells[m_cellKeys[i]];
+          std::vector<uint32_t>::iterator it = std::find (old.begin (), old.end (), i);
+          *it = old.back ();
+          old.pop_back ();
+          if (old.empty ())
+            {
+              m_cells.erase (m_cellKeys[i]);
+            }
+        }
+      m_cells[key].push_back (i);
+      m_cellKeys[i] = key;
+    }
+
+  if (m_leaveTimes[i] >= 0)
+    {
+      m_leaving.erase (std::make_pair (m_leaveTimes[i], i));
+      m_leaveTimes[i] = -1;
+    }
+
+  // the time to the first cell boundary met at the current velocity
+  double c[3] = { (double) cx, (double) cy, (double) cz };
+  double x[3] = { p.x, p.y, p.z };
+  double u[3] = { v.x, v.y, v.z };
+  double t = -1;
+  for (int k = 0; k < 3; k++)
+    {
+      double tk;
+      if (u[k] > 0)
+        {
+          tk = ((c[k] + 1) * m_cellSize - x[k]) / u[k];
+        }
+      else if (u[k] < 0)
+        {
+          tk = (c[k] * m_cellSize - x[k]) / u[k];
+        }
+      else
+        {
+          continue;
+        }
+      if (t < 0 || tk < t)
+        {
+          t = tk;
+        }
+    }
+  if (t >= 0)
+    {
+      int64_t steps = Seconds (t).GetTimeStep ();
+      m_leaveTimes[i] = Simulator::Now ().GetTimeStep () + (steps > 0 ? steps : 1);
+      m_leaving.insert (std::make_pair (m_leaveTimes[i], i));
+    }
+}
+
+void
+P1906Medium::UpdateSpatialIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  while (!m_leaving.empty () && m_leaving.begin ()->first <= now)
+    {
+      IndexNode (m_leaving.begin ()->second, true);
+    }
+}
+
+void
+P1906Medium::CourseChanged (Ptr<const MobilityModel> m)
+{
+  NS_LOG_FUNCTION (this << m);
+  if (m_cellSize == 0)
+    {
+      return;
+    }
+  std::map<const MobilityModel *, uint32_t>::iterator it = m_mobilityIndex.find (PeekPointer (m));
+  if (it != m_mobilityIndex.end ())
+    {
+      IndexNode (it->second, true);
+    }
+}
+
+void
+P1906Medium::GetCommunicationInterfacesInRange (Vector position, double radius, P1906CommunicationInterfaces &out)
+{
+  NS_LOG_FUNCTION (this << position << radius);
+  out.clear ();
+  if (m_cellSize == 0)
+    {
+      BuildSpatialIndex (radius);
+    }
+  UpdateSpatialIndex ();
+
+  int64_t x0 = (int64_t) std::floor ((position.x - radius) / m_cellSize);
+  int64_t x1 = (int64_t) std::floor ((position.x + radius) / m_cellSize);
+  int64_t y0 = (int64_t) std::floor ((position.y - radius) / m_cellSize);
+  int64_t y1 = (int64_t) std::floor ((position.y + radius) / m_cellSize);
+  int64_t z0 = (int64_t) std::floor ((position.z - radius) / m_cellSize);
+  int64_t z1 = (int64_t) std::floor ((position.z + radius) / m_cellSize);
+  for (int64_t x = x0; x <= x1; x++)
+    {
+      for (int64_t y = y0; y <= y1; y++)
+        {
+          for (int64_t z = z0; z <= z1; z++)
+            {
+              std::map<uint64_t, std::vector<uint32_t> >::const_iterator it = m_cells.find (GetCellKey (x, y, z));
+              if (it == m_cells.end ())
+                {
+                  continue;
+                }
+              for (uint32_t k = 0; k < it->second.size (); k++)
+                {
+                  uint32_t i = it->second[k];
+                  if (CalculateDistance (position, m_mobility[i]->GetPosition ()) <= radius)
+                    {
+                      out.push_back ((*m_communicationInterfaces)[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 } // namespace ns3
@@ -33,6 +33,12 @@
 #include "ns3/net-device.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/vector.h"
+#include <map>
+#include <set>
+#include <vector>
 
 
 namespace ns3 {
@@ -41,6 +47,7 @@ class P1906CommunicationInterface;
 class P1906MessageCarrier;
 class P1906Field;
 class P1906Motion;
+class MobilityModel;
 
 
 /**
@@ -92,9 +99,92 @@ public:
   void SetP1906CommunicationInterfaces (P1906CommunicationInterfaces* i);
   P1906CommunicationInterfaces* GetP1906CommunicationInterfaces ();
 
+  /**
+   * A message carrier propagating through the medium, i.e., scheduled
+   * for reception but not yet received
+   */
+  struct PendingDelivery
+  {
+    Ptr<P1906CommunicationInterface> src;
+    Ptr<P1906CommunicationInterface> dst;
+    Ptr<P1906MessageCarrier> message;
+    Time deliveryTime;
+    EventId event;
+  };
+  typedef std::map<uint64_t, PendingDelivery> PendingDeliveries;
+
+  /**
+   * \param src the sender of the message carrier
+   * \param dst the receiver of the message carrier
+   * \param message the message carrier as it will be received
+   * \param delay the propagation delay
+   *
+   * Schedules the reception of the message carrier. With delivery tracking
+   * enabled, the carrier is also kept track of until it is received
+   */
+  void ScheduleDelivery (Ptr<P1906CommunicationInterface> src,
+                         Ptr<P1906CommunicationInterface> dst,
+                         Ptr<P1906MessageCarrier> message,
+                         Time delay);
+  /**
+   * \param track keep track of the deliveries scheduled from now on,
+   * e.g., to checkpoint the medium (default false)
+   */
+  void SetTrackDeliveries (bool track);
+  bool GetTrackDeliveries (void) const;
+  const PendingDeliveries & GetPendingDeliveries (void) const;
+  void CancelPendingDeliveries (void);
+  /**
+   * \return a counter incremented each time the tracked deliveries change
+   */
+  uint64_t GetDeliveriesVersion (void) const;
+
+  /**
+   * \param cellSize the side of the cells of the grid [m]
+   *
+   * Builds a uniform grid over the positions of the nodes of the
+   * communication interfaces. The index follows the nodes as they move:
+   * from its velocity, the time each node leaves its cell is known, and
+   * only the nodes that have crossed a cell boundary are moved, in bulk,
+   * when the index is queried. Course changes (see
+   * MobilityModel::NotifyCourseChange) update the node at once.
+   */
+  void BuildSpatialIndex (double cellSize);
+  /**
+   * Move the nodes that have left their cell since the last update
+   */
+  void UpdateSpatialIndex (void);
+  /**
+   * \param position the center of the query
+   * \param radius the range of the query [m]
+   * \param out filled with the communication interfaces whose node lies within range
+   *
+   * The spatial index is built at the first query, with cells as large
+   * as the range, if it has not been built yet
+   */
+  void GetCommunicationInterfacesInRange (Vector position, double radius, P1906CommunicationInterfaces &out);
+
 private:
+  void DeliverPending (uint64_t id);
+  uint64_t GetCellKey (int64_t x, int64_t y, int64_t z) const;
+  void IndexNode (uint32_t i, bool indexed);
+  void CourseChanged (Ptr<const MobilityModel> m);
+
   P1906CommunicationInterfaces* m_communicationInterfaces;
   Ptr<P1906Motion> m_motion;
+  bool m_trackDeliveries;
+  PendingDeliveries m_pendingDeliveries;
+  uint64_t m_nextDelivery;
+  uint64_t m_deliveriesVersion;
+
+  double m_cellSize;                                  //!< 0 until the spatial index is built
+  std::map<uint64_t, std::vector<uint32_t> > m_cells;  //!< indexes into the communication interfaces
+  std::vector<Ptr<MobilityModel> > m_mobility;
+  std::vector<uint64_t> m_cellKeys;
+  std::vector<int64_t> m_leaveTimes;                   //!< the time step each node leaves its cell, or -1
+  std::set<std::pair<int64_t, uint32_t> > m_leaving;
+  std::map<const MobilityModel *, uint32_t> m_mobilityIndex;
+  std::set<Ptr<MobilityModel> > m_tracked;            //!< the models whose course changes are followed, until DoDispose
 
 protected:
   virtual void DoDispose ();
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "p1906-memory-tracker.h"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MemoryTracker");
+
+namespace {
+
+const char *g_componentNames[P1906MemoryTracker::NUM_COMPONENTS] = {
+  "Carrier",
+  "Position",
+  "Motion",
+  "Field",
+  "Microtubule",
+  "Tube",
+  "VolSurface",
+  "Diffusion",
+  "Other"
+};
+
+struct Block
+{
+  P1906MemoryTracker::Component c;
+  size_t bytes;
+};
+
+struct ComponentCounters
+{
+  uint64_t liveBytes;
+  uint64_t peakBytes;
+  uint64_t allocations;
+};
+
+/*
+ * The tracked blocks and the counters of the components; allocations
+ * may come from several threads, so they are serialized by the lock
+ */
+struct TrackerRegistry
+{
+  std::mutex lock;
+  std::unordered_map<const void *, Block> blocks;
+  ComponentCounters counters[P1906MemoryTracker::NUM_COMPONENTS];
+  bool scheduled;
+  std::string format;
+  std::chrono::steady_clock::time_point startTime;
+};
+
+// never destroyed, since blocks may be released after the static objects are destroyed
+TrackerRegistry &
+GetRegistry (void)
+{
+  static TrackerRegistry *registry = new TrackerRegistry ();
+  return *registry;
+}
+
+} // anonymous namespace
+
+std::atomic<bool> P1906MemoryTracker::m_enabled (false);
+
+void
+P1906MemoryTracker::Enable (std::string format)
+{
+  NS_LOG_FUNCTION (format);
+  TrackerRegistry &r = GetRegistry ();
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    r.format = format;
+    if (!m_enabled.load ())
+      {
+        r.startTime = std::chrono::steady_clock::now ();
+      }
+    if (!r.scheduled)
+      {
+        r.scheduled = true;
+        Simulator::ScheduleDestroy (&P1906MemoryTracker::PrintSummary);
+      }
+  }
+  m_enabled.store (true);
+}
+
+void
+P1906MemoryTracker::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled.store (false);
+}
+
+void
+P1906MemoryTracker::Allocate (Component c, const void *p, size_t bytes)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  std::unordered_map<const void *, Block>::iterator it = r.blocks.find (p);
+  if (it != r.blocks.end ())
+    {
+      ComponentCounters &old = r.counters[it->second.c];
+      old.liveBytes -= it->second.bytes;
+      it->second.c = c;
+      it->second.bytes = bytes;
+    }
+  else
+    {
+      Block b;
+      b.c = c;
+      b.bytes = bytes;
+      r.blocks[p] = b;
+      r.counters[c].allocations++;
+    }
+  ComponentCounters &cc = r.counters[c];
+  cc.liveBytes += bytes;
+  if (cc.liveBytes > cc.peakBytes)
+    {
+      cc.peakBytes = cc.liveBytes;
+    }
+}
+
+void
+P1906MemoryTracker::Free (const void *p)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  std::unordered_map<const void *, Block>::iterator it = r.blocks.find (p);
+  if (it == r.blocks.end ())
+    {
+      return;
+    }
+  r.counters[it->second.c].liveBytes -= it->second.bytes;
+  r.blocks.erase (it);
+}
+
+uint64_t
+P1906MemoryTracker::GetLiveBytes (Component c)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  return r.counters[c].liveBytes;
+}
+
+uint64_t
+P1906MemoryTracker::GetPeakBytes (Component c)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  return r.counters[c].peakBytes;
+}
+
+uint64_t
+P1906MemoryTracker::GetAllocations (Component c)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  return r.counters[c].allocations;
+}
+
+double
+P1906MemoryTracker::GetAllocationRate (Component c)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  double elapsed = std::chrono::duration<double> (std::chrono::steady_clock::now () - r.startTime).count ();
+  if (elapsed <= 0.)
+    {
+      return 0.;
+    }
+  return r.counters[c].allocations / elapsed;
+}
+
+std::string
+P1906MemoryTracker::GetName (Component c)
+{
+  return g_componentNames[c];
+}
+
+void
+P1906MemoryTracker::Reset (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  TrackerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  r.blocks.clear ();
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      r.counters[i].liveBytes = 0;
+      r.counters[i].peakBytes = 0;
+      r.counters[i].allocations = 0;
+    }
+  r.startTime = std::chrono::steady_clock::now ();
+}
+
+void
+P1906MemoryTracker::Print (std::ostream &os)
+{
+  uint64_t total = 0;
+  os << "[component,liveBytes,peakBytes,allocations,allocationsPerSecond]" << std::endl;
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      Component c = (Component) i;
+      uint64_t live = GetLiveBytes (c);
+      total += live;
+      os << "[component,liveBytes,peakBytes,allocations,allocationsPerSecond] " << g_componentNames[i] << " "
+         << live << " " << GetPeakBytes (c) << " " << GetAllocations (c) << " " << GetAllocationRate (c) << std::endl;
+    }
+  os << "[liveBytes] " << total << std::endl;
+}
+
+void
+P1906MemoryTracker::PrintJson (std::ostream &os)
+{
+  os << "{\"components\":[";
+  for (int i = 0; i < NUM_COMPONENTS; i++)
+    {
+      Component c = (Component) i;
+      os << (i > 0 ? "," : "") << "{\"component\":\"" << g_componentNames[i] << "\",\"live_bytes\":" << GetLiveBytes (c)
+         << ",\"peak_bytes\":" << GetPeakBytes (c) << ",\"allocations\":" << GetAllocations (c)
+         << ",\"allocations_per_s\":" << GetAllocationRate (c) << "}";
+    }
+  os << "]}" << std::endl;
+}
+
+void
+P1906MemoryTracker::PrintSummary (void)
+{
+  TrackerRegistry &r = GetRegistry ();
+  std::string format;
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    r.scheduled = false;
+    format = r.format;
+  }
+  if (format == "json")
+    {
+      PrintJson (std::cout);
+    }
+  else
+    {
+      Print (std::cout);
+    }
+}
+
+} // namespace ns3
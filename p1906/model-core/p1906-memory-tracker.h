@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#ifndef P1906_MEMORY_TRACKER
+#define P1906_MEMORY_TRACKER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906MemoryTracker
+ *
+ * \brief This class attributes the memory of the P1906 framework to the
+ * subsystem that allocated it. The GSL vectors and matrices of the motor
+ * model are allocated through VectorAlloc/MatrixAlloc, and the message
+ * carriers and positions report themselves when they are created and
+ * destroyed. Each component keeps its live bytes, its peak, and its
+ * allocations, from which the allocation rate is derived.
+ *
+ * Tracking is off by default: while disabled, the wrappers only add a
+ * branch to the GSL calls. Once enabled, the report is printed with the
+ * run summary, i.e., when Simulator::Destroy is called. Blocks allocated
+ * before Enable are not tracked and their release is ignored.
+ */
+
+class P1906MemoryTracker
+{
+public:
+  /**
+   * The subsystems memory is attributed to
+   */
+  enum Component
+  {
+    CARRIER = 0,
+    POSITION,
+    MOTION,
+    FIELD,
+    MICROTUBULE,
+    TUBE,
+    VOL_SURFACE,
+    DIFFUSION,
+    OTHER,
+    NUM_COMPONENTS
+  };
+
+  /**
+   * Start tracking and print the report at Simulator::Destroy
+   * \param format "table" or "json"
+   */
+  static void Enable (std::string format = "table");
+  static void Disable (void);
+  static bool IsEnabled (void)
+  {
+    return m_enabled.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * Account for a block of a component. Calling it again for a tracked
+   * block changes its size without counting a new allocation, e.g., when
+   * the constructor of a derived class reports its own size.
+   */
+  static void Allocate (Component c, const void *p, size_t bytes);
+  /**
+   * Release a tracked block; blocks not tracked are ignored
+   */
+  static void Free (const void *p);
+
+  static gsl_vector * VectorAlloc (Component c, size_t n)
+  {
+    gsl_vector *v = gsl_vector_alloc (n);
+    if (IsEnabled () && v)
+      {
+        Allocate (c, v, sizeof (gsl_vector) + sizeof (gsl_block) + n * sizeof (double));
+      }
+    return v;
+  }
+  static gsl_vector * VectorCalloc (Component c, size_t n)
+  {
+    gsl_vector *v = gsl_vector_calloc (n);
+    if (IsEnabled () && v)
+      {
+        Allocate (c, v, sizeof (gsl_vector) + sizeof (gsl_block) + n * sizeof (double));
+      }
+    return v;
+  }
+  static gsl_matrix * MatrixAlloc (Component c, size_t n1, size_t n2)
+  {
+    gsl_matrix *m = gsl_matrix_alloc (n1, n2);
+    if (IsEnabled () && m)
+      {
+        Allocate (c, m, sizeof (gsl_matrix) + sizeof (gsl_block) + n1 * n2 * sizeof (double));
+      }
+    return m;
+  }
+  static gsl_matrix * MatrixCalloc (Component c, size_t n1, size_t n2)
+  {
+    gsl_matrix *m = gsl_matrix_calloc (n1, n2);
+    if (IsEnabled () && m)
+      {
+        Allocate (c, m, sizeof (gsl_matrix) + sizeof (gsl_block) + n1 * n2 * sizeof (double));
+      }
+    return m;
+  }
+  static void VectorFree (gsl_vector *v)
+  {
+    if (IsEnabled () && v)
+      {
+        Free (v);
+      }
+    gsl_vector_free (v);
+  }
+  static void MatrixFree (gsl_matrix *m)
+  {
+    if (IsEnabled () && m)
+      {
+        Free (m);
+      }
+    gsl_matrix_free (m);
+  }
+
+  /**
+   * \return the bytes of a component currently allocated
+   */
+  static uint64_t GetLiveBytes (Component c);
+  /**
+   * \return the largest value reached by the live bytes of a component
+   */
+  static uint64_t GetPeakBytes (Component c);
+  /**
+   * \return the allocations of a component since Enable
+   */
+  static uint64_t GetAllocations (Component c);
+  /**
+   * \return the allocations of a component per second of wall clock time since Enable
+   */
+  static double GetAllocationRate (Component c);
+  static std::string GetName (Component c);
+
+  /**
+   * Clear the counters and forget the tracked blocks
+   */
+  static void Reset (void);
+  static void Print (std::ostream &os);
+  static void PrintJson (std::ostream &os);
+
+private:
+  static void PrintSummary (void);
+
+  static std::atomic<bool> m_enabled;
+};
+
+}
+
+#endif /* P1906_MEMORY_TRACKER */
@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "p1906-message-carrier.h"
+#include "p1906-memory-tracker.h"
 
 
 namespace ns3 {
@@ -47,12 +48,20 @@ P1906MessageCarrier::P1906MessageCarrier ()
 {
   NS_LOG_FUNCTION (this);
   m_message = 0;
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906MessageCarrier));
+    }
 }
 
 P1906MessageCarrier::~P1906MessageCarrier ()
 {
   NS_LOG_FUNCTION (this);
   m_message = 0;
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Free (this);
+    }
 }
 
 void
@@ -69,5 +78,16 @@ P1906MessageCarrier::GetMessage ()
   return m_message;
 }
 
+P1906MessageCarrier::CaptureMetadata
+P1906MessageCarrier::GetCaptureMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  CaptureMetadata m;
+  m.model = GENERIC_CARRIER;
+  m.start = Seconds (0);
+  m.nValues = 0;
+  return m;
+}
+
 
 } // namespace ns3
@@ -57,6 +57,41 @@ public:
   void SetMessage (Ptr<Packet> message);
   Ptr<Packet> GetMessage ();
 
+  /**
+   * The kind of message carrier, as recorded by a P1906Capture
+   */
+  enum CarrierModel
+  {
+    GENERIC_CARRIER = 0,
+    EM_CARRIER,
+    MOL_CARRIER,
+    MOTOR_CARRIER,
+    CALCIUM_CARRIER,
+    BACTERIA_CARRIER,
+    FRET_CARRIER
+  };
+
+  static const uint32_t MAX_CAPTURE_VALUES = 3;
+
+  /**
+   * The physical parameters of the message carrier recorded by a P1906Capture
+   */
+  struct CaptureMetadata
+  {
+    uint8_t model;                        //!< a CarrierModel
+    Time start;                           //!< the start of the transmission
+    uint8_t nValues;
+    double values[MAX_CAPTURE_VALUES];    //!< EM: central frequency [Hz], bandwidth [Hz], power [W]; MOL: molecules;
+                                          //!< motor: molecules, propagation delay [motor time units], energy [J] (NaN until received);
+                                          //!< calcium: calcium [uM]; bacteria: bacteria;
+                                          //!< FRET: excitons, exciton lifetime [s]
+  };
+
+  /**
+   * \return the parameters of the carrier; this base class has none
+   */
+  virtual CaptureMetadata GetCaptureMetadata (void);
+
 private:
 
   Ptr<Packet> m_message;
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "p1906-net-device-tag.h"
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (P1906NetDeviceTag);
+
+TypeId
+P1906NetDeviceTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906NetDeviceTag")
+    .SetParent<Tag> ()
+    .AddConstructor<P1906NetDeviceTag> ();
+  return tid;
+}
+
+TypeId
+P1906NetDeviceTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+P1906NetDeviceTag::P1906NetDeviceTag ()
+  : m_protocol (0)
+{
+}
+
+P1906NetDeviceTag::P1906NetDeviceTag (Mac48Address source, Mac48Address destination, uint16_t protocol)
+  : m_source (source),
+    m_destination (destination),
+    m_protocol (protocol)
+{
+}
+
+uint32_t
+P1906NetDeviceTag::GetSerializedSize (void) const
+{
+  return 6 + 6 + 2;
+}
+
+void
+P1906NetDeviceTag::Serialize (TagBuffer i) const
+{
+  uint8_t buffer[6];
+  m_source.CopyTo (buffer);
+  i.Write (buffer, 6);
+  m_destination.CopyTo (buffer);
+  i.Write (buffer, 6);
+  i.WriteU16 (m_protocol);
+}
+
+void
+P1906NetDeviceTag::Deserialize (TagBuffer i)
+{
+  uint8_t buffer[6];
+  i.Read (buffer, 6);
+  m_source.CopyFrom (buffer);
+  i.Read (buffer, 6);
+  m_destination.CopyFrom (buffer);
+  m_protocol = i.ReadU16 ();
+}
+
+void
+P1906NetDeviceTag::Print (std::ostream &os) const
+{
+  os << "[src,dst,protocol] " << m_source << " " << m_destination << " " << m_protocol;
+}
+
+Mac48Address
+P1906NetDeviceTag::GetSource (void) const
+{
+  return m_source;
+}
+
+Mac48Address
+P1906NetDeviceTag::GetDestination (void) const
+{
+  return m_destination;
+}
+
+uint16_t
+P1906NetDeviceTag::GetProtocol (void) const
+{
+  return m_protocol;
+}
+
+} // namespace ns3
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_NET_DEVICE_TAG
+#define P1906_NET_DEVICE_TAG
+
+#include "ns3/tag.h"
+#include "ns3/mac48-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906NetDeviceTag
+ *
+ * \brief The link layer information of a message sent by a P1906NetDevice.
+ * It travels as a packet tag with the message carrier, so that the size of
+ * the message, and hence its transmission time and energy, do not change.
+ */
+
+class P1906NetDeviceTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  P1906NetDeviceTag ();
+  P1906NetDeviceTag (Mac48Address source, Mac48Address destination, uint16_t protocol);
+
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+  Mac48Address GetSource (void) const;
+  Mac48Address GetDestination (void) const;
+  uint16_t GetProtocol (void) const;
+
+private:
+  Mac48Address m_source;
+  Mac48Address m_destination;
+  uint16_t m_protocol;
+};
+
+}
+
+#endif /* P1906_NET_DEVICE_TAG */
@@ -39,7 +39,13 @@
 #include "ns3/seq-ts-header.h"
 #include "ns3/simulator.h"
 #include "p1906-net-device.h"
+#include "p1906-net-device-tag.h"
 #include "p1906-communication-interface.h"
+#include "p1906-transmitter-communication-interface.h"
+#include "p1906-perturbation.h"
+#include "p1906-mac.h"
+#include "p1906-relay.h"
+#include "p1906-energy-store.h"
 
 
 NS_LOG_COMPONENT_DEFINE ("P1906NetDevice");
@@ -55,6 +61,25 @@ P1906NetDevice::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::P1906NetDevice")
     .SetParent<NetDevice> ()
     .AddConstructor<P1906NetDevice> ()
+    .AddAttribute ("TxQueueSize",
+                   "The maximum number of messages waiting for transmission",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&P1906NetDevice::m_txQueueSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Mtu",
+                   "The largest message accepted by Send [bytes]",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&P1906NetDevice::m_mtu),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddTraceSource ("MacTx",
+                     "A message has been handed to the communication interface",
+                     MakeTraceSourceAccessor (&P1906NetDevice::m_macTxTrace))
+    .AddTraceSource ("MacTxDrop",
+                     "A message has been dropped because the transmit queue is full",
+                     MakeTraceSourceAccessor (&P1906NetDevice::m_macTxDropTrace))
+    .AddTraceSource ("MacRx",
+                     "A message has been received by the communication interface",
+                     MakeTraceSourceAccessor (&P1906NetDevice::m_macRxTrace))
   ;
   return tid;
 }
@@ -63,6 +88,12 @@ P1906NetDevice::P1906NetDevice ()
 {
   NS_LOG_FUNCTION (this);
   m_p1906CommunicationInterface = 0;
+  m_ifIndex = 0;
+  m_mtu = 1500;
+  m_address = Mac48Address::Allocate ();
+  m_txQueueSize = 100;
+  m_txBusy = false;
+  ResetQueueStatistics ();
 }
 
 P1906NetDevice::~P1906NetDevice ()
@@ -75,6 +106,23 @@ void
 P1906NetDevice::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_txEvent.Cancel ();
+  m_txQueue.clear ();
+  m_rxCallback.Nullify ();
+  m_promiscRxCallback.Nullify ();
+  m_node = 0;
+  m_p1906CommunicationInterface = 0;
+  if (m_mac != 0)
+    {
+      m_mac->Dispose ();
+      m_mac = 0;
+    }
+  if (m_relay != 0)
+    {
+      m_relay->Dispose ();
+      m_relay = 0;
+    }
+  m_energyStore = 0;
   NetDevice::DoDispose ();
 }
 
@@ -90,6 +138,53 @@ P1906NetDevice::GetP1906CommunicationInterface (void)
   return m_p1906CommunicationInterface;
 }
 
+void
+P1906NetDevice::SetP1906Mac (Ptr<P1906Mac> mac)
+{
+  NS_LOG_FUNCTION (this << mac);
+  m_mac = mac;
+  if (m_mac != 0)
+    {
+      m_mac->SetP1906NetDevice (this);
+    }
+}
+
+Ptr<P1906Mac>
+P1906NetDevice::GetP1906Mac (void)
+{
+  return m_mac;
+}
+
+void
+P1906NetDevice::SetP1906Relay (Ptr<P1906Relay> relay)
+{
+  NS_LOG_FUNCTION (this << relay);
+  m_relay = relay;
+  if (m_relay != 0)
+    {
+      m_relay->SetP1906NetDevice (this);
+    }
+}
+
+Ptr<P1906Relay>
+P1906NetDevice::GetP1906Relay (void)
+{
+  return m_relay;
+}
+
+void
+P1906NetDevice::SetP1906EnergyStore (Ptr<P1906EnergyStore> store)
+{
+  NS_LOG_FUNCTION (this << store);
+  m_energyStore = store;
+}
+
+Ptr<P1906EnergyStore>
+P1906NetDevice::GetP1906EnergyStore (void)
+{
+  return m_energyStore;
+}
+
 
 
 
@@ -180,14 +275,15 @@ bool
 P1906NetDevice::SetMtu (uint16_t mtu)
 {
   NS_LOG_FUNCTION (mtu);
-  return (mtu == 0);
+  m_mtu = mtu;
+  return true;
 }
 
 uint16_t
 P1906NetDevice::GetMtu (void) const
 {
   NS_LOG_FUNCTION (this);
-  return 0;
+  return m_mtu;
 }
 
 Ptr<Channel>
@@ -201,27 +297,29 @@ void
 P1906NetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (this);
+  m_address = Mac48Address::ConvertFrom (address);
 }
 
 Address
 P1906NetDevice::GetAddress (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Address ();
+  return m_address;
 }
 
 bool
 P1906NetDevice::IsBroadcast (void) const
 {
   NS_LOG_FUNCTION (this);
-  return false;
+  // every message carrier reaches all the interfaces attached to the medium
+  return true;
 }
 
 Address
 P1906NetDevice::GetBroadcast (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Address ();
+  return Mac48Address::GetBroadcast ();
 }
 
 bool
@@ -285,7 +383,7 @@ bool
 P1906NetDevice::IsLinkUp (void) const
 {
   NS_LOG_FUNCTION (this);
-  return false;
+  return m_p1906CommunicationInterface != 0;
 }
 
 void
@@ -298,33 +396,221 @@ void
 P1906NetDevice::SetReceiveCallback (NetDevice::ReceiveCallback cb)
 {
   NS_LOG_FUNCTION (&cb);
+  m_rxCallback = cb;
 }
 
 void
 P1906NetDevice::SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb)
 {
   NS_LOG_FUNCTION (&cb);
+  m_promiscRxCallback = cb;
 }
 
 bool
 P1906NetDevice::SupportsSendFrom () const
 {
   NS_LOG_FUNCTION (this);
-  return false;
+  return true;
 }
 
 bool
 P1906NetDevice::Send (Ptr<Packet> packet,const Address& dest, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (packet << dest << protocolNumber);
-  return false;
+  return SendFrom (packet, m_address, dest, protocolNumber);
 }
 
 bool
 P1906NetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address& dest, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (packet << src << dest << protocolNumber);
-  return false;
+  if (m_relay != 0)
+    {
+      m_relay->HandleSend (packet, Mac48Address::ConvertFrom (dest));
+    }
+  return Enqueue (packet, Mac48Address::ConvertFrom (src), Mac48Address::ConvertFrom (dest), protocolNumber);
+}
+
+bool
+P1906NetDevice::Enqueue (Ptr<Packet> packet, Mac48Address src, Mac48Address dest, uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (packet << src << dest << protocolNumber);
+
+  if (m_p1906CommunicationInterface == 0 || packet->GetSize () > m_mtu ||
+      m_txQueue.size () >= m_txQueueSize)
+    {
+      NS_LOG_FUNCTION (this << "message dropped [queue]" << m_txQueue.size ());
+      m_stats.dropped++;
+      m_macTxDropTrace (packet);
+      return false;
+    }
+
+  packet->AddPacketTag (P1906NetDeviceTag (src, dest, protocolNumber));
+  QueueItem item;
+  item.packet = packet;
+  item.enqueued = Simulator::Now ();
+  m_txQueue.push_back (item);
+  m_stats.enqueued++;
+  if (m_txQueue.size () > m_stats.maxLength)
+    {
+      m_stats.maxLength = m_txQueue.size ();
+    }
+
+  if (!m_txBusy)
+    {
+      StartTransmission ();
+    }
+  return true;
+}
+
+void
+P1906NetDevice::StartTransmission (void)
+{
+  NS_LOG_FUNCTION (this << m_txQueue.size ());
+  Ptr<P1906Perturbation> perturbation = m_p1906CommunicationInterface->
+    GetP1906TransmitterCommunicationInterface ()->GetP1906Perturbation ();
+
+  while (m_energyStore != 0)
+    {
+      // wait, with a single event, until the harvester has charged the store enough
+      double energy = perturbation->ComputeMessageEnergy (m_txQueue.front ().packet);
+      Time wait = m_energyStore->GetTimeToEnergy (energy);
+      if (wait == Time::Max ())
+        {
+          NS_LOG_FUNCTION (this << "message dropped [energy]" << energy);
+          m_stats.energyDropped++;
+          m_macTxDropTrace (m_txQueue.front ().packet);
+          m_txQueue.pop_front ();
+          if (m_txQueue.empty ())
+            {
+              m_txBusy = false;
+              return;
+            }
+          continue;
+        }
+      if (wait.IsStrictlyPositive ())
+        {
+          m_txBusy = true;
+          m_txEvent = Simulator::Schedule (wait, &P1906NetDevice::StartTransmission, this);
+          return;
+        }
+      break;
+    }
+
+  QueueItem item = m_txQueue.front ();
+  m_txQueue.pop_front ();
+
+  m_stats.transmitted++;
+  m_stats.txBytes += item.packet->GetSize ();
+  m_stats.queueDelay += Simulator::Now () - item.enqueued;
+  m_macTxTrace (item.packet);
+
+  m_txBusy = true;
+  if (m_mac != 0)
+    {
+      m_mac->StartTransmission (item.packet);
+      return;
+    }
+
+  // the medium is busy until the Perturbation has sent the last pulse of the message
+  m_p1906CommunicationInterface->HandleTransmission (item.packet);
+  Time duration = perturbation->ComputeTransmissionTime (item.packet);
+  m_txEvent = Simulator::Schedule (duration, &P1906NetDevice::NotifyTransmissionComplete, this);
+}
+
+void
+P1906NetDevice::NotifyTransmissionComplete (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_txBusy = false;
+  if (!m_txQueue.empty ())
+    {
+      StartTransmission ();
+    }
+}
+
+void
+P1906NetDevice::Receive (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+
+  // every receiver of the medium gets the same message: give each its own copy
+  Ptr<Packet> packet = p->Copy ();
+  P1906NetDeviceTag tag;
+  Mac48Address from;
+  Mac48Address to = m_address;
+  uint16_t protocol = 0;
+  if (packet->RemovePacketTag (tag))
+    {
+      from = tag.GetSource ();
+      to = tag.GetDestination ();
+      protocol = tag.GetProtocol ();
+    }
+  if (m_relay != 0 && !m_relay->HandleReception (packet, from, to, protocol))
+    {
+      // a copy of a message already received
+      return;
+    }
+
+  NetDevice::PacketType type;
+  if (to == m_address)
+    {
+      type = NetDevice::PACKET_HOST;
+    }
+  else if (to.IsBroadcast ())
+    {
+      type = NetDevice::PACKET_BROADCAST;
+    }
+  else if (to.IsGroup ())
+    {
+      type = NetDevice::PACKET_MULTICAST;
+    }
+  else
+    {
+      type = NetDevice::PACKET_OTHERHOST;
+    }
+
+  m_stats.received++;
+  m_stats.rxBytes += packet->GetSize ();
+  m_macRxTrace (packet);
+
+  if (!m_promiscRxCallback.IsNull ())
+    {
+      m_promiscRxCallback (this, packet, protocol, from, to, type);
+    }
+  if (type != NetDevice::PACKET_OTHERHOST && !m_rxCallback.IsNull ())
+    {
+      m_rxCallback (this, packet, protocol, from);
+    }
+}
+
+P1906NetDevice::QueueStatistics
+P1906NetDevice::GetQueueStatistics (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_stats;
+}
+
+void
+P1906NetDevice::ResetQueueStatistics (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stats.enqueued = 0;
+  m_stats.dropped = 0;
+  m_stats.energyDropped = 0;
+  m_stats.transmitted = 0;
+  m_stats.txBytes = 0;
+  m_stats.received = 0;
+  m_stats.rxBytes = 0;
+  m_stats.maxLength = 0;
+  m_stats.queueDelay = Seconds (0);
+}
+
+uint32_t
+P1906NetDevice::GetQueueLength (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_txQueue.size ();
 }
 
 
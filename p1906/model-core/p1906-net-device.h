@@ -37,11 +37,18 @@
 #include <ns3/packet.h>
 #include <ns3/traced-callback.h>
 #include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/mac48-address.h>
 #include <list>
+#include <deque>
 
 namespace ns3 {
 
 class P1906CommunicationInterface;
+class P1906Mac;
+class P1906Relay;
+class P1906EnergyStore;
 
 /**
  * \ingroup P1906 framework
@@ -54,6 +61,19 @@ class P1906CommunicationInterface;
  * storing the transmission entity and the reception entity. It enable the
  * interaction between low-layer components of the P1906 framework and
  * upper layers of the protocol stack.
+ *
+ * Messages given to Send are stored in a bounded transmit queue and handed
+ * to the communication interface one at a time: the next message starts
+ * when the Perturbation component has transmitted the previous one (see
+ * P1906Perturbation::ComputeTransmissionTime). Received messages are
+ * passed to the receive callback of the protocol stack. The link layer
+ * addresses and the protocol number travel in a P1906NetDeviceTag.
+ * When a P1906Mac is set, the message at the head of the queue is handed
+ * to it, and the MAC protocol decides when it is transmitted. When a
+ * P1906Relay is set, received messages are forwarded to the nodes out of
+ * the range of the sender. When a P1906EnergyStore is set, the message at
+ * the head of the queue waits until the store holds the energy needed to
+ * transmit it.
  */
 
 class P1906NetDevice : public NetDevice
@@ -73,15 +93,105 @@ public:
 
   virtual void DoDispose (void);
 
+  /**
+   * The statistics of the transmit queue and of the received messages
+   */
+  struct QueueStatistics
+  {
+    uint64_t enqueued;       //!< messages accepted by Send
+    uint64_t dropped;        //!< messages refused because the queue was full
+    uint64_t energyDropped;  //!< messages needing more energy than the store can ever hold
+    uint64_t transmitted;    //!< messages handed to the communication interface (or to the MAC)
+    uint64_t txBytes;
+    uint64_t received;       //!< messages passed up by the communication interface
+    uint64_t rxBytes;
+    uint32_t maxLength;      //!< the largest queue length observed
+    Time queueDelay;         //!< the total time spent in the queue by the transmitted messages
+  };
+
+  QueueStatistics GetQueueStatistics (void) const;
+  void ResetQueueStatistics (void);
+  /**
+   * \return the messages waiting in the transmit queue
+   */
+  uint32_t GetQueueLength (void) const;
+
+  /**
+   * Called by the communication interface for every message received correctly
+   *
+   * \param p the received message
+   */
+  void Receive (Ptr<Packet> p);
+
+  /**
+   * Called when the message being transmitted no longer holds the device,
+   * i.e., when the Perturbation has sent its last pulse or the MAC has
+   * given it up
+   */
+  void NotifyTransmissionComplete (void);
+
+  /**
+   * Set the MAC protocol; without one, messages are transmitted at once
+   */
+  void SetP1906Mac (Ptr<P1906Mac> mac);
+  Ptr<P1906Mac> GetP1906Mac (void);
+
+  /**
+   * Set the relay forwarding the received messages; without one, messages
+   * reach the neighbours of the sender only
+   */
+  void SetP1906Relay (Ptr<P1906Relay> relay);
+  Ptr<P1906Relay> GetP1906Relay (void);
+
+  /**
+   * Set the store paying for the transmitted messages; without one,
+   * energy is unlimited
+   */
+  void SetP1906EnergyStore (Ptr<P1906EnergyStore> store);
+  Ptr<P1906EnergyStore> GetP1906EnergyStore (void);
+
+  /**
+   * Put a message in the transmit queue, with the given link layer
+   * information; used by Send and by the relay to forward messages
+   *
+   * \return false if the message has been dropped
+   */
+  bool Enqueue (Ptr<Packet> packet, Mac48Address src, Mac48Address dest, uint16_t protocolNumber);
+
 private:
+  void StartTransmission (void);
+
+  struct QueueItem
+  {
+    Ptr<Packet> packet;
+    Time enqueued;
+  };
+
   Ptr<Node> m_node;
   uint32_t m_ifIndex;
+  uint16_t m_mtu;
+  Mac48Address m_address;
 
   /**
    * The P1906 communication interface
    */
   Ptr<P1906CommunicationInterface> m_p1906CommunicationInterface;
-
+  Ptr<P1906Mac> m_mac;
+  Ptr<P1906Relay> m_relay;
+  Ptr<P1906EnergyStore> m_energyStore;
+
+  std::deque<QueueItem> m_txQueue;
+  uint32_t m_txQueueSize;
+  bool m_txBusy;
+  EventId m_txEvent;
+  QueueStatistics m_stats;
+
+  NetDevice::ReceiveCallback m_rxCallback;
+  NetDevice::PromiscReceiveCallback m_promiscRxCallback;
+
+  TracedCallback<Ptr<const Packet> > m_macTxTrace;
+  TracedCallback<Ptr<const Packet> > m_macTxDropTrace;
+  TracedCallback<Ptr<const Packet> > m_macRxTrace;
 
 
 public:
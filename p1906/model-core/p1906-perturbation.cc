@@ -64,4 +64,18 @@ P1906Perturbation::CreateMessageCarrier (Ptr<Packet> p)
   return carrier;
 }
 
+double
+P1906Perturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  return 0.;
+}
+
+Time
+P1906Perturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  return Seconds (0);
+}
+
 } // namespace ns3
@@ -60,6 +60,19 @@ public:
 
   virtual Ptr<P1906MessageCarrier> CreateMessageCarrier (Ptr<Packet> p);
 
+  /**
+   * \param p the message to be transmitted
+   * \return the energy [J] spent by the Perturbation to transmit the message
+   */
+  virtual double ComputeMessageEnergy (Ptr<Packet> p);
+
+  /**
+   * \param p the message to be transmitted
+   * \return the time the Perturbation needs to transmit the message, i.e.,
+   * the earliest time after which the next message can be transmitted
+   */
+  virtual Time ComputeTransmissionTime (Ptr<Packet> p);
+
 private:
 };
 
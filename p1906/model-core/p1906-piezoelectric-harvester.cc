@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "p1906-piezoelectric-harvester.h"
+#include <cmath>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906PiezoelectricHarvester");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906PiezoelectricHarvester);
+
+TypeId P1906PiezoelectricHarvester::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906PiezoelectricHarvester")
+    .SetParent<P1906EnergyHarvester> ()
+    .AddConstructor<P1906PiezoelectricHarvester> ()
+    .AddAttribute ("CyclePeriod",
+                   "The period of the vibration driving the nanogenerator",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&P1906PiezoelectricHarvester::m_cyclePeriod),
+                   MakeTimeChecker ())
+    .AddAttribute ("EnergyPerCycle",
+                   "The energy harvested in one cycle of the vibration [J]",
+                   DoubleValue (1e-12),
+                   MakeDoubleAccessor (&P1906PiezoelectricHarvester::m_energyPerCycle),
+                   MakeDoubleChecker<double> (0.0));
+  return tid;
+}
+
+P1906PiezoelectricHarvester::P1906PiezoelectricHarvester ()
+{
+  NS_LOG_FUNCTION (this);
+  m_cyclePeriod = Seconds (1);
+  m_energyPerCycle = 1e-12;
+}
+
+P1906PiezoelectricHarvester::~P1906PiezoelectricHarvester ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+double
+P1906PiezoelectricHarvester::GetHarvestedEnergy (Time from, Time to)
+{
+  NS_LOG_FUNCTION (this << from << to);
+  // the cycles ending in (from, to]
+  int64_t period = m_cyclePeriod.GetTimeStep ();
+  int64_t cycles = to.GetTimeStep () / period - from.GetTimeStep () / period;
+  return cycles * m_energyPerCycle;
+}
+
+Time
+P1906PiezoelectricHarvester::GetHarvestingTime (Time from, double joules)
+{
+  NS_LOG_FUNCTION (this << from << joules);
+  if (joules <= 0)
+    {
+      return Seconds (0);
+    }
+  if (m_energyPerCycle <= 0)
+    {
+      return Time::Max ();
+    }
+  int64_t period = m_cyclePeriod.GetTimeStep ();
+  int64_t cycles = (int64_t) std::ceil (joules / m_energyPerCycle);
+  int64_t end = (from.GetTimeStep () / period + cycles) * period;
+  return TimeStep (end - from.GetTimeStep ());
+}
+
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_PIEZOELECTRIC_HARVESTER
+#define P1906_PIEZOELECTRIC_HARVESTER
+
+#include "ns3/nstime.h"
+#include "p1906-energy-harvester.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906PiezoelectricHarvester
+ *
+ * \brief This class models a piezoelectric nanogenerator driven by a
+ * periodic vibration, e.g., the heart beat or the air flow of breathing.
+ * Every cycle of the vibration delivers EnergyPerCycle to the store, at
+ * the end of the cycle; cycles end at the multiples of CyclePeriod.
+ */
+
+class P1906PiezoelectricHarvester : public P1906EnergyHarvester
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906PiezoelectricHarvester ();
+  virtual ~P1906PiezoelectricHarvester ();
+
+  virtual double GetHarvestedEnergy (Time from, Time to);
+  virtual Time GetHarvestingTime (Time from, double joules);
+
+private:
+  Time m_cyclePeriod;
+  double m_energyPerCycle;
+};
+
+}
+
+#endif /* P1906_PIEZOELECTRIC_HARVESTER */
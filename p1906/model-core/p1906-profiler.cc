@@ -0,0 +1,310 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "p1906-profiler.h"
+
+#include <iostream>
+#include <mutex>
+#include <set>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906Profiler");
+
+namespace {
+
+const char *g_probeNames[P1906Profiler::NUM_PROBES] = {
+  "HandleTransmission",
+  "ComputePropagationDelay",
+  "CalculateReceivedMessageCarrier",
+  "CheckRxCompatibility",
+  "BrownianStep",
+  "TubeQuery",
+  "SurfaceCheck"
+};
+
+/*
+ * The counters of a thread: only the owning thread writes them,
+ * the summary reads them from another thread
+ */
+struct ProfilerCounters
+{
+  std::atomic<uint64_t> calls[P1906Profiler::NUM_PROBES];
+  std::atomic<uint64_t> ticks[P1906Profiler::NUM_PROBES];
+};
+
+/*
+ * The live threads and the counters merged from the threads which exited
+ */
+struct ProfilerRegistry
+{
+  std::mutex lock;
+  std::set<ProfilerCounters *> threads;
+  uint64_t calls[P1906Profiler::NUM_PROBES];
+  uint64_t ticks[P1906Profiler::NUM_PROBES];
+  bool scheduled;
+  std::string format;
+  uint64_t startTicks;
+  std::chrono::steady_clock::time_point startTime;
+};
+
+// never destroyed, since threads may exit after the static objects are destroyed
+ProfilerRegistry &
+GetRegistry (void)
+{
+  static ProfilerRegistry *registry = new ProfilerRegistry ();
+  return *registry;
+}
+
+struct ThreadCounters
+{
+  ProfilerCounters c;
+
+  ThreadCounters ()
+  {
+    for (int i = 0; i < P1906Profiler::NUM_PROBES; i++)
+      {
+        c.calls[i].store (0, std::memory_order_relaxed);
+        c.ticks[i].store (0, std::memory_order_relaxed);
+      }
+    ProfilerRegistry &r = GetRegistry ();
+    std::lock_guard<std::mutex> guard (r.lock);
+    r.threads.insert (&c);
+  }
+
+  ~ThreadCounters ()
+  {
+    ProfilerRegistry &r = GetRegistry ();
+    std::lock_guard<std::mutex> guard (r.lock);
+    for (int i = 0; i < P1906Profiler::NUM_PROBES; i++)
+      {
+        r.calls[i] += c.calls[i].load (std::memory_order_relaxed);
+        r.ticks[i] += c.ticks[i].load (std::memory_order_relaxed);
+      }
+    r.threads.erase (&c);
+  }
+};
+
+thread_local ThreadCounters t_counters;
+
+// the merged counters of all the threads, the caller holds the registry lock
+void
+Merge (ProfilerRegistry &r, uint64_t *calls, uint64_t *ticks)
+{
+  for (int i = 0; i < P1906Profiler::NUM_PROBES; i++)
+    {
+      calls[i] = r.calls[i];
+      ticks[i] = r.ticks[i];
+    }
+  std::set<ProfilerCounters *>::iterator it;
+  for (it = r.threads.begin (); it != r.threads.end (); it++)
+    {
+      for (int i = 0; i < P1906Profiler::NUM_PROBES; i++)
+        {
+          calls[i] += (*it)->calls[i].load (std::memory_order_relaxed);
+          ticks[i] += (*it)->ticks[i].load (std::memory_order_relaxed);
+        }
+    }
+}
+
+} // anonymous namespace
+
+std::atomic<bool> P1906Profiler::m_enabled (false);
+
+void
+P1906Profiler::Enable (std::string format)
+{
+  NS_LOG_FUNCTION (format);
+  ProfilerRegistry &r = GetRegistry ();
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    r.format = format;
+    if (!m_enabled.load ())
+      {
+        r.startTicks = Ticks ();
+        r.startTime = std::chrono::steady_clock::now ();
+      }
+    if (!r.scheduled)
+      {
+        r.scheduled = true;
+        Simulator::ScheduleDestroy (&P1906Profiler::PrintSummary);
+      }
+  }
+  m_enabled.store (true);
+}
+
+void
+P1906Profiler::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled.store (false);
+}
+
+void
+P1906Profiler::Add (Probe p, uint64_t ticks)
+{
+  ProfilerCounters &c = t_counters.c;
+  c.calls[p].store (c.calls[p].load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  c.ticks[p].store (c.ticks[p].load (std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+}
+
+uint64_t
+P1906Profiler::GetCalls (Probe p)
+{
+  ProfilerRegistry &r = GetRegistry ();
+  uint64_t calls[NUM_PROBES], ticks[NUM_PROBES];
+  std::lock_guard<std::mutex> guard (r.lock);
+  Merge (r, calls, ticks);
+  return calls[p];
+}
+
+double
+P1906Profiler::GetSeconds (Probe p)
+{
+  ProfilerRegistry &r = GetRegistry ();
+  uint64_t calls[NUM_PROBES], ticks[NUM_PROBES];
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    Merge (r, calls, ticks);
+  }
+  return ticks[p] / TicksPerSecond ();
+}
+
+std::string
+P1906Profiler::GetName (Probe p)
+{
+  return g_probeNames[p];
+}
+
+void
+P1906Profiler::Reset (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  ProfilerRegistry &r = GetRegistry ();
+  std::lock_guard<std::mutex> guard (r.lock);
+  for (int i = 0; i < NUM_PROBES; i++)
+    {
+      r.calls[i] = 0;
+      r.ticks[i] = 0;
+    }
+  std::set<ProfilerCounters *>::iterator it;
+  for (it = r.threads.begin (); it != r.threads.end (); it++)
+    {
+      for (int i = 0; i < NUM_PROBES; i++)
+        {
+          (*it)->calls[i].store (0, std::memory_order_relaxed);
+          (*it)->ticks[i].store (0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * The time stamp counter rate, measured against the steady clock since Enable
+ */
+double
+P1906Profiler::TicksPerSecond (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  ProfilerRegistry &r = GetRegistry ();
+  double elapsed = std::chrono::duration<double> (std::chrono::steady_clock::now () - r.startTime).count ();
+  while (elapsed < 0.01)
+    {
+      elapsed = std::chrono::duration<double> (std::chrono::steady_clock::now () - r.startTime).count ();
+    }
+  return (Ticks () - r.startTicks) / elapsed;
+#else
+  return 1e9;
+#endif
+}
+
+void
+P1906Profiler::Print (std::ostream &os)
+{
+  ProfilerRegistry &r = GetRegistry ();
+  uint64_t calls[NUM_PROBES], ticks[NUM_PROBES];
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    Merge (r, calls, ticks);
+  }
+  double tps = TicksPerSecond ();
+  os << "[probe,calls,seconds,meanNs] (inclusive)" << std::endl;
+  for (int i = 0; i < NUM_PROBES; i++)
+    {
+      double seconds = ticks[i] / tps;
+      os << "[probe,calls,seconds,meanNs] " << g_probeNames[i] << " " << calls[i] << " " << seconds << " "
+         << (calls[i] > 0 ? seconds * 1e9 / calls[i] : 0.) << std::endl;
+    }
+}
+
+void
+P1906Profiler::PrintJson (std::ostream &os)
+{
+  ProfilerRegistry &r = GetRegistry ();
+  uint64_t calls[NUM_PROBES], ticks[NUM_PROBES];
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    Merge (r, calls, ticks);
+  }
+  double tps = TicksPerSecond ();
+  os << "{\"probes\":[";
+  for (int i = 0; i < NUM_PROBES; i++)
+    {
+      double seconds = ticks[i] / tps;
+      os << (i > 0 ? "," : "") << "{\"probe\":\"" << g_probeNames[i] << "\",\"calls\":" << calls[i]
+         << ",\"seconds\":" << seconds << ",\"mean_ns\":" << (calls[i] > 0 ? seconds * 1e9 / calls[i] : 0.) << "}";
+    }
+  os << "]}" << std::endl;
+}
+
+void
+P1906Profiler::PrintSummary (void)
+{
+  ProfilerRegistry &r = GetRegistry ();
+  std::string format;
+  {
+    std::lock_guard<std::mutex> guard (r.lock);
+    r.scheduled = false;
+    format = r.format;
+  }
+  if (format == "json")
+    {
+      PrintJson (std::cout);
+    }
+  else
+    {
+      Print (std::cout);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#ifndef P1906_PROFILER
+#define P1906_PROFILER
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906Profiler
+ *
+ * \brief This class measures where the simulation time goes in the hot
+ * paths of the P1906 components. A probe accumulates the calls and the
+ * time stamp counter ticks of the scopes opened on it; each thread keeps
+ * its own counters, which are merged when the thread exits and when the
+ * summary is printed, so the hot path takes no lock. A disabled profiler
+ * costs one branch per scope.
+ *
+ * Once enabled, the summary is printed when Simulator::Destroy is called,
+ * as a table or as JSON. Probe times are inclusive: e.g., the Brownian
+ * steps of a motor journey are also part of ComputePropagationDelay.
+ */
+
+class P1906Profiler
+{
+public:
+  /**
+   * The instrumented hot paths
+   */
+  enum Probe
+  {
+    HANDLE_TRANSMISSION = 0,
+    COMPUTE_PROPAGATION_DELAY,
+    CALCULATE_RECEIVED_MESSAGE_CARRIER,
+    CHECK_RX_COMPATIBILITY,
+    BROWNIAN_STEP,
+    TUBE_QUERY,
+    SURFACE_CHECK,
+    NUM_PROBES
+  };
+
+  /**
+   * Start counting and print the summary at Simulator::Destroy
+   * \param format "table" or "json"
+   */
+  static void Enable (std::string format = "table");
+  static void Disable (void);
+  static bool IsEnabled (void)
+  {
+    return m_enabled.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * \return the time stamp counter, in ticks
+   */
+  static uint64_t Ticks (void)
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc ();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#endif
+  }
+
+  /**
+   * Account for one call of a probe lasting ticks, in the counters of the calling thread
+   */
+  static void Add (Probe p, uint64_t ticks);
+
+  /**
+   * \return the calls of a probe, over all the threads
+   */
+  static uint64_t GetCalls (Probe p);
+  /**
+   * \return the time spent in a probe [s], over all the threads
+   */
+  static double GetSeconds (Probe p);
+  static std::string GetName (Probe p);
+
+  static void Reset (void);
+  static void Print (std::ostream &os);
+  static void PrintJson (std::ostream &os);
+
+private:
+  static void PrintSummary (void);
+  static double TicksPerSecond (void);
+
+  static std::atomic<bool> m_enabled;
+};
+
+/**
+ * \brief Accounts for the lifetime of the scope to a probe of P1906Profiler
+ */
+class P1906ProfilerScope
+{
+public:
+  explicit P1906ProfilerScope (P1906Profiler::Probe p)
+    : m_probe (p),
+      m_start (P1906Profiler::IsEnabled () ? P1906Profiler::Ticks () : 0)
+  {
+  }
+  ~P1906ProfilerScope ()
+  {
+    if (m_start != 0)
+      {
+        P1906Profiler::Add (m_probe, P1906Profiler::Ticks () - m_start);
+      }
+  }
+
+private:
+  P1906Profiler::Probe m_probe;
+  uint64_t m_start;
+};
+
+}
+
+#endif /* P1906_PROFILER */
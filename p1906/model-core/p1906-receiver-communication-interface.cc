@@ -38,6 +38,10 @@
 #include "p1906-medium.h"
 #include "p1906-net-device.h"
 #include "p1906-motion.h"
+#include "p1906-energy-ledger.h"
+#include "p1906-specificity-collector.h"
+#include "p1906-profiler.h"
+#include "p1906-capture.h"
 
 
 namespace ns3 {
@@ -90,11 +94,21 @@ P1906ReceiverCommunicationInterface::HandleReception (Ptr<P1906CommunicationInte
    * received or not.
    */
 
-  bool isRxOk = GetP1906Specificity ()->CheckRxCompatibility (src, dst, message);
+  bool isRxOk;
+  {
+    P1906ProfilerScope scope (P1906Profiler::CHECK_RX_COMPATIBILITY);
+    isRxOk = GetP1906Specificity ()->CheckRxCompatibility (src, dst, message);
+  }
+  P1906SpecificityCollector::GetCollector ()->NotifyDecision (src, dst, GetP1906Specificity (), isRxOk);
+  if (P1906Capture::IsEnabled ())
+    {
+      P1906Capture::GetCapture ()->NotifyReception (src, dst, message, GetP1906Specificity (), isRxOk);
+    }
   if (isRxOk)
     {
 	  //elaborate the message carrier
 	  Ptr<Packet> p = message->GetMessage ();
+	  P1906EnergyLedger::GetLedger ()->NotifyDelivery (p->GetUid (), p->GetSize () * 8);
 	  GetP1906CommunicationInterface ()->HandleReception (p);
     }
   else
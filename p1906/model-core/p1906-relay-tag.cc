@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "p1906-relay-tag.h"
+
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (P1906RelayTag);
+
+TypeId
+P1906RelayTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906RelayTag")
+    .SetParent<Tag> ()
+    .AddConstructor<P1906RelayTag> ();
+  return tid;
+}
+
+TypeId
+P1906RelayTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+P1906RelayTag::P1906RelayTag ()
+  : m_origin (NO_NODE),
+    m_sequence (0),
+    m_ttl (0),
+    m_hops (0),
+    m_nextHop (NO_NODE),
+    m_destination (NO_NODE)
+{
+}
+
+uint32_t
+P1906RelayTag::GetSerializedSize (void) const
+{
+  return 4 + 4 + 2 + 2 + 4 + 4;
+}
+
+void
+P1906RelayTag::Serialize (TagBuffer i) const
+{
+  i.WriteU32 (m_origin);
+  i.WriteU32 (m_sequence);
+  i.WriteU16 (m_ttl);
+  i.WriteU16 (m_hops);
+  i.WriteU32 (m_nextHop);
+  i.WriteU32 (m_destination);
+}
+
+void
+P1906RelayTag::Deserialize (TagBuffer i)
+{
+  m_origin = i.ReadU32 ();
+  m_sequence = i.ReadU32 ();
+  m_ttl = i.ReadU16 ();
+  m_hops = i.ReadU16 ();
+  m_nextHop = i.ReadU32 ();
+  m_destination = i.ReadU32 ();
+}
+
+void
+P1906RelayTag::Print (std::ostream &os) const
+{
+  os << "[origin,sequence,ttl,hops,nextHop,destination] " << m_origin << " " << m_sequence << " "
+     << m_ttl << " " << m_hops << " " << m_nextHop << " " << m_destination;
+}
+
+void
+P1906RelayTag::SetOrigin (uint32_t node)
+{
+  m_origin = node;
+}
+
+uint32_t
+P1906RelayTag::GetOrigin (void) const
+{
+  return m_origin;
+}
+
+void
+P1906RelayTag::SetSequence (uint32_t s)
+{
+  m_sequence = s;
+}
+
+uint32_t
+P1906RelayTag::GetSequence (void) const
+{
+  return m_sequence;
+}
+
+void
+P1906RelayTag::SetTtl (uint16_t ttl)
+{
+  m_ttl = ttl;
+}
+
+uint16_t
+P1906RelayTag::GetTtl (void) const
+{
+  return m_ttl;
+}
+
+void
+P1906RelayTag::SetHops (uint16_t hops)
+{
+  m_hops = hops;
+}
+
+uint16_t
+P1906RelayTag::GetHops (void) const
+{
+  return m_hops;
+}
+
+void
+P1906RelayTag::SetNextHop (uint32_t node)
+{
+  m_nextHop = node;
+}
+
+uint32_t
+P1906RelayTag::GetNextHop (void) const
+{
+  return m_nextHop;
+}
+
+void
+P1906RelayTag::SetDestination (uint32_t node)
+{
+  m_destination = node;
+}
+
+uint32_t
+P1906RelayTag::GetDestination (void) const
+{
+  return m_destination;
+}
+
+uint64_t
+P1906RelayTag::GetMessageId (void) const
+{
+  return ((uint64_t) m_origin << 32) | m_sequence;
+}
+
+} // namespace ns3
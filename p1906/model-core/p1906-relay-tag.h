@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_RELAY_TAG
+#define P1906_RELAY_TAG
+
+#include "ns3/tag.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906RelayTag
+ *
+ * \brief The multi-hop information of a message relayed by a P1906Relay:
+ * the message id (the originating node and its sequence number), the
+ * remaining hops and, for geographic forwarding, the node chosen as the
+ * next relay and the destination node. Like the P1906NetDeviceTag, it
+ * travels as a packet tag, so the size of the message does not change.
+ */
+
+class P1906RelayTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+
+  /**
+   * Node id meaning any node
+   */
+  static const uint32_t NO_NODE = 0xffffffff;
+
+  P1906RelayTag ();
+
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+  void SetOrigin (uint32_t node);
+  uint32_t GetOrigin (void) const;
+  void SetSequence (uint32_t s);
+  uint32_t GetSequence (void) const;
+  void SetTtl (uint16_t ttl);
+  uint16_t GetTtl (void) const;
+  void SetHops (uint16_t hops);
+  uint16_t GetHops (void) const;
+  void SetNextHop (uint32_t node);
+  uint32_t GetNextHop (void) const;
+  void SetDestination (uint32_t node);
+  uint32_t GetDestination (void) const;
+
+  /**
+   * \return the message id, i.e., the origin and the sequence number
+   */
+  uint64_t GetMessageId (void) const;
+
+private:
+  uint32_t m_origin;
+  uint32_t m_sequence;
+  uint16_t m_ttl;
+  uint16_t m_hops;
+  uint32_t m_nextHop;
+  uint32_t m_destination;
+};
+
+}
+
+#endif /* P1906_RELAY_TAG */
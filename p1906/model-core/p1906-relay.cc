@@ -0,0 +1,429 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/mobility-model.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include "p1906-relay.h"
+#include "p1906-net-device.h"
+#include "p1906-communication-interface.h"
+#include "p1906-medium.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906Relay");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906Relay);
+
+TypeId P1906Relay::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906Relay")
+    .SetParent<Object> ()
+    .AddConstructor<P1906Relay> ()
+    .AddAttribute ("Mode",
+                   "How the received messages are forwarded",
+                   EnumValue (P1906Relay::PROBABILISTIC),
+                   MakeEnumAccessor (&P1906Relay::m_mode),
+                   MakeEnumChecker (P1906Relay::PROBABILISTIC, "Probabilistic",
+                                    P1906Relay::COUNTER, "Counter",
+                                    P1906Relay::GEOGRAPHIC, "Geographic"))
+    .AddAttribute ("ForwardProbability",
+                   "The probability of forwarding a message (Probabilistic mode)",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&P1906Relay::m_forwardProbability),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("CounterThreshold",
+                   "The copies heard that cancel the forwarding of a message (Counter mode)",
+                   UintegerValue (3),
+                   MakeUintegerAccessor (&P1906Relay::m_counterThreshold),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxAssessmentDelay",
+                   "The largest random delay before forwarding a message (Counter mode)",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&P1906Relay::m_maxAssessmentDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("RelayRange",
+                   "The range within which the next relay is chosen (Geographic mode) [m]",
+                   DoubleValue (1e-3),
+                   MakeDoubleAccessor (&P1906Relay::m_relayRange),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("Ttl",
+                   "The largest number of hops of a message",
+                   UintegerValue (0xffff),
+                   MakeUintegerAccessor (&P1906Relay::m_ttl),
+                   MakeUintegerChecker<uint16_t> (1))
+    .AddAttribute ("DuplicateWindow",
+                   "The sequence numbers of each origin kept for the duplicate suppression (a multiple of 64)",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&P1906Relay::m_window),
+                   MakeUintegerChecker<uint32_t> (64));
+  return tid;
+}
+
+P1906Relay::P1906Relay ()
+{
+  NS_LOG_FUNCTION (this);
+  m_dev = 0;
+  m_mode = PROBABILISTIC;
+  m_forwardProbability = 1.0;
+  m_counterThreshold = 3;
+  m_maxAssessmentDelay = MilliSeconds (10);
+  m_relayRange = 1e-3;
+  m_ttl = 0xffff;
+  m_window = 256;
+  m_nextSequence = 0;
+  m_random = CreateObject<UniformRandomVariable> ();
+  ResetRelayStatistics ();
+}
+
+P1906Relay::~P1906Relay ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906Relay::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::map<uint64_t, PendingForward>::iterator it;
+  for (it = m_pending.begin (); it != m_pending.end (); it++)
+    {
+      it->second.event.Cancel ();
+    }
+  m_pending.clear ();
+  m_received.clear ();
+  m_random = 0;
+  m_dev = 0;
+  Object::DoDispose ();
+}
+
+void
+P1906Relay::SetP1906NetDevice (Ptr<P1906NetDevice> d)
+{
+  NS_LOG_FUNCTION (this << d);
+  m_dev = d;
+}
+
+Ptr<P1906NetDevice>
+P1906Relay::GetP1906NetDevice (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_dev;
+}
+
+int64_t
+P1906Relay::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_random->SetStream (stream);
+  return 1;
+}
+
+uint32_t
+P1906Relay::GetNodeId (void)
+{
+  return m_dev->GetNode ()->GetId ();
+}
+
+void
+P1906Relay::HandleSend (Ptr<Packet> p, Mac48Address dest)
+{
+  NS_LOG_FUNCTION (this << p << dest);
+  P1906RelayTag tag;
+  tag.SetOrigin (GetNodeId ());
+  tag.SetSequence (m_nextSequence++);
+  tag.SetTtl (m_ttl);
+  tag.SetHops (0);
+  if (m_mode == GEOGRAPHIC && !dest.IsGroup ())
+    {
+      tag.SetDestination (FindNode (dest));
+      if (tag.GetDestination () != P1906RelayTag::NO_NODE)
+        {
+          tag.SetNextHop (ChooseNextHop (tag.GetDestination ()));
+        }
+    }
+  // the copies echoed back by the neighbours are duplicates
+  CheckDuplicate (tag.GetOrigin (), tag.GetSequence ());
+  p->AddPacketTag (tag);
+  m_stats.originated++;
+}
+
+bool
+P1906Relay::HandleReception (Ptr<Packet> p, Mac48Address from, Mac48Address to, uint16_t protocol)
+{
+  NS_LOG_FUNCTION (this << p << from << to << protocol);
+  P1906RelayTag tag;
+  if (!p->RemovePacketTag (tag))
+    {
+      // not sent through a relay
+      return true;
+    }
+  m_stats.received++;
+
+  if (CheckDuplicate (tag.GetOrigin (), tag.GetSequence ()))
+    {
+      m_stats.duplicates++;
+      std::map<uint64_t, PendingForward>::iterator it = m_pending.find (tag.GetMessageId ());
+      if (it != m_pending.end ())
+        {
+          it->second.copies++;
+        }
+      return false;
+    }
+
+  if (to == Mac48Address::ConvertFrom (m_dev->GetAddress ()))
+    {
+      // arrived
+      return true;
+    }
+  if (tag.GetTtl () <= 1)
+    {
+      m_stats.expired++;
+      return true;
+    }
+  tag.SetTtl (tag.GetTtl () - 1);
+  tag.SetHops (tag.GetHops () + 1);
+
+  switch (m_mode)
+    {
+    case PROBABILISTIC:
+      if (m_random->GetValue () < m_forwardProbability)
+        {
+          Forward (p, tag, from, to, protocol);
+        }
+      else
+        {
+          m_stats.suppressed++;
+        }
+      break;
+    case COUNTER:
+      {
+        PendingForward &f = m_pending[tag.GetMessageId ()];
+        f.packet = p;
+        f.tag = tag;
+        f.from = from;
+        f.to = to;
+        f.protocol = protocol;
+        f.copies = 1;
+        f.event = Simulator::Schedule (m_maxAssessmentDelay * m_random->GetValue (),
+                                       &P1906Relay::AssessmentExpired, this, tag.GetMessageId ());
+      }
+      break;
+    case GEOGRAPHIC:
+      if (tag.GetNextHop () == GetNodeId ())
+        {
+          uint32_t next = ChooseNextHop (tag.GetDestination ());
+          if (next == P1906RelayTag::NO_NODE)
+            {
+              m_stats.noProgress++;
+              break;
+            }
+          tag.SetNextHop (next);
+          Forward (p, tag, from, to, protocol);
+        }
+      break;
+    }
+  return true;
+}
+
+void
+P1906Relay::AssessmentExpired (uint64_t id)
+{
+  NS_LOG_FUNCTION (this << id);
+  std::map<uint64_t, PendingForward>::iterator it = m_pending.find (id);
+  if (it == m_pending.end ())
+    {
+      return;
+    }
+  PendingForward f = it->second;
+  m_pending.erase (it);
+  if (f.copies < m_counterThreshold)
+    {
+      Forward (f.packet, f.tag, f.from, f.to, f.protocol);
+    }
+  else
+    {
+      m_stats.suppressed++;
+    }
+}
+
+void
+P1906Relay::Forward (Ptr<Packet> p, P1906RelayTag tag, Mac48Address from, Mac48Address to, uint16_t protocol)
+{
+  NS_LOG_FUNCTION (this << p << tag.GetMessageId () << tag.GetHops ());
+  Ptr<Packet> copy = p->Copy ();
+  copy->AddPacketTag (tag);
+  if (m_dev->Enqueue (copy, from, to, protocol))
+    {
+      m_stats.forwarded++;
+    }
+}
+
+bool
+P1906Relay::CheckDuplicate (uint32_t origin, uint32_t sequence)
+{
+  uint32_t words = (m_window + 63) / 64;
+  uint32_t window = words * 64;
+  std::map<uint32_t, DuplicateWindow>::iterator it = m_received.find (origin);
+  if (it == m_received.end ())
+    {
+      DuplicateWindow w;
+      w.top = sequence;
+      w.bits.assign (words, 0);
+      it = m_received.insert (std::make_pair (origin, w)).first;
+    }
+  else if (sequence > it->second.top)
+    {
+      // slide the window, forgetting the sequence numbers falling out of it
+      DuplicateWindow &w = it->second;
+      if (sequence - w.top >= window)
+        {
+          w.bits.assign (words, 0);
+        }
+      else
+        {
+          for (uint32_t s = w.top + 1; s != sequence + 1; s++)
+            {
+              w.bits[(s % window) / 64] &= ~(1ULL << (s % 64));
+            }
+        }
+      w.top = sequence;
+    }
+  else if (it->second.top - sequence >= window)
+    {
+      // too old to tell: taken as a duplicate
+      return true;
+    }
+
+  uint64_t &word = it->second.bits[(sequence % window) / 64];
+  uint64_t mask = 1ULL << (sequence % 64);
+  if (word & mask)
+    {
+      return true;
+    }
+  word |= mask;
+  return false;
+}
+
+uint32_t
+P1906Relay::FindNode (Mac48Address address)
+{
+  NS_LOG_FUNCTION (this << address);
+  P1906Medium::P1906CommunicationInterfaces *interfaces =
+    m_dev->GetP1906CommunicationInterface ()->GetP1906Medium ()->GetP1906CommunicationInterfaces ();
+  for (uint32_t i = 0; i < interfaces->size (); i++)
+    {
+      Ptr<P1906NetDevice> d = (*interfaces)[i]->GetP1906NetDevice ();
+      if (Mac48Address::ConvertFrom (d->GetAddress ()) == address)
+        {
+          return d->GetNode ()->GetId ();
+        }
+    }
+  return P1906RelayTag::NO_NODE;
+}
+
+uint32_t
+P1906Relay::ChooseNextHop (uint32_t destination)
+{
+  NS_LOG_FUNCTION (this << destination);
+  Ptr<MobilityModel> dstMobility = NodeList::GetNode (destination)->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> mobility = m_dev->GetNode ()->GetObject<MobilityModel> ();
+  if (dstMobility == 0 || mobility == 0)
+    {
+      return P1906RelayTag::NO_NODE;
+    }
+  Vector target = dstMobility->GetPosition ();
+  Vector position = mobility->GetPosition ();
+
+  P1906Medium::P1906CommunicationInterfaces neighbours;
+  m_dev->GetP1906CommunicationInterface ()->GetP1906Medium ()->
+    GetCommunicationInterfacesInRange (position, m_relayRange, neighbours);
+
+  uint32_t self = GetNodeId ();
+  uint32_t best = P1906RelayTag::NO_NODE;
+  double bestDistance = CalculateDistance (position, target);
+  for (uint32_t i = 0; i < neighbours.size (); i++)
+    {
+      Ptr<Node> node = neighbours[i]->GetP1906NetDevice ()->GetNode ();
+      if (node->GetId () == self)
+        {
+          continue;
+        }
+      double d = CalculateDistance (node->GetObject<MobilityModel> ()->GetPosition (), target);
+      if (d < bestDistance)
+        {
+          bestDistance = d;
+          best = node->GetId ();
+        }
+    }
+  return best;
+}
+
+P1906Relay::RelayStatistics
+P1906Relay::GetRelayStatistics (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_stats;
+}
+
+void
+P1906Relay::ResetRelayStatistics (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stats.originated = 0;
+  m_stats.received = 0;
+  m_stats.duplicates = 0;
+  m_stats.forwarded = 0;
+  m_stats.suppressed = 0;
+  m_stats.expired = 0;
+  m_stats.noProgress = 0;
+}
+
+uint64_t
+P1906Relay::GetDuplicateMemory (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t bytes = 0;
+  std::map<uint32_t, DuplicateWindow>::const_iterator it;
+  for (it = m_received.begin (); it != m_received.end (); it++)
+    {
+      bytes += sizeof (it->second) + it->second.bits.size () * sizeof (uint64_t);
+    }
+  return bytes;
+}
+
+} // namespace ns3
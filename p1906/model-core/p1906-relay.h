@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_RELAY
+#define P1906_RELAY
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/event-id.h"
+#include "ns3/mac48-address.h"
+#include "p1906-relay-tag.h"
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+class Packet;
+class P1906NetDevice;
+class UniformRandomVariable;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906Relay
+ *
+ * \brief This class forwards the messages received by a P1906NetDevice
+ * towards nodes out of the range of the sender. Every message sent by the
+ * device gets a message id (the node id and a sequence number, see
+ * P1906RelayTag); the first copy of a message is passed to the upper
+ * layers and possibly forwarded, the following copies are discarded.
+ *
+ * Three forwarding modes are available:
+ * - PROBABILISTIC: the message is forwarded with probability ForwardProbability
+ *   (1 gives blind flooding);
+ * - COUNTER: the message is forwarded after a random assessment delay unless
+ *   CounterThreshold copies have been heard meanwhile;
+ * - GEOGRAPHIC: only the node named by the sender forwards the message, to
+ *   the neighbour within RelayRange closest to the destination, found with
+ *   the spatial index of the medium (see P1906Medium::GetCommunicationInterfacesInRange);
+ *   broadcast messages are not forwarded in this mode.
+ *
+ * Duplicates are detected with a bitmap of the last DuplicateWindow sequence
+ * numbers of each origin, so the memory of a node depends on the number of
+ * origins, not on the number of messages relayed; messages older than the
+ * window are taken as duplicates.
+ */
+
+class P1906Relay : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906Relay ();
+  virtual ~P1906Relay ();
+
+  virtual void DoDispose (void);
+
+  enum Mode
+  {
+    PROBABILISTIC = 0,
+    COUNTER,
+    GEOGRAPHIC
+  };
+
+  void SetP1906NetDevice (Ptr<P1906NetDevice> d);
+  Ptr<P1906NetDevice> GetP1906NetDevice (void);
+
+  /**
+   * Called by the device for every message it originates
+   *
+   * \param p the message, tagged here with a new message id
+   * \param dest the link layer destination
+   */
+  void HandleSend (Ptr<Packet> p, Mac48Address dest);
+
+  /**
+   * Called by the device for every message received
+   *
+   * \param p the message, without its P1906NetDeviceTag
+   * \param from the link layer source
+   * \param to the link layer destination
+   * \param protocol the protocol number
+   * \return false if the message is a duplicate, i.e., it must not be passed to the upper layers
+   */
+  bool HandleReception (Ptr<Packet> p, Mac48Address from, Mac48Address to, uint16_t protocol);
+
+  /**
+   * The statistics of the relay
+   */
+  struct RelayStatistics
+  {
+    uint64_t originated;     //!< messages tagged by HandleSend
+    uint64_t received;       //!< relayed messages received, duplicates included
+    uint64_t duplicates;
+    uint64_t forwarded;
+    uint64_t suppressed;     //!< messages not forwarded by the probability or by the counter
+    uint64_t expired;        //!< messages not forwarded because their TTL is over
+    uint64_t noProgress;     //!< geographic messages with no neighbour closer to the destination
+  };
+
+  RelayStatistics GetRelayStatistics (void) const;
+  void ResetRelayStatistics (void);
+
+  /**
+   * \return the bytes held by the duplicate-suppression bitmaps
+   */
+  uint64_t GetDuplicateMemory (void) const;
+
+  /**
+   * Assign a fixed random variable stream number to the forwarding decisions
+   *
+   * \return the number of streams used
+   */
+  int64_t AssignStreams (int64_t stream);
+
+private:
+  /**
+   * The sequence numbers received from one origin, within (top - window, top]
+   */
+  struct DuplicateWindow
+  {
+    uint32_t top;
+    std::vector<uint64_t> bits;
+  };
+
+  struct PendingForward
+  {
+    Ptr<Packet> packet;
+    P1906RelayTag tag;
+    Mac48Address from;
+    Mac48Address to;
+    uint16_t protocol;
+    uint32_t copies;
+    EventId event;
+  };
+
+  /**
+   * \return true if the message has been received before; otherwise mark it as received
+   */
+  bool CheckDuplicate (uint32_t origin, uint32_t sequence);
+  void Forward (Ptr<Packet> p, P1906RelayTag tag, Mac48Address from, Mac48Address to, uint16_t protocol);
+  void AssessmentExpired (uint64_t id);
+  /**
+   * \return the neighbour closest to the destination, or P1906RelayTag::NO_NODE
+   * if no neighbour is closer than this node
+   */
+  uint32_t ChooseNextHop (uint32_t destination);
+  uint32_t FindNode (Mac48Address address);
+  uint32_t GetNodeId (void);
+
+  Ptr<P1906NetDevice> m_dev;
+  Mode m_mode;
+  double m_forwardProbability;
+  uint32_t m_counterThreshold;
+  Time m_maxAssessmentDelay;
+  double m_relayRange;
+  uint16_t m_ttl;
+  uint32_t m_window;
+
+  uint32_t m_nextSequence;
+  std::map<uint32_t, DuplicateWindow> m_received;
+  std::map<uint64_t, PendingForward> m_pending;
+  Ptr<UniformRandomVariable> m_random;
+  RelayStatistics m_stats;
+};
+
+}
+
+#endif /* P1906_RELAY */
@@ -0,0 +1,425 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+#include "ns3/log.h"
+#include "p1906-specificity-collector.h"
+#include "p1906-specificity.h"
+#include "p1906-communication-interface.h"
+#include "p1906-net-device.h"
+#include "ns3/node.h"
+#include <cmath>
+#include <cstring>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906SpecificityCollector");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906SpecificityCollector);
+
+const double P1906SpecificityCollector::BIN_WIDTH = 0.5;
+
+TypeId P1906SpecificityCollector::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906SpecificityCollector")
+    .SetParent<Object> ()
+    .AddConstructor<P1906SpecificityCollector> ();
+  return tid;
+}
+
+P1906SpecificityCollector::P1906SpecificityCollector ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906SpecificityCollector::~P1906SpecificityCollector ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ptr<P1906SpecificityCollector>
+P1906SpecificityCollector::GetCollector (void)
+{
+  static Ptr<P1906SpecificityCollector> collector = CreateObject<P1906SpecificityCollector> ();
+  return collector;
+}
+
+void
+P1906SpecificityCollector::NotifyDecision (Ptr<P1906CommunicationInterface> src,
+                                           Ptr<P1906CommunicationInterface> dst,
+                                           Ptr<P1906Specificity> specificity,
+                                           bool accepted)
+{
+  NS_LOG_FUNCTION (this << accepted);
+  NotifyDecision (src->GetP1906NetDevice ()->GetNode ()->GetId (),
+                  dst->GetP1906NetDevice ()->GetNode ()->GetId (),
+                  accepted,
+                  specificity->HasDecisionMargin (),
+                  specificity->GetDecisionMargin (),
+                  specificity->GetMarginScale ());
+}
+
+void
+P1906SpecificityCollector::NotifyDecision (uint32_t src, uint32_t dst, bool accepted, bool hasMargin, double margin,
+                                           double scale)
+{
+  // called once per message carrier and receiver: counter increments only
+  if (dst >= m_receivers.size ())
+    {
+      ReceiverRecord empty;
+      memset (&empty, 0, sizeof (empty));
+      m_receivers.resize (dst + 1, empty);
+    }
+  ReceiverRecord &r = m_receivers[dst];
+
+  std::map<uint32_t, uint32_t>::const_iterator it = m_targets.find (src);
+  bool intended = (it == m_targets.end () || it->second == dst);
+
+  if (intended && accepted)
+    {
+      r.tp++;
+    }
+  else if (intended)
+    {
+      r.fn++;
+    }
+  else if (accepted)
+    {
+      r.fp++;
+    }
+  else
+    {
+      r.tn++;
+    }
+
+  if (!hasMargin || !std::isfinite (margin))
+    {
+      return;
+    }
+
+  r.scale = scale;
+  uint32_t bin = GetBin (margin, scale);
+  if (intended)
+    {
+      r.intendedHistogram[bin]++;
+      if (accepted)
+        {
+          r.acceptedMargin += margin;
+          r.acceptedMarginCount++;
+        }
+    }
+  else
+    {
+      r.unintendedHistogram[bin]++;
+    }
+}
+
+void
+P1906SpecificityCollector::SetIntendedTarget (uint32_t src, uint32_t dst)
+{
+  NS_LOG_FUNCTION (this << src << dst);
+  m_targets[src] = dst;
+}
+
+void
+P1906SpecificityCollector::ClearIntendedTargets (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_targets.clear ();
+}
+
+uint32_t
+P1906SpecificityCollector::GetBin (double margin, double scale) const
+{
+  double s;
+  if (scale > 0)
+    {
+      s = margin / scale;
+    }
+  else
+    {
+      s = (margin < 0 ? -1. : 1.) * std::log10 (1. + std::fabs (margin));
+    }
+  double b = std::floor (s / BIN_WIDTH) + NUM_BINS / 2;
+  if (b < 0)
+    {
+      return 0;
+    }
+  if (b >= NUM_BINS)
+    {
+      return NUM_BINS - 1;
+    }
+  return (uint32_t) b;
+}
+
+double
+P1906SpecificityCollector::GetBinLowerEdge (uint32_t node, uint32_t bin) const
+{
+  NS_LOG_FUNCTION (this << node << bin);
+  double s = ((double) bin - NUM_BINS / 2) * BIN_WIDTH;
+  double scale = GetRecord (node).scale;
+  if (scale > 0)
+    {
+      return s * scale;
+    }
+  return (s < 0 ? -1. : 1.) * (std::pow (10., std::fabs (s)) - 1.);
+}
+
+P1906SpecificityCollector::ReceiverRecord
+P1906SpecificityCollector::GetRecord (uint32_t node) const
+{
+  ReceiverRecord r;
+  memset (&r, 0, sizeof (r));
+  bool scaled = false;
+
+  for (uint32_t i = 0; i < m_receivers.size (); i++)
+    {
+      if (node != ALL_NODES && node != i)
+        {
+          continue;
+        }
+      const ReceiverRecord &n = m_receivers[i];
+      r.tp += n.tp;
+      r.fp += n.fp;
+      r.tn += n.tn;
+      r.fn += n.fn;
+      r.acceptedMargin += n.acceptedMargin;
+      r.acceptedMarginCount += n.acceptedMarginCount;
+      uint64_t margins = 0;
+      for (uint32_t b = 0; b < NUM_BINS; b++)
+        {
+          margins += n.intendedHistogram[b] + n.unintendedHistogram[b];
+        }
+      if (margins == 0)
+        {
+          continue;
+        }
+      if (!scaled)
+        {
+          r.scale = n.scale;
+          scaled = true;
+        }
+      else if (n.scale != r.scale)
+        {
+          // histograms on another scale cannot be added up
+          continue;
+        }
+      for (uint32_t b = 0; b < NUM_BINS; b++)
+        {
+          r.intendedHistogram[b] += n.intendedHistogram[b];
+          r.unintendedHistogram[b] += n.unintendedHistogram[b];
+        }
+    }
+  return r;
+}
+
+uint64_t
+P1906SpecificityCollector::GetTruePositives (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  return GetRecord (node).tp;
+}
+
+uint64_t
+P1906SpecificityCollector::GetFalsePositives (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  return GetRecord (node).fp;
+}
+
+uint64_t
+P1906SpecificityCollector::GetTrueNegatives (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  return GetRecord (node).tn;
+}
+
+uint64_t
+P1906SpecificityCollector::GetFalseNegatives (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  return GetRecord (node).fn;
+}
+
+double
+P1906SpecificityCollector::GetSpecificity (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  ReceiverRecord r = GetRecord (node);
+  if (r.tn + r.fp == 0)
+    {
+      return 1.;
+    }
+  return (double) r.tn / (r.tn + r.fp);
+}
+
+double
+P1906SpecificityCollector::GetSensitivity (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  ReceiverRecord r = GetRecord (node);
+  if (r.tp + r.fn == 0)
+    {
+      return 0.;
+    }
+  return (double) r.tp / (r.tp + r.fn);
+}
+
+double
+P1906SpecificityCollector::GetAffinity (uint32_t node) const
+{
+  NS_LOG_FUNCTION (this << node);
+  ReceiverRecord r = GetRecord (node);
+  if (r.acceptedMarginCount == 0)
+    {
+      return 0.;
+    }
+  return r.acceptedMargin / r.acceptedMarginCount;
+}
+
+void
+P1906SpecificityCollector::GetRocPoint (uint32_t node, uint32_t bin, double &tpr, double &fpr) const
+{
+  NS_LOG_FUNCTION (this << node << bin);
+  ReceiverRecord r = GetRecord (node);
+  uint64_t intended = 0, intendedAbove = 0;
+  uint64_t unintended = 0, unintendedAbove = 0;
+  for (uint32_t b = 0; b < NUM_BINS; b++)
+    {
+      intended += r.intendedHistogram[b];
+      unintended += r.unintendedHistogram[b];
+      if (b >= bin)
+        {
+          intendedAbove += r.intendedHistogram[b];
+          unintendedAbove += r.unintendedHistogram[b];
+        }
+    }
+  tpr = intended ? (double) intendedAbove / intended : 0.;
+  fpr = unintended ? (double) unintendedAbove / unintended : 0.;
+}
+
+uint64_t
+P1906SpecificityCollector::GetBinCount (uint32_t node, uint32_t bin, bool intended) const
+{
+  NS_LOG_FUNCTION (this << node << bin << intended);
+  if (bin >= NUM_BINS)
+    {
+      return 0;
+    }
+  ReceiverRecord r = GetRecord (node);
+  return intended ? r.intendedHistogram[bin] : r.unintendedHistogram[bin];
+}
+
+void
+P1906SpecificityCollector::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_receivers.clear ();
+}
+
+void
+P1906SpecificityCollector::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_receivers.size (); i++)
+    {
+      const ReceiverRecord &r = m_receivers[i];
+      if (r.tp + r.fp + r.tn + r.fn == 0)
+        {
+          continue;
+        }
+      os << "[node,tp,fp,tn,fn,specificity,sensitivity,affinity] " << i << " "
+         << r.tp << " " << r.fp << " " << r.tn << " " << r.fn << " "
+         << GetSpecificity (i) << " " << GetSensitivity (i) << " " << GetAffinity (i) << std::endl;
+    }
+}
+
+void
+P1906SpecificityCollector::SaveState (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t nReceivers = m_receivers.size ();
+  uint64_t nTargets = m_targets.size ();
+  os.write ((const char *) &nReceivers, sizeof (nReceivers));
+  if (nReceivers > 0)
+    {
+      os.write ((const char *) &m_receivers[0], nReceivers * sizeof (ReceiverRecord));
+    }
+  os.write ((const char *) &nTargets, sizeof (nTargets));
+  std::map<uint32_t, uint32_t>::const_iterator it;
+  for (it = m_targets.begin (); it != m_targets.end (); it++)
+    {
+      os.write ((const char *) &it->first, sizeof (it->first));
+      os.write ((const char *) &it->second, sizeof (it->second));
+    }
+}
+
+bool
+P1906SpecificityCollector::RestoreState (std::istream &is)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t nReceivers = 0;
+  uint64_t nTargets = 0;
+  Reset ();
+  ClearIntendedTargets ();
+  is.read ((char *) &nReceivers, sizeof (nReceivers));
+  if (!is)
+    {
+      return false;
+    }
+  // the records are read one at a time: a count from a truncated or foreign stream must not
+  // allocate more than the stream holds
+  for (uint64_t i = 0; i < nReceivers && is; i++)
+    {
+      ReceiverRecord r;
+      if (is.read ((char *) &r, sizeof (r)))
+        {
+          m_receivers.push_back (r);
+        }
+    }
+  is.read ((char *) &nTargets, sizeof (nTargets));
+  for (uint64_t i = 0; i < nTargets && is; i++)
+    {
+      uint32_t src;
+      uint32_t dst;
+      is.read ((char *) &src, sizeof (src));
+      is.read ((char *) &dst, sizeof (dst));
+      m_targets[src] = dst;
+    }
+  if (!is)
+    {
+      Reset ();
+      ClearIntendedTargets ();
+      return false;
+    }
+  return true;
+}
+
+} // namespace ns3
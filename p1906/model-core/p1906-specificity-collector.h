@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+#ifndef P1906_SPECIFICITY_COLLECTOR
+#define P1906_SPECIFICITY_COLLECTOR
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include <vector>
+#include <map>
+#include <ostream>
+#include <istream>
+
+namespace ns3 {
+
+class P1906CommunicationInterface;
+class P1906Specificity;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906SpecificityCollector
+ *
+ * \brief This class collects the decisions taken by the Specificity
+ * component of every receiver. For each receiver it keeps the
+ * true/false positive/negative counts and two fixed-size histograms
+ * of the decision margins (intended and unintended message carriers),
+ * so that Specificity, Sensitivity, Affinity and ROC points are
+ * computed incrementally during the simulation.
+ *
+ * A message carrier is intended for a receiver if no target has been
+ * set for its source node or if the receiver is the target of the source.
+ *
+ * The bin scale of a receiver is set by its Specificity model: margins
+ * are binned on the linear scale m / u, with u the margin scale of the
+ * model, or on the signed logarithmic scale sign(m) * log10(1 + |m|)
+ * when the model leaves u to zero. NUM_BINS bins of width BIN_WIDTH on
+ * that scale are centered on zero; out of range margins fall in the
+ * first/last bin. Aggregated statistics (ALL_NODES) add up the
+ * histograms of the receivers on the scale of the first one.
+ */
+
+class P1906SpecificityCollector : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906SpecificityCollector ();
+  virtual ~P1906SpecificityCollector ();
+
+  /**
+   * \return the collector shared by all the receivers of the simulation
+   */
+  static Ptr<P1906SpecificityCollector> GetCollector (void);
+
+  static const uint32_t NUM_BINS = 64;
+  static const double BIN_WIDTH;
+  /**
+   * Node identifier used to query the statistics aggregated over all the receivers
+   */
+  static const uint32_t ALL_NODES = 0xffffffff;
+
+  /**
+   * \param src the sender of the message carrier
+   * \param dst the receiver that took the decision
+   * \param specificity the specificity component that took the decision
+   * \param accepted the result of CheckRxCompatibility
+   */
+  void NotifyDecision (Ptr<P1906CommunicationInterface> src,
+                       Ptr<P1906CommunicationInterface> dst,
+                       Ptr<P1906Specificity> specificity,
+                       bool accepted);
+  void NotifyDecision (uint32_t src, uint32_t dst, bool accepted, bool hasMargin, double margin,
+                       double scale = 0.);
+
+  /**
+   * \param src the id of the sending node
+   * \param dst the id of the node the message carriers of src are intended for
+   */
+  void SetIntendedTarget (uint32_t src, uint32_t dst);
+  void ClearIntendedTargets (void);
+
+  uint64_t GetTruePositives (uint32_t node) const;
+  uint64_t GetFalsePositives (uint32_t node) const;
+  uint64_t GetTrueNegatives (uint32_t node) const;
+  uint64_t GetFalseNegatives (uint32_t node) const;
+
+  /**
+   * \return TN / (TN + FP), i.e., the fraction of unintended carriers rejected
+   */
+  double GetSpecificity (uint32_t node) const;
+  /**
+   * \return TP / (TP + FN), i.e., the fraction of intended carriers accepted
+   */
+  double GetSensitivity (uint32_t node) const;
+  /**
+   * \return the mean decision margin of the accepted intended carriers
+   */
+  double GetAffinity (uint32_t node) const;
+
+  /**
+   * \param node the receiver (or ALL_NODES)
+   * \param bin the histogram bin whose lower edge is used as decision threshold
+   * \param tpr the fraction of intended carriers with margin above the threshold
+   * \param fpr the fraction of unintended carriers with margin above the threshold
+   */
+  void GetRocPoint (uint32_t node, uint32_t bin, double &tpr, double &fpr) const;
+  /**
+   * \return the margin corresponding to the lower edge of a bin of a receiver (or ALL_NODES)
+   */
+  double GetBinLowerEdge (uint32_t node, uint32_t bin) const;
+  uint64_t GetBinCount (uint32_t node, uint32_t bin, bool intended) const;
+
+  void Reset (void);
+  void Print (std::ostream &os) const;
+
+  /**
+   * Write the decision counts, histograms and targets in binary form, e.g., into a checkpoint
+   */
+  void SaveState (std::ostream &os) const;
+  /**
+   * Replace the collected statistics with those written by SaveState
+   * \return false if the state cannot be read
+   */
+  bool RestoreState (std::istream &is);
+
+private:
+  struct ReceiverRecord
+  {
+    uint64_t tp;
+    uint64_t fp;
+    uint64_t tn;
+    uint64_t fn;
+    double acceptedMargin;
+    uint64_t acceptedMarginCount;
+    double scale;
+    uint64_t intendedHistogram[NUM_BINS];
+    uint64_t unintendedHistogram[NUM_BINS];
+  };
+
+  uint32_t GetBin (double margin, double scale) const;
+  ReceiverRecord GetRecord (uint32_t node) const;
+
+  std::vector<ReceiverRecord> m_receivers;
+  std::map<uint32_t, uint32_t> m_targets;
+};
+
+}
+
+#endif /* P1906_SPECIFICITY_COLLECTOR */
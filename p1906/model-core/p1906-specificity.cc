@@ -47,6 +47,9 @@ TypeId P1906Specificity::GetTypeId (void)
 P1906Specificity::P1906Specificity ()
 {
   NS_LOG_FUNCTION (this << "Created default Specificity Component");
+  m_decisionMargin = 0;
+  m_hasDecisionMargin = false;
+  m_marginScale = 0;
 }
 
 P1906Specificity::~P1906Specificity ()
@@ -61,6 +64,41 @@ P1906Specificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Pt
   return true;
 }
 
+void
+P1906Specificity::SetDecisionMargin (double margin)
+{
+  NS_LOG_FUNCTION (this << margin);
+  m_decisionMargin = margin;
+  m_hasDecisionMargin = true;
+}
+
+double
+P1906Specificity::GetDecisionMargin (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_decisionMargin;
+}
+
+bool
+P1906Specificity::HasDecisionMargin (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_hasDecisionMargin;
+}
+
+void
+P1906Specificity::SetMarginScale (double scale)
+{
+  NS_LOG_FUNCTION (this << scale);
+  m_marginScale = scale;
+}
+
+double
+P1906Specificity::GetMarginScale (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_marginScale;
+}
 
 void
 P1906Specificity::SetP1906CommunicationInterface (Ptr<P1906CommunicationInterface> i)
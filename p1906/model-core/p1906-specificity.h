@@ -58,11 +58,31 @@ public:
 
   virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message);
 
+  /**
+   * The decision margin of the last CheckRxCompatibility, e.g., the channel
+   * capacity minus the transmission rate. Positive margins lead to a successful
+   * reception. Components that do not compute a margin leave HasDecisionMargin false.
+   */
+  void SetDecisionMargin (double margin);
+  double GetDecisionMargin (void);
+  bool HasDecisionMargin (void);
+
+  /**
+   * The margin unit of the linear scale on which the decision margins are
+   * binned, chosen by the model for the range of its margins. With a zero
+   * unit (the default) margins are binned on a logarithmic scale.
+   */
+  void SetMarginScale (double scale);
+  double GetMarginScale (void);
+
   void SetP1906CommunicationInterface (Ptr<P1906CommunicationInterface> i);
   Ptr<P1906CommunicationInterface> GetP1906CommunicationInterface (void);
 
 private:
   Ptr<P1906CommunicationInterface> m_p1906CommunicationInterface;
+  double m_decisionMargin;
+  bool m_hasDecisionMargin;
+  double m_marginScale;
 };
 
 }
@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "p1906-task-pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906TaskPool");
+
+namespace {
+
+GlobalValue g_p1906Threads ("P1906Threads",
+                            "The number of threads of the P1906 parallel kernels, caller included (0: one per hardware thread)",
+                            UintegerValue (1),
+                            MakeUintegerChecker<uint32_t> ());
+
+/*
+ * A chunk of a kernel; pending counts the chunks of the kernel not yet done
+ */
+struct Task
+{
+  const std::function<void (size_t, size_t)> *body;
+  size_t begin;
+  size_t end;
+  std::atomic<size_t> *pending;
+};
+
+/*
+ * The queue of a worker: the owner pushes and pops at the back, thieves
+ * take the oldest tasks from the front
+ */
+struct TaskQueue
+{
+  std::mutex lock;
+  std::deque<Task> tasks;
+};
+
+struct Pool
+{
+  std::vector<TaskQueue *> queues;
+  std::vector<std::thread> workers;
+  std::mutex sleepLock;
+  std::condition_variable wake;
+  std::atomic<size_t> queued;
+  bool stop;
+  bool started;
+  uint32_t threads;
+  std::atomic<size_t> nextQueue;
+
+  Pool ()
+    : queued (0),
+      stop (false),
+      started (false),
+      threads (1),
+      nextQueue (0)
+  {
+  }
+
+  ~Pool ()
+  {
+    Shutdown ();
+  }
+
+  void Shutdown (void);
+  void Start (uint32_t n);
+};
+
+// the queue owned by the calling thread, -1 outside the workers
+thread_local int t_queue = -1;
+
+Pool &
+GetPool (void)
+{
+  static Pool pool;
+  return pool;
+}
+
+bool
+PopOwn (Pool &p, Task &t)
+{
+  if (t_queue < 0)
+    {
+      return false;
+    }
+  TaskQueue *q = p.queues[t_queue];
+  std::lock_guard<std::mutex> guard (q->lock);
+  if (q->tasks.empty ())
+    {
+      return false;
+    }
+  t = q->tasks.back ();
+  q->tasks.pop_back ();
+  return true;
+}
+
+bool
+Steal (Pool &p, Task &t)
+{
+  size_t n = p.queues.size ();
+  size_t first = t_queue < 0 ? 0 : t_queue + 1;
+  for (size_t i = 0; i < n; i++)
+    {
+      TaskQueue *q = p.queues[(first + i) % n];
+      std::lock_guard<std::mutex> guard (q->lock);
+      if (!q->tasks.empty ())
+        {
+          t = q->tasks.front ();
+          q->tasks.pop_front ();
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+Run (Pool &p, const Task &t)
+{
+  p.queued--;
+  (*t.body) (t.begin, t.end);
+  t.pending->fetch_sub (1);
+}
+
+void
+WorkerLoop (Pool *p, int queue)
+{
+  t_queue = queue;
+  Task t;
+  while (true)
+    {
+      if (PopOwn (*p, t) || Steal (*p, t))
+        {
+          Run (*p, t);
+          continue;
+        }
+      std::unique_lock<std::mutex> guard (p->sleepLock);
+      if (p->stop)
+        {
+          return;
+        }
+      if (p->queued.load () == 0)
+        {
+          p->wake.wait (guard);
+        }
+    }
+}
+
+void
+Pool::Start (uint32_t n)
+{
+  threads = n;
+  stop = false;
+  started = true;
+  // the caller runs tasks too, so n threads need n - 1 workers
+  for (uint32_t i = 0; i + 1 < n; i++)
+    {
+      queues.push_back (new TaskQueue ());
+    }
+  for (uint32_t i = 0; i + 1 < n; i++)
+    {
+      workers.push_back (std::thread (WorkerLoop, this, (int) i));
+    }
+}
+
+void
+Pool::Shutdown (void)
+{
+  {
+    std::lock_guard<std::mutex> guard (sleepLock);
+    stop = true;
+  }
+  wake.notify_all ();
+  for (size_t i = 0; i < workers.size (); i++)
+    {
+      workers[i].join ();
+    }
+  workers.clear ();
+  for (size_t i = 0; i < queues.size (); i++)
+    {
+      delete queues[i];
+    }
+  queues.clear ();
+  started = false;
+}
+
+uint32_t
+Resolve (uint32_t n)
+{
+  if (n == 0)
+    {
+      n = std::thread::hardware_concurrency ();
+    }
+  return n > 0 ? n : 1;
+}
+
+// start the pool with the global value on first use
+Pool &
+GetStartedPool (void)
+{
+  Pool &p = GetPool ();
+  static std::once_flag once;
+  std::call_once (once, [&p] ()
+    {
+      if (!p.started)
+        {
+          UintegerValue v;
+          g_p1906Threads.GetValue (v);
+          p.Start (Resolve (v.Get ()));
+        }
+    });
+  return p;
+}
+
+} // anonymous namespace
+
+uint32_t
+P1906TaskPool::GetThreadCount (void)
+{
+  return GetStartedPool ().threads;
+}
+
+void
+P1906TaskPool::SetThreadCount (uint32_t n)
+{
+  NS_LOG_FUNCTION (n);
+  Pool &p = GetStartedPool ();
+  p.Shutdown ();
+  p.Start (Resolve (n));
+  g_p1906Threads.SetValue (UintegerValue (n));
+}
+
+size_t
+P1906TaskPool::GetGrain (size_t begin, size_t end, size_t grain)
+{
+  if (grain > 0)
+    {
+      return grain;
+    }
+  size_t g = (end - begin) / 64;
+  return g > 0 ? g : 1;
+}
+
+void
+P1906TaskPool::ParallelFor (size_t begin, size_t end, size_t grain,
+                            const std::function<void (size_t, size_t)> &body)
+{
+  if (end <= begin)
+    {
+      return;
+    }
+  size_t g = GetGrain (begin, end, grain);
+  size_t chunks = (end - begin + g - 1) / g;
+  Pool &p = GetStartedPool ();
+
+  if (p.threads <= 1 || chunks == 1)
+    {
+      for (size_t b = begin; b < end; b += g)
+        {
+          body (b, b + g < end ? b + g : end);
+        }
+      return;
+    }
+
+  std::atomic<size_t> pending (chunks);
+  for (size_t b = begin; b < end; b += g)
+    {
+      Task t;
+      t.body = &body;
+      t.begin = b;
+      t.end = b + g < end ? b + g : end;
+      t.pending = &pending;
+      // a worker keeps its own tasks, other threads spread them over the workers
+      size_t q = t_queue >= 0 ? t_queue : (p.nextQueue++ % p.queues.size ());
+      {
+        std::lock_guard<std::mutex> guard (p.queues[q]->lock);
+        p.queues[q]->tasks.push_back (t);
+      }
+      p.queued++;
+    }
+  {
+    std::lock_guard<std::mutex> guard (p.sleepLock);
+  }
+  p.wake.notify_all ();
+
+  // help until the kernel is done, running its tasks or those of other kernels
+  Task t;
+  while (pending.load () > 0)
+    {
+      if (PopOwn (p, t) || Steal (p, t))
+        {
+          Run (p, t);
+        }
+      else
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+
+#ifndef P1906_TASK_POOL
+#define P1906_TASK_POOL
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906TaskPool
+ *
+ * \brief This class implements the work-stealing thread pool shared by the
+ * parallel kernels of the P1906 framework. Each worker owns a queue of
+ * tasks; an idle worker steals from the queues of the others, and the
+ * thread waiting for a kernel runs tasks too, so that kernels can be
+ * nested without deadlocks.
+ *
+ * The number of threads, caller included, is the global value
+ * "P1906Threads" (e.g., --P1906Threads=8 on the command line); it is read
+ * when the pool starts and can be changed later with SetThreadCount.
+ * The default of 1 keeps every kernel serial; 0 uses one thread per
+ * hardware thread.
+ *
+ * A range is split into chunks that only depend on the grain, not on the
+ * number of threads, and partial results are combined in chunk order:
+ * the results of a kernel do not depend on the number of threads.
+ * Kernels must not use the ns-3 simulator nor copy a Ptr shared with
+ * other tasks, since reference counts are not atomic.
+ */
+
+class P1906TaskPool
+{
+public:
+  /**
+   * \return the number of threads running the kernels, caller included
+   */
+  static uint32_t GetThreadCount (void);
+  /**
+   * Restart the pool with n threads (0: one per hardware thread); it
+   * must not be called while a kernel is running
+   */
+  static void SetThreadCount (uint32_t n);
+
+  /**
+   * Call body (b, e) on the chunks [b, e) of [begin, end) and return when
+   * all of them are done
+   * \param grain the size of the chunks (0: about 1/64 of the range)
+   */
+  static void ParallelFor (size_t begin, size_t end, size_t grain,
+                           const std::function<void (size_t, size_t)> &body);
+
+  /**
+   * \return combine () of the results of body (b, e) on the chunks
+   * [b, e) of [begin, end), starting from identity, in chunk order
+   */
+  template <typename T, typename Body, typename Combine>
+  static T ParallelReduce (size_t begin, size_t end, size_t grain, T identity,
+                           Body body, Combine combine)
+  {
+    if (end <= begin)
+      {
+        return identity;
+      }
+    size_t g = GetGrain (begin, end, grain);
+    std::vector<T> partial ((end - begin + g - 1) / g, identity);
+    ParallelFor (begin, end, g, [&] (size_t b, size_t e)
+      {
+        partial[(b - begin) / g] = body (b, e);
+      });
+    T result = identity;
+    for (size_t i = 0; i < partial.size (); i++)
+      {
+        result = combine (result, partial[i]);
+      }
+    return result;
+  }
+
+private:
+  static size_t GetGrain (size_t begin, size_t end, size_t grain);
+};
+
+}
+
+#endif /* P1906_TASK_POOL */
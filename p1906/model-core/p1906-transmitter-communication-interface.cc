@@ -39,6 +39,10 @@
 #include "ns3/packet.h"
 #include "p1906-medium.h"
 #include "p1906-net-device.h"
+#include "p1906-energy-ledger.h"
+#include "p1906-energy-store.h"
+#include "p1906-capture.h"
+#include "ns3/node.h"
 
 
 
@@ -115,7 +119,35 @@ bool
 P1906TransmitterCommunicationInterface::HandleTransmission (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this);
+
+  uint32_t node = P1906EnergyLedger::NO_NODE;
+  Ptr<P1906NetDevice> dev = m_p1906CommunicationInterface->GetP1906NetDevice ();
+  if (dev && dev->GetNode ())
+    {
+      node = dev->GetNode ()->GetId ();
+    }
+
+  // a node running on harvested energy transmits only what it can pay for
+  double energy = m_perturbation->ComputeMessageEnergy (p);
+  Ptr<P1906EnergyStore> store = 0;
+  if (dev)
+    {
+      store = dev->GetP1906EnergyStore ();
+    }
+  if (store != 0 && !store->Consume (energy))
+    {
+      NS_LOG_FUNCTION (this << "message refused [energy]" << energy);
+      return false;
+    }
+
   Ptr<P1906MessageCarrier> carrier = m_perturbation->CreateMessageCarrier(p);
+  P1906EnergyLedger::GetLedger ()->AddEnergy (node, p->GetUid (),
+		                                      P1906EnergyLedger::PERTURBATION,
+		                                      energy);
+  if (P1906Capture::IsEnabled ())
+    {
+      P1906Capture::GetCapture ()->NotifyTransmission (m_p1906CommunicationInterface, p, carrier);
+    }
 
   GetP1906Medium ()->HandleTransmission(m_p1906CommunicationInterface,
 		                                carrier,
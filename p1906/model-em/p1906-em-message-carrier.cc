@@ -31,6 +31,7 @@
 #include "ns3/packet.h"
 #include "p1906-em-message-carrier.h"
 #include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -47,6 +48,10 @@ P1906EMMessageCarrier::P1906EMMessageCarrier ()
 {
   NS_LOG_FUNCTION (this);
   SetMessage (0);
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906EMMessageCarrier));
+    }
 }
 
 P1906EMMessageCarrier::~P1906EMMessageCarrier ()
@@ -168,4 +173,18 @@ P1906EMMessageCarrier::GetSubChannel (void)
   return m_subChannel;
 }
 
+P1906MessageCarrier::CaptureMetadata
+P1906EMMessageCarrier::GetCaptureMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  CaptureMetadata m;
+  m.model = EM_CARRIER;
+  m.start = m_startTime;
+  m.nValues = 3;
+  m.values[0] = m_centralFrequency;
+  m.values[1] = m_bandwidth;
+  m.values[2] = m_spectrumValue ? Integral (*m_spectrumValue) : 0.;
+  return m;
+}
+
 } // namespace ns3
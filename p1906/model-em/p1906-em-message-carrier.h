@@ -77,6 +77,8 @@ public:
   void SetSubChannel (double c);
   double GetSubChannel (void);
 
+  virtual CaptureMetadata GetCaptureMetadata (void);
+
 private:
   Ptr<SpectrumValue> m_spectrumValue;
   Time m_duration;
@@ -67,6 +67,32 @@ public:
   void SetWaveSpeed (double s);
   double GetWaveSpeed (void);
 
+  /**
+   * The number of sub-bands of the path loss model
+   */
+  static const int NUM_BANDS = 11;
+
+  /**
+   * \param distance the distance between transmitter and receiver [m]
+   * \param waveSpeed the propagation speed [m/s]
+   * \return the propagation delay [s]
+   */
+  static double ComputeDelay (double distance, double waveSpeed);
+  /**
+   * \param distance the distance between transmitter and receiver [m]
+   * \return the row of the path loss and molecular noise tables for that distance
+   */
+  static int GetDistanceIndex (double distance);
+  /**
+   * Apply the path loss of the given distance to the NUM_BANDS sub-bands;
+   * txPsd and rxPsd may be the same array
+   *
+   * \param distance the distance between transmitter and receiver [m]
+   * \param txPsd the transmitted power spectral density of each sub-band [W/Hz]
+   * \param rxPsd the received power spectral density of each sub-band [W/Hz]
+   */
+  static void ComputeReceivedPsd (double distance, const double *txPsd, double *rxPsd);
+
 private:
   double m_waveSpeed;
 };
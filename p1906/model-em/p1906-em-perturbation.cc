@@ -189,4 +189,27 @@ P1906EMPerturbation::CreateMessageCarrier (Ptr<Packet> p)
   return carrier;
 }
 
+double
+P1906EMPerturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+
+  // one pulse of duration m_pulseDuration per transmitted bit
+  double energy = m_powerTx * m_pulseDuration.GetSeconds () * p->GetSize () * 8;
+
+  NS_LOG_FUNCTION (this << "[ptx,pulseD,bits,energy]" << m_powerTx << m_pulseDuration
+		  << p->GetSize () * 8 << energy);
+
+  return energy;
+}
+
+Time
+P1906EMPerturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+
+  // one pulse per transmitted bit, every m_pulseInterval
+  return Seconds (m_pulseInterval.GetSeconds () * p->GetSize () * 8);
+}
+
 } // namespace ns3
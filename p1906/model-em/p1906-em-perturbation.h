@@ -56,6 +56,8 @@ public:
   virtual ~P1906EMPerturbation ();
 
   virtual Ptr<P1906MessageCarrier> CreateMessageCarrier (Ptr<Packet> p);
+  virtual double ComputeMessageEnergy (Ptr<Packet> p);
+  virtual Time ComputeTransmissionTime (Ptr<Packet> p);
 
   void SetPowerTransmission (double ptx);
   double GetPowerTransmission (void);
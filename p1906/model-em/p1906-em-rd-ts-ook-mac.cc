@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/uinteger.h"
+#include "ns3/p1906-net-device.h"
+#include "p1906-em-rd-ts-ook-mac.h"
+#include "p1906-em-perturbation.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906EMRdTsOokMac");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906EMRdTsOokMac);
+
+TypeId P1906EMRdTsOokMac::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906EMRdTsOokMac")
+    .SetParent<P1906Mac> ()
+    .AddConstructor<P1906EMRdTsOokMac> ()
+    .AddAttribute ("SpreadingRatio",
+                   "The nominal ratio between the pulse interval and the pulse duration",
+                   UintegerValue (1000),
+                   MakeUintegerAccessor (&P1906EMRdTsOokMac::m_nominalRatio),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Rates",
+                   "The number of different spreading ratios given to the nodes",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&P1906EMRdTsOokMac::m_rates),
+                   MakeUintegerChecker<uint32_t> (1));
+  return tid;
+}
+
+P1906EMRdTsOokMac::P1906EMRdTsOokMac ()
+{
+  NS_LOG_FUNCTION (this);
+  m_nominalRatio = 1000;
+  m_rates = 16;
+  m_ratio = 0;
+}
+
+P1906EMRdTsOokMac::~P1906EMRdTsOokMac ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+P1906EMRdTsOokMac::ComputeSpreadingRatio (uint32_t nominal, uint32_t index)
+{
+  NS_LOG_FUNCTION (nominal << index);
+  uint32_t n = nominal < 2 ? 2 : nominal;
+  for (;;)
+    {
+      bool prime = true;
+      for (uint32_t d = 2; d * d <= n; d++)
+        {
+          if (n % d == 0)
+            {
+              prime = false;
+              break;
+            }
+        }
+      if (prime)
+        {
+          if (index == 0)
+            {
+              return n;
+            }
+          index--;
+        }
+      n++;
+    }
+}
+
+uint32_t
+P1906EMRdTsOokMac::GetSpreadingRatio (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<Node> node = GetP1906NetDevice ()->GetNode ();
+  uint32_t id = node != 0 ? node->GetId () : 0;
+  return ComputeSpreadingRatio (m_nominalRatio, id % m_rates);
+}
+
+void
+P1906EMRdTsOokMac::DoStartTransmission (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  if (m_ratio == 0)
+    {
+      // the symbol rate of the node is set once, at its first message
+      m_ratio = GetSpreadingRatio ();
+      Ptr<P1906EMPerturbation> perturbation = DynamicCast<P1906EMPerturbation> (GetP1906Perturbation ());
+      NS_ASSERT_MSG (perturbation != 0, "RD TS-OOK needs a P1906EMPerturbation");
+      perturbation->SetPulseInterval (perturbation->GetPulseDuration () * m_ratio);
+      NS_LOG_FUNCTION (this << "spreading ratio" << m_ratio << perturbation->GetPulseInterval ());
+    }
+  P1906Mac::DoStartTransmission (p);
+}
+
+Time
+P1906EMRdTsOokMac::GetTimerTick (void)
+{
+  NS_LOG_FUNCTION (this);
+  // the messages end on multiples of the pulse duration
+  Ptr<P1906EMPerturbation> perturbation = DynamicCast<P1906EMPerturbation> (GetP1906Perturbation ());
+  if (perturbation != 0 && perturbation->GetPulseDuration ().IsStrictlyPositive ())
+    {
+      return perturbation->GetPulseDuration ();
+    }
+  return P1906Mac::GetTimerTick ();
+}
+
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_EM_RD_TS_OOK_MAC
+#define P1906_EM_RD_TS_OOK_MAC
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-mac.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906EMRdTsOokMac
+ *
+ * \brief This class implements the Rate Division Time Spread On-Off Keying
+ * (RD TS-OOK) medium access for the EM model. Instead of contending for
+ * the medium, each node spreads its pulses with its own symbol rate: the
+ * pulse interval is the pulse duration times a spreading ratio, and nodes
+ * use different prime spreading ratios, so the pulses of concurrent
+ * messages seldom overlap more than once. Messages are therefore
+ * transmitted at once.
+ *
+ * The spreading ratio of a node is the i-th prime not smaller than the
+ * nominal ratio, where i is the node id modulo the number of rates.
+ */
+
+class P1906EMRdTsOokMac : public P1906Mac
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906EMRdTsOokMac ();
+  virtual ~P1906EMRdTsOokMac ();
+
+  virtual Time GetTimerTick (void);
+
+  /**
+   * \return the spreading ratio of the node of the device
+   */
+  uint32_t GetSpreadingRatio (void);
+
+  /**
+   * \return the index-th prime not smaller than nominal
+   */
+  static uint32_t ComputeSpreadingRatio (uint32_t nominal, uint32_t index);
+
+protected:
+  virtual void DoStartTransmission (Ptr<Packet> p);
+
+private:
+  uint32_t m_nominalRatio;
+  uint32_t m_rates;
+  uint32_t m_ratio;   //!< 0 until the Perturbation is configured
+};
+
+}
+
+#endif /* P1906_EM_RD_TS_OOK_MAC */
@@ -38,6 +38,10 @@
 #include "ns3/p1906-medium.h"
 #include "ns3/p1906-net-device.h"
 #include "ns3/p1906-motion.h"
+#include "ns3/p1906-energy-ledger.h"
+#include "ns3/p1906-specificity-collector.h"
+#include "ns3/p1906-profiler.h"
+#include "ns3/p1906-capture.h"
 #include "p1906-em-specificity.h"
 
 
@@ -68,12 +72,22 @@ P1906EMReceiverCommunicationInterface::HandleReception (Ptr<P1906CommunicationIn
   NS_LOG_FUNCTION (this);
 
   Ptr<P1906EMSpecificity> specificity = GetP1906Specificity ()->GetObject<P1906EMSpecificity> ();
-  bool isRxOk = specificity->CheckRxCompatibility (src, dst, message);
+  bool isRxOk;
+  {
+    P1906ProfilerScope scope (P1906Profiler::CHECK_RX_COMPATIBILITY);
+    isRxOk = specificity->CheckRxCompatibility (src, dst, message);
+  }
+  P1906SpecificityCollector::GetCollector ()->NotifyDecision (src, dst, specificity, isRxOk);
+  if (P1906Capture::IsEnabled ())
+    {
+      P1906Capture::GetCapture ()->NotifyReception (src, dst, message, specificity, isRxOk);
+    }
   if (isRxOk)
     {
 	  NS_LOG_FUNCTION (this << "message received correctly");
 	  Ptr<Packet> p = message->GetMessage ();
-	  //xxx forward to upper layer
+	  P1906EnergyLedger::GetLedger ()->NotifyDelivery (p->GetUid (), p->GetSize () * 8);
+	  GetP1906CommunicationInterface ()->HandleReception (p);
     }
   else
     {
@@ -56,6 +56,21 @@ public:
 
   virtual bool CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message);
 
+  /**
+   * The number of sub-bands of the molecular noise model
+   */
+  static const int NUM_BANDS = 11;
+
+  /**
+   * Shannon capacity of the NUM_BANDS sub-bands under molecular absorption noise
+   *
+   * \param distance the distance between transmitter and receiver [m]
+   * \param rxPsd the received power spectral density of each sub-band [W/Hz]
+   * \param subChannel the width of a sub-band [Hz]
+   * \return the channel capacity [bit/s]
+   */
+  static double ComputeCapacity (double distance, const double *rxPsd, double subChannel);
+
 private:
 
 };
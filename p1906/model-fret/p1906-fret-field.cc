@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/mobility-model.h"
+
+#include "p1906-fret-field.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-task-pool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FRETField");
+
+// the Foerster radius of kappa^2 n^-4 Q J = 1 [m]
+static const double FOERSTER_UNIT = 0.211e-10;
+
+TypeId P1906FRETField::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FRETField")
+    .SetParent<P1906Field> ();
+  return tid;
+}
+
+P1906FRETField::P1906FRETField ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << "Created FRET Field Component");
+  m_overlap.assign (MAX_SPECIES * MAX_SPECIES, 0.);
+  m_refractiveIndex = 1.4;      // biological tissue
+  m_tableSize = 0;
+}
+
+P1906FRETField::~P1906FRETField ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+P1906FRETField::AddSpecies (double lifetime, double quantumYield)
+{
+  NS_LOG_FUNCTION (this << lifetime << quantumYield);
+  NS_ASSERT_MSG (m_species.size () < MAX_SPECIES, "too many fluorophore species");
+  Species s;
+  s.lifetime = lifetime;
+  s.quantumYield = quantumYield;
+  m_species.push_back (s);
+  return m_species.size () - 1;
+}
+
+void
+P1906FRETField::SetOverlapIntegral (uint32_t donor, uint32_t acceptor, double j)
+{
+  NS_LOG_FUNCTION (this << donor << acceptor << j);
+  NS_ASSERT (donor < m_species.size () && acceptor < m_species.size ());
+  m_overlap[donor * MAX_SPECIES + acceptor] = j;
+}
+
+void
+P1906FRETField::SetRefractiveIndex (double n)
+{
+  NS_LOG_FUNCTION (this << n);
+  m_refractiveIndex = n;
+}
+
+double
+P1906FRETField::GetRefractiveIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_refractiveIndex;
+}
+
+void
+P1906FRETField::AttachNode (uint32_t node, uint32_t species, Vector dipole)
+{
+  NS_LOG_FUNCTION (this << node << species << dipole);
+  NS_ASSERT_MSG (species < m_species.size (), "unknown fluorophore species");
+  double norm = std::sqrt (dipole.x * dipole.x + dipole.y * dipole.y + dipole.z * dipole.z);
+  if (norm > 0.)
+    {
+      dipole = Vector (dipole.x / norm, dipole.y / norm, dipole.z / norm);
+    }
+
+  if (node >= m_indices.size ())
+    {
+      m_indices.resize (node + 1, NO_INDEX);
+    }
+  if (m_indices[node] == NO_INDEX)
+    {
+      m_indices[node] = m_nodes.size ();
+      m_nodes.push_back (node);
+      m_nodeSpecies.push_back (species);
+      m_dipoles.push_back (dipole);
+    }
+  else
+    {
+      m_nodeSpecies[m_indices[node]] = species;
+      m_dipoles[m_indices[node]] = dipole;
+    }
+}
+
+void
+P1906FRETField::BuildTables (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t n = m_nodes.size ();
+  m_tableSize = n;
+
+  // the nodes as structures of arrays, so that a row is one pass over contiguous data
+  std::vector<double> x (n), y (n), z (n), dx (n), dy (n), dz (n), oriented (n), overlap (n);
+  std::vector<uint32_t> species (m_nodeSpecies);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> mobility = NodeList::GetNode (m_nodes[i])->GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (mobility, "a fluorophore node has no position");
+      Vector p = mobility->GetPosition ();
+      x[i] = p.x;
+      y[i] = p.y;
+      z[i] = p.z;
+      dx[i] = m_dipoles[i].x;
+      dy[i] = m_dipoles[i].y;
+      dz[i] = m_dipoles[i].z;
+      oriented[i] = (dx[i] != 0. || dy[i] != 0. || dz[i] != 0.) ? 1. : 0.;
+    }
+
+  m_rates.assign (uint64_t (n) * n, 0.f);
+  m_kappa2.assign (uint64_t (n) * n, 0.f);
+  m_decayRates.resize (n);
+  m_totalRates.resize (n);
+
+  double unit6 = std::pow (FOERSTER_UNIT, 6) / std::pow (m_refractiveIndex, 4);
+  P1906TaskPool::ParallelFor (0, n, 0, [&] (size_t b, size_t e)
+    {
+      std::vector<double> j (n);
+      for (size_t i = b; i < e; i++)
+        {
+          const Species &s = m_species[species[i]];
+          const double *jRow = &m_overlap[species[i] * MAX_SPECIES];
+          for (uint32_t a = 0; a < n; a++)
+            {
+              j[a] = jRow[species[a]];
+            }
+
+          double kd = 1. / s.lifetime;
+          double pre = kd * unit6 * s.quantumYield;
+          float *rates = &m_rates[uint64_t (i) * n];
+          float *kappa2 = &m_kappa2[uint64_t (i) * n];
+          double total = 0.;
+          for (uint32_t a = 0; a < n; a++)
+            {
+              double rx = x[a] - x[i];
+              double ry = y[a] - y[i];
+              double rz = z[a] - z[i];
+              double r2 = rx * rx + ry * ry + rz * rz + 1e-40;
+              double inv = 1. / std::sqrt (r2);
+              double cosD = (dx[i] * rx + dy[i] * ry + dz[i] * rz) * inv;
+              double cosA = (dx[a] * rx + dy[a] * ry + dz[a] * rz) * inv;
+              double cosT = dx[i] * dx[a] + dy[i] * dy[a] + dz[i] * dz[a];
+              double k = cosT - 3. * cosD * cosA;
+              double both = oriented[i] * oriented[a];
+              double kap = both * k * k + (1. - both) * (2. / 3.);
+              double rate = a == i ? 0. : pre * kap * j[a] / (r2 * r2 * r2);
+              rates[a] = rate;
+              kappa2[a] = kap;
+              total += rate;
+            }
+          m_decayRates[i] = kd;
+          m_totalRates[i] = kd + total;
+        }
+    });
+
+  NS_LOG_FUNCTION (this << "[nodes,tableBytes]" << n << 2 * uint64_t (n) * n * sizeof (float));
+}
+
+uint32_t
+P1906FRETField::GetIndex (uint32_t node) const
+{
+  NS_ASSERT_MSG (node < m_indices.size () && m_indices[node] < m_tableSize,
+                 "node " << node << " not in the FRET tables, see BuildTables");
+  return m_indices[node];
+}
+
+uint32_t
+P1906FRETField::GetNodeCount (void) const
+{
+  return m_tableSize;
+}
+
+bool
+P1906FRETField::HasNode (uint32_t node) const
+{
+  return node < m_indices.size () && m_indices[node] < m_tableSize;
+}
+
+uint32_t
+P1906FRETField::GetNodeAt (uint32_t index) const
+{
+  return m_nodes[index];
+}
+
+double
+P1906FRETField::GetLifetime (uint32_t node) const
+{
+  return 1. / m_decayRates[GetIndex (node)];
+}
+
+double
+P1906FRETField::GetQuantumYield (uint32_t node) const
+{
+  return m_species[m_nodeSpecies[GetIndex (node)]].quantumYield;
+}
+
+double
+P1906FRETField::GetOrientationFactor (uint32_t donor, uint32_t acceptor) const
+{
+  return m_kappa2[uint64_t (GetIndex (donor)) * m_tableSize + GetIndex (acceptor)];
+}
+
+double
+P1906FRETField::GetFoersterRadius (uint32_t donor, uint32_t acceptor) const
+{
+  uint32_t i = GetIndex (donor);
+  uint32_t a = GetIndex (acceptor);
+  double j = m_overlap[m_nodeSpecies[i] * MAX_SPECIES + m_nodeSpecies[a]];
+  double q = m_species[m_nodeSpecies[i]].quantumYield;
+  double kap = m_kappa2[uint64_t (i) * m_tableSize + a];
+  return FOERSTER_UNIT * std::pow (kap * q * j / std::pow (m_refractiveIndex, 4), 1. / 6.);
+}
+
+double
+P1906FRETField::GetTransferRate (uint32_t donor, uint32_t acceptor) const
+{
+  return m_rates[uint64_t (GetIndex (donor)) * m_tableSize + GetIndex (acceptor)];
+}
+
+double
+P1906FRETField::GetEfficiency (uint32_t donor, uint32_t acceptor) const
+{
+  uint32_t i = GetIndex (donor);
+  double k = m_rates[uint64_t (i) * m_tableSize + GetIndex (acceptor)];
+  return k / (k + m_decayRates[i]);
+}
+
+double
+P1906FRETField::GetTransferProbability (uint32_t donor, uint32_t acceptor) const
+{
+  uint32_t i = GetIndex (donor);
+  return m_rates[uint64_t (i) * m_tableSize + GetIndex (acceptor)] / m_totalRates[i];
+}
+
+double
+P1906FRETField::GetExcitedLifetime (uint32_t donor) const
+{
+  return 1. / m_totalRates[GetIndex (donor)];
+}
+
+void
+P1906FRETField::EvaluatePulse (uint32_t donor, double excitons, std::vector<double> &received) const
+{
+  uint32_t i = GetIndex (donor);
+  const float *rates = &m_rates[uint64_t (i) * m_tableSize];
+  double scale = excitons / m_totalRates[i];
+  received.resize (m_tableSize);
+  for (uint32_t a = 0; a < m_tableSize; a++)
+    {
+      received[a] = rates[a] * scale;
+    }
+}
+
+} // namespace ns3
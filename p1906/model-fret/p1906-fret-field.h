@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_FRET_FIELD
+#define P1906_FRET_FIELD
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/p1906-field.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906FRETField
+ *
+ * \brief Class implementing the Field component of the P1906
+ * framework for the FRET Example: the fluorophores of the nodes and
+ * the Foerster resonance energy transfer between them. An exciton of
+ * donor i moves to acceptor j at the rate
+ *
+ *   k_ij = (1 / tau_i) (R0_ij / r_ij)^6,
+ *   R0_ij^6 = (0.211 A)^6 kappa_ij^2 n^-4 Q_i J_ij
+ *
+ * with tau_i and Q_i the lifetime and quantum yield of the donor, J_ij
+ * the overlap integral of the donor emission and acceptor absorption
+ * spectra [M^-1 cm^-1 nm^4], n the refractive index of the medium and
+ * kappa_ij^2 the orientation factor of the two dipoles (2/3, the
+ * isotropic average, when either is not set). Alone, the pair transfers
+ * with efficiency R0^6 / (R0^6 + r^6); among several acceptors, the
+ * exciton goes to j with probability k_ij / (1 / tau_i + sum_l k_il).
+ *
+ * BuildTables computes the rates and orientation factors of every
+ * pair from the positions of the nodes at that time, as dense N x N
+ * tables, one row per donor, filled by vectorizable loops spread over
+ * the P1906TaskPool. The queries of the Motion and the Specificity are
+ * then table lookups. A single Field is shared by the devices.
+ */
+
+class P1906FRETField : public P1906Field
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906FRETField ();
+  virtual ~P1906FRETField ();
+
+  /**
+   * \param lifetime the lifetime of the excited state, without acceptors [s]
+   * \param quantumYield the quantum yield of the fluorophore
+   * \return the id of the new fluorophore species
+   */
+  uint32_t AddSpecies (double lifetime, double quantumYield);
+  /**
+   * \param j the overlap integral of the emission of donor and the absorption of acceptor [M^-1 cm^-1 nm^4]
+   */
+  void SetOverlapIntegral (uint32_t donor, uint32_t acceptor, double j);
+  void SetRefractiveIndex (double n);
+  double GetRefractiveIndex (void);
+
+  /**
+   * Give a node a fluorophore of a species
+   *
+   * \param dipole the direction of the transition dipole; a null vector
+   * stands for a freely rotating fluorophore
+   */
+  void AttachNode (uint32_t node, uint32_t species, Vector dipole);
+  /**
+   * Compute the tables of the attached nodes, at their current positions
+   */
+  void BuildTables (void);
+
+  uint32_t GetNodeCount (void) const;
+  bool HasNode (uint32_t node) const;
+
+  double GetLifetime (uint32_t node) const;
+  double GetQuantumYield (uint32_t node) const;
+  double GetOrientationFactor (uint32_t donor, uint32_t acceptor) const;
+  double GetFoersterRadius (uint32_t donor, uint32_t acceptor) const;
+  double GetTransferRate (uint32_t donor, uint32_t acceptor) const;
+  /**
+   * \return the efficiency of the transfer between the two nodes alone
+   */
+  double GetEfficiency (uint32_t donor, uint32_t acceptor) const;
+  /**
+   * \return the probability that an exciton of donor ends in acceptor, all the acceptors competing
+   */
+  double GetTransferProbability (uint32_t donor, uint32_t acceptor) const;
+  /**
+   * \return the lifetime of the excited donor, shortened by the transfers to all the acceptors [s]
+   */
+  double GetExcitedLifetime (uint32_t donor) const;
+  /**
+   * Spread the excitons of a pulse of a donor over all the nodes
+   *
+   * \param received the excitons reaching each node, indexed as GetNodeAt
+   */
+  void EvaluatePulse (uint32_t donor, double excitons, std::vector<double> &received) const;
+  uint32_t GetNodeAt (uint32_t index) const;
+
+private:
+  struct Species
+  {
+    double lifetime;
+    double quantumYield;
+  };
+
+  uint32_t GetIndex (uint32_t node) const;
+
+  std::vector<Species> m_species;
+  std::vector<double> m_overlap;          //!< J of donor species s and acceptor species t at s * MAX_SPECIES + t
+  double m_refractiveIndex;
+
+  std::vector<uint32_t> m_nodes;          //!< the node of each index
+  std::vector<uint32_t> m_nodeSpecies;
+  std::vector<Vector> m_dipoles;
+  std::vector<uint32_t> m_indices;        //!< the index of each node id, NO_INDEX if not attached
+
+  // the tables, valid after BuildTables
+  std::vector<float> m_rates;             //!< k_ij at i * N + j [1/s]
+  std::vector<float> m_kappa2;            //!< kappa_ij^2 at i * N + j
+  std::vector<double> m_decayRates;       //!< 1 / tau_i [1/s]
+  std::vector<double> m_totalRates;       //!< 1 / tau_i + sum_j k_ij [1/s]
+  uint32_t m_tableSize;
+
+  static const uint32_t MAX_SPECIES = 64;
+  static const uint32_t NO_INDEX = 0xffffffff;
+};
+
+}
+
+#endif /* P1906_FRET_FIELD */
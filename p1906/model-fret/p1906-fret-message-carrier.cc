@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "p1906-fret-message-carrier.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-memory-tracker.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FRETMessageCarrier");
+
+TypeId P1906FRETMessageCarrier::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FRETMessageCarrier")
+    .SetParent<P1906MessageCarrier> ();
+  return tid;
+}
+
+P1906FRETMessageCarrier::P1906FRETMessageCarrier ()
+{
+  NS_LOG_FUNCTION (this);
+  SetMessage (0);
+  m_excitons = 0.;
+  m_excitonLifetime = 0.;
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906FRETMessageCarrier));
+    }
+}
+
+P1906FRETMessageCarrier::~P1906FRETMessageCarrier ()
+{
+  NS_LOG_FUNCTION (this);
+  SetMessage (0);
+}
+
+void
+P1906FRETMessageCarrier::SetDuration (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_duration = t;
+}
+
+Time
+P1906FRETMessageCarrier::GetDuration (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_duration;
+}
+
+void
+P1906FRETMessageCarrier::SetPulseInterval (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_pulseInterval = t;
+}
+
+Time
+P1906FRETMessageCarrier::GetPulseInterval (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_pulseInterval;
+}
+
+void
+P1906FRETMessageCarrier::SetStartTime (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_startTime = t;
+}
+
+Time
+P1906FRETMessageCarrier::GetStartTime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_startTime;
+}
+
+void
+P1906FRETMessageCarrier::SetExcitons (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_excitons = e;
+}
+
+double
+P1906FRETMessageCarrier::GetExcitons (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_excitons;
+}
+
+void
+P1906FRETMessageCarrier::SetExcitonLifetime (double t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_excitonLifetime = t;
+}
+
+double
+P1906FRETMessageCarrier::GetExcitonLifetime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_excitonLifetime;
+}
+
+P1906MessageCarrier::CaptureMetadata
+P1906FRETMessageCarrier::GetCaptureMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  CaptureMetadata m;
+  m.model = FRET_CARRIER;
+  m.start = m_startTime;
+  m.nValues = 2;
+  m.values[0] = m_excitons;
+  m.values[1] = m_excitonLifetime;
+  return m;
+}
+
+} // namespace ns3
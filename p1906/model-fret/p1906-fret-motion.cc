@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+#include "p1906-fret-motion.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-field.h"
+#include "ns3/p1906-net-device.h"
+#include "p1906-fret-field.h"
+#include "p1906-fret-message-carrier.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FRETMotion");
+
+TypeId P1906FRETMotion::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FRETMotion")
+    .SetParent<P1906Motion> ();
+  return tid;
+}
+
+P1906FRETMotion::P1906FRETMotion ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+P1906FRETMotion::~P1906FRETMotion ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+double
+P1906FRETMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
+		                                 Ptr<P1906CommunicationInterface> dst,
+		                                 Ptr<P1906MessageCarrier> message,
+		                                 Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this << "Foerster transfer");
+  Ptr<P1906FRETField> fret = field->GetObject<P1906FRETField> ();
+  uint32_t donor = src->GetP1906NetDevice ()->GetNode ()->GetId ();
+  double delay = fret->GetExcitedLifetime (donor);
+
+  NS_LOG_FUNCTION (this << "[donor,delay]" << donor << delay);
+  return delay;
+}
+
+
+Ptr<P1906MessageCarrier>
+P1906FRETMotion::CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface> src,
+		                                        Ptr<P1906CommunicationInterface> dst,
+		                                        Ptr<P1906MessageCarrier> message,
+		                                        Ptr<P1906Field> field)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906FRETMessageCarrier> m = message->GetObject<P1906FRETMessageCarrier> ();
+  Ptr<P1906FRETField> fret = field->GetObject<P1906FRETField> ();
+  uint32_t donor = src->GetP1906NetDevice ()->GetNode ()->GetId ();
+  uint32_t acceptor = dst->GetP1906NetDevice ()->GetNode ()->GetId ();
+
+  // each receiver gets its own share of the excitons, the transmitted carrier is left untouched
+  Ptr<P1906FRETMessageCarrier> received = CreateObject<P1906FRETMessageCarrier> ();
+  received->SetMessage (m->GetMessage ());
+  received->SetDuration (m->GetDuration ());
+  received->SetPulseInterval (m->GetPulseInterval ());
+  received->SetStartTime (m->GetStartTime ());
+  received->SetExcitons (m->GetExcitons () * fret->GetTransferProbability (donor, acceptor));
+  received->SetExcitonLifetime (fret->GetExcitedLifetime (donor));
+
+  NS_LOG_FUNCTION (this << "[donor,acceptor,excitons,transferred]" << donor << acceptor
+                   << m->GetExcitons () << received->GetExcitons ());
+  return received;
+}
+
+
+} // namespace ns3
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "p1906-fret-perturbation.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-perturbation.h"
+#include "p1906-fret-message-carrier.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FRETPerturbation");
+
+TypeId P1906FRETPerturbation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FRETPerturbation")
+    .SetParent<P1906Perturbation> ();
+  return tid;
+}
+
+P1906FRETPerturbation::P1906FRETPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+  m_pulseInterval = NanoSeconds (100);
+  m_excitons = 1000.;
+  m_excitationEnergy = 4e-19;       // [J/exciton], a photon at about 500 nm
+}
+
+P1906FRETPerturbation::~P1906FRETPerturbation ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906FRETPerturbation::SetPulseInterval (Time t)
+{
+  NS_LOG_FUNCTION (this << t);
+  m_pulseInterval = t;
+}
+
+Time
+P1906FRETPerturbation::GetPulseInterval (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_pulseInterval;
+}
+
+void
+P1906FRETPerturbation::SetExcitons (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_excitons = e;
+}
+
+double
+P1906FRETPerturbation::GetExcitons (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_excitons;
+}
+
+void
+P1906FRETPerturbation::SetExcitationEnergy (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_excitationEnergy = e;
+}
+
+double
+P1906FRETPerturbation::GetExcitationEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_excitationEnergy;
+}
+
+Ptr<P1906MessageCarrier>
+P1906FRETPerturbation::CreateMessageCarrier (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906FRETMessageCarrier> carrier = CreateObject<P1906FRETMessageCarrier> ();
+
+  double duration = m_pulseInterval.GetSeconds () * p->GetSize () * 8;
+
+  NS_LOG_FUNCTION (this << "[t,bits,pulseI,duration,excitons]" << Simulator::Now ().GetSeconds ()
+		  << p->GetSize() * 8 << m_pulseInterval << duration << m_excitons);
+
+  carrier->SetPulseInterval (m_pulseInterval);
+  carrier->SetDuration (Seconds (duration));
+  carrier->SetStartTime (Simulator::Now ());
+  carrier->SetExcitons (m_excitons);
+  carrier->SetMessage (p);
+
+  return carrier;
+}
+
+double
+P1906FRETPerturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  // one pulse of m_excitons absorbed photons for each transmitted bit
+  return m_excitons * m_excitationEnergy * p->GetSize () * 8;
+}
+
+Time
+P1906FRETPerturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+  return Seconds (m_pulseInterval.GetSeconds () * p->GetSize () * 8);
+}
+
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+#include "p1906-fret-specificity.h"
+#include "ns3/p1906-specificity.h"
+#include "ns3/p1906-net-device.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-transmitter-communication-interface.h"
+#include "p1906-fret-message-carrier.h"
+#include "p1906-fret-field.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906FRETSpecificity");
+
+TypeId P1906FRETSpecificity::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906FRETSpecificity")
+    .SetParent<P1906Specificity> ();
+  return tid;
+}
+
+P1906FRETSpecificity::P1906FRETSpecificity ()
+{
+  NS_LOG_FUNCTION (this << "FRET Specificity Component");
+  m_threshold = 10.;        // [photons]
+  m_separation = 5.;        // the excited state decays to 0.7%
+}
+
+P1906FRETSpecificity::~P1906FRETSpecificity ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+P1906FRETSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src, Ptr<P1906CommunicationInterface> dst, Ptr<P1906MessageCarrier> message)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906FRETMessageCarrier> m = message->GetObject <P1906FRETMessageCarrier>();
+
+  // the fluorophores are described by the Field shared by the devices
+  Ptr<P1906FRETField> fret = dst->GetP1906TransmitterCommunicationInterface ()->GetP1906Field ()->GetObject<P1906FRETField> ();
+  uint32_t acceptor = dst->GetP1906NetDevice ()->GetNode ()->GetId ();
+  double photons = m->GetExcitons () * fret->GetQuantumYield (acceptor);
+  SetDecisionMargin (photons - m_threshold);
+
+  NS_LOG_FUNCTION (this << "[excitons,photons,threshold,pulseI,lifetime]" << m->GetExcitons ()
+                   << photons << m_threshold << m->GetPulseInterval () << m->GetExcitonLifetime ());
+
+  if (m->GetPulseInterval ().GetSeconds () < m_separation * m->GetExcitonLifetime ())
+    {
+      NS_LOG_FUNCTION (this << "overlapping pulses --> transmission failed");
+      return false;
+    }
+  if (photons >= m_threshold)
+    {
+      NS_LOG_FUNCTION (this << "acceptor emission detected");
+      return true;
+    }
+  else
+    {
+      NS_LOG_FUNCTION (this << "acceptor emission below the threshold --> transmission failed");
+      return false;
+    }
+}
+
+void
+P1906FRETSpecificity::SetThreshold (double photons)
+{
+  NS_LOG_FUNCTION (this << photons);
+  m_threshold = photons;
+}
+
+double
+P1906FRETSpecificity::GetThreshold (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_threshold;
+}
+
+void
+P1906FRETSpecificity::SetSeparation (double lifetimes)
+{
+  NS_LOG_FUNCTION (this << lifetimes);
+  m_separation = lifetimes;
+}
+
+double
+P1906FRETSpecificity::GetSeparation (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_separation;
+}
+
+} // namespace ns3
@@ -31,6 +31,7 @@
 #include "ns3/packet.h"
 #include "p1906-mol-message-carrier.h"
 #include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -47,6 +48,10 @@ P1906MOLMessageCarrier::P1906MOLMessageCarrier ()
 {
   NS_LOG_FUNCTION (this);
   SetMessage (0);
+  if (P1906MemoryTracker::IsEnabled ())
+    {
+      P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906MOLMessageCarrier));
+    }
 }
 
 P1906MOLMessageCarrier::~P1906MOLMessageCarrier ()
@@ -111,4 +116,16 @@ P1906MOLMessageCarrier::GetMolecules (void)
   return m_molecules;
 }
 
+P1906MessageCarrier::CaptureMetadata
+P1906MOLMessageCarrier::GetCaptureMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  CaptureMetadata m;
+  m.model = MOL_CARRIER;
+  m.start = m_startTime;
+  m.nValues = 1;
+  m.values[0] = m_molecules;
+  return m;
+}
+
 } // namespace ns3
@@ -68,6 +68,8 @@ public:
   void SetMolecules (double q);
   double GetMolecules (void);
 
+  virtual CaptureMetadata GetCaptureMetadata (void);
+
 private:
   Time m_duration;
   Time m_pulseInterval;
@@ -82,7 +82,7 @@ P1906MOLMotion::ComputePropagationDelay (Ptr<P1906CommunicationInterface> src,
 
 
   double distance = dstMobility->GetDistanceFrom (srcMobility);
-  double delay = pow(distance,2)/(GetDiffusionConefficient ()*6);
+  double delay = ComputeDelay (distance, GetDiffusionConefficient ());
 
   NS_LOG_FUNCTION (this << "[dist,diffusion,delay]" << distance << GetDiffusionConefficient () << delay);
 
@@ -101,6 +101,12 @@ P1906MOLMotion::CalculateReceivedMessageCarrier(Ptr<P1906CommunicationInterface>
   return message;
 }
 
+double
+P1906MOLMotion::ComputeDelay (double distance, double diffusionCoefficient)
+{
+  return pow(distance,2)/(diffusionCoefficient*6);
+}
+
 void
 P1906MOLMotion::SetDiffusionCoefficient (double d)
 {
@@ -67,6 +67,13 @@ public:
   void SetDiffusionCoefficient (double d);
   double GetDiffusionConefficient (void);
 
+  /**
+   * \param distance the distance between transmitter and receiver [m]
+   * \param diffusionCoefficient the diffusion coefficient [m^2/s]
+   * \return the propagation delay of the Fick's law [s]
+   */
+  static double ComputeDelay (double distance, double diffusionCoefficient);
+
 private:
   double m_diffusionCoefficient;
 };
@@ -36,21 +36,30 @@
 #include "p1906-mol-message-carrier.h"
 #include "ns3/simulator.h"
 #include "ns3/spectrum-value.h"
+#include "ns3/double.h"
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("P1906MOLPerturbation");
 
+NS_OBJECT_ENSURE_REGISTERED (P1906MOLPerturbation);
+
 TypeId P1906MOLPerturbation::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOLPerturbation")
-    .SetParent<P1906Perturbation> ();
+    .SetParent<P1906Perturbation> ()
+    .AddAttribute ("SynthesisEnergy",
+                   "The energy spent to synthesize one molecule [J/molecule].",
+                   DoubleValue (1.66e-18),
+                   MakeDoubleAccessor (&P1906MOLPerturbation::m_synthesisEnergy),
+                   MakeDoubleChecker<double> (0.));
   return tid;
 }
 
 P1906MOLPerturbation::P1906MOLPerturbation ()
 {
   NS_LOG_FUNCTION (this);
+  m_synthesisEnergy = 1.66e-18; // [J/molecule], about 20 ATP hydrolyses
 }
 
 P1906MOLPerturbation::~P1906MOLPerturbation ()
@@ -86,6 +95,19 @@ P1906MOLPerturbation::GetMolecules (void)
   return m_molecules;
 }
 
+void
+P1906MOLPerturbation::SetSynthesisEnergy (double e)
+{
+  NS_LOG_FUNCTION (this << e);
+  m_synthesisEnergy = e;
+}
+
+double
+P1906MOLPerturbation::GetSynthesisEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_synthesisEnergy;
+}
 
 Ptr<P1906MessageCarrier>
 P1906MOLPerturbation::CreateMessageCarrier (Ptr<Packet> p)
@@ -109,4 +131,27 @@ P1906MOLPerturbation::CreateMessageCarrier (Ptr<Packet> p)
   return carrier;
 }
 
+double
+P1906MOLPerturbation::ComputeMessageEnergy (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+
+  // m_molecules are synthesized and released for each transmitted bit
+  double energy = m_molecules * m_synthesisEnergy * p->GetSize () * 8;
+
+  NS_LOG_FUNCTION (this << "[molecules,synthesisE,bits,energy]" << m_molecules << m_synthesisEnergy
+		  << p->GetSize () * 8 << energy);
+
+  return energy;
+}
+
+Time
+P1906MOLPerturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+
+  // one pulse per transmitted bit, every m_pulseInterval
+  return Seconds (m_pulseInterval.GetSeconds () * p->GetSize () * 8);
+}
+
 } // namespace ns3
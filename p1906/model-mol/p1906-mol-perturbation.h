@@ -56,6 +56,8 @@ public:
   virtual ~P1906MOLPerturbation ();
 
   virtual Ptr<P1906MessageCarrier> CreateMessageCarrier (Ptr<Packet> p);
+  virtual double ComputeMessageEnergy (Ptr<Packet> p);
+  virtual Time ComputeTransmissionTime (Ptr<Packet> p);
 
   void SetPulseInterval (Time t);
   Time GetPulseInterval (void);
@@ -63,9 +65,13 @@ public:
   void SetMolecules (double q);
   double GetMolecules (void);
 
+  void SetSynthesisEnergy (double e);
+  double GetSynthesisEnergy (void);
+
 private:
   Time m_pulseInterval;
   double m_molecules;
+  double m_synthesisEnergy;
 };
 
 }
@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/p1906-medium.h"
+#include "p1906-mol-random-access-mac.h"
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOLRandomAccessMac");
+
+NS_OBJECT_ENSURE_REGISTERED (P1906MOLRandomAccessMac);
+
+namespace {
+
+/**
+ * The state of the contention on one medium
+ */
+struct Contention
+{
+  Time busyUntil;
+  std::vector<Ptr<P1906MOLRandomAccessMac> > attempts;   //!< the attempts of the current slot
+};
+
+struct ContentionRegistry
+{
+  std::map<P1906Medium *, Contention> media;
+  bool scheduled;
+
+  ContentionRegistry () : scheduled (false) {}
+};
+
+// never destroyed: the contention state is cleared at Simulator::Destroy
+ContentionRegistry &
+GetRegistry (void)
+{
+  static ContentionRegistry *registry = new ContentionRegistry ();
+  return *registry;
+}
+
+void
+ClearContention (void)
+{
+  GetRegistry ().media.clear ();
+  GetRegistry ().scheduled = false;
+}
+
+Contention &
+GetContention (Ptr<P1906Medium> medium)
+{
+  ContentionRegistry &r = GetRegistry ();
+  if (!r.scheduled)
+    {
+      r.scheduled = true;
+      Simulator::ScheduleDestroy (&ClearContention);
+    }
+  return r.media[PeekPointer (medium)];
+}
+
+}
+
+TypeId P1906MOLRandomAccessMac::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOLRandomAccessMac")
+    .SetParent<P1906Mac> ()
+    .AddConstructor<P1906MOLRandomAccessMac> ()
+    .AddAttribute ("SlotTime",
+                   "The duration of a backoff slot",
+                   TimeValue (MilliSeconds (8)),
+                   MakeTimeAccessor (&P1906MOLRandomAccessMac::m_slotTime),
+                   MakeTimeChecker ())
+    .AddAttribute ("MinContentionWindow",
+                   "The contention window of the first attempt [slots]",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&P1906MOLRandomAccessMac::m_minCw),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxContentionWindow",
+                   "The largest contention window [slots]",
+                   UintegerValue (64),
+                   MakeUintegerAccessor (&P1906MOLRandomAccessMac::m_maxCw),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxRetries",
+                   "The collisions after which a message is dropped",
+                   UintegerValue (7),
+                   MakeUintegerAccessor (&P1906MOLRandomAccessMac::m_maxRetries),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Slotted",
+                   "Whether attempts start at slot boundaries",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&P1906MOLRandomAccessMac::m_slotted),
+                   MakeBooleanChecker ());
+  return tid;
+}
+
+P1906MOLRandomAccessMac::P1906MOLRandomAccessMac ()
+{
+  NS_LOG_FUNCTION (this);
+  m_slotTime = MilliSeconds (8);
+  m_minCw = 2;
+  m_maxCw = 64;
+  m_maxRetries = 7;
+  m_slotted = true;
+  m_cw = m_minCw;
+  m_retries = 0;
+  m_backoff = CreateObject<UniformRandomVariable> ();
+}
+
+P1906MOLRandomAccessMac::~P1906MOLRandomAccessMac ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+P1906MOLRandomAccessMac::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_packet = 0;
+  m_backoff = 0;
+  P1906Mac::DoDispose ();
+}
+
+int64_t
+P1906MOLRandomAccessMac::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_backoff->SetStream (stream);
+  return 1;
+}
+
+Time
+P1906MOLRandomAccessMac::GetTimerTick (void)
+{
+  NS_LOG_FUNCTION (this);
+  // slotted attempts are resolved in the middle of the slot
+  if (m_slotted)
+    {
+      return m_slotTime / 2;
+    }
+  return P1906Mac::GetTimerTick ();
+}
+
+void
+P1906MOLRandomAccessMac::DoStartTransmission (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  m_packet = p;
+  m_cw = m_minCw;
+  m_retries = 0;
+  Backoff ();
+}
+
+void
+P1906MOLRandomAccessMac::Backoff (void)
+{
+  NS_LOG_FUNCTION (this << m_cw << m_retries);
+  Time delay;
+  if (m_slotted)
+    {
+      // wait for the next slot boundary, then for the backoff slots
+      int64_t now = Simulator::Now ().GetTimeStep ();
+      int64_t slot = m_slotTime.GetTimeStep ();
+      int64_t boundary = (now / slot + 1) * slot;
+      delay = TimeStep (boundary - now) + m_slotTime * m_backoff->GetInteger (0, m_cw - 1);
+    }
+  else
+    {
+      delay = m_slotTime * m_backoff->GetValue (0, m_cw);
+    }
+  ScheduleTimer (delay, ATTEMPT);
+}
+
+void
+P1906MOLRandomAccessMac::HandleTimer (uint32_t token)
+{
+  NS_LOG_FUNCTION (this << token);
+  switch (token)
+    {
+    case ATTEMPT:
+      Attempt ();
+      break;
+    case RESOLVE:
+      Resolve ();
+      break;
+    default:
+      P1906Mac::HandleTimer (token);
+    }
+}
+
+void
+P1906MOLRandomAccessMac::Attempt (void)
+{
+  NS_LOG_FUNCTION (this);
+  Contention &c = GetContention (GetP1906Medium ());
+  if (m_slotted)
+    {
+      // the first attempt of the slot resolves the contention of all the others
+      c.attempts.push_back (this);
+      if (c.attempts.size () == 1)
+        {
+          ScheduleTimer (m_slotTime / 2, RESOLVE);
+        }
+      return;
+    }
+
+  if (Simulator::Now () < c.busyUntil)
+    {
+      Collide ();
+      return;
+    }
+  Send ();
+}
+
+void
+P1906MOLRandomAccessMac::Resolve (void)
+{
+  NS_LOG_FUNCTION (this);
+  Contention &c = GetContention (GetP1906Medium ());
+  std::vector<Ptr<P1906MOLRandomAccessMac> > attempts;
+  attempts.swap (c.attempts);
+  NS_LOG_FUNCTION (this << "attempts" << attempts.size ());
+
+  if (attempts.size () == 1 && Simulator::Now () >= c.busyUntil)
+    {
+      attempts[0]->Send ();
+      return;
+    }
+  for (uint32_t i = 0; i < attempts.size (); i++)
+    {
+      attempts[i]->Collide ();
+    }
+}
+
+void
+P1906MOLRandomAccessMac::Send (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<Packet> p = m_packet;
+  m_packet = 0;
+  Contention &c = GetContention (GetP1906Medium ());
+  c.busyUntil = Simulator::Now () + GetTransmissionTime (p);
+  Transmit (p);
+}
+
+void
+P1906MOLRandomAccessMac::Collide (void)
+{
+  NS_LOG_FUNCTION (this << m_retries);
+  m_macStats.collisions++;
+  m_retries++;
+  if (m_retries > m_maxRetries)
+    {
+      NS_LOG_FUNCTION (this << "message dropped [retries]");
+      Ptr<Packet> p = m_packet;
+      m_packet = 0;
+      Drop (p);
+      return;
+    }
+  m_cw = std::min (2 * m_cw, m_maxCw);
+  Backoff ();
+}
+
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2014 by IEEE.
+ *
+ *  This source file is an essential part of IEEE P1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE P1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Giuseppe Piro - Telematics Lab Research Group
+ *                         Politecnico di Bari
+ *                         giuseppe.piro@poliba.it
+ *                         telematics.poliba.it/piro
+ */
+
+
+#ifndef P1906_MOL_RANDOM_ACCESS_MAC
+#define P1906_MOL_RANDOM_ACCESS_MAC
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/p1906-mac.h"
+
+namespace ns3 {
+
+class UniformRandomVariable;
+
+/**
+ * \ingroup P1906 framework
+ *
+ * \class P1906MOLRandomAccessMac
+ *
+ * \brief This class implements a random access with binary exponential
+ * backoff for the MOL and motor models, where transmitters cannot sense
+ * the medium. Before each attempt a node waits a random number of slots
+ * in [0, CW). In the slotted scheme attempts start at slot boundaries and
+ * are resolved in the middle of the slot: a lone attempt on an idle medium
+ * is transmitted, while concurrent attempts on the same medium collide.
+ * In the unslotted scheme the backoff is continuous and an attempt
+ * collides when the medium is still busy with another message. After a
+ * collision CW is doubled, up to MaxContentionWindow; after MaxRetries
+ * collisions the message is dropped.
+ */
+
+class P1906MOLRandomAccessMac : public P1906Mac
+{
+public:
+  static TypeId GetTypeId (void);
+
+  P1906MOLRandomAccessMac ();
+  virtual ~P1906MOLRandomAccessMac ();
+
+  virtual void DoDispose (void);
+
+  virtual void HandleTimer (uint32_t token);
+  virtual Time GetTimerTick (void);
+
+  /**
+   * Assign a fixed random variable stream number to the backoff
+   *
+   * \return the number of streams used
+   */
+  int64_t AssignStreams (int64_t stream);
+
+protected:
+  virtual void DoStartTransmission (Ptr<Packet> p);
+
+private:
+  enum Token
+  {
+    ATTEMPT = 1,
+    RESOLVE
+  };
+
+  void Backoff (void);
+  void Attempt (void);
+  void Resolve (void);
+  void Collide (void);
+  void Send (void);
+
+  Time m_slotTime;
+  uint32_t m_minCw;
+  uint32_t m_maxCw;
+  uint32_t m_maxRetries;
+  bool m_slotted;
+
+  Ptr<Packet> m_packet;
+  uint32_t m_cw;
+  uint32_t m_retries;
+  Ptr<UniformRandomVariable> m_backoff;
+};
+
+}
+
+#endif /* P1906_MOL_RANDOM_ACCESS_MAC */
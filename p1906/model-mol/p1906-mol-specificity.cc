@@ -84,11 +84,12 @@ P1906MOLSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
 
   NS_LOG_FUNCTION (this << "[distance,txRate]" << distance << transmissionRate);
 
-  double minPulseWidth = (0.4501/GetDiffusionConefficient ()) * pow(distance,2);
-  double channelCapacity = 1. / minPulseWidth;
+  double channelCapacity = ComputeCapacity (distance, GetDiffusionConefficient ());
 
   NS_LOG_FUNCTION (this << "testcapacity: [distance, txRate, channelCapacity]" << distance << transmissionRate << channelCapacity);
 
+  SetDecisionMargin (channelCapacity - transmissionRate);
+
   if (channelCapacity >= transmissionRate)
 	{
 	  NS_LOG_FUNCTION (this << "Fick's bound has been respected");
@@ -101,6 +102,13 @@ P1906MOLSpecificity::CheckRxCompatibility (Ptr<P1906CommunicationInterface> src,
 	}
 }
 
+double
+P1906MOLSpecificity::ComputeCapacity (double distance, double diffusionCoefficient)
+{
+  double minPulseWidth = (0.4501/diffusionCoefficient) * pow(distance,2);
+  return 1. / minPulseWidth;
+}
+
 void
 P1906MOLSpecificity::SetDiffusionCoefficient (double d)
 {
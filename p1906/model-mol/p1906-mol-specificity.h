@@ -59,6 +59,13 @@ public:
   void SetDiffusionCoefficient (double d);
   double GetDiffusionConefficient (void);
 
+  /**
+   * \param distance the distance between transmitter and receiver [m]
+   * \param diffusionCoefficient the diffusion coefficient [m^2/s]
+   * \return the inverse of the minimum pulse width the receiver can detect [pulses/s]
+   */
+  static double ComputeCapacity (double distance, double diffusionCoefficient);
+
 private:
   double m_diffusionCoefficient;
 
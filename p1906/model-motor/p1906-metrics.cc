@@ -46,6 +46,7 @@
 #include "ns3/log.h"
 
 #include "p1906-metrics.h"
+#include "ns3/p1906-energy-ledger.h"
 
 namespace ns3 {
 
@@ -115,8 +116,17 @@ void P1906_Metrics::Bandwidth_Delay_Product()
 //! where 
 //!    	\f$E_{mc}\f$ is the energy expended to deliver a message
 //!   	\f$I_{mc}\f$ is the information per Message Carrier in bits.
-void P1906_Metrics::Information_and_Communication_Energy()
-{}
+//!
+//! The energy is collected by P1906EnergyLedger from the Perturbation (e.g., EM pulses, molecule synthesis) and 
+//! Motion (e.g., ATP per motor step) components; the bits are those delivered through the Specificity component.
+double P1906_Metrics::Information_and_Communication_Energy()
+{
+  Ptr<P1906EnergyLedger> ledger = P1906EnergyLedger::GetLedger ();
+  
+  NS_LOG_INFO ("energy: " << ledger->GetTotalEnergy () << " J delivered bits: " << ledger->GetDeliveredBits ());
+  
+  return ledger->GetEnergyPerBit ();
+}
 
 //! See Clause 6.6 of P1906.1/D1.1 Draft Recommended Practice for Nanoscale and Molecular Communication Framework
 //! Collision Behavior measures the physical result of collision between Message Carriers. Upon impact, they 
@@ -210,16 +220,31 @@ void P1906_Metrics::Langevin_Noise()
 {}
 
 //! See Clause 6.12 of P1906.1/D1.1 Draft Recommended Practice for Nanoscale and Molecular Communication Framework
-void P1906_Metrics::Specificity()
-{}
+//! Specificity is the ability of a receiver to reject Message Carriers that are not intended for it. It is 
+//! the true negative rate TN / (TN + FP) of the decisions taken by the Specificity component; the counts are 
+//! collected by P1906SpecificityCollector for each receiver (node) or for all of them (ALL_NODES).
+double P1906_Metrics::Specificity(uint32_t node)
+{
+  return P1906SpecificityCollector::GetCollector ()->GetSpecificity (node);
+}
 
 //! See Clause 6.13 of P1906.1/D1.1 Draft Recommended Practice for Nanoscale and Molecular Communication Framework
-void P1906_Metrics::Affinity()
-{}
+//! Affinity is the strength of the binding between a Message Carrier and its intended target. It is the mean 
+//! decision margin of the accepted intended Message Carriers: channel capacity minus transmission rate for the 
+//! EM and MOL Specificity components and the binding score with the receiver volume for molecular motors.
+double P1906_Metrics::Affinity(uint32_t node)
+{
+  return P1906SpecificityCollector::GetCollector ()->GetAffinity (node);
+}
 
 //! See Clause 6.14 of P1906.1/D1.1 Draft Recommended Practice for Nanoscale and Molecular Communication Framework
-void P1906_Metrics::Sensitivity()
-{}
+//! Sensitivity is the ability of a receiver to detect the Message Carriers intended for it. It is the true 
+//! positive rate TP / (TP + FN) of the decisions taken by the Specificity component. ROC curves are obtained 
+//! from P1906SpecificityCollector::GetRocPoint by sweeping the decision threshold over the margin histograms.
+double P1906_Metrics::Sensitivity(uint32_t node)
+{
+  return P1906SpecificityCollector::GetCollector ()->GetSensitivity (node);
+}
 
 //! See Clause 6.15 of P1906.1/D1.1 Draft Recommended Practice for Nanoscale and Molecular Communication Framework
 void P1906_Metrics::Angular_Spectrum()
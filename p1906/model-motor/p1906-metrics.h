@@ -45,6 +45,7 @@ using namespace std;
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/p1906-specificity-collector.h"
 
 namespace ns3 {
 
@@ -126,16 +127,16 @@ public:
   void Message_Lifetime();
   void Information_Density();
   void Bandwidth_Delay_Product();
-  void Information_and_Communication_Energy();
+  double Information_and_Communication_Energy();
   void Collision_Behavior();
   void Mass_Displacement();
   void Positioning_Accuracy_of_Message_Carriers();
   void Persistence_Length();
   void Diffusive_Flux();
   void Langevin_Noise();
-  void Specificity();
-  void Affinity();
-  void Sensitivity();
+  double Specificity(uint32_t node = P1906SpecificityCollector::ALL_NODES);
+  double Affinity(uint32_t node = P1906SpecificityCollector::ALL_NODES);
+  double Sensitivity(uint32_t node = P1906SpecificityCollector::ALL_NODES);
   void Angular_Spectrum();
   void Delay_Spectrum();
   void Active_Network_Programmability(gsl_matrix * vf, gsl_vector * pt);
@@ -34,6 +34,7 @@
 #include "gsl/gsl_sf_exp.h"
 #include "ns3/p1906-mol-diffusion-wave.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -120,7 +121,7 @@ std::istream& operator>>(std::istream& in, P1906MOL_ExtendedDiffusionWave& d_wav
 //! configure a transmission
 void P1906MOL_ExtendedDiffusionWave::prepare_transmission(double tt, double Cd, double ic, P1906MOL_MOTOR_Pos ip)
 {
-  gsl_vector * p = gsl_vector_alloc(3);
+  gsl_vector * p = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::DIFFUSION, 3);
   
   //! time the concentration was released [s]
   transmission_time = tt;
@@ -169,8 +170,8 @@ double P1906MOL_ExtendedDiffusionWave::concentration_wave (P1906MOL_MOTOR_Pos re
   //! receiver 3D position [nm] (x,y,z)
   float D = 1.0; //! diffusion coefficient [nm^2/s]
   double r; //! radius from source [nm]
-  gsl_vector *xpos = gsl_vector_alloc(3);
-  gsl_vector *rpos = gsl_vector_alloc(3);
+  gsl_vector *xpos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::DIFFUSION, 3);
+  gsl_vector *rpos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::DIFFUSION, 3);
   double t; //! [s]
   double c; //! [nmol / nm^3]
 
@@ -36,6 +36,7 @@
 #include "gsl/gsl_sf_exp.h"
 #include "ns3/p1906-mol-diffusion.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -157,8 +158,8 @@ double P1906MOL_ExtendedDiffusion::unitTest_diffusion ()
   P1906MOL_MOTOR_Pos transmitter; //! receiver 3D position [nm] (x,y,z)
   double D = 1.0; //! diffusion coefficient [nm^2/s]
   //double r; //! radius from source [nm]
-  gsl_vector *xpos = gsl_vector_alloc(3);
-  gsl_vector *rpos = gsl_vector_alloc(3);
+  gsl_vector *xpos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::DIFFUSION, 3);
+  gsl_vector *rpos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::DIFFUSION, 3);
   //double t; //! [s]
   //double c; //! [nmol / nm^3]
   //gsl_vector * p = gsl_vector_alloc(3);
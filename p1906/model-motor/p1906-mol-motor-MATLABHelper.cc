@@ -29,6 +29,7 @@
  *
  * <pre>
  * Creates ASCII files designed for import into MATLAB
+ * The files are formatted in memory and written by P1906MOL_MOTOR_ExportService
  * +-----------+                      +--------+
  * |           |     +---------+      |        |
  * |   NS-3    | +-> | *.dat   |  +-> | MATLAB |
@@ -44,6 +45,9 @@
 
 #include "ns3/p1906-mol-motor-MATLABHelper.h"
 #include "ns3/p1906-mol-motor-tube.h"
+#include "ns3/p1906-mol-motor-export-service.h"
+#include "ns3/p1906-memory-tracker.h"
+#include "ns3/p1906-task-pool.h"
 
 namespace ns3 {
 
@@ -78,22 +82,43 @@ P1906MOL_MOTOR_MATLABHelper::P1906MOL_MOTOR_MATLABHelper ()
 //! write a list of vectors into file fname in MATLAB loadable format
 void P1906MOL_MOTOR_MATLABHelper::vectorFieldPlotMATLAB(gsl_matrix * vf, const char * fname)
 {
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  string buf;
+  
+  buf.reserve (vf->size1 * 6 * 16);
   
   for (size_t i = 0; i < vf->size1; i++)
-  {
-    fprintf (pFile, "%f %f %f %f %f %f\n", 
+    appendRow (buf,
 	  gsl_matrix_get (vf, i, 0),
 	  gsl_matrix_get (vf, i, 1),
 	  gsl_matrix_get (vf, i, 2),
 	  gsl_matrix_get (vf, i, 3),
 	  gsl_matrix_get (vf, i, 4),
 	  gsl_matrix_get (vf, i, 5));
-  }
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
+}
+
+//! write the vector field into file fname as the variable vf of a binary MATLAB .mat file
+void P1906MOL_MOTOR_MATLABHelper::vectorField2Mat(gsl_matrix * vf, const char * fname)
+{
+  P1906MOL_MOTOR_ExportService::getService ()->matrix2Mat (vf, "vf", fname);
+}
+
+//! append a row of six values separated by spaces, identical to "%f %f %f %f %f %f\n"
+void P1906MOL_MOTOR_MATLABHelper::appendRow(string & buf, double x, double y, double z, double u, double v, double w)
+{
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, x);
+  buf += ' ';
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, y);
+  buf += ' ';
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, z);
+  buf += ' ';
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, u);
+  buf += ' ';
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, v);
+  buf += ' ';
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, w);
+  buf += '\n';
 }
 
 //! write the vector field in MATLAB format using regular spacing between samples in the file fname
@@ -101,9 +126,7 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldPlotMATLAB(gsl_matrix * vf, const c
 //! Then the vector field operators are applied - see bushsf@research.ge.com for results
 void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const char * fname)
 {
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  string buf;
   
   // find the mesh volume limits
   double xMin, xMax;
@@ -113,12 +136,12 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const c
   double vMin, vMax;
   double wMin, wMax;
   
-  gsl_vector * x = gsl_vector_alloc(vf->size1);
-  gsl_vector * y = gsl_vector_alloc(vf->size1);
-  gsl_vector * z = gsl_vector_alloc(vf->size1);
-  gsl_vector * u = gsl_vector_alloc(vf->size1);
-  gsl_vector * v = gsl_vector_alloc(vf->size1);
-  gsl_vector * w = gsl_vector_alloc(vf->size1);
+  gsl_vector * x = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
+  gsl_vector * y = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
+  gsl_vector * z = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
+  gsl_vector * u = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
+  gsl_vector * v = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
+  gsl_vector * w = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, vf->size1);
   
   //! extract the location and vector components from the field
   gsl_matrix_get_col (x, vf, 0);
@@ -139,69 +162,77 @@ void P1906MOL_MOTOR_MATLABHelper::vectorFieldMeshMATLAB(gsl_matrix * vf, const c
   //printf ("xMin: %f yMin: %f zMin: %f uMin: %f vMin: %f wMin: %f\n", xMin, yMin, zMin, vMin, uMin, wMin);
   //printf ("xMax: %f yMax: %f zMax: %f uMax: %f vMax: %f wMax: %f\n", xMax, yMax, zMax, vMax, uMax, wMax);
 	
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
-  gsl_vector * vec = gsl_vector_alloc (3);
-  gsl_vector * closest = gsl_vector_alloc (6);
-  
   double xStepsize = (xMax - xMin) / 10.0;
   double yStepsize = (yMax - yMin) / 10.0;
   double zStepsize = (zMax - zMin) / 10.0;
   
   //printf ("xStepsize: %f yStepsize: %f zStepsize: %f\n", xStepsize, yStepsize, zStepsize);
   
-  //! step through equidistant points in a volume and store the vector values at each point
+  //! the equidistant sample coordinates along each axis
+  vector<double> xs, ys, zs;
   for (double i = xMin; i < xMax; i += xStepsize)
-    for (double j = yMin; j < yMax; j += yStepsize)
-	  for (double k = zMin; k < zMax; k += zStepsize)
-      {
-	    //! find the closest point to the current location
-	    P1906MOL_MOTOR_Field::point (pt1, i, j, k);
-		// printf ("pt1\n");
-		// displayPoint (pt1);
-	    P1906MOL_MOTOR_Field::findClosestPoint (pt1, vf, closest);
-		//printf ("(findClosestPoint) closest vector: %f %f %f %f %f %f\n",
-        //  gsl_vector_get (closest, 0),
-	    //  gsl_vector_get (closest, 1),
-	    //  gsl_vector_get (closest, 2),
-	    //  gsl_vector_get (closest, 3),
-	    //  gsl_vector_get (closest, 4),
-	    //  gsl_vector_get (closest, 5));
-		P1906MOL_MOTOR_Field::point (pt2, 
-		  gsl_vector_get (closest, 0),
-		  gsl_vector_get (closest, 1),
-		  gsl_vector_get (closest, 2));
-		  
-		// printf ("(vectorFieldMeshMATLAB) distance between pt and vector location: %f\n", distance (pt1, pt2));
-		//! check if distance within range
-		if (P1906MOL_MOTOR_Field::distance(pt1, pt2) > 2.0 * xStepsize)
-		{
-		  //! if not, store the null vector
-		  // printf ("(vectorFieldMeshMATLAB) using null vector\n");
-          P1906MOL_MOTOR_Field::point (vec, 0.0, 0.0, 0.0);
-		  // displayPoint (vec);
-	    } 
-		else 
-		{
-		  // printf ("(vectorFieldMeshMATLAB) using vector\n");
-		  //! otherwise, store the vector value
-		  P1906MOL_MOTOR_Field::point (vec,
-	        gsl_vector_get (closest, 3),
-	        gsl_vector_get (closest, 4),
-	        gsl_vector_get (closest, 5));
-		  // displayPoint (vec);
-		}
-		//! print current location and stored vector value
-        fprintf (pFile, "%f %f %f %f %f %f\n",
-	      i, 
-		  j,
-		  k, 
-		  gsl_vector_get (vec, 0),
-          gsl_vector_get (vec, 1),
-          gsl_vector_get (vec, 2));
-      }
+    xs.push_back (i);
+  for (double j = yMin; j < yMax; j += yStepsize)
+    ys.push_back (j);
+  for (double k = zMin; k < zMax; k += zStepsize)
+    zs.push_back (k);
+  
+  //! the x planes are sampled on the shared task pool, each into its own rows
+  vector<string> planes (xs.size ());
+  P1906TaskPool::ParallelFor (0, xs.size (), 1, [&] (size_t first, size_t last)
+  {
+    gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, 3);
+    gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, 3);
+    gsl_vector * vec = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, 3);
+    gsl_vector * closest = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::OTHER, 6);
+    
+    //! step through equidistant points in a volume and store the vector values at each point
+    for (size_t xi = first; xi < last; xi++)
+      for (size_t yi = 0; yi < ys.size (); yi++)
+        for (size_t zi = 0; zi < zs.size (); zi++)
+        {
+          double i = xs[xi], j = ys[yi], k = zs[zi];
+          //! find the closest point to the current location
+          P1906MOL_MOTOR_Field::point (pt1, i, j, k);
+          P1906MOL_MOTOR_Field::findClosestPoint (pt1, vf, closest);
+          P1906MOL_MOTOR_Field::point (pt2, 
+            gsl_vector_get (closest, 0),
+            gsl_vector_get (closest, 1),
+            gsl_vector_get (closest, 2));
+          
+          //! check if distance within range
+          if (P1906MOL_MOTOR_Field::distance(pt1, pt2) > 2.0 * xStepsize)
+          {
+            //! if not, store the null vector
+            P1906MOL_MOTOR_Field::point (vec, 0.0, 0.0, 0.0);
+          } 
+          else 
+          {
+            //! otherwise, store the vector value
+            P1906MOL_MOTOR_Field::point (vec,
+              gsl_vector_get (closest, 3),
+              gsl_vector_get (closest, 4),
+              gsl_vector_get (closest, 5));
+          }
+          //! print current location and stored vector value
+          appendRow (planes[xi],
+            i, 
+            j,
+            k, 
+            gsl_vector_get (vec, 0),
+            gsl_vector_get (vec, 1),
+            gsl_vector_get (vec, 2));
+        }
+    P1906MemoryTracker::VectorFree (pt1);
+    P1906MemoryTracker::VectorFree (pt2);
+    P1906MemoryTracker::VectorFree (vec);
+    P1906MemoryTracker::VectorFree (closest);
+  });
+  
+  for (size_t xi = 0; xi < planes.size (); xi++)
+    buf += planes[xi];
 	  
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 P1906MOL_MOTOR_MATLABHelper::~P1906MOL_MOTOR_MATLABHelper ()
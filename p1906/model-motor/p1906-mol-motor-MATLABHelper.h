@@ -40,6 +40,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <string>
 using namespace std;
 
 #include "ns3/object.h"
@@ -80,9 +81,15 @@ public:
   void vectorFieldMeshMATLAB(gsl_matrix * vf, const char * fname);
   //! write a list of vectors into file fname in MATLAB loadable format
   void vectorFieldPlotMATLAB(gsl_matrix * vf, const char * fname);  
+  //! write a list of vectors into file fname as the variable vf of a binary MATLAB .mat file
+  void vectorField2Mat(gsl_matrix * vf, const char * fname);
   
   virtual ~P1906MOL_MOTOR_MATLABHelper ();
 
+private:
+  //! append a row of six values in MATLAB loadable format
+  void appendRow(string & buf, double x, double y, double z, double u, double v, double w);
+
 };
 
 }
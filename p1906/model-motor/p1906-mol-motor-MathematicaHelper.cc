@@ -29,6 +29,7 @@
  *
  * <pre>
  * Create ASCII files designed for import into Mathematica
+ * The files are formatted in memory and written by P1906MOL_MOTOR_ExportService
  * +---------+                       +-------------+
  * |         |      +----------+     |             |
  * |   NS-3  +--->  |  *.mma   +---> | Mathematica |
@@ -44,6 +45,7 @@
 
 #include "ns3/p1906-mol-motor-MathematicaHelper.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-export-service.h"
 
 namespace ns3 {
 
@@ -78,177 +80,173 @@ P1906MOL_MOTOR_MathematicaHelper::P1906MOL_MOTOR_MathematicaHelper ()
 //! display the vector field in Mathematica format for VectorPlot3D in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorFieldPlotMma(gsl_matrix * vf, const char * fname)
 {
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  string buf;
+  buf.reserve (vf->size1 * 6 * 16 + 64);
   
-  fprintf (pFile, "ListVectorPlot3D[{");
+  buf += "ListVectorPlot3D[{";
   for (size_t i = 0; i < vf->size1; i++)
   {
-    fprintf (pFile, "{{%lf, %lf, %lf}, {%lf, %lf, %lf}}", 
+    buf += '{';
+    P1906MOL_MOTOR_ExportService::appendPoint (buf,
 	  gsl_matrix_get (vf, i, 0),
 	  gsl_matrix_get (vf, i, 1),
-	  gsl_matrix_get (vf, i, 2),
+	  gsl_matrix_get (vf, i, 2));
+    buf += ", ";
+    P1906MOL_MOTOR_ExportService::appendPoint (buf,
 	  gsl_matrix_get (vf, i, 3),
 	  gsl_matrix_get (vf, i, 4),
 	  gsl_matrix_get (vf, i, 5));
-    if (i < (vf->size1 - 1)) fprintf (pFile, ", ");
+    buf += '}';
+    if (i < (vf->size1 - 1)) buf += ", ";
   }
-  //! fprintf (pFile, "}, ");
-  //! fprintf (pFile, ", PlotStyle -> {Dashed, Thick, Red}");
-  fprintf (pFile, "}]\n");
+  //! buf += "}, ";
+  //! buf += ", PlotStyle -> {Dashed, Thick, Red}";
+  buf += "}]\n";
   //! option to print vertex labels
-  //! fprintf (pFile, "}, VertexLabeling -> True]\n");
+  //! buf += "}, VertexLabeling -> True]\n";
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! write the vector field in Mathematica format using regular spacing between samples in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorFieldMeshMma(gsl_matrix * vf, const char * fname)
 {
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
-  
-  fprintf (pFile, "ListVectorPlot3D[{");
-  for (size_t i = 0; i < vf->size1; i++)
-  {
-    fprintf (pFile, "{{%f, %f, %f}, {%f, %f, %f}}", 
-	  gsl_matrix_get (vf, i, 0),
-	  gsl_matrix_get (vf, i, 1),
-	  gsl_matrix_get (vf, i, 2),
-	  gsl_matrix_get (vf, i, 3),
-	  gsl_matrix_get (vf, i, 4),
-	  gsl_matrix_get (vf, i, 5));
-    if (i < (vf->size1 - 1)) fprintf (pFile, ", ");
-  }
-  //! fprintf (pFile, "}, ");
-  //! fprintf (pFile, ", PlotStyle -> {Dashed, Thick, Red}");
-  fprintf (pFile, "}]\n");
-  //! option to print vertex labels
-  //! fprintf (pFile, "}, VertexLabeling -> True]\n");
-  
-  fclose(pFile);
+  //! the mesh and the plot share the same ListVectorPlot3D format
+  vectorFieldPlotMma (vf, fname);
 }
 
 //! write the vector field in Mathematica format using regular spacing between samples in file fname
 void P1906MOL_MOTOR_MathematicaHelper::vectorPlotMma(gsl_matrix * vf, const char * fname)
 {
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  string buf;
+  buf.reserve (vf->size1 * 6 * 16 + 64);
   
-  fprintf (pFile, "Graphics3D[{");
+  buf += "Graphics3D[{";
   for (size_t i = 0; i < vf->size1; i++)
   {
     //Graphics3D[{Arrow[{{0, 0, 1}, {1, 1, 1}}], Arrow[{{0, 0, 0}, {-1, 1, 1}}]}, Axes -> True]
-    fprintf (pFile, "Arrow[{{%lf, %lf, %lf}, {%lf, %lf, %lf}}]", 
+    buf += "Arrow[{";
+    P1906MOL_MOTOR_ExportService::appendPoint (buf,
 	  gsl_matrix_get (vf, i, 0),
 	  gsl_matrix_get (vf, i, 1),
-	  gsl_matrix_get (vf, i, 2),
+	  gsl_matrix_get (vf, i, 2));
+    buf += ", ";
+    P1906MOL_MOTOR_ExportService::appendPoint (buf,
 	  gsl_matrix_get (vf, i, 3),
 	  gsl_matrix_get (vf, i, 4),
 	  gsl_matrix_get (vf, i, 5));
-    if (i < (vf->size1 - 1)) fprintf (pFile, ", ");
+    buf += "}]";
+    if (i < (vf->size1 - 1)) buf += ", ";
   }
-  fprintf (pFile, "}, Axes -> True]\n");
+  buf += "}, Axes -> True]\n";
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! print the points (vertices) in pts in Mathematica format into file fname and include edges between the vertices
-void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> pts, const char * fname)
+void P1906MOL_MOTOR_MathematicaHelper::connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname)
 {
-  FILE * pFile;
+  string buf;
   double x, y, z;
   
-  pFile = fopen (fname,"w");
+  buf.reserve (pts.size() * 80 + 128);
   size_t pt = 1;
   
-  fprintf (pFile, "GraphPlot3D[{");
+  buf += "GraphPlot3D[{";
   for (size_t i = 0; i < pts.size(); i++)
   {
-    fprintf (pFile, "%ld -> ", pt);
+    P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+    buf += " -> ";
 	pt++;
-	fprintf (pFile, "%ld", pt);
-    if (i < (pts.size() - 1)) fprintf (pFile, ", ");
+	P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+    if (i < (pts.size() - 1)) buf += ", ";
   }
-  fprintf (pFile, "}, ");
+  buf += "}, ";
   pt = 1;
-  fprintf (pFile, "VertexCoordinateRules ->{");
+  buf += "VertexCoordinateRules ->{";
   for (size_t i = 0; i < pts.size(); i++)
   {
 	pts.at(i).getPos (&x, &y, &z);
-    fprintf (pFile, "%ld -> {%f, %f, %f}", pt, x, y, z);
+    P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+    buf += " -> ";
+    P1906MOL_MOTOR_ExportService::appendPoint (buf, x, y, z);
     pt++;
-	if (i < (pts.size() - 1)) fprintf (pFile, ", ");
+	if (i < (pts.size() - 1)) buf += ", ";
   }
-  fprintf (pFile, "}");
-  fprintf (pFile, ", PlotStyle -> {Dashed, Thick, Red}");
-  fprintf (pFile, "]\n");
+  buf += "}";
+  buf += ", PlotStyle -> {Dashed, Thick, Red}";
+  buf += "]\n";
   //! option to print vertex labels
-  //! fprintf (pFile, "}, VertexLabeling -> True]\n");
+  //! buf += "}, VertexLabeling -> True]\n";
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! print the first numPts points pts in Mathematica format in file fname
 void P1906MOL_MOTOR_MathematicaHelper::points2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname)
 {
-  FILE * pFile;
-  P1906MOL_MOTOR_Pos pt;
+  string buf;
   double x, y, z;
   
-  pFile = fopen (fname,"w");
+  buf.reserve (pts.size() * 48 + 64);
   
-  fprintf (pFile, "Graphics3D[{PointSize[Large], Blue, ");
+  buf += "Graphics3D[{PointSize[Large], Blue, ";
   for (size_t i = 0; i < pts.size(); i++)
   {
-	pt = pts.at(i);
-	pt.getPos(&x, &y, &z);
-    fprintf (pFile, "Point[{%f, %f, %f}]", x, y, z);
-	if (i < pts.size() - 1) fprintf (pFile, ", ");
+	pts.at(i).getPos(&x, &y, &z);
+    buf += "Point[";
+    P1906MOL_MOTOR_ExportService::appendPoint (buf, x, y, z);
+    buf += ']';
+	if (i < pts.size() - 1) buf += ", ";
   }
-  fprintf (pFile, "}]\n");
+  buf += "}]\n";
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! display the volume surface in Mathematica format into file fname
 void P1906MOL_MOTOR_MathematicaHelper::volSurfacePlot(P1906MOL_MOTOR_Pos center, double radius, const char * fname)
 {
-  FILE * pFile;
+  string buf;
   double x, y, z;
   
-  pFile = fopen (fname,"w");
-  
   center.getPos (&x, &y, &z);
-  fprintf (pFile, "Graphics3D[{Opacity[0.5], Sphere[{%lf, %lf, %lf}, %lf]}, Axes -> True]\n", x, y, z, radius);
+  buf += "Graphics3D[{Opacity[0.5], Sphere[";
+  P1906MOL_MOTOR_ExportService::appendPoint (buf, x, y, z);
+  buf += ", ";
+  P1906MOL_MOTOR_ExportService::appendDouble (buf, radius);
+  buf += "]}, Axes -> True]\n";
     
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! print a plot of x,y values in vals in Mathematica format into file fname
 void P1906MOL_MOTOR_MathematicaHelper::plot2Mma(gsl_matrix * vals, const char * fname, const char * xlabel, const char * ylabel)
 {
-  FILE * pFile;
+  string buf;
   size_t numVals = vals->size1;
   
-  pFile = fopen (fname,"w");
+  buf.reserve (numVals * 32 + 128);
   
-  fprintf (pFile, "ListLinePlot[{");
+  buf += "ListLinePlot[{";
   for (size_t i = 0; i < numVals; i++)
   {
-    fprintf (pFile, "{%f, %f}", 
-	  gsl_matrix_get(vals, i, 0), 
-	  gsl_matrix_get(vals, i, 1));
-    if (i < (numVals - 1)) fprintf (pFile, ", ");
+    buf += '{';
+    P1906MOL_MOTOR_ExportService::appendDouble (buf, gsl_matrix_get(vals, i, 0));
+    buf += ", ";
+    P1906MOL_MOTOR_ExportService::appendDouble (buf, gsl_matrix_get(vals, i, 1));
+    buf += '}';
+    if (i < (numVals - 1)) buf += ", ";
   }
-  fprintf (pFile, "}");
-  fprintf (pFile, ", AxesLabel -> {\"%s\", \"%s\"}, GridLines -> Automatic", xlabel, ylabel);
-  fprintf (pFile, "]\n");
+  buf += "}";
+  buf += ", AxesLabel -> {\"";
+  buf += xlabel;
+  buf += "\", \"";
+  buf += ylabel;
+  buf += "\"}, GridLines -> Automatic";
+  buf += "]\n";
   
-  fclose(pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 //! print all tubes in tubeMatrix into a Mathematica file fname with segments per tube of segPerTube
@@ -258,76 +256,61 @@ void P1906MOL_MOTOR_MathematicaHelper::tubes2Mma(gsl_matrix * tubeMatrix, size_t
     GraphPlot3D[{1 -> 2, 1 -> 4, 1 -> 5, 2 -> 3, 2 -> 6, 3 -> 4, 3 -> 7, 4 -> 8, 5 -> 6, 5 -> 8, 6 -> 7, 7 -> 8}, 
 	VertexCoordinateRules -> {1 -> {0, 1, 2}, 2 -> {-1, 0, 2}, 3 -> {0, -1, 2}, 4 -> {1, 0, 2}, 5 -> {0, 2, 0}, 6 -> {-2, 0, 0}, 7 -> {0, -2, 0}, 8 -> {2, 0, 0}}]
   */
-  FILE * pFile;
-
-  pFile = fopen (fname,"w");
+  string buf;
   
   size_t numSegments = tubeMatrix->size1;
   size_t pt = 1;
   size_t numTubes = numSegments / segPerTube;
   
-  //printf ("(tubes2Mma) tubeMatrix: %ld x %ld\n", tubeMatrix->size1, tubeMatrix->size2);
-  //printf ("(tubes2Mma) numTubes: %ld segPerTube: %ld\n", numTubes, segPerTube);
-  //gsl_matrix_fprintf (stdout, tubeMatrix, "%f");
+  buf.reserve (numSegments * 100 + 128);
   
-  fprintf (pFile, "GraphPlot3D[{");
+  buf += "GraphPlot3D[{";
   for (size_t i = 0; i < numTubes; i++)
   {
     for (size_t j = 0; j < segPerTube; j++)
 	{
-      fprintf (pFile, "%ld -> ", pt);
+      P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+      buf += " -> ";
 	  pt++;
-	  fprintf (pFile, "%ld", pt);
-      if ((i < (numTubes - 1)) || (j < (segPerTube - 1))) fprintf (pFile, ", ");
+	  P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+      if ((i < (numTubes - 1)) || (j < (segPerTube - 1))) buf += ", ";
 	}
     pt++;
   }
-  fprintf (pFile, "}, ");
+  buf += "}, ";
   pt = 1;
-  fprintf (pFile, "VertexCoordinateRules ->{");
+  buf += "VertexCoordinateRules ->{";
     for (size_t i = 0; i < numTubes; i++)
 	{
       for (size_t j = 0; j < segPerTube; j++)
 	  {
 	    if (j == 0) //! only print the ends after the first one
 	    {
-		  //printf ("(tubes2Mma) i: %ld j: %ld index: %ld pos: %f %f %f\n", 
-		  //  i, 
-		  //  j, 
-		  //  i * segPerTube + j,
-		  //  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 0),
-		  //  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 1),
-		  //  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 2));
-			
-          fprintf (pFile, "%ld -> {%lf, %lf, %lf}, ",
-		    pt,
+          P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+          buf += " -> ";
+          P1906MOL_MOTOR_ExportService::appendPoint (buf,
 	        gsl_matrix_get(tubeMatrix, i * segPerTube + j, 0),
 		    gsl_matrix_get(tubeMatrix, i * segPerTube + j, 1),
 		    gsl_matrix_get(tubeMatrix, i * segPerTube + j, 2));
+          buf += ", ";
 		  pt++;
         }
-		//printf ("(tubes2Mma) i: %ld j: %ld index: %ld pos: %f %f %f\n", 
-		//  i, 
-		//  j, 
-		//  i * segPerTube + j,
-		//  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 3),
-		//  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 4),
-		//  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 5));
 		  
-		fprintf (pFile, "%ld -> {%lf, %lf, %lf}", 
-		  pt,
+		P1906MOL_MOTOR_ExportService::appendSize (buf, pt);
+		buf += " -> ";
+		P1906MOL_MOTOR_ExportService::appendPoint (buf,
 		  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 3),
 		  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 4),
 		  gsl_matrix_get(tubeMatrix, i * segPerTube + j, 5));
 		pt++;
-	    if ((i < (numTubes - 1)) || (j < (segPerTube - 1))) fprintf (pFile, ", ");
+	    if ((i < (numTubes - 1)) || (j < (segPerTube - 1))) buf += ", ";
 	  }
 	}
-  fprintf (pFile, "}]\n");
+  buf += "}]\n";
   //! option to print vertex labels
-  //! fprintf (pFile, "}, VertexLabeling -> True]\n");
+  //! buf += "}, VertexLabeling -> True]\n";
   
-  fclose (pFile);
+  P1906MOL_MOTOR_ExportService::getService ()->submit (fname, buf);
 }
 
 P1906MOL_MOTOR_MathematicaHelper::~P1906MOL_MOTOR_MathematicaHelper ()
@@ -96,7 +96,7 @@ public:
   //! write a list of points into file fname in Mathematica format
   void points2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname);
   //! write a list of connected points into file fname in Mathematica format
-  void connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> pts, const char * fname);
+  void connectedPoints2Mma(vector<P1906MOL_MOTOR_Pos> & pts, const char * fname);
   
   /*
    * Plot and segment display methods
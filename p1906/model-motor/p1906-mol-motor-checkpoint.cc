@@ -0,0 +1,898 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details This class writes incremental checkpoints of motor and molecular simulations.
+ *
+ * <pre>
+ * File layout: a file header followed by records, each a record_t and its data
+ * +--------+-------+-------+--------+-------+--------+-------+--------+
+ * | header | block | block | commit | block | commit | block | (torn) |
+ * +--------+-------+-------+--------+-------+--------+-------+--------+
+ *           checkpoint 0             checkpoint 1      ignored on restart
+ * </pre>
+ */
+
+#include "ns3/log.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+
+#include "ns3/p1906-medium.h"
+#include "ns3/p1906-message-carrier.h"
+#include "ns3/p1906-communication-interface.h"
+#include "ns3/p1906-mol-message-carrier.h"
+#include "ns3/p1906-energy-ledger.h"
+#include "ns3/p1906-specificity-collector.h"
+#include "ns3/p1906-mol-motor.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "ns3/p1906-mol-motor-microtubule.h"
+#include "ns3/p1906-mol-motor-checkpoint.h"
+#include "ns3/p1906-memory-tracker.h"
+
+#include <sstream>
+#include <cstring>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Checkpoint");
+
+//! the file header
+static const char checkpointMagic[8] = { 'P', '1', '9', '0', '6', 'C', 'K', 'P' };
+static const uint32_t checkpointVersion = 2;
+
+//! the carrier types whose state can be checkpointed
+enum carrierKind { BaseCarrier = 0, MOLCarrier, MotorCarrier, UnsupportedCarrier = 0xff };
+
+//! append size raw bytes to buf
+static void putRaw(string & buf, const void * data, size_t size)
+{
+  buf.append ((const char *) data, size);
+}
+
+//! read size raw bytes from p, return false if fewer than size bytes are left
+static bool getRaw(const char * & p, const char * end, void * data, size_t size)
+{
+  if ((size_t) (end - p) < size)
+    return false;
+  memcpy (data, p, size);
+  p += size;
+  return true;
+}
+
+TypeId P1906MOL_MOTOR_Checkpoint::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_Checkpoint")
+    .SetParent<Object> ();
+  return tid;
+}
+
+P1906MOL_MOTOR_Checkpoint::P1906MOL_MOTOR_Checkpoint ()
+{
+  saveMetrics = true;
+  file = 0;
+  checkpoints = 0;
+  dirtyBlocks = 0;
+  lastBytes = 0;
+}
+
+void P1906MOL_MOTOR_Checkpoint::addMotor(Ptr<P1906MOL_Motor> m)
+{
+  motors.push_back (m);
+}
+
+void P1906MOL_MOTOR_Checkpoint::addField(Ptr<P1906MOL_MOTOR_MicrotubulesField> f)
+{
+  fields.push_back (f);
+}
+
+void P1906MOL_MOTOR_Checkpoint::addMedium(Ptr<P1906Medium> m)
+{
+  m->SetTrackDeliveries (true);
+  media.push_back (m);
+}
+
+void P1906MOL_MOTOR_Checkpoint::setSaveMetrics(bool save)
+{
+  saveMetrics = save;
+}
+
+void P1906MOL_MOTOR_Checkpoint::setFile(const char * fname)
+{
+  if (file)
+  {
+    fclose (file);
+    file = 0;
+  }
+  fileName = fname;
+  writtenHash.clear();
+  writtenSignature.clear();
+}
+
+void P1906MOL_MOTOR_Checkpoint::start(Time i)
+{
+  stop();
+  interval = i;
+  nextCheckpoint = Simulator::Schedule (interval, &P1906MOL_MOTOR_Checkpoint::periodicCheckpoint, this);
+}
+
+void P1906MOL_MOTOR_Checkpoint::stop()
+{
+  Simulator::Cancel (nextCheckpoint);
+}
+
+void P1906MOL_MOTOR_Checkpoint::periodicCheckpoint()
+{
+  checkpoint();
+  nextCheckpoint = Simulator::Schedule (interval, &P1906MOL_MOTOR_Checkpoint::periodicCheckpoint, this);
+}
+
+uint64_t P1906MOL_MOTOR_Checkpoint::hash(const char * data, size_t size)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; i++)
+  {
+    h ^= (uint8_t) data[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+uint64_t P1906MOL_MOTOR_Checkpoint::key(uint32_t kind, uint32_t index)
+{
+  return ((uint64_t) kind << 32) | index;
+}
+
+//! a file restored from is extended, any other file is replaced
+bool P1906MOL_MOTOR_Checkpoint::openFile()
+{
+  if (file)
+    return true;
+  if (fileName.empty())
+  {
+    NS_LOG_WARN ("No checkpoint file set");
+    return false;
+  }
+  
+  bool append = !writtenHash.empty();
+  file = fopen (fileName.c_str(), append ? "ab" : "wb");
+  if (!file)
+  {
+    NS_LOG_WARN ("Cannot open " << fileName);
+    return false;
+  }
+  if (!append)
+  {
+    uint32_t h[2] = { checkpointVersion, (uint32_t) Time::GetResolution () };
+    fwrite (checkpointMagic, sizeof (checkpointMagic), 1, file);
+    fwrite (h, sizeof (h), 1, file);
+  }
+  return true;
+}
+
+void P1906MOL_MOTOR_Checkpoint::writeRecord(uint32_t kind, uint32_t index, const string & buf, uint64_t h)
+{
+  record_t rec;
+  rec.kind = kind;
+  rec.index = index;
+  rec.size = buf.size();
+  rec.hash = h;
+  fwrite (&rec, sizeof (rec), 1, file);
+  fwrite (buf.data(), 1, buf.size(), file);
+}
+
+size_t P1906MOL_MOTOR_Checkpoint::checkpoint()
+{
+  if (!openFile())
+    return 0;
+  
+  //! the blocks in a fixed order: motors, fields, media, metrics
+  vector< pair<uint32_t, uint32_t> > blocks;
+  for (size_t i = 0; i < motors.size(); i++)
+    blocks.push_back (make_pair ((uint32_t) MotorBlock, (uint32_t) i));
+  for (size_t i = 0; i < fields.size(); i++)
+    blocks.push_back (make_pair ((uint32_t) FieldBlock, (uint32_t) i));
+  for (size_t i = 0; i < media.size(); i++)
+    blocks.push_back (make_pair ((uint32_t) MediumBlock, (uint32_t) i));
+  if (saveMetrics)
+    blocks.push_back (make_pair ((uint32_t) MetricsBlock, (uint32_t) 0));
+  
+  //! serialize only the blocks whose signature changed, write only those whose content changed
+  string buf;
+  size_t bytes = 0;
+  dirtyBlocks = 0;
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    uint64_t k = key (blocks[i].first, blocks[i].second);
+    uint64_t s = signature (blocks[i].first, blocks[i].second);
+    map<uint64_t, uint64_t>::iterator it = writtenSignature.find (k);
+    if (it != writtenSignature.end() && it->second == s && writtenHash.count (k))
+      continue;
+    writtenSignature[k] = s;
+  
+    buf.clear();
+    saveBlock (blocks[i].first, blocks[i].second, buf);
+    uint64_t h = hash (buf.data(), buf.size());
+    it = writtenHash.find (k);
+    if (it != writtenHash.end() && it->second == h)
+      continue;
+    writeRecord (blocks[i].first, blocks[i].second, buf, h);
+    writtenHash[k] = h;
+    bytes += sizeof (record_t) + buf.size();
+    dirtyBlocks++;
+  }
+  
+  //! the commit record makes the checkpoint valid
+  checkpointTime = Simulator::Now ();
+  int64_t now = checkpointTime.GetTimeStep ();
+  buf.assign ((const char *) &now, sizeof (now));
+  writeRecord (CommitBlock, (uint32_t) checkpoints, buf, hash (buf.data(), buf.size()));
+  bytes += sizeof (record_t) + buf.size();
+  
+  fflush (file);
+  fsync (fileno (file));
+  
+  checkpoints++;
+  lastBytes = bytes;
+  NS_LOG_DEBUG ("checkpoint " << checkpoints << " [blocks,bytes] " << dirtyBlocks << " " << bytes);
+  return bytes;
+}
+
+//! write a full checkpoint into a new file which then replaces the current one
+void P1906MOL_MOTOR_Checkpoint::compact()
+{
+  if (file)
+  {
+    fclose (file);
+    file = 0;
+  }
+  string target = fileName;
+  fileName = target + ".tmp";
+  writtenHash.clear();
+  writtenSignature.clear();
+  size_t bytes = checkpoint();
+  fileName = target;
+  if (!file)
+    return;
+  fclose (file);
+  file = 0;
+  if (bytes == 0 || rename ((target + ".tmp").c_str(), target.c_str()) != 0)
+  {
+    NS_LOG_WARN ("Cannot replace " << target);
+    writtenHash.clear();
+    writtenSignature.clear();
+  }
+}
+
+bool P1906MOL_MOTOR_Checkpoint::restore(const char * fname)
+{
+  FILE * f = fopen (fname, "rb");
+  if (!f)
+  {
+    NS_LOG_WARN ("Cannot open " << fname);
+    return false;
+  }
+  
+  char magic[8];
+  uint32_t h[2];
+  if (fread (magic, sizeof (magic), 1, f) != 1 || fread (h, sizeof (h), 1, f) != 1 ||
+      memcmp (magic, checkpointMagic, sizeof (magic)) != 0 || h[0] != checkpointVersion)
+  {
+    NS_LOG_WARN (fname << " is not a checkpoint file");
+    fclose (f);
+    return false;
+  }
+  //! times are kept as time steps
+  if (h[1] != (uint32_t) Time::GetResolution ())
+  {
+    NS_LOG_WARN (fname << " was written with another time resolution");
+    fclose (f);
+    return false;
+  }
+  
+  //! replay the records; blocks become valid at the following commit
+  map<uint64_t, string> committed, staged;
+  map<uint64_t, uint64_t> committedHash, stagedHash;
+  long validLength = ftell (f);
+  int64_t commitTime = 0;
+  bool found = false;
+  record_t rec;
+  string buf;
+  while (fread (&rec, sizeof (rec), 1, f) == 1)
+  {
+    buf.resize (rec.size);
+    if (rec.size > 0 && fread (&buf[0], 1, rec.size, f) != rec.size)
+      break;
+    if (hash (buf.data(), buf.size()) != rec.hash)
+      break;
+    if (rec.kind == CommitBlock)
+    {
+      for (map<uint64_t, string>::iterator it = staged.begin(); it != staged.end(); it++)
+      {
+        committed[it->first].swap (it->second);
+        committedHash[it->first] = stagedHash[it->first];
+      }
+      staged.clear();
+      stagedHash.clear();
+      memcpy (&commitTime, buf.data(), min (buf.size(), sizeof (commitTime)));
+      validLength = ftell (f);
+      found = true;
+    }
+    else
+    {
+      staged[key (rec.kind, rec.index)] = buf;
+      stagedHash[key (rec.kind, rec.index)] = rec.hash;
+    }
+  }
+  fclose (f);
+  
+  if (!found)
+  {
+    NS_LOG_WARN ("No complete checkpoint in " << fname);
+    return false;
+  }
+  
+  //! validate every block before changing any state: a mismatch leaves the registered objects untouched
+  Time previousTime = checkpointTime;
+  checkpointTime = TimeStep (commitTime);
+  vector< function<void ()> > apply;
+  for (map<uint64_t, string>::iterator it = committed.begin(); it != committed.end(); it++)
+  {
+    uint32_t kind = it->first >> 32;
+    uint32_t index = it->first & 0xffffffff;
+    if (!restoreBlock (kind, index, it->second, apply))
+    {
+      NS_LOG_WARN ("Block " << kind << "/" << index << " of " << fname << " does not match the registered objects");
+      checkpointTime = previousTime;
+      return false;
+    }
+  }
+  for (size_t i = 0; i < apply.size(); i++)
+    apply[i] ();
+  
+  //! drop a checkpoint torn by a crash and continue the same file incrementally
+  if (truncate (fname, validLength) != 0)
+    NS_LOG_WARN ("Cannot truncate " << fname);
+  if (file)
+    fclose (file);
+  file = 0;
+  fileName = fname;
+  writtenHash = committedHash;
+  writtenSignature.clear();
+  
+  NS_LOG_DEBUG ("restored " << committed.size() << " blocks from " << fname);
+  return true;
+}
+
+//! the signatures read a few scalars of each object: fields change only through their generator or by
+//! replacing their matrices, media count their delivery changes
+uint64_t P1906MOL_MOTOR_Checkpoint::signature(uint32_t kind, uint32_t index)
+{
+  string buf;
+  switch (kind)
+  {
+    case MotorBlock:
+    {
+      Ptr<P1906MOL_Motor> m = motors.at(index);
+      double v[6];
+      m->current_location.getPos (&v[0], &v[1], &v[2]);
+      v[3] = m->t.time;
+      v[4] = m->energy;
+      v[5] = m->GetMolecules ();
+      uint64_t s[4] = { m->pos_history.size(), m->vsl.size(),
+                        (uint64_t) m->GetStartTime ().GetTimeStep (), P1906MOL_MOTOR_Rng::getStep (m->r) };
+      putRaw (buf, v, sizeof (v));
+      putRaw (buf, s, sizeof (s));
+      for (size_t i = 0; i < m->vsl.size(); i++)
+      {
+        uint64_t step = P1906MOL_MOTOR_Rng::getStep (m->vsl[i].r);
+        putRaw (buf, &step, sizeof (step));
+      }
+      break;
+    }
+    case FieldBlock:
+    {
+      Ptr<P1906MOL_MOTOR_MicrotubulesField> f = fields.at(index);
+      const void * matrices[2] = { f->tubeMatrix, f->vf };
+      uint64_t s[3] = { f->tubeMatrix->size1, f->vf->size1, P1906MOL_MOTOR_Rng::getStep (f->r) };
+      putRaw (buf, &f->ts, sizeof (f->ts));
+      putRaw (buf, matrices, sizeof (matrices));
+      putRaw (buf, s, sizeof (s));
+      break;
+    }
+    case MediumBlock:
+    {
+      Ptr<P1906Medium> m = media.at(index);
+      uint64_t s[2] = { m->GetDeliveriesVersion (), m->GetP1906CommunicationInterfaces ()->size() };
+      putRaw (buf, s, sizeof (s));
+      break;
+    }
+    case MetricsBlock:
+    {
+      Ptr<P1906EnergyLedger> ledger = P1906EnergyLedger::GetLedger ();
+      Ptr<P1906SpecificityCollector> collector = P1906SpecificityCollector::GetCollector ();
+      uint32_t all = P1906SpecificityCollector::ALL_NODES;
+      double energy = ledger->GetTotalEnergy ();
+      uint64_t s[5] = { ledger->GetDeliveredBits (),
+                        collector->GetTruePositives (all), collector->GetFalsePositives (all),
+                        collector->GetTrueNegatives (all), collector->GetFalseNegatives (all) };
+      putRaw (buf, &energy, sizeof (energy));
+      putRaw (buf, s, sizeof (s));
+      break;
+    }
+  }
+  return hash (buf.data(), buf.size());
+}
+
+void P1906MOL_MOTOR_Checkpoint::saveBlock(uint32_t kind, uint32_t index, string & buf)
+{
+  switch (kind)
+  {
+    case MotorBlock:
+      saveMotor (buf, motors.at(index));
+      break;
+    case FieldBlock:
+    {
+      Ptr<P1906MOL_MOTOR_MicrotubulesField> f = fields.at(index);
+      uint64_t rows[2] = { f->tubeMatrix->size1, f->vf->size1 };
+      putRaw (buf, &f->ts, sizeof (f->ts));
+      putRaw (buf, rows, sizeof (rows));
+      for (size_t i = 0; i < f->tubeMatrix->size1; i++)
+        putRaw (buf, gsl_matrix_const_ptr (f->tubeMatrix, i, 0), 6 * sizeof (double));
+      for (size_t i = 0; i < f->vf->size1; i++)
+        putRaw (buf, gsl_matrix_const_ptr (f->vf, i, 0), 6 * sizeof (double));
+      saveRng (buf, f->r);
+      break;
+    }
+    case MediumBlock:
+    {
+      //! carriers in flight with the indexes of their source and destination interfaces and their
+      //! delivery time, which does not change while they propagate
+      Ptr<P1906Medium> m = media.at(index);
+      P1906Medium::P1906CommunicationInterfaces * ci = m->GetP1906CommunicationInterfaces ();
+      const P1906Medium::PendingDeliveries & pending = m->GetPendingDeliveries ();
+      uint64_t n = pending.size();
+      putRaw (buf, &n, sizeof (n));
+      for (P1906Medium::PendingDeliveries::const_iterator it = pending.begin(); it != pending.end(); it++)
+      {
+        uint32_t idx[2] = { 0, 0 };
+        for (size_t i = 0; i < ci->size(); i++)
+        {
+          if (ci->at(i) == it->second.src)
+            idx[0] = i;
+          if (ci->at(i) == it->second.dst)
+            idx[1] = i;
+        }
+        int64_t deliveryTime = it->second.deliveryTime.GetTimeStep ();
+        putRaw (buf, idx, sizeof (idx));
+        putRaw (buf, &deliveryTime, sizeof (deliveryTime));
+        saveCarrier (buf, it->second.message);
+      }
+      break;
+    }
+    case MetricsBlock:
+    {
+      ostringstream os;
+      P1906EnergyLedger::GetLedger ()->SaveState (os);
+      P1906SpecificityCollector::GetCollector ()->SaveState (os);
+      buf += os.str();
+      break;
+    }
+  }
+}
+
+bool P1906MOL_MOTOR_Checkpoint::restoreBlock(uint32_t kind, uint32_t index, const string & buf, vector< function<void ()> > & apply)
+{
+  const char * p = buf.data();
+  const char * end = p + buf.size();
+  
+  switch (kind)
+  {
+    case MotorBlock:
+    {
+      if (index >= motors.size())
+        return false;
+      function<void ()> f;
+      if (!restoreMotor (p, end, motors.at(index), f))
+        return false;
+      apply.push_back (f);
+      return true;
+    }
+    case FieldBlock:
+    {
+      if (index >= fields.size())
+        return false;
+      Ptr<P1906MOL_MOTOR_MicrotubulesField> f = fields.at(index);
+      tubeCharacteristcs_t ts;
+      uint64_t rows[2];
+      if (!getRaw (p, end, &ts, sizeof (ts)) || !getRaw (p, end, rows, sizeof (rows)))
+        return false;
+      if ((uint64_t) (end - p) < (rows[0] + rows[1]) * 6 * sizeof (double))
+        return false;
+      vector<double> tubes (rows[0] * 6), vf (rows[1] * 6);
+      if (rows[0] > 0)
+        getRaw (p, end, &tubes[0], tubes.size() * sizeof (double));
+      if (rows[1] > 0)
+        getRaw (p, end, &vf[0], vf.size() * sizeof (double));
+      string state;
+      if (!restoreRng (p, end, f->r, state))
+        return false;
+      apply.push_back ([f, ts, rows, tubes, vf, state] ()
+      {
+        f->ts = ts;
+        if (f->tubeMatrix->size1 != rows[0])
+        {
+          P1906MemoryTracker::MatrixFree (f->tubeMatrix);
+          f->tubeMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, rows[0], 6);
+        }
+        if (f->vf->size1 != rows[1])
+        {
+          P1906MemoryTracker::MatrixFree (f->vf);
+          f->vf = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, rows[1], 6);
+        }
+        for (size_t i = 0; i < rows[0]; i++)
+          memcpy (gsl_matrix_ptr (f->tubeMatrix, i, 0), &tubes[6 * i], 6 * sizeof (double));
+        for (size_t i = 0; i < rows[1]; i++)
+          memcpy (gsl_matrix_ptr (f->vf, i, 0), &vf[6 * i], 6 * sizeof (double));
+        memcpy (gsl_rng_state (f->r), state.data(), state.size());
+      });
+      return true;
+    }
+    case MediumBlock:
+    {
+      if (index >= media.size())
+        return false;
+      Ptr<P1906Medium> m = media.at(index);
+      P1906Medium::P1906CommunicationInterfaces * ci = m->GetP1906CommunicationInterfaces ();
+      uint64_t n;
+      if (!getRaw (p, end, &n, sizeof (n)))
+        return false;
+      //! the carriers are new objects: they are created here, but scheduled only with the other blocks
+      vector<P1906Medium::PendingDelivery> pending;
+      for (uint64_t i = 0; i < n; i++)
+      {
+        uint32_t idx[2];
+        int64_t deliveryTime;
+        if (!getRaw (p, end, idx, sizeof (idx)) || !getRaw (p, end, &deliveryTime, sizeof (deliveryTime)))
+          return false;
+        if (idx[0] >= ci->size() || idx[1] >= ci->size())
+          return false;
+        uint8_t carrierKind = UnsupportedCarrier;
+        if (p < end)
+          carrierKind = *p;
+        Ptr<P1906MessageCarrier> c = restoreCarrier (p, end);
+        if (!c)
+        {
+          if (carrierKind != UnsupportedCarrier)
+            return false;
+          //! the carrier type cannot be checkpointed, it was dropped
+          continue;
+        }
+        P1906Medium::PendingDelivery d;
+        d.src = ci->at(idx[0]);
+        d.dst = ci->at(idx[1]);
+        d.message = c;
+        d.deliveryTime = TimeStep (deliveryTime) - checkpointTime;  //! the remaining delay
+        pending.push_back (d);
+      }
+      apply.push_back ([m, pending] ()
+      {
+        m->CancelPendingDeliveries ();
+        for (size_t i = 0; i < pending.size(); i++)
+          m->ScheduleDelivery (pending[i].src, pending[i].dst, pending[i].message, pending[i].deliveryTime);
+      });
+      return true;
+    }
+    case MetricsBlock:
+    {
+      //! read into scratch objects first, the shared ones are then restored from the same bytes
+      istringstream is (buf);
+      if (!CreateObject<P1906EnergyLedger> ()->RestoreState (is) ||
+          !CreateObject<P1906SpecificityCollector> ()->RestoreState (is))
+        return false;
+      apply.push_back ([buf] ()
+      {
+        istringstream is (buf);
+        P1906EnergyLedger::GetLedger ()->RestoreState (is);
+        P1906SpecificityCollector::GetCollector ()->RestoreState (is);
+      });
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void P1906MOL_MOTOR_Checkpoint::saveCarrier(string & buf, Ptr<P1906MessageCarrier> c)
+{
+  uint8_t kind = BaseCarrier;
+  if (DynamicCast<P1906MOL_Motor> (c))
+    kind = MotorCarrier;
+  else if (DynamicCast<P1906MOLMessageCarrier> (c))
+    kind = MOLCarrier;
+  else if (c->GetInstanceTypeId () != P1906MessageCarrier::GetTypeId ())
+  {
+    //! e.g., EM carriers reference a SpectrumModel which is not serialized
+    NS_LOG_WARN ("Carrier " << c->GetInstanceTypeId ().GetName () << " cannot be checkpointed");
+    kind = UnsupportedCarrier;
+  }
+  putRaw (buf, &kind, sizeof (kind));
+  if (kind == UnsupportedCarrier)
+    return;
+  
+  //! the packet payload
+  Ptr<Packet> pkt = c->GetMessage ();
+  uint32_t size = pkt ? pkt->GetSize () : 0xffffffff;
+  putRaw (buf, &size, sizeof (size));
+  if (pkt)
+  {
+    vector<uint8_t> data (size + 1);
+    pkt->CopyData (&data[0], size);
+    putRaw (buf, &data[0], size);
+  }
+  
+  if (kind == MOLCarrier)
+  {
+    Ptr<P1906MOLMessageCarrier> mol = DynamicCast<P1906MOLMessageCarrier> (c);
+    int64_t t[3] = { mol->GetDuration ().GetTimeStep (),
+                     mol->GetPulseInterval ().GetTimeStep (),
+                     mol->GetStartTime ().GetTimeStep () };
+    double molecules = mol->GetMolecules ();
+    putRaw (buf, t, sizeof (t));
+    putRaw (buf, &molecules, sizeof (molecules));
+  }
+  else if (kind == MotorCarrier)
+    saveMotor (buf, DynamicCast<P1906MOL_Motor> (c));
+}
+
+Ptr<P1906MessageCarrier> P1906MOL_MOTOR_Checkpoint::restoreCarrier(const char * & p, const char * end)
+{
+  uint8_t kind;
+  uint32_t size;
+  if (!getRaw (p, end, &kind, sizeof (kind)) || kind == UnsupportedCarrier)
+    return 0;
+  if (!getRaw (p, end, &size, sizeof (size)))
+    return 0;
+  
+  Ptr<Packet> pkt = 0;
+  if (size != 0xffffffff)
+  {
+    if ((size_t) (end - p) < size)
+      return 0;
+    pkt = Create<Packet> ((const uint8_t *) p, size);
+    p += size;
+  }
+  
+  Ptr<P1906MessageCarrier> c;
+  if (kind == MOLCarrier)
+  {
+    int64_t t[3];
+    double molecules;
+    if (!getRaw (p, end, t, sizeof (t)) || !getRaw (p, end, &molecules, sizeof (molecules)))
+      return 0;
+    Ptr<P1906MOLMessageCarrier> mol = CreateObject<P1906MOLMessageCarrier> ();
+    mol->SetDuration (TimeStep (t[0]));
+    mol->SetPulseInterval (TimeStep (t[1]));
+    mol->SetStartTime (TimeStep (t[2]));
+    mol->SetMolecules (molecules);
+    c = mol;
+  }
+  else if (kind == MotorCarrier)
+  {
+    //! motors in flight are arrival copies, their generator state is overwritten
+    Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> (P1906MOL_MOTOR_Rng::Arrival);
+    function<void ()> apply;
+    if (!restoreMotor (p, end, motor, apply))
+      return 0;
+    apply ();
+    motor->arrived = true;
+    c = motor;
+  }
+  else
+    c = CreateObject<P1906MessageCarrier> ();
+  
+  c->SetMessage (pkt);
+  return c;
+}
+
+void P1906MOL_MOTOR_Checkpoint::saveMotor(string & buf, Ptr<P1906MOL_Motor> m)
+{
+  double x, y, z;
+  m->current_location.getPos (&x, &y, &z);
+  double v[8] = { m->start_x, m->start_y, m->start_z, x, y, z, m->t.time, m->energy };
+  putRaw (buf, v, sizeof (v));
+  
+  //! the molecular carrier properties of the motor
+  int64_t t[3] = { m->GetDuration ().GetTimeStep (),
+                   m->GetPulseInterval ().GetTimeStep (),
+                   m->GetStartTime ().GetTimeStep () };
+  double molecules = m->GetMolecules ();
+  putRaw (buf, t, sizeof (t));
+  putRaw (buf, &molecules, sizeof (molecules));
+  
+  uint64_t n = m->pos_history.size();
+  putRaw (buf, &n, sizeof (n));
+  for (size_t i = 0; i < n; i++)
+  {
+    double h[3];
+    m->pos_history[i].getPos (&h[0], &h[1], &h[2]);
+    putRaw (buf, h, sizeof (h));
+  }
+  saveRng (buf, m->r);
+  
+  n = m->vsl.size();
+  putRaw (buf, &n, sizeof (n));
+  for (size_t i = 0; i < n; i++)
+  {
+    double s[4];
+    int32_t type = m->vsl[i].getType ();
+    m->vsl[i].center.getPos (&s[0], &s[1], &s[2]);
+    s[3] = m->vsl[i].radius;
+    putRaw (buf, s, sizeof (s));
+    putRaw (buf, &type, sizeof (type));
+    saveRng (buf, m->vsl[i].r);
+  }
+}
+
+bool P1906MOL_MOTOR_Checkpoint::restoreMotor(const char * & p, const char * end, Ptr<P1906MOL_Motor> m, function<void ()> & apply)
+{
+  //! a volume surface as read from the block
+  struct surface_t
+  {
+    double s[4];
+    int32_t type;
+    string state;
+  };
+  
+  double v[8];
+  int64_t t[3];
+  double molecules;
+  uint64_t n;
+  if (!getRaw (p, end, v, sizeof (v)) || !getRaw (p, end, t, sizeof (t)) ||
+      !getRaw (p, end, &molecules, sizeof (molecules)) || !getRaw (p, end, &n, sizeof (n)))
+    return false;
+  
+  if ((uint64_t) (end - p) < n * 3 * sizeof (double))
+    return false;
+  vector<double> history (n * 3);
+  if (n > 0)
+    getRaw (p, end, &history[0], history.size() * sizeof (double));
+  string state;
+  if (!restoreRng (p, end, m->r, state))
+    return false;
+  
+  if (!getRaw (p, end, &n, sizeof (n)))
+    return false;
+  if ((uint64_t) (end - p) < n * (4 * sizeof (double) + sizeof (int32_t)))
+    return false;
+  bool rebuild = (n != m->vsl.size());
+  vector<surface_t> surfaces (n);
+  for (size_t i = 0; i < n; i++)
+  {
+    if (!getRaw (p, end, surfaces[i].s, sizeof (surfaces[i].s)) ||
+        !getRaw (p, end, &surfaces[i].type, sizeof (surfaces[i].type)))
+      return false;
+    //! rebuilt surfaces get generators of the type of the motor generator
+    if (!restoreRng (p, end, rebuild ? m->r : m->vsl[i].r, surfaces[i].state))
+      return false;
+  }
+  
+  apply = [m, v, t, molecules, history, state, rebuild, surfaces] ()
+  {
+    m->start_x = v[0];
+    m->start_y = v[1];
+    m->start_z = v[2];
+    m->setLocation (v[3], v[4], v[5]);
+    m->t.time = v[6];
+    m->energy = v[7];
+    m->SetDuration (TimeStep (t[0]));
+    m->SetPulseInterval (TimeStep (t[1]));
+    m->SetStartTime (TimeStep (t[2]));
+    m->SetMolecules (molecules);
+  
+    m->pos_history.resize (history.size() / 3);
+    for (size_t i = 0; i < m->pos_history.size(); i++)
+      m->pos_history[i].setPos (history[3 * i], history[3 * i + 1], history[3 * i + 2]);
+    memcpy (gsl_rng_state (m->r), state.data(), state.size());
+  
+    if (rebuild)
+      m->vsl.clear();
+    for (size_t i = 0; i < surfaces.size(); i++)
+    {
+      P1906MOL_MOTOR_Pos c;
+      c.setPos (surfaces[i].s[0], surfaces[i].s[1], surfaces[i].s[2]);
+      if (rebuild)
+        m->addVolumeSurface (c, surfaces[i].s[3], (P1906MOL_MOTOR_VolSurface::typeOfVolume) surfaces[i].type);
+      else
+      {
+        m->vsl[i].setVolume (c, surfaces[i].s[3]);
+        m->vsl[i].setType ((P1906MOL_MOTOR_VolSurface::typeOfVolume) surfaces[i].type);
+      }
+      memcpy (gsl_rng_state (m->vsl[i].r), surfaces[i].state.data(), surfaces[i].state.size());
+    }
+  };
+  return true;
+}
+
+//! the generator is identified by its name; its state is copied as is
+void P1906MOL_MOTOR_Checkpoint::saveRng(string & buf, const gsl_rng * r)
+{
+  string name = gsl_rng_name (r);
+  uint32_t sizes[2] = { (uint32_t) name.size(), (uint32_t) gsl_rng_size (r) };
+  putRaw (buf, sizes, sizeof (sizes));
+  putRaw (buf, name.data(), name.size());
+  putRaw (buf, gsl_rng_state (r), sizes[1]);
+}
+
+bool P1906MOL_MOTOR_Checkpoint::restoreRng(const char * & p, const char * end, const gsl_rng * r, string & state)
+{
+  uint32_t sizes[2];
+  if (!getRaw (p, end, sizes, sizeof (sizes)) || (size_t) (end - p) < (size_t) sizes[0] + sizes[1])
+    return false;
+  string name (p, sizes[0]);
+  p += sizes[0];
+  if (name != gsl_rng_name (r) || sizes[1] != gsl_rng_size (r))
+  {
+    NS_LOG_WARN ("Generator " << name << " does not match " << gsl_rng_name (r));
+    return false;
+  }
+  state.assign (p, sizes[1]);
+  p += sizes[1];
+  return true;
+}
+
+size_t P1906MOL_MOTOR_Checkpoint::getCheckpoints()
+{
+  return checkpoints;
+}
+
+size_t P1906MOL_MOTOR_Checkpoint::getDirtyBlocks()
+{
+  return dirtyBlocks;
+}
+
+size_t P1906MOL_MOTOR_Checkpoint::getLastBytes()
+{
+  return lastBytes;
+}
+
+Time P1906MOL_MOTOR_Checkpoint::getCheckpointTime()
+{
+  return checkpointTime;
+}
+
+P1906MOL_MOTOR_Checkpoint::~P1906MOL_MOTOR_Checkpoint ()
+{
+  NS_LOG_FUNCTION (this);
+  stop();
+  if (file)
+    fclose (file);
+}
+
+} // namespace ns3
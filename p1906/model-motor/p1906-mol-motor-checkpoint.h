@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+
+#ifndef P1906_MOL_MOTOR_CHECKPOINT
+#define P1906_MOL_MOTOR_CHECKPOINT
+
+#include <gsl/gsl_rng.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <cstdio>
+#include <stdint.h>
+using namespace std;
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/event-id.h"
+
+namespace ns3 {
+
+class P1906Medium;
+class P1906MessageCarrier;
+class P1906MOL_Motor;
+class P1906MOL_MOTOR_MicrotubulesField;
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_Checkpoint
+ *
+ * \brief Periodic checkpoint and restart of long motor and molecular simulations
+ *
+ * The state of the registered motors (position, history, time, energy, volume
+ * surfaces and all their gsl_rng states), of the registered microtubule fields
+ * (tubes, vector field and gsl_rng state), of the message carriers propagating
+ * through the registered media and of the global energy ledger and specificity
+ * collector is written as one block per object into an append-only file.
+ *
+ * Each checkpoint appends only the blocks whose content changed since the
+ * previous checkpoint, followed by a commit record. A cheap signature of each
+ * object (e.g., the time, energy, history length and rng step of a motor)
+ * tells which blocks may have changed, so unchanged objects are neither
+ * serialized nor hashed. A restart replays the file up to the last complete
+ * commit, so a crash while writing loses at most one checkpoint interval.
+ *
+ * Registering a medium enables its delivery tracking: carriers scheduled
+ * before addMedium are not checkpointed.
+ *
+ * To restart, build the scenario as in the original run, register the same
+ * objects in the same order and call restore: every block is validated
+ * before any state is changed, then the state is restored in place and the
+ * carriers in flight are rescheduled with their remaining delay relative to
+ * the current simulation time.
+ */
+
+class P1906MOL_MOTOR_Checkpoint : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  
+  P1906MOL_MOTOR_Checkpoint ();
+  
+  /*
+   * Methods related to the checkpointed objects
+   */
+  //! checkpoint the motor m
+  void addMotor(Ptr<P1906MOL_Motor> m);
+  //! checkpoint the microtubule network f
+  void addField(Ptr<P1906MOL_MOTOR_MicrotubulesField> f);
+  //! checkpoint the message carriers propagating through medium m
+  void addMedium(Ptr<P1906Medium> m);
+  //! checkpoint the energy ledger and the specificity collector (default true)
+  void setSaveMetrics(bool save);
+  
+  /*
+   * Methods related to writing checkpoints
+   */
+  //! set the checkpoint file; the file is created by the first checkpoint
+  void setFile(const char * fname);
+  //! write a checkpoint every interval of simulated time
+  void start(Time interval);
+  //! stop the periodic checkpoints
+  void stop();
+  //! write a checkpoint now; return the number of bytes written
+  size_t checkpoint();
+  //! rewrite the file with the last version of each block only
+  void compact();
+  
+  /*
+   * Methods related to restarting
+   */
+  //! restore the registered objects from the last complete checkpoint in fname; return false if none is found
+  bool restore(const char * fname);
+  
+  /*
+   * Statistics
+   */
+  //! return the number of checkpoints written
+  size_t getCheckpoints();
+  //! return the number of blocks written by the last checkpoint
+  size_t getDirtyBlocks();
+  //! return the number of bytes written by the last checkpoint
+  size_t getLastBytes();
+  //! return the simulation time of the last checkpoint written or restored
+  Time getCheckpointTime();
+  
+  virtual ~P1906MOL_MOTOR_Checkpoint ();
+
+private:
+  //! the kind of object a block holds
+  enum blockKind { MotorBlock = 1, FieldBlock, MediumBlock, MetricsBlock, CommitBlock = 0xffff };
+  
+  //! the header of each record of the file
+  struct record_t
+  {
+    uint32_t kind;
+    uint32_t index;
+    uint64_t size;
+    uint64_t hash;
+  };
+  
+  //! return the 64-bit FNV-1a hash of size bytes
+  static uint64_t hash(const char * data, size_t size);
+  static uint64_t key(uint32_t kind, uint32_t index);
+  
+  //! return a value which changes whenever the block may have changed
+  uint64_t signature(uint32_t kind, uint32_t index);
+  //! serialize one block
+  void saveBlock(uint32_t kind, uint32_t index, string & buf);
+  //! validate one block and add the function applying it to apply; return false if it does not match the registered objects
+  bool restoreBlock(uint32_t kind, uint32_t index, const string & buf, vector< function<void ()> > & apply);
+  
+  //! serialize the state of a carrier of any type
+  static void saveCarrier(string & buf, Ptr<P1906MessageCarrier> c);
+  //! create a carrier from its serialized state
+  static Ptr<P1906MessageCarrier> restoreCarrier(const char * & p, const char * end);
+  static void saveMotor(string & buf, Ptr<P1906MOL_Motor> m);
+  //! validate the state of m and set apply to the function restoring it
+  static bool restoreMotor(const char * & p, const char * end, Ptr<P1906MOL_Motor> m, function<void ()> & apply);
+  static void saveRng(string & buf, const gsl_rng * r);
+  //! read the state of a generator of the same type as r into state
+  static bool restoreRng(const char * & p, const char * end, const gsl_rng * r, string & state);
+  
+  //! open the file for appending, writing the file header if it is new
+  bool openFile();
+  //! append a record to the file
+  void writeRecord(uint32_t kind, uint32_t index, const string & buf, uint64_t h);
+  //! body of the periodic checkpoints
+  void periodicCheckpoint();
+  
+  vector< Ptr<P1906MOL_Motor> > motors;
+  vector< Ptr<P1906MOL_MOTOR_MicrotubulesField> > fields;
+  vector< Ptr<P1906Medium> > media;
+  bool saveMetrics;
+  
+  string fileName;
+  FILE * file;
+  //! hash of the last written version of each block
+  map<uint64_t, uint64_t> writtenHash;
+  //! signature of each block when it was last serialized
+  map<uint64_t, uint64_t> writtenSignature;
+  
+  Time interval;
+  EventId nextCheckpoint;
+  
+  size_t checkpoints;
+  size_t dirtyBlocks;
+  size_t lastBytes;
+  Time checkpointTime;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_CHECKPOINT */
@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/* \details This class writes exported data on a background thread.
+ *
+ * <pre>
+ * Helpers format into memory, a single writer thread performs the file I/O
+ * +-------------------+      +---------------+      +--------+      +------------+
+ * | MathematicaHelper | +--> |               |      |        |      |  *.mma     |
+ * +-------------------+      | bounded queue | +--> | writer | +--> |  *.dat     |
+ * | MATLABHelper      | +--> |               |      | thread |      |  *.mat/raw |
+ * +-------------------+      +---------------+      +--------+      +------------+
+ * </pre>
+ */
+
+#include "ns3/log.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include "ns3/p1906-mol-motor-export-service.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_ExportService");
+
+TypeId P1906MOL_MOTOR_ExportService::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_ExportService")
+    .SetParent<Object> ();
+  return tid;
+}
+
+Ptr<P1906MOL_MOTOR_ExportService> P1906MOL_MOTOR_ExportService::getService()
+{
+  static Ptr<P1906MOL_MOTOR_ExportService> service = CreateObject<P1906MOL_MOTOR_ExportService> ();
+  return service;
+}
+
+P1906MOL_MOTOR_ExportService::P1906MOL_MOTOR_ExportService ()
+{
+  pendingBytes = 0;
+  //! default bound on the queued data: 256 MB
+  maxPendingBytes = 256 * 1024 * 1024;
+  writing = false;
+  stopWriter = false;
+  
+  writer = thread (&P1906MOL_MOTOR_ExportService::writerLoop, this);
+}
+
+void P1906MOL_MOTOR_ExportService::setMaxPendingBytes(size_t bytes)
+{
+  lock_guard<mutex> guard (lock);
+  maxPendingBytes = bytes;
+}
+
+size_t P1906MOL_MOTOR_ExportService::getMaxPendingBytes()
+{
+  lock_guard<mutex> guard (lock);
+  return maxPendingBytes;
+}
+
+//! append v with the same text as printf ("%f", v)
+void P1906MOL_MOTOR_ExportService::appendDouble(string & buf, double v)
+{
+  char tmp[352]; //! enough for the largest double in fixed notation
+  to_chars_result res = to_chars (tmp, tmp + sizeof (tmp), v, chars_format::fixed, 6);
+  buf.append (tmp, res.ptr - tmp);
+}
+
+void P1906MOL_MOTOR_ExportService::appendSize(string & buf, size_t v)
+{
+  char tmp[24];
+  to_chars_result res = to_chars (tmp, tmp + sizeof (tmp), v);
+  buf.append (tmp, res.ptr - tmp);
+}
+
+void P1906MOL_MOTOR_ExportService::appendPoint(string & buf, double x, double y, double z)
+{
+  buf += '{';
+  appendDouble (buf, x);
+  buf += ", ";
+  appendDouble (buf, y);
+  buf += ", ";
+  appendDouble (buf, z);
+  buf += '}';
+}
+
+//! the caller only waits if the writer is more than maxPendingBytes behind
+void P1906MOL_MOTOR_ExportService::submit(const char * fname, string & buf)
+{
+  size_t bytes = buf.size ();
+  unique_lock<mutex> guard (lock);
+  
+  //! a single file larger than the bound is accepted when the queue is empty
+  while (pendingBytes > 0 && pendingBytes + bytes > maxPendingBytes)
+    spaceAvailable.wait (guard);
+  
+  jobs.push_back (job_t ());
+  jobs.back ().fname = fname;
+  jobs.back ().data.swap (buf);
+  pendingBytes += bytes;
+  
+  guard.unlock ();
+  jobAvailable.notify_one ();
+}
+
+//! MATLAB Level 4 format: a header of five 32-bit integers, the variable name and the column-major data
+void P1906MOL_MOTOR_ExportService::matrix2Mat(gsl_matrix * m, const char * varName, const char * fname)
+{
+  //! type MOPT: M = 0 little-endian or 1 big-endian IEEE, O = 0, P = 0 double, T = 0 full numeric matrix
+  const uint16_t endian = 1;
+  int32_t header[5];
+  header[0] = (*(const uint8_t *) &endian == 1) ? 0 : 1000;
+  header[1] = m->size1;
+  header[2] = m->size2;
+  header[3] = 0; //! no imaginary part
+  header[4] = strlen (varName) + 1;
+  
+  string buf;
+  buf.reserve (sizeof (header) + header[4] + m->size1 * m->size2 * sizeof (double));
+  buf.append ((const char *) header, sizeof (header));
+  buf.append (varName, header[4]);
+  
+  for (size_t j = 0; j < m->size2; j++)
+    for (size_t i = 0; i < m->size1; i++)
+    {
+      double v = gsl_matrix_get (m, i, j);
+      buf.append ((const char *) &v, sizeof (v));
+    }
+  
+  submit (fname, buf);
+}
+
+void P1906MOL_MOTOR_ExportService::matrix2RawFloat(gsl_matrix * m, const char * fname)
+{
+  string buf;
+  buf.resize (m->size1 * m->size2 * sizeof (float));
+  
+  char * out = &buf[0];
+  for (size_t i = 0; i < m->size1; i++)
+    for (size_t j = 0; j < m->size2; j++)
+    {
+      float v = gsl_matrix_get (m, i, j);
+      memcpy (out, &v, sizeof (v));
+      out += sizeof (v);
+    }
+  
+  NS_LOG_DEBUG ("raw float array " << fname << ": " << m->size1 << " x " << m->size2);
+  submit (fname, buf);
+}
+
+void P1906MOL_MOTOR_ExportService::flush()
+{
+  unique_lock<mutex> guard (lock);
+  while (!jobs.empty () || writing)
+    drained.wait (guard);
+}
+
+//! each file is written with a single fwrite of the whole formatted buffer
+void P1906MOL_MOTOR_ExportService::writerLoop()
+{
+  unique_lock<mutex> guard (lock);
+  
+  while (true)
+  {
+    while (jobs.empty () && !stopWriter)
+      jobAvailable.wait (guard);
+    
+    if (jobs.empty ())
+      break;
+	
+    job_t job;
+    job.fname.swap (jobs.front ().fname);
+    job.data.swap (jobs.front ().data);
+    jobs.pop_front ();
+    writing = true;
+    guard.unlock ();
+    
+    FILE * pFile = fopen (job.fname.c_str (), "wb");
+    if (pFile == NULL)
+      printf ("(writerLoop) Warning! Cannot open %s\n", job.fname.c_str ());
+    else
+    {
+      if (fwrite (job.data.data (), 1, job.data.size (), pFile) != job.data.size ())
+        printf ("(writerLoop) Warning! Short write to %s\n", job.fname.c_str ());
+      fclose (pFile);
+    }
+    
+    guard.lock ();
+    writing = false;
+    pendingBytes -= job.data.size ();
+    spaceAvailable.notify_all ();
+    if (jobs.empty ())
+      drained.notify_all ();
+  }
+}
+
+//! all the queued files are written before the service is destroyed
+P1906MOL_MOTOR_ExportService::~P1906MOL_MOTOR_ExportService ()
+{
+  NS_LOG_FUNCTION (this);
+  
+  {
+    lock_guard<mutex> guard (lock);
+    stopWriter = true;
+  }
+  jobAvailable.notify_one ();
+  if (writer.joinable ())
+    writer.join ();
+}
+
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+
+#ifndef P1906_MOL_MOTOR_EXPORT_SERVICE
+#define P1906_MOL_MOTOR_EXPORT_SERVICE
+
+#include <gsl/gsl_matrix.h>
+
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+using namespace std;
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_ExportService
+ *
+ * \brief Shared service writing exported data to files on a background thread
+ *
+ * The Mathematica and MATLAB helpers format their output into a memory buffer
+ * with the fast append methods below and submit it to this service. A single
+ * writer thread drains a bounded queue of buffers and writes each file with one
+ * large write, so the simulation thread never waits on formatted file I/O
+ * unless more than maxPendingBytes are waiting to be written.
+ *
+ * Binary output is offered as MATLAB Level 4 .mat files, which MATLAB and
+ * Octave read with load, and as raw row-major arrays of 32-bit floats.
+ */
+
+class P1906MOL_MOTOR_ExportService : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+  
+  //! return the service shared by all the exporters of the simulation
+  static Ptr<P1906MOL_MOTOR_ExportService> getService();
+  
+  P1906MOL_MOTOR_ExportService ();
+  
+  //! set the number of queued bytes above which submit blocks until the writer catches up
+  void setMaxPendingBytes(size_t bytes);
+  //! return the number of queued bytes above which submit blocks
+  size_t getMaxPendingBytes();
+  
+  /*
+   * Fast formatting methods
+   */
+  //! append v in fixed notation with six decimals, identical to printf's %f
+  static void appendDouble(string & buf, double v);
+  //! append an unsigned integer
+  static void appendSize(string & buf, size_t v);
+  //! append a point in Mathematica list format {x, y, z}
+  static void appendPoint(string & buf, double x, double y, double z);
+  
+  /*
+   * Asynchronous output methods
+   */
+  //! queue buf to be written into file fname; buf is left empty
+  void submit(const char * fname, string & buf);
+  //! write matrix m as variable varName of a MATLAB Level 4 .mat file fname
+  void matrix2Mat(gsl_matrix * m, const char * varName, const char * fname);
+  //! write matrix m into file fname as a raw row-major array of 32-bit floats
+  void matrix2RawFloat(gsl_matrix * m, const char * fname);
+  //! block until all the queued files have been written
+  void flush();
+  
+  virtual ~P1906MOL_MOTOR_ExportService ();
+
+private:
+  //! a file waiting to be written
+  struct job_t
+  {
+    string fname;
+    string data;
+  };
+  
+  //! body of the writer thread
+  void writerLoop();
+  
+  deque<job_t> jobs;
+  size_t pendingBytes;
+  size_t maxPendingBytes;
+  bool writing;
+  bool stopWriter;
+  
+  mutex lock;
+  condition_variable jobAvailable;
+  condition_variable spaceAvailable;
+  condition_variable drained;
+  thread writer;
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_EXPORT_SERVICE */
@@ -57,6 +57,9 @@
 #include "ns3/p1906-mol-motor-field.h"
 #include "ns3/p1906-mol-motor-MathematicaHelper.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-profiler.h"
+#include "ns3/p1906-memory-tracker.h"
+#include "ns3/p1906-task-pool.h"
 
 namespace ns3 {
 
@@ -166,7 +169,7 @@ void P1906MOL_MOTOR_Field::line(gsl_matrix * line, size_t mp, gsl_vector * pt1,
 //! set the segment with the given end points
 void P1906MOL_MOTOR_Field::line(gsl_vector * line, P1906MOL_MOTOR_Pos p1, P1906MOL_MOTOR_Pos p2)
 {
-  gsl_vector * p = gsl_vector_alloc (3);
+  gsl_vector * p = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   
   p1.getPos (p);
   for (size_t i = 0; i < 3; i++)
@@ -252,7 +255,7 @@ bool P1906MOL_MOTOR_Field::isPointOverlap(gsl_vector * pt, gsl_vector * segment)
 	double sz2 = gsl_vector_get (segment, 2);
 	
 	//! direction vector
-	gsl_vector * dV = gsl_vector_alloc (3);
+	gsl_vector * dV = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
 	
 	//! slope of each dimension
 	gsl_vector_set (dV, 0, sx2 - sx1);
@@ -288,8 +291,8 @@ void P1906MOL_MOTOR_Field::displayPoints(gsl_matrix *pts, size_t numPts)
 //! return vector field vf determined by the tubes in tubeMatrix
 void P1906MOL_MOTOR_Field::tubes2VectorField(gsl_matrix * tubeMatrix, gsl_matrix * vf)
 {
-  gsl_matrix * v = gsl_matrix_alloc (tubeMatrix->size1, 3);
-  gsl_matrix * pt = gsl_matrix_alloc (tubeMatrix->size1, 3);
+  gsl_matrix * v = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, tubeMatrix->size1, 3);
+  gsl_matrix * pt = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, tubeMatrix->size1, 3);
   
   for (size_t i = 0; i < tubeMatrix->size1; i++)
     for (size_t j = 0; j < 3; j++)
@@ -314,10 +317,11 @@ void P1906MOL_MOTOR_Field::tubes2VectorField(gsl_matrix * tubeMatrix, gsl_matrix
 //! return the index of the nearest tube in tubeMatrix within a given radius from pt, otherwise return -1 
 size_t P1906MOL_MOTOR_Field::findNearestTube(gsl_vector * pt, gsl_matrix * tubeMatrix, double radius)
 {
+  P1906ProfilerScope scope (P1906Profiler::TUBE_QUERY);
   double shortestDistance = GSL_POSINF;
   double d = 0;
   size_t closestSegment = -1;
-  gsl_vector *segment = gsl_vector_alloc (6);
+  gsl_vector *segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 6);
   
   for (size_t i = 0; i < tubeMatrix->size1; i++)
   {
@@ -339,13 +343,13 @@ size_t P1906MOL_MOTOR_Field::findNearestTube(gsl_vector * pt, gsl_matrix * tubeM
 //! if segment_or_point is a vector of length 6, then it is a line segment described by two end points
 double P1906MOL_MOTOR_Field::distance(gsl_vector *pt, gsl_vector *segment_or_point)
 {
-  gsl_vector * td = gsl_vector_alloc (3);
-  gsl_vector * segment = gsl_vector_alloc (6);
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
-  gsl_vector * res = gsl_vector_alloc (3);
-  gsl_vector * res1 = gsl_vector_alloc (3);
-  gsl_vector * res2 = gsl_vector_alloc (3);
+  gsl_vector * td = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 6);
+  gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * res = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * res1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * res2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   double d;
 	  
   switch (segment_or_point->size)
@@ -391,7 +395,7 @@ double P1906MOL_MOTOR_Field::distance(gsl_vector *pt, gsl_vector *segment_or_poi
       // NS_LOG_DEBUG ("res1\n");
       // displayPoint (res1);
   
-      d = gsl_blas_dasum (res) / gsl_blas_dasum (res1);
+      d = gsl_blas_dnrm2 (res) / gsl_blas_dnrm2 (res1);
       // NS_LOG_DEBUG ("distance: " << d);
   
       return d;
@@ -425,15 +429,15 @@ void P1906MOL_MOTOR_Field::cross_product(const gsl_vector *u, const gsl_vector *
 bool P1906MOL_MOTOR_Field::unitTest_getOverlap()
 {
   bool passTests = false;
-  gsl_vector * segment = gsl_vector_alloc (6);
-  gsl_matrix * tubeMatrix = gsl_matrix_alloc (1, 6);
-  gsl_matrix * pts = gsl_matrix_alloc (1, 6);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 6);
+  gsl_matrix * tubeMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, 1, 6);
+  gsl_matrix * pts = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, 1, 6);
   gsl_matrix_set_zero (pts);
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
-  gsl_vector * pt3 = gsl_vector_alloc (3);
-  gsl_vector * pt4 = gsl_vector_alloc (3);
-  gsl_vector *tubeSegments = gsl_vector_alloc (1);
+  gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * pt3 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * pt4 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector *tubeSegments = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 1);
   
   //! Test 1: Simple cross
   
@@ -462,34 +466,49 @@ bool P1906MOL_MOTOR_Field::unitTest_getOverlap()
 void P1906MOL_MOTOR_Field::getAllOverlaps3D(gsl_matrix *tubeMatrix, vector<P1906MOL_MOTOR_Pos> & pts)
 {
   size_t numSegments = tubeMatrix->size1;
-  gsl_vector *segment = gsl_vector_alloc (6);
-  gsl_matrix *tmpPts = gsl_matrix_alloc (numSegments * numSegments, 3);
-  size_t numPts = 0; // totPts = 0;
-  //size_t pp = 0;
-  gsl_vector *tubeSegments = gsl_vector_alloc (numSegments * numSegments);
+  //! the overlapping points of each segment, x y z
+  vector< vector<double> > segPts (numSegments);
   
+  //! the segments are checked independently on the shared task pool
+  P1906TaskPool::ParallelFor (0, numSegments, 0, [&] (size_t first, size_t last)
+  {
+    gsl_vector *segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 6);
+    //! a segment overlaps each segment of tubeMatrix at most once
+    gsl_matrix *tmpPts = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, numSegments, 3);
+    gsl_vector *tubeSegments = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, numSegments);
+    
+    for (size_t i = first; i < last; i++)
+    {
+      //! move segment from tubes to segment
+      for (size_t k = 0; k < 6; k++)
+        gsl_vector_set (segment, k, gsl_matrix_get (tubeMatrix, i, k));
+      //! check for overlap
+      size_t numPts = getOverlap3D(segment, tubeMatrix, tmpPts, tubeSegments);
+      for (size_t k = 0; k < numPts; k++)
+        for (size_t j = 0; j < 3; j++)
+          segPts[i].push_back (gsl_matrix_get (tmpPts, k, j));
+    }
+    P1906MemoryTracker::VectorFree (segment);
+    P1906MemoryTracker::MatrixFree (tmpPts);
+    P1906MemoryTracker::VectorFree (tubeSegments);
+  });
+  
+  //! store overlapping points in segment order
   for (size_t i = 0; i < numSegments; i++)
   {
-    //! move segment from tubes to segment
-	for (size_t k = 0; k < 6; k++)
-	  gsl_vector_set (segment, k, gsl_matrix_get (tubeMatrix, i, k));
-	//! check for overlap
-    numPts = getOverlap3D(segment, tubeMatrix, tmpPts, tubeSegments);
-	//! store overlapping points
-	for (size_t k = 0; k < numPts; k++)
-	{
-	  P1906MOL_MOTOR_Pos Pos;
-	  Pos.setPos ( gsl_matrix_get (tmpPts, k, 0),
-	               gsl_matrix_get (tmpPts, k, 1),
-	               gsl_matrix_get (tmpPts, k, 2) );
-	  pts.insert(pts.end(), Pos);
-	}
+    for (size_t k = 0; k < segPts[i].size (); k += 3)
+    {
+      P1906MOL_MOTOR_Pos Pos;
+      Pos.setPos (segPts[i][k], segPts[i][k + 1], segPts[i][k + 2]);
+      pts.insert(pts.end(), Pos);
+    }
   }
 }
 
 //! return the number of overlapping points in pts and the index of the tubeMatrix segments overlapped in tubeSegments
 int P1906MOL_MOTOR_Field::getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMatrix, gsl_matrix * pts, gsl_vector * tubeSegments)
 {
+  P1906ProfilerScope scope (P1906Profiler::TUBE_QUERY);
   /** 
     all points defined by x, y, z values
 	line A -> B: (a1, a2, a3) -> (b1, b2, b3)
@@ -516,13 +535,13 @@ int P1906MOL_MOTOR_Field::getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMa
   //! second end point of tubeMatrix segment
   double d1, d2, d3;
   
-  gsl_matrix * A = gsl_matrix_alloc (3, 2);
-  gsl_matrix * V = gsl_matrix_alloc (2, 2);
-  gsl_vector * b = gsl_vector_alloc (3);
-  gsl_vector * x = gsl_vector_alloc (2);
-  gsl_vector * S = gsl_vector_alloc (2);
-  gsl_vector * work = gsl_vector_alloc (2);
-  gsl_vector * pt = gsl_vector_alloc (3);
+  gsl_matrix * A = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, 3, 2);
+  gsl_matrix * V = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::FIELD, 2, 2);
+  gsl_vector * b = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
+  gsl_vector * x = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 2);
+  gsl_vector * S = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 2);
+  gsl_vector * work = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 2);
+  gsl_vector * pt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   size_t numPts = 0;
   size_t ts = 0;
   
@@ -612,12 +631,13 @@ int P1906MOL_MOTOR_Field::getOverlap3D(gsl_vector * segment, gsl_matrix * tubeMa
 //! return the location of the vector from vf that is closest to the point pt and put it in result
 void P1906MOL_MOTOR_Field::findClosestPoint(gsl_vector * pt, gsl_matrix * vf, gsl_vector * result)
 {
+  P1906ProfilerScope scope (P1906Profiler::TUBE_QUERY);
   //! the current closest point
-  gsl_vector * cpt = gsl_vector_alloc (3);
+  gsl_vector * cpt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   //! the current closest vector 
-  gsl_vector * cv = gsl_vector_alloc (3);
+  gsl_vector * cv = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   //! the test point
-  gsl_vector * tpt = gsl_vector_alloc (3);
+  gsl_vector * tpt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::FIELD, 3);
   
   //! display the vector field
   // for (size_t i = 0; i < vf->size1; i++)
@@ -79,6 +79,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include <cstring>
 
 #include "ns3/p1906-mol-motor-microtubule.h"
 #include "ns3/p1906-mol-motor-MathematicaHelper.h"
@@ -88,6 +89,9 @@
 #include "ns3/p1906-mol-motor-tube.h"
 #include "ns3/p1906-mol-motor-pos.h"
 #include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "ns3/p1906-memory-tracker.h"
+#include "ns3/p1906-task-pool.h"
 
 namespace ns3 {
 
@@ -190,9 +194,8 @@ P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField ()
   P1906MOL_MOTOR_MathematicaHelper mathematica;
   
   //! allocate and start the random number generator
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);
-  gsl_rng_env_setup();
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::MicrotubulesField);
     
   //! set the microtubule network properties
   setTubeVolume(25);
@@ -207,13 +210,13 @@ P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField ()
   displayTubeChars();
   
   //! create the microtubules
-  tubeMatrix = gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6);
+  tubeMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, ts.numTubes * ts.segPerTube, 6);
   genTubes();
   mathematica.tubes2Mma(tubeMatrix, ts.segPerTube, "tubes.mma");
   NS_LOG_DEBUG ("completed tube creation");
 
   //! create the vector field
-  vf = gsl_matrix_alloc (ts.numTubes * ts.segPerTube, 6);
+  vf = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, ts.numTubes * ts.segPerTube, 6);
   tubes2VectorField(tubeMatrix, vf);
 
   //! test the computation of distance
@@ -257,6 +260,25 @@ P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField ()
   NS_LOG_FUNCTION (this << "Created P1906MOL_MOTOR_MicrotubulesField");
 }
 
+//! used by P1906SnapshotHelper to restore a network from a snapshot, e.g., memory mapped, in a single copy
+P1906MOL_MOTOR_MicrotubulesField::P1906MOL_MOTOR_MicrotubulesField (const tubeCharacteristcs_t & c, const double * tubes, const double * vectorField)
+{
+  //! allocate and start the random number generator
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::MicrotubulesField);
+  
+  //! the network properties are restored as they were, including the derived ones
+  ts = c;
+  
+  size_t rows = ts.numTubes * ts.segPerTube;
+  tubeMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, rows, 6);
+  vf = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, rows, 6);
+  memcpy (tubeMatrix->data, tubes, rows * 6 * sizeof (double));
+  memcpy (vf->data, vectorField, rows * 6 * sizeof (double));
+  
+  NS_LOG_FUNCTION (this << "Restored P1906MOL_MOTOR_MicrotubulesField" << rows);
+}
+
 std::ostream& operator<<(std::ostream& out, const P1906MOL_MOTOR_MicrotubulesField& m_field)
 {
   // display segments that comprise the tube tubeMatrix (see displayTube)
@@ -377,7 +399,7 @@ void P1906MOL_MOTOR_MicrotubulesField::persistenceVersusEntropy(gsl_vector * per
   P1906MOL_MOTOR_MathematicaHelper mathematica;
   char plot_filename[256];
   //! store the results here
-  gsl_matrix * pve = gsl_matrix_alloc (persistenceLengths->size, 2);
+  gsl_matrix * pve = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, persistenceLengths->size, 2);
   
   //NS_LOG_DEBUG ("persistenceLengths->size: " << persistenceLengths->size);
   for (size_t i = 0; i < persistenceLengths->size; i++)
@@ -416,10 +438,11 @@ void P1906MOL_MOTOR_MicrotubulesField::genTubes()
   //tubeMatrix = gsl_matrix_alloc (ts->numTubes * ts->segPerTube, 6);
 
   //! \todo get actual tube graph properties from biologist
-  gsl_vector * startPt = gsl_vector_alloc (3);
-  //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
-  gsl_matrix * segMatrix = gsl_matrix_alloc (ts.segPerTube, 6);
-  double total_structural_entropy = 0;
+  //! the starting points and the streams of the tubes are drawn in tube order, so the tubes
+  //! are the same whatever the number of threads building them
+  vector<double> startPts (3 * ts.numTubes);
+  vector<gsl_rng *> streams (ts.numTubes);
+  vector<double> se (ts.numTubes);
   
   //NS_LOG_DEBUG ("tubeMatrix: " << tubeMatrix->size1 << " x " << tubeMatrix->size2);
   //NS_LOG_DEBUG ("numTubes: " << ts->numTubes << " segPerTube: " << ts->segPerTube << " volume: " << ts->volume);
@@ -428,29 +451,48 @@ void P1906MOL_MOTOR_MicrotubulesField::genTubes()
   for(size_t i = 0; i < ts.numTubes; i++)
   {
     //! set the starting location for the tube
-    point (startPt, 
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))),
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))),
-	  gsl_ran_gaussian (r, pow(ts.volume, (1/4))));
-
-	//! create a single tube
-    P1906MOL_MOTOR_Tube tube(&ts, startPt);
-	
-    //! create a single tube of many segments
-    //tube.genTube(ts, r, segMatrix, startPt);
-    //NS_LOG_DEBUG ("segMatrix");
-	//tube.displayTube();
-	total_structural_entropy += (ts.se);
-	
-	tube.getSegmatrix(segMatrix);
-	//! copy tube segments to main tube matrix
-	for(size_t j = 0; j < ts.segPerTube; j++)
-	  for(size_t k = 0; k < 6; k++)
-	  {
-	    gsl_matrix_set(tubeMatrix, i * ts.segPerTube + j, k, gsl_matrix_get(segMatrix, j, k));
-	  }
+    startPts[3 * i] = gsl_ran_gaussian (r, pow(ts.volume, (1/4)));
+    startPts[3 * i + 1] = gsl_ran_gaussian (r, pow(ts.volume, (1/4)));
+    startPts[3 * i + 2] = gsl_ran_gaussian (r, pow(ts.volume, (1/4)));
+    streams[i] = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::Tube);
   }
   
+  //! the tubes are independent: build them on the shared task pool
+  P1906TaskPool::ParallelFor (0, ts.numTubes, 1, [&] (size_t first, size_t last)
+  {
+    gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+    //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
+    gsl_matrix * segMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, ts.segPerTube, 6);
+    //! each tube writes its structural entropy into its own characteristics
+    struct tubeCharacteristcs_t tc = ts;
+    
+    for (size_t i = first; i < last; i++)
+    {
+      point (startPt, startPts[3 * i], startPts[3 * i + 1], startPts[3 * i + 2]);
+      
+      {
+        //! create a single tube of many segments
+        P1906MOL_MOTOR_Tube tube(&tc, startPt, streams[i]);
+        se[i] = tc.se;
+        tube.getSegmatrix(segMatrix);
+      }
+      gsl_rng_free (streams[i]);
+      
+      //! copy tube segments to main tube matrix
+      for(size_t j = 0; j < ts.segPerTube; j++)
+        for(size_t k = 0; k < 6; k++)
+        {
+          gsl_matrix_set(tubeMatrix, i * ts.segPerTube + j, k, gsl_matrix_get(segMatrix, j, k));
+        }
+    }
+    P1906MemoryTracker::VectorFree (startPt);
+    P1906MemoryTracker::MatrixFree (segMatrix);
+  });
+  
+  double total_structural_entropy = 0;
+  for(size_t i = 0; i < ts.numTubes; i++)
+    total_structural_entropy += se[i];
+  
   ts.se = total_structural_entropy;
 }
 
@@ -462,9 +504,9 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_VolSurface()
   c.setPos (0, 0, 0);
   P1906MOL_MOTOR_VolSurface vs;
   vector<P1906MOL_MOTOR_Pos> ipt;
-  gsl_vector * segment = gsl_vector_alloc (6);
-  gsl_vector * radius = gsl_vector_alloc (6);
-  gsl_matrix * vectors = gsl_matrix_alloc (3, 6);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 6);
+  gsl_vector * radius = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 6);
+  gsl_matrix * vectors = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, 3, 6);
   double flux;
   
   vs.setVolume (c, 100);
@@ -602,7 +644,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_ReflectiveBarrier()
 {
   Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Pos volCenter;
   P1906MOL_MOTOR_Motion motion;
@@ -637,7 +679,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_FluxMeter()
 {
   Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Pos volCenter;
   P1906MOL_MOTOR_Motion motion;
@@ -670,10 +712,10 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_FluxMeter()
 //! test distance calculation
 bool P1906MOL_MOTOR_MicrotubulesField::unitTest_Distance()
 {
-  gsl_vector * startPt = gsl_vector_alloc (3);
-  gsl_vector * segment = gsl_vector_alloc (6);
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 6);
+  gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   
   NS_LOG_DEBUG ("Beginning\n");
   point (startPt, 0, 0, 0);
@@ -690,15 +732,15 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_Distance()
 //! test finding a segment overlap
 bool P1906MOL_MOTOR_MicrotubulesField::unitTest_Overlap()
 {
-  gsl_vector * segment3D = gsl_vector_alloc (6);
-  gsl_matrix * pts3D = gsl_matrix_alloc (1, 3);
-  gsl_matrix * tubeMatrix3D = gsl_matrix_alloc (1, 6);
+  gsl_vector * segment3D = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 6);
+  gsl_matrix * pts3D = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, 1, 3);
+  gsl_matrix * tubeMatrix3D = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, 1, 6);
   gsl_matrix_set_zero (pts3D);
-  gsl_vector * pt1 = gsl_vector_alloc (3);
-  gsl_vector * pt2 = gsl_vector_alloc (3);
-  gsl_vector * pt3 = gsl_vector_alloc (3);
-  gsl_vector * pt4 = gsl_vector_alloc (3);
-  gsl_vector * tubeSegments = gsl_vector_alloc (1);
+  gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * pt3 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * pt4 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
+  gsl_vector * tubeSegments = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 1);
   
   NS_LOG_DEBUG ("Beginning");
   point (pt1, 0, 0, 0);
@@ -732,7 +774,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_AllOverlaps()
 //! plot persistence length versus entropy
 bool P1906MOL_MOTOR_MicrotubulesField::unitTest_PersistenceLengthsVsEntropy()
 {
-  gsl_vector * persistenceLengths = gsl_vector_alloc (10);
+  gsl_vector * persistenceLengths = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 10);
   
   NS_LOG_DEBUG ("Beginning");
   for (size_t i = 0; i < 10; i++)
@@ -762,7 +804,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_NoTubeMotion()
 {
   Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
 
@@ -792,7 +834,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_MotorMovement(vector<P1906MOL_MO
 {
   Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   //double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
 
@@ -854,7 +896,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_Plot2Mma(vector<P1906MOL_MOTOR_P
   }
   
   //! test plotting points - move to a unit test
-  gsl_matrix * vals = gsl_matrix_alloc (pts.size(), 2);
+  gsl_matrix * vals = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::MICROTUBULE, pts.size(), 2);
   for (size_t i = 0; i < pts.size(); i++)
   {
     Pos = pts.at(i);
@@ -874,7 +916,7 @@ bool P1906MOL_MOTOR_MicrotubulesField::unitTest_MotorMove2Destination(vector<P19
 {
   Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MICROTUBULE, 3);
   double timePeriod = 100;
   P1906MOL_MOTOR_Motion motion;
 
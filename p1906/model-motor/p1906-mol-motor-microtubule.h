@@ -93,6 +93,8 @@ public:
   gsl_rng * r;
   
   P1906MOL_MOTOR_MicrotubulesField ();
+  //! restore a microtubule network with properties c from row-major tube and vector field data (ts.numTubes * ts.segPerTube x 6) without regenerating it
+  P1906MOL_MOTOR_MicrotubulesField (const tubeCharacteristcs_t & c, const double * tubes, const double * vectorField);
   
   /*
    * Methods related to tube properties
@@ -49,6 +49,10 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/double.h"
+#include "ns3/trace-source-accessor.h"
+
+#include <algorithm>
 
 #include "ns3/p1906-mol-motor-motion.h"
 #include "ns3/p1906-mol-motor-tube.h"
@@ -59,22 +63,84 @@
 #include "ns3/p1906-metrics.h"
 #include "ns3/p1906-mol-motor.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-rng.h"
 
 #include "ns3/p1906-communication-interface.h"
 #include "ns3/mobility-model.h"
 #include "ns3/p1906-net-device.h"
+#include "ns3/p1906-energy-ledger.h"
+#include "ns3/p1906-profiler.h"
+#include "ns3/node.h"
 
 //! for ODE test \todo remove before submitting
 #include "ns3/p1906-mol-diffusion.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Motion");
 
+//! a first-passage jump must cover at least this many rms Brownian steps, otherwise the motor steps
+static const double JUMP_STEPS = 3;
+//! the fewest simulated delays a Tabulated draw interpolates between
+static const size_t MIN_TABLE_DELAYS = 16;
+//! the most delays kept per geometry: a reservoir sample of them all, whose quantile error stays below 1/64
+static const size_t MAX_TABLE_DELAYS = 4096;
+//! journeys whose starts differ by less than this share of their gap share their statistics
+static const double START_RESOLUTION = 0.01;
+//! the cost of a step or jump [ticks] until one has been measured
+static const double PRIOR_TICKS_PER_MOVE = 2000;
+//! the exit time table covers the quantiles below EXIT_TABLE_U
+static const size_t EXIT_TABLE_SIZE = 1024;
+static const double EXIT_TABLE_U = 0.99;
+//! the Brownian steps whose displacements are drawn at once: 192 variates, i.e., 96 whole Philox blocks
+static const size_t BROWNIAN_BATCH = 64;
+
+namespace {
+
+//! the unit Gaussian displacements of the successive Brownian steps of a journey, drawn BROWNIAN_BATCH
+//! steps at a time by the batched Box-Muller of P1906MOL_MOTOR_Rng; the draws left at the end of the
+//! journey are discarded
+class BrownianDisplacements
+{
+public:
+  BrownianDisplacements (gsl_rng * r)
+    : m_r (r),
+      m_next (3 * BROWNIAN_BATCH)
+  {
+  }
+  //! return the displacement of the next step
+  const double * next (void)
+  {
+    if (m_next == 3 * BROWNIAN_BATCH)
+    {
+      P1906MOL_MOTOR_Rng::gaussian (m_r, 1.0, m_z, 3 * BROWNIAN_BATCH);
+      m_next = 0;
+    }
+    m_next += 3;
+    return m_z + m_next - 3;
+  }
+private:
+  gsl_rng * m_r;
+  double m_z[3 * BROWNIAN_BATCH];
+  size_t m_next;
+};
+
+}
+
 TypeId P1906MOL_MOTOR_Motion::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::P1906MOL_MOTOR_Motion")
-    .SetParent<P1906MOLMotion> ();
+    .SetParent<P1906MOLMotion> ()
+    .AddAttribute ("AccuracyTarget",
+                   "The relative error tolerated on the propagation delay with respect to full Brownian stepping; 0 always steps",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&P1906MOL_MOTOR_Motion::m_accuracyTarget),
+                   MakeDoubleChecker<double> (0.0))
+    .AddTraceSource ("EngineSelected",
+                     "The engine chosen to move a motor, its estimated error and its estimated cost [ticks]",
+                     MakeTraceSourceAccessor (&P1906MOL_MOTOR_Motion::m_engineTrace))
+  ;
   return tid;
 }
 
@@ -96,6 +162,14 @@ P1906MOL_MOTOR_Motion::P1906MOL_MOTOR_Motion ()
   */
     
   NS_LOG_FUNCTION (this);
+  m_accuracyTarget = 0;
+  m_lastEngine = FullStepping;
+  for (int e = 0; e < NumEngines; e++)
+  {
+    m_ticks[e] = 0;
+    m_moves[e] = 0;
+    m_journeys[e] = 0;
+  }
 }
 
 //! assumes motor is within radius of a tube, otherwise it simply returns
@@ -108,15 +182,19 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
 	bound time ~2 sec
 	assumes startPt is on a tube in tubeMatrix
   */
-  gsl_vector * segment = gsl_vector_alloc(6);
-  gsl_vector * pt1 = gsl_vector_alloc(3);
-  gsl_vector * pt2 = gsl_vector_alloc(3);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 6);
+  gsl_vector * pt1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
+  gsl_vector * pt2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
   P1906MOL_MOTOR_Pos Pos1;
   P1906MOL_MOTOR_Pos Pos2;
   //! tube radius nm
   double radius = 15; // [nm]
   //! motor movement rate (nm / sec)
   double movementRate = 1000; // [nm/s]
+  //! motor step length; one ATP is hydrolysed per step (kinesin)
+  double stepLength = 8; // [nm]
+  //! free energy of ATP hydrolysis, about 20 k_B T
+  double atpEnergy = 8.3e-20; // [J]
   //! motor mean binding time (s)
   //! double bindingTime = 2; // [s]
   double x1, y1, z1;
@@ -183,7 +261,9 @@ void P1906MOL_MOTOR_Motion::motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng
 	//NS_LOG_DEBUG ("distance: " << P1906MOL_MOTOR_Field::distance(pt1, pt2) <<
 	//  " movementRate: " << movementRate << 
 	//  " time: " << P1906MOL_MOTOR_Field::distance(pt1, pt2) / movementRate) 
-	motor->updateTime(P1906MOL_MOTOR_Field::distance(pt1, pt2) / movementRate);
+	double walked = P1906MOL_MOTOR_Field::distance(pt1, pt2);
+	motor->updateTime(walked / movementRate);
+	motor->updateEnergy(ceil(walked / stepLength) * atpEnergy);
   }
 }
 
@@ -203,16 +283,24 @@ void P1906MOL_MOTOR_Motion::displayPos(gsl_vector *pt)
 //!   returns the index of the contact segment in tubeMatrix
 size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> &pts, gsl_matrix * tubeMatrix, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl)
 {
-  gsl_vector * currentPos = gsl_vector_alloc (3);
-  gsl_vector * newPos = gsl_vector_alloc (3);
+  gsl_vector * currentPos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
+  gsl_vector * newPos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
   int numPts = 0; //! total number of points traversed
   double timeout = 100; //! stop if no tube found
-  int ts; //! nearest tube segment
+  int ts = -1; //! nearest tube segment
   double radius = 15;
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  Journey j;
+  Engine e = FullStepping;
+  double elapsed = 0;
+  uint64_t ticks = P1906Profiler::Ticks ();
+  BrownianDisplacements steps (r);
+  double tubeGap = 0; //! tube clearance at tubeAnchor
+  double tubeAnchor[3] = { 0, 0, 0 };
   
   D = GetDiffusionConefficient ();
+  double sigma = sqrt(6 * D * timePeriod); //! rms length of a 3D step
   
   //! begin at the starting point
   P1906MOL_MOTOR_Field::point (currentPos, 
@@ -220,8 +308,16 @@ size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_r
 	gsl_vector_get (startPt, 1), 
 	gsl_vector_get (startPt, 2));
 
-  //! float to the nearest tube within a given radius
-  for (int i = 0; i < timeout; i++)
+  //! only FullStepping and FirstPassage resolve where the motor meets a tube
+  if (m_accuracyTarget > 0)
+  {
+    describeJourney(vsl, currentPos, tubeMatrix, radius, timePeriod, D, j);
+    e = selectEngine(j);
+  }
+
+  //! float to the nearest tube within a given radius, for timeout steps of timePeriod
+  //! with FirstPassage, for as long; the last jump may end past the timeout
+  for (int i = 0; (e == FirstPassage) ? (elapsed < timeout * timePeriod) : (i < timeout); i++)
   {
     P1906MOL_MOTOR_Pos Pos;
 	Pos.setPos ( gsl_vector_get (currentPos, 0), 
@@ -230,8 +326,37 @@ size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_r
 	//NS_LOG_DEBUG ("position: " << Pos);
 	pts.insert(pts.end(), Pos);
 	numPts++; //! consider starting position the first point
-	brownianMotion(r, currentPos, newPos, timePeriod, D, vsl);
+	
+	double rho = 0;
+	if (e == FirstPassage)
+	{
+	  //! the tube clearance changes by at most the distance moved from tubeAnchor, so the tubes are
+	  //! scanned again only when that bound cannot tell whether they allow a jump
+	  double dx = gsl_vector_get (currentPos, 0) - tubeAnchor[0];
+	  double dy = gsl_vector_get (currentPos, 1) - tubeAnchor[1];
+	  double dz = gsl_vector_get (currentPos, 2) - tubeAnchor[2];
+	  double moved = (numPts > 1) ? sqrt(dx * dx + dy * dy + dz * dz) : GSL_POSINF;
+	  if (!(tubeGap + moved <= JUMP_STEPS * sigma) && !(tubeGap - moved > JUMP_STEPS * sigma))
+	  {
+	    tubeGap = tubeClearance(currentPos, tubeMatrix, radius);
+	    for (size_t k = 0; k < 3; k++)
+	      tubeAnchor[k] = gsl_vector_get (currentPos, k);
+	    moved = 0;
+	  }
+	  rho = min(surfaceClearance(Pos, vsl), tubeGap - moved);
+	}
+	if (rho > JUMP_STEPS * sigma)
+	{
+	  //! the jump ends at least radius away from every tube: no contact to check
+	  double t = firstPassageJump(r, currentPos, rho, D);
+	  motor->updateTime(t);
+	  elapsed += t;
+	  continue;
+	}
+	
+	brownianMotion(steps.next (), currentPos, newPos, timePeriod, D, vsl);
 	motor->updateTime(timePeriod);
+	elapsed += timePeriod;
     gsl_vector_set (currentPos, 0, gsl_vector_get (newPos, 0));
 	gsl_vector_set (currentPos, 1, gsl_vector_get (newPos, 1));
 	gsl_vector_set (currentPos, 2, gsl_vector_get (newPos, 2));
@@ -243,6 +368,8 @@ size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_r
 	}
   }
 
+  recordJourney(j, e, elapsed, P1906Profiler::Ticks () - ticks, numPts);
+
   return ts;
 }
 
@@ -252,19 +379,29 @@ size_t P1906MOL_MOTOR_Motion::float2Tube(Ptr<P1906MessageCarrier> carrier, gsl_r
 //! note that Brownian motion landing on a receiver is a form of the "narrow escape" problem.
 void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl)
 {
+  double z[3];
+  
+  P1906MOL_MOTOR_Rng::gaussian (r, 1.0, z, 3);
+  brownianMotion (z, currentPos, newPos, timePeriod, D, vsl);
+}
+
+//! the journeys draw z in batches, see BrownianDisplacements
+void P1906MOL_MOTOR_Motion::brownianMotion(const double * z, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+{
+  P1906ProfilerScope scope (P1906Profiler::BROWNIAN_STEP);
   //! the new position is Gaussian with variance proportional to time taken: W_t - W_s ~ N(0, t - s)
   //! sigma is the standard deviation
   double sigma = sqrt(2 * D * timePeriod); /* sigma should be proportional to time */
   
   P1906MOL_MOTOR_Field::point (newPos, 
-    gsl_vector_get (currentPos, 0) + gsl_ran_gaussian (r, sigma), /* x distance */
-    gsl_vector_get (currentPos, 1) + gsl_ran_gaussian (r, sigma), /* y distance */
-    gsl_vector_get (currentPos, 2) + gsl_ran_gaussian (r, sigma)  /* z distance */
+    gsl_vector_get (currentPos, 0) + sigma * z[0], /* x distance */
+    gsl_vector_get (currentPos, 1) + sigma * z[1], /* y distance */
+    gsl_vector_get (currentPos, 2) + sigma * z[2]  /* z distance */
   );
   
   //! check for reflection if contact with the volume surface of a P1906MOL_MOTOR_VolSurface::ReflectiveBarrier
   vector<P1906MOL_MOTOR_Pos> ipt;
-  gsl_vector * segment = gsl_vector_alloc (6);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 6);
   P1906MOL_MOTOR_Pos cp, np;
   
   cp.setPos (currentPos);
@@ -284,6 +421,8 @@ void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, gsl_vector * currentPos,
 		
     if (vsl.at(i).getType() == P1906MOL_MOTOR_VolSurface::ReflectiveBarrier)
     {
+      //! sphereIntersections appends: only the intersections with this barrier count
+      ipt.clear();
       vsl.at(i).sphereIntersections(segment, ipt);
 	  
 	  //NS_LOG_DEBUG ("ipt.size(): " << ipt.size());
@@ -310,8 +449,8 @@ void P1906MOL_MOTOR_Motion::brownianMotion(gsl_rng * r, gsl_vector * currentPos,
 int P1906MOL_MOTOR_Motion::freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl)
 {
   //P1906MOL_MOTOR_Tube tube;
-  gsl_vector * currentPos = gsl_vector_alloc (3);
-  gsl_vector * newPos = gsl_vector_alloc (3);
+  gsl_vector * currentPos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
+  gsl_vector * newPos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
   P1906MOL_MOTOR_Field::point (currentPos, 
     gsl_vector_get (currentPos, 0), 
 	gsl_vector_get (currentPos, 1), 
@@ -319,6 +458,7 @@ int P1906MOL_MOTOR_Motion::freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng *
   int numPts = 0;
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  BrownianDisplacements steps (r);
    
   D = GetDiffusionConefficient ();
   
@@ -330,7 +470,7 @@ int P1906MOL_MOTOR_Motion::freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng *
 			     gsl_vector_get (currentPos, 2) );
 	pts.insert(pts.end(), Pos);
 	
-	brownianMotion(r, currentPos, newPos, timePeriod, D, vsl);
+	brownianMotion(steps.next (), currentPos, newPos, timePeriod, D, vsl);
 	motor->updateTime(timePeriod);
     gsl_vector_set (currentPos, 0, gsl_vector_get (newPos, 0));
 	gsl_vector_set (currentPos, 1, gsl_vector_get (newPos, 1));
@@ -381,12 +521,10 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
   		                                  Ptr<P1906Field> field)
 {
   P1906MOL_MOTOR_MathematicaHelper mathematica;
-  gsl_vector * startPt = gsl_vector_alloc (3);
   double timePeriod = 100;
   char plot_filename[256];
   //! fix the units used here with those passed in via _RUN_MOTOR_CHANNEL_CAPACITY_
   float distanceMultiplier = pow(10.0, 9); //! convert meters to nanometers
-  double D = 1.0; //! mass diffusivity (default)
   
   //! begin test of ODE - \todo remove before submitting
   P1906MOL_ExtendedDiffusion dif;
@@ -397,10 +535,6 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
 
   NS_LOG_FUNCTION (this << "beginning ComputePropagationDelay");
   
-  //! reusing the coefficient from the MOL model that is entered at run time
-  //! this can be called directly from brownianMotion 
-  D = GetDiffusionConefficient ();
-  
   Ptr<MobilityModel> srcMobility = src->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ();
   Ptr<MobilityModel> dstMobility = dst->GetP1906NetDevice ()->GetNode ()->GetObject<MobilityModel> ();
 
@@ -412,8 +546,37 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
   
   Ptr<P1906MOL_Motor> motor = message->GetObject <P1906MOL_Motor> ();
  
-  //! reset the motor's timer
+  float2Receiver(motor, sv, dv, timePeriod);
+  
+  //! volume surface must overlap with destination in order for the test to end
+  motor->displayVolSurfaces();
+  
+  NS_LOG_FUNCTION (this << "[propagation time]" << motor->getTime() << "[engine]" << getEngineName (getLastEngine ()));
+  
+  //! charge the energy consumed by the motor journey to the transmitting node
+  P1906EnergyLedger::GetLedger ()->AddEnergy (src->GetP1906NetDevice ()->GetNode ()->GetId (),
+                                              motor->GetMessage ()->GetUid (),
+                                              P1906EnergyLedger::MOTION,
+                                              motor->getEnergy ());
+  sprintf (plot_filename, "float2destination_%lf_%lf.mma", sv.x, dv.x * distanceMultiplier);
+  mathematica.connectedPoints2Mma(motor->pos_history, plot_filename);
+  
+  NS_LOG_FUNCTION (this << "completed ComputePropagationDelay");
+  
+  return motor->getTime();
+}
+
+//! the journey of ComputePropagationDelay without the node lookup, energy charge and plot, e.g., for channel queries
+double P1906MOL_MOTOR_Motion::float2Receiver(Ptr<P1906MessageCarrier> carrier, Vector sv, Vector dv, double timePeriod)
+{
+  gsl_vector * startPt = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
+  //! fix the units used here with those passed in via _RUN_MOTOR_CHANNEL_CAPACITY_
+  float distanceMultiplier = pow(10.0, 9); //! convert meters to nanometers
+  Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
+ 
+  //! reset the motor's timer and energy consumption
   motor->initTime();
+  motor->initEnergy();
    
   //! Starting position is the transmitting node location
   P1906MOL_MOTOR_Field::point (startPt, sv.x, sv.y, sv.z);
@@ -428,22 +591,14 @@ double P1906MOL_MOTOR_Motion::ComputePropagationDelay (Ptr<P1906CommunicationInt
   dvol.setPos (sv.x, sv.y, sv.z);
   motor->addVolumeSurface(dvol, distanceMultiplier * (dv.x + (0.1 * dv.x)), P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
 
-  //! volume surface must overlap with destination in order for the test to end
-  motor->displayVolSurfaces();
-  
   /*
    * move randomly until destination reached
    */
   motor->setStartingPoint(startPt);
+  P1906MemoryTracker::VectorFree (startPt);
   
   float2Destination(motor, timePeriod);
   
-  NS_LOG_FUNCTION (this << "[propagation time]" << motor->getTime());
-  sprintf (plot_filename, "float2destination_%lf_%lf.mma", sv.x, dv.x * distanceMultiplier);
-  mathematica.connectedPoints2Mma(motor->pos_history, plot_filename);
-  
-  NS_LOG_FUNCTION (this << "completed ComputePropagationDelay");
-  
   return motor->getTime();
 }
 
@@ -455,37 +610,88 @@ Ptr<P1906MessageCarrier> P1906MOL_MOTOR_Motion::CalculateReceivedMessageCarrier(
   		                                                           Ptr<P1906Field> field)
 {
   //! 'message' above is really the message carrier (motor)
+  //! the motor journeys to every receiver in turn: each receiver gets the motor as it arrived there
 
-  NS_LOG_FUNCTION (this << "Do nothing for motor");
-  return motor;
+  NS_LOG_FUNCTION (this);
+  Ptr<P1906MOL_Motor> m = motor->GetObject <P1906MOL_Motor> ();
+  if (!m)
+    return motor;
+  return m->arrival();
 }
 
 //! motor uses Brownian motion until the destination volume is reached
+//! with an AccuracyTarget, the engine moving the motor is the cheapest one meeting the target
 void P1906MOL_MOTOR_Motion::float2Destination(Ptr<P1906MessageCarrier> carrier, double timePeriod)
 {
-  gsl_vector * newPos = gsl_vector_alloc (3);
-  gsl_vector * current_location = gsl_vector_alloc (3);
+  gsl_vector * newPos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
+  gsl_vector * current_location = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
   double D = 1.0; //! mass diffusivity (default)
+  Journey j;
+  Engine e = FullStepping;
+  uint64_t moves = 0;
+  double start = motor->getTime ();
+  uint64_t ticks = P1906Profiler::Ticks ();
+  BrownianDisplacements steps (motor->r);
     
   D = GetDiffusionConefficient ();
+  double sigma = sqrt(6 * D * timePeriod); //! rms length of a 3D step
   
   motor->pos_history.insert (motor->pos_history.end(), motor->current_location);
   
   //NS_LOG_DEBUG ("motor location: " << current_location);
-	
-  //! float until in destination volume
-  while (!motor->inDestination())
+  
+  if (m_accuracyTarget > 0)
   {
-	motor->current_location.getPos (current_location);
-	brownianMotion (motor->r, current_location, newPos, timePeriod, D, motor->vsl);
-	motor->updateTime (timePeriod);
-    motor->current_location.setPos (newPos);
+    motor->current_location.getPos (current_location);
+    describeJourney (motor->vsl, current_location, 0, 0, timePeriod, D, j);
+    e = selectEngine (j);
+  }
+  
+  if (e == ClosedForm)
+  {
+    //! free diffusion from gap + a to the center of a Receiver of radius a reaches it after
+    //! gap^2 / (2 D Z^2), Z standard normal, if it reaches it (Smoluchowski, conditioned on the hit)
+    double z;
+    P1906MOL_MOTOR_Rng::gaussian (motor->r, 1.0, &z, 1);
+    motor->updateTime (j.gap * j.gap / (2 * D * max (z * z, 1e-300)));
+    land (motor);
+    moves = 1;
+  }
+  else if (e == Tabulated)
+  {
+    motor->updateTime (tabulatedDelay (j, motor->r));
+    land (motor);
+    moves = 1;
+  }
+  else
+  {
+    //! float until in destination volume
+    while (!motor->inDestination())
+    {
+	  motor->current_location.getPos (current_location);
+	  double rho = (e == FirstPassage) ? surfaceClearance (motor->current_location, motor->vsl) : 0;
+	  if (rho > JUMP_STEPS * sigma)
+	  {
+	    //! far from every surface: jump out of the free sphere around the motor
+	    motor->updateTime (firstPassageJump (motor->r, current_location, rho, D));
+	    motor->current_location.setPos (current_location);
+	  }
+	  else
+	  {
+	    brownianMotion (steps.next (), current_location, newPos, timePeriod, D, motor->vsl);
+	    motor->updateTime (timePeriod);
+        motor->current_location.setPos (newPos);
+	  }
+	  moves++;
 	
-    //NS_LOG_DEBUG ("motor location: " << current_location);
+      //NS_LOG_DEBUG ("motor location: " << current_location);
 
-    motor->pos_history.insert (motor->pos_history.end(), motor->current_location);
+      motor->pos_history.insert (motor->pos_history.end(), motor->current_location);
+    }
   }
+  
+  recordJourney (j, e, motor->getTime () - start, P1906Profiler::Ticks () - ticks, moves);
 }
 
 //! use microtubules, if available, Brownian motion otherwise until destination is reached
@@ -494,7 +700,7 @@ void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, g
   int timeout = 100; //! in case motor never reaches destination
   int loops = 0; //! keep track of iterations
   Ptr<P1906MOL_Motor> motor = carrier->GetObject <P1906MOL_Motor> ();
-  gsl_vector * current_location = gsl_vector_alloc (3);
+  gsl_vector * current_location = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 3);
   
   while (!motor->inDestination() && (loops < timeout))
   {	
@@ -512,6 +718,370 @@ void P1906MOL_MOTOR_Motion::move2Destination(Ptr<P1906MessageCarrier> carrier, g
   }
 }
 
+//! return the name of engine e
+const char * P1906MOL_MOTOR_Motion::getEngineName(Engine e)
+{
+  static const char * names[NumEngines] = { "FullStepping", "FirstPassage", "Tabulated", "ClosedForm" };
+  return names[e];
+}
+
+//! return the engine that moved the last motor
+P1906MOL_MOTOR_Motion::Engine P1906MOL_MOTOR_Motion::getLastEngine()
+{
+  lock_guard<mutex> guard (m_engineLock);
+  return m_lastEngine;
+}
+
+//! return the number of journeys moved by engine e
+uint64_t P1906MOL_MOTOR_Motion::getEngineJourneys(Engine e)
+{
+  lock_guard<mutex> guard (m_engineLock);
+  return m_journeys[e];
+}
+
+void P1906MOL_MOTOR_Motion::setAccuracyTarget(double target)
+{
+  NS_LOG_FUNCTION (this << target);
+  m_accuracyTarget = target;
+}
+
+double P1906MOL_MOTOR_Motion::getAccuracyTarget()
+{
+  return m_accuracyTarget;
+}
+
+//! quantiles of the exit time from the center of the unit sphere at unit diffusivity, whose survival is
+//! \f$S(\tau) = 2 \sum_{n \geq 1} (-1)^{n+1} e^{-n^2 \pi^2 \tau}\f$ (mean 1/6), by bisection on the series
+static const vector<double> & exitTimeQuantiles()
+{
+  static const vector<double> quantiles = [] ()
+  {
+    vector<double> q (EXIT_TABLE_SIZE);
+    for (size_t i = 0; i < EXIT_TABLE_SIZE; i++)
+    {
+      double u = EXIT_TABLE_U * i / (EXIT_TABLE_SIZE - 1);
+      //! below 0.002 the exit probability is under 1e-50 and 64 terms do not converge
+      double lo = 0.002, hi = 5;
+      for (int k = 0; k < 60; k++)
+      {
+        double tau = 0.5 * (lo + hi);
+        double s = 0;
+        for (int n = 1; n <= 64; n++)
+          s += ((n % 2) ? 2 : -2) * exp(-n * n * M_PI * M_PI * tau);
+        if (1 - s < u)
+          lo = tau;
+        else
+          hi = tau;
+      }
+      q[i] = 0.5 * (lo + hi);
+    }
+    return q;
+  } ();
+  return quantiles;
+}
+
+//! the exit time is rho^2 / D times a draw of the unit exit time: interpolated in its quantile table or,
+//! in the tail, where \f$S(\tau) = 2 e^{-\pi^2 \tau}\f$ to double precision, by direct inversion
+double P1906MOL_MOTOR_Motion::sphereExitTime(gsl_rng * r, double rho, double D)
+{
+  const vector<double> & q = exitTimeQuantiles();
+  double u = gsl_rng_uniform (r);
+  double tau;
+  
+  if (u >= EXIT_TABLE_U)
+    tau = log(2 / (1 - u)) / (M_PI * M_PI);
+  else
+  {
+    double x = u / EXIT_TABLE_U * (EXIT_TABLE_SIZE - 1);
+    size_t i = min((size_t) x, EXIT_TABLE_SIZE - 2);
+    double f = x - i;
+    tau = q[i] * (1 - f) + q[i + 1] * f;
+  }
+  return rho * rho * tau / D;
+}
+
+//! Brownian motion started at the center of a sphere leaves it at a uniformly distributed point
+double P1906MOL_MOTOR_Motion::firstPassageJump(gsl_rng * r, gsl_vector * pos, double rho, double D)
+{
+  double d[3];
+  
+  P1906MOL_MOTOR_Rng::gaussian (r, 1.0, d, 3);
+  double n = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+  if (n == 0)
+  {
+    d[0] = 1;
+    n = 1;
+  }
+  for (int k = 0; k < 3; k++)
+    gsl_vector_set (pos, k, gsl_vector_get (pos, k) + rho * d[k] / n);
+  return sphereExitTime(r, rho, D);
+}
+
+//! FluxMeter surfaces do not act on the motor and are ignored
+double P1906MOL_MOTOR_Motion::surfaceClearance(P1906MOL_MOTOR_Pos pt, vector<P1906MOL_MOTOR_VolSurface> & vsl)
+{
+  double clearance = GSL_POSINF;
+  double x, y, z, cx, cy, cz;
+  
+  pt.getPos (&x, &y, &z);
+  for (size_t i = 0; i < vsl.size(); i++)
+  {
+    if (vsl.at(i).getType() == P1906MOL_MOTOR_VolSurface::FluxMeter)
+      continue;
+    vsl.at(i).center.getPos (&cx, &cy, &cz);
+    double d = sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy) + (z - cz) * (z - cz));
+    clearance = min(clearance, fabs(d - vsl.at(i).radius));
+  }
+  return clearance;
+}
+
+//! the motor binds to a tube within radius, as in findNearestTube
+double P1906MOL_MOTOR_Motion::tubeClearance(gsl_vector * pt, gsl_matrix * tubeMatrix, double radius)
+{
+  P1906ProfilerScope scope (P1906Profiler::TUBE_QUERY);
+  double clearance = GSL_POSINF;
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::MOTION, 6);
+  
+  for (size_t i = 0; i < tubeMatrix->size1; i++)
+  {
+    P1906MOL_MOTOR_Field::line(segment, tubeMatrix, i);
+    clearance = min(clearance, P1906MOL_MOTOR_Field::distance(pt, segment) - radius);
+  }
+  P1906MemoryTracker::VectorFree (segment);
+  return clearance;
+}
+
+//! the key holds everything the delay distribution depends on, the start quantized to a grid of a power
+//! of two Brownian steps no coarser than START_RESOLUTION of the gap, so that the geometries stay few;
+//! journeys to tubes have no key: only the engines simulating the motion are used with tubes, and their
+//! start and clearance would make a new geometry of every journey
+void P1906MOL_MOTOR_Motion::describeJourney(vector<P1906MOL_MOTOR_VolSurface> & vsl, gsl_vector * start, gsl_matrix * tubeMatrix, double radius, double timePeriod, double D, Journey & j)
+{
+  P1906MOL_MOTOR_Pos p;
+  double x, y, z, cx, cy, cz;
+  size_t receivers = 0;
+  double a = 0, rc = 0;
+  
+  p.setPos (start);
+  p.getPos (&x, &y, &z);
+  j.D = D;
+  j.timePeriod = timePeriod;
+  j.gap = GSL_POSINF;
+  j.hitFraction = 0;
+  j.error = 0;
+  j.key.clear();
+  j.key.push_back (D);
+  j.key.push_back (timePeriod);
+  
+  for (size_t i = 0; i < vsl.size(); i++)
+  {
+    if (vsl.at(i).getType() == P1906MOL_MOTOR_VolSurface::FluxMeter)
+      continue;
+    vsl.at(i).center.getPos (&cx, &cy, &cz);
+    j.key.push_back (vsl.at(i).getType());
+    j.key.push_back (cx);
+    j.key.push_back (cy);
+    j.key.push_back (cz);
+    j.key.push_back (vsl.at(i).radius);
+    if (vsl.at(i).getType() == P1906MOL_MOTOR_VolSurface::Receiver)
+    {
+      rc = sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy) + (z - cz) * (z - cz));
+      a = vsl.at(i).radius;
+      j.gap = min(j.gap, rc - a);
+      receivers++;
+    }
+  }
+  j.clearance = surfaceClearance(p, vsl);
+  
+  j.tubes = (tubeMatrix != 0) && (tubeMatrix->size1 > 0);
+  if (j.tubes)
+  {
+    //! the destination is the closest tube
+    j.gap = tubeClearance(start, tubeMatrix, radius);
+    j.clearance = min(j.clearance, j.gap);
+    j.key.clear();
+    return;
+  }
+  if (receivers == 1 && j.gap > 0)
+  {
+    //! free diffusion reaches a sphere of radius a from distance rc with probability a / rc
+    j.hitFraction = a / rc;
+  }
+  
+  double grid = sqrt(6 * D * timePeriod);
+  if (!(grid > 0))
+  {
+    //! a motor which does not move has no delay to share
+    j.key.clear();
+    return;
+  }
+  if (j.gap > 0 && j.gap != GSL_POSINF && START_RESOLUTION * j.gap > grid)
+    grid = ldexp(grid, (int) floor(log2(START_RESOLUTION * j.gap / grid)));
+  j.key.push_back (grid);
+  j.key.push_back (floor(x / grid + 0.5));
+  j.key.push_back (floor(y / grid + 0.5));
+  j.key.push_back (floor(z / grid + 0.5));
+}
+
+//! errors are relative to FullStepping, the reference model:
+//!  - FirstPassage is exact away from surfaces but its delays are not multiples of timePeriod
+//!  - Tabulated draws among n delays: the statistical error of their quantiles, 1 / sqrt(n),
+//!    plus the error of the engines which simulated them and of the quantized start: a delay
+//!    grows as the square of the gap, so twice START_RESOLUTION
+//!  - ClosedForm ignores the reflective barriers, i.e., misses the share 1 - a / rc of the motors
+//!    which escape free diffusion and are reflected back
+//! costs are the ticks measured for the geometry or, until measured, a number of moves (steps or jumps)
+//! times the measured ticks per move: delay / timePeriod steps for FullStepping, as many scaled by
+//! the share of the journey spent within JUMP_STEPS steps of a surface for FirstPassage
+P1906MOL_MOTOR_Motion::Engine P1906MOL_MOTOR_Motion::selectEngine(Journey & j)
+{
+  double error[NumEngines];
+  double cost[NumEngines];
+  bool eligible[NumEngines];
+  Engine best = FullStepping;
+  
+  //! no destination, or already there: nothing to choose
+  if (!(j.gap > 0) || j.gap == GSL_POSINF)
+  {
+    j.key.clear();
+    return FullStepping;
+  }
+  
+  unique_lock<mutex> guard (m_engineLock);
+  GeometryStats none = GeometryStats ();
+  map<vector<double>, GeometryStats>::const_iterator it = m_geometries.find (j.key);
+  const GeometryStats & g = (it != m_geometries.end ()) ? it->second : none;
+  size_t n = g.delays.size();
+  double meanDelay = 0;
+  for (size_t i = 0; i < n; i++)
+    meanDelay += g.delays[i];
+  meanDelay = (n > 0) ? meanDelay / n : max(j.gap * j.gap / (6 * j.D), j.timePeriod);
+  
+  double ticksPerMove = PRIOR_TICKS_PER_MOVE;
+  if (m_moves[FullStepping] > 0)
+    ticksPerMove = (double) m_ticks[FullStepping] / m_moves[FullStepping];
+  else if (m_moves[FirstPassage] > 0)
+    ticksPerMove = (double) m_ticks[FirstPassage] / m_moves[FirstPassage];
+  double sigma = sqrt(6 * j.D * j.timePeriod);
+  
+  eligible[FullStepping] = true;
+  error[FullStepping] = 0;
+  cost[FullStepping] = max(1.0, meanDelay / j.timePeriod) * ticksPerMove;
+  
+  eligible[FirstPassage] = true;
+  error[FirstPassage] = j.timePeriod / (j.timePeriod + meanDelay);
+  cost[FirstPassage] = cost[FullStepping] * min(1.0, pow(JUMP_STEPS * sigma / j.clearance, 2));
+  
+  eligible[Tabulated] = !j.tubes && n >= MIN_TABLE_DELAYS;
+  error[Tabulated] = g.delayError + 1 / sqrt((double) max(n, (size_t) 1)) + 2 * START_RESOLUTION;
+  cost[Tabulated] = ticksPerMove;
+  
+  eligible[ClosedForm] = j.hitFraction > 0;
+  error[ClosedForm] = 1 - j.hitFraction + error[FirstPassage];
+  cost[ClosedForm] = ticksPerMove;
+  
+  for (int e = 0; e < NumEngines; e++)
+  {
+    if (g.journeys[e] > 0)
+      cost[e] = (double) g.ticks[e] / g.journeys[e];
+  }
+  
+  //! the cheapest engine within the target; the most accurate one among equally cheap ones
+  for (int e = FirstPassage; e < NumEngines; e++)
+  {
+    if (!eligible[e] || error[e] > m_accuracyTarget)
+      continue;
+    if (cost[e] < cost[best] || (cost[e] == cost[best] && error[e] < error[best]))
+      best = (Engine) e;
+  }
+  
+  guard.unlock ();
+  
+  j.error = error[best];
+  NS_LOG_INFO ("[engine,error,cost] " << getEngineName (best) << " " << error[best] << " " << cost[best]);
+  m_engineTrace (best, error[best], cost[best]);
+  return best;
+}
+
+//! journeys with no key, e.g., without an AccuracyTarget or to tubes, only add to the costs of their engine
+void P1906MOL_MOTOR_Motion::recordJourney(const Journey & j, Engine e, double delay, uint64_t ticks, uint64_t moves)
+{
+  lock_guard<mutex> guard (m_engineLock);
+  m_lastEngine = e;
+  m_journeys[e]++;
+  m_ticks[e] += ticks;
+  m_moves[e] += moves;
+  if (j.key.empty())
+    return;
+  
+  GeometryStats & g = m_geometries[j.key];
+  g.ticks[e] += ticks;
+  g.journeys[e]++;
+  if (e == FullStepping || e == FirstPassage)
+  {
+    //! reservoir sampling (Vitter's algorithm R), drawing from the counter g.recorded so that the
+    //! random streams of the motors are left alone
+    g.recorded++;
+    if (g.delays.size() < MAX_TABLE_DELAYS)
+      g.delays.push_back (delay);
+    else
+    {
+      const uint32_t key[2] = { P1906MOL_MOTOR_Rng::Motor, 0 };
+      const uint32_t ctr[4] = { (uint32_t) g.recorded, (uint32_t) (g.recorded >> 32), 0, 0 };
+      uint32_t out[4];
+      P1906MOL_MOTOR_Rng::philox4x32 (key, ctr, out);
+      uint64_t k = ((((uint64_t) out[0]) << 32) | out[1]) % g.recorded;
+      if (k < MAX_TABLE_DELAYS)
+        g.delays[k] = delay;
+    }
+    g.sorted = false;
+    g.delayError = max(g.delayError, j.error);
+  }
+}
+
+double P1906MOL_MOTOR_Motion::tabulatedDelay(const Journey & j, gsl_rng * r)
+{
+  lock_guard<mutex> guard (m_engineLock);
+  GeometryStats & g = m_geometries[j.key];
+  
+  if (!g.sorted)
+  {
+    sort (g.delays.begin(), g.delays.end());
+    g.sorted = true;
+  }
+  double x = gsl_rng_uniform (r) * (g.delays.size() - 1);
+  size_t i = min((size_t) x, g.delays.size() - 2);
+  double f = x - i;
+  return g.delays[i] * (1 - f) + g.delays[i + 1] * f;
+}
+
+//! the drawn journey ends where the straight line from the motor to the center meets the Receiver
+void P1906MOL_MOTOR_Motion::land(Ptr<P1906MOL_Motor> motor)
+{
+  double x, y, z, cx, cy, cz;
+  double closest = GSL_POSINF;
+  P1906MOL_MOTOR_Pos landing = motor->current_location;
+  
+  motor->current_location.getPos (&x, &y, &z);
+  for (size_t i = 0; i < motor->vsl.size(); i++)
+  {
+    if (motor->vsl.at(i).getType() != P1906MOL_MOTOR_VolSurface::Receiver)
+      continue;
+    motor->vsl.at(i).center.getPos (&cx, &cy, &cz);
+    double d = sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy) + (z - cz) * (z - cz));
+    double radius = motor->vsl.at(i).radius;
+    if (d - radius < closest && d > 0)
+    {
+      //! just inside, so that inDestination holds
+      double s = radius * (1 - 1e-9) / d;
+      closest = d - radius;
+      landing.setPos (cx + (x - cx) * s, cy + (y - cy) * s, cz + (z - cz) * s);
+    }
+  }
+  motor->setLocation (landing);
+  motor->pos_history.insert (motor->pos_history.end(), motor->current_location);
+}
+
 P1906MOL_MOTOR_Motion::~P1906MOL_MOTOR_Motion ()
 {
   NS_LOG_FUNCTION (this);
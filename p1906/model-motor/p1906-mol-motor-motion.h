@@ -39,11 +39,15 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <mutex>
 using namespace std;
 
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/traced-callback.h"
 #include "ns3/p1906-motion.h"
 #include "ns3/p1906-mol-motion.h"
 #include "ns3/p1906-mol-motor-pos.h"
@@ -51,6 +55,8 @@ using namespace std;
 
 namespace ns3 {
 
+class P1906MOL_Motor;
+
 /**
  * \ingroup IEEE P1906 framework
  *
@@ -70,6 +76,20 @@ namespace ns3 {
  *  Each tube is comprised of a list of segments within a gsl_matrix * of size s x 6 -> s x ((x1, y1, z1), (x2, y2, z2)).
  *  A set of tubes is also a gsl_matrix * of size (s * t) x 6, where s is the number of segments and t the number of tubes.
  *  All random number are derived from gsl_rng *.
+ *
+ * A motor journey is moved by one of four engines, from the most faithful to the cheapest:
+ *  - FullStepping: Brownian steps of timePeriod until the destination is reached (the reference model)
+ *  - FirstPassage: away from every surface and tube, jump to the exit point of the largest free sphere,
+ *      drawing the exit time from its first-passage distribution; step only close to surfaces
+ *  - Tabulated: draw the delay from the delays already simulated for the same geometry
+ *  - ClosedForm: draw the first-passage time of free diffusion to a single Receiver sphere
+ * With the AccuracyTarget attribute at 0 (default) every journey uses FullStepping. Otherwise, each
+ * journey uses the cheapest engine whose estimated relative error on the delay, with respect to
+ * FullStepping, is within the target. The errors depend on the geometry (surfaces present, clearance
+ * around the start, tubes) and on the delays simulated so far; the costs are the measured costs of
+ * the engines, or estimates until measured. Since the choice depends on measured times, runs with a
+ * non-zero target are not bit-reproducible. The chosen engine is logged, traced (EngineSelected) and
+ * returned by getLastEngine.
  */
 
 class P1906MOL_MOTOR_Motion : public P1906MOLMotion
@@ -88,12 +108,16 @@ public:
    */
   //! motor is driven by Brownian motion until the destination is reached, returning the propagation time
   void float2Destination(Ptr<P1906MessageCarrier> carrier, double timePeriod);
+  //! add the receiver and barrier volume surfaces of a transmitter at sv and a receiver at dv [m], then float2Destination, returning the propagation time
+  double float2Receiver(Ptr<P1906MessageCarrier> carrier, Vector sv, Vector dv, double timePeriod);
   //! motor binds to microtubule and walks and is driven by Brownian motion when unbound to microtubule, returning propagation time
   void move2Destination(Ptr<P1906MessageCarrier> carrier, gsl_matrix * tubeMatrix, size_t segPerTube, double timePeriod, vector<P1906MOL_MOTOR_Pos> & pts);
   //! display all the volume surfaces recognizing the motor
   void displayVolSurfaces();
   //! newPos is Brownian motion from currentPos over timePeriod 
   void brownianMotion(gsl_rng * r, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  //! newPos is Brownian motion from currentPos over timePeriod for the unit Gaussian displacement z (3 variates)
+  void brownianMotion(const double * z, gsl_vector * currentPos, gsl_vector * newPos, double timePeriod, double D, vector<P1906MOL_MOTOR_VolSurface> & vsl);
   //! Brownian motion from startPt for length time in timePeriod units; results returned in pts
   int freeFloat(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, int time, double timePeriod, vector<P1906MOL_MOTOR_VolSurface> & vsl);
   //! free float until intersection with any tube
@@ -101,6 +125,23 @@ public:
   //! walk along a specific tube identified by startPt and place result in pts
   void motorWalk(Ptr<P1906MessageCarrier> carrier, gsl_rng * r, gsl_vector * startPt, vector<P1906MOL_MOTOR_Pos> & pts, gsl_matrix * tubeMatrix, size_t segPerTube, vector<P1906MOL_MOTOR_VolSurface> & vsl);
   
+  /*
+   * Methods related to the choice of the engine moving the motor
+   */
+  //! the engines able to move a motor, from the most faithful to the cheapest
+  enum Engine { FullStepping = 0, FirstPassage, Tabulated, ClosedForm, NumEngines };
+  //! return the name of engine e
+  static const char * getEngineName(Engine e);
+  //! return the engine that moved the last motor
+  Engine getLastEngine();
+  //! return the number of journeys moved by engine e
+  uint64_t getEngineJourneys(Engine e);
+  //! relative error tolerated on the propagation delay with respect to FullStepping, 0 to always step
+  void setAccuracyTarget(double target);
+  double getAccuracyTarget();
+  //! draw the exit time of Brownian motion from the center of a sphere of radius rho [same units as rho^2 / D]
+  static double sphereExitTime(gsl_rng * r, double rho, double D);
+  
   /*
    * These methods are required to utilize the core IEEE 1906 reference model
    */
@@ -118,6 +159,58 @@ public:
   P1906MOL_MOTOR_Motion ();
   virtual ~P1906MOL_MOTOR_Motion ();
 
+private:
+  //! what is known about the journeys of a geometry: the delays simulated so far and the measured costs
+  struct GeometryStats
+  {
+    vector<double> delays; //! delays moved by FullStepping or FirstPassage, at most MAX_TABLE_DELAYS of them
+    uint64_t recorded; //! all the delays recorded, of which delays is a uniform sample
+    bool sorted;
+    double delayError; //! the largest estimated error of those delays
+    uint64_t ticks[NumEngines];
+    uint64_t journeys[NumEngines];
+  };
+  //! what decides which engines may move a journey
+  struct Journey
+  {
+    vector<double> key; //! D, timePeriod, start, surfaces and tubes: journeys with the same key share their statistics
+    double D;
+    double timePeriod;
+    double gap; //! distance from the start to the destination
+    double clearance; //! distance from the start to the closest surface or tube
+    double hitFraction; //! probability of free diffusion reaching the single Receiver, 0 if the closed form does not apply
+    bool tubes;
+    double error; //! the estimated error of the engine chosen for the journey
+  };
+
+  //! describe a journey from start through the volume surfaces and, if any, the tubes within binding radius
+  void describeJourney(vector<P1906MOL_MOTOR_VolSurface> & vsl, gsl_vector * start, gsl_matrix * tubeMatrix, double radius, double timePeriod, double D, Journey & j);
+  //! return the cheapest engine meeting the accuracy target for journey j
+  Engine selectEngine(Journey & j);
+  //! account for a journey of engine e lasting delay and costing ticks for moves steps or jumps
+  void recordJourney(const Journey & j, Engine e, double delay, uint64_t ticks, uint64_t moves);
+  //! draw a delay among those simulated for journey j, by linear interpolation of their quantiles
+  double tabulatedDelay(const Journey & j, gsl_rng * r);
+  //! move the motor just inside the closest Receiver, on the side facing its location
+  void land(Ptr<P1906MOL_Motor> motor);
+  //! distance from pt to the closest Receiver or ReflectiveBarrier surface
+  static double surfaceClearance(P1906MOL_MOTOR_Pos pt, vector<P1906MOL_MOTOR_VolSurface> & vsl);
+  //! distance from pt to the closest tube, less the binding radius
+  static double tubeClearance(gsl_vector * pt, gsl_matrix * tubeMatrix, double radius);
+  //! move pos to a uniformly random point of the sphere of radius rho around it, returning the exit time
+  double firstPassageJump(gsl_rng * r, gsl_vector * pos, double rho, double D);
+
+  double m_accuracyTarget;
+  Engine m_lastEngine;
+  //! the measured ticks and moves (steps or jumps) of the journeys of each engine, over all geometries
+  uint64_t m_ticks[NumEngines];
+  uint64_t m_moves[NumEngines];
+  uint64_t m_journeys[NumEngines];
+  map<vector<double>, GeometryStats> m_geometries;
+  //! journeys of a channel query share the Motion between threads
+  mutex m_engineLock;
+  //! engine, estimated error, estimated cost [ticks]
+  TracedCallback<uint32_t, double, double> m_engineTrace;
 };
 
 }
@@ -106,4 +106,13 @@ P1906MOL_MOTOR_Perturbation::CreateMessageCarrier (Ptr<Packet> p)
   return carrier;
 }
 
+Time
+P1906MOL_MOTOR_Perturbation::ComputeTransmissionTime (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this);
+
+  // one pulse per transmitted bit, every m_pulseInterval
+  return Seconds (m_pulseInterval.GetSeconds () * p->GetSize () * 8);
+}
+
 } // namespace ns3
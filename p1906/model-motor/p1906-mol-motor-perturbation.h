@@ -54,6 +54,8 @@ public:
 
   //! required for use IEEE 1906 core; this is where the user-defined Message Carrier is created
   virtual Ptr<P1906MessageCarrier> CreateMessageCarrier (Ptr<Packet> p);
+  //! one motor is released per bit, every pulse interval
+  virtual Time ComputeTransmissionTime (Ptr<Packet> p);
 
   void SetPulseInterval (Time t);
   Time GetPulseInterval (void);
@@ -42,6 +42,7 @@
  
 #include "ns3/log.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-memory-tracker.h"
 
 #include <string>
 
@@ -91,7 +92,9 @@ P1906MOL_MOTOR_Pos::P1906MOL_MOTOR_Pos ()
 	  
   */
 
-  pos = gsl_vector_alloc (3);
+  pos = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::POSITION, 3);
+  if (P1906MemoryTracker::IsEnabled ())
+    P1906MemoryTracker::Allocate (P1906MemoryTracker::POSITION, this, sizeof (P1906MOL_MOTOR_Pos));
 }
 
 ATTRIBUTE_HELPER_CPP (P1906MOL_MOTOR_Pos);
@@ -158,7 +161,7 @@ void P1906MOL_MOTOR_Pos::getPos (double * x, double * y, double * z)
 //! shift point by a scaled vector: new_pos = pos + d v_in
 void P1906MOL_MOTOR_Pos::shiftPos (P1906MOL_MOTOR_Pos v_in, double d)
 {
-  gsl_vector * v = gsl_vector_alloc (3);
+  gsl_vector * v = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::POSITION, 3);
   
   NS_LOG_DEBUG ("initial position: " << this);
   
@@ -189,6 +192,8 @@ void P1906MOL_MOTOR_Pos::displayPos()
 P1906MOL_MOTOR_Pos::~P1906MOL_MOTOR_Pos ()
 {
   NS_LOG_FUNCTION (this);
+  if (P1906MemoryTracker::IsEnabled ())
+    P1906MemoryTracker::Free (this);
 }
 
 } // namespace ns3
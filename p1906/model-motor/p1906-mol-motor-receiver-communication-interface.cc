@@ -36,7 +36,12 @@
 #include "ns3/p1906-medium.h"
 #include "ns3/p1906-net-device.h"
 #include "ns3/p1906-motion.h"
+#include "ns3/p1906-energy-ledger.h"
+#include "ns3/p1906-specificity-collector.h"
+#include "ns3/p1906-profiler.h"
+#include "ns3/p1906-capture.h"
 #include "ns3/p1906-mol-specificity.h"
+#include "ns3/p1906-mol-motor.h"
 #include "ns3/p1906-mol-motor-receiver-communication-interface.h"
 
 namespace ns3 {
@@ -67,12 +72,30 @@ P1906MOL_MOTOR_ReceiverCommunicationInterface::HandleReception (Ptr<P1906Communi
   NS_LOG_FUNCTION (this);
 
   Ptr<P1906MOLSpecificity> specificity = GetP1906Specificity ()->GetObject<P1906MOLSpecificity> ();
-  bool isRxOk = specificity->CheckRxCompatibility (src, dst, message);
+  bool isRxOk;
+  {
+    P1906ProfilerScope scope (P1906Profiler::CHECK_RX_COMPATIBILITY);
+    isRxOk = specificity->CheckRxCompatibility (src, dst, message);
+  }
+  //! the decision margin of a motor is its binding score with the receiver volume, at most 1:
+  //! the histogram bins span the scores in [-2, 2)
+  Ptr<P1906MOL_Motor> motor = message->GetObject<P1906MOL_Motor> ();
+  if (motor)
+    {
+	  specificity->SetDecisionMargin (motor->bindingScore ());
+	  specificity->SetMarginScale (0.125);
+    }
+  P1906SpecificityCollector::GetCollector ()->NotifyDecision (src, dst, specificity, isRxOk);
+  if (P1906Capture::IsEnabled ())
+    {
+      P1906Capture::GetCapture ()->NotifyReception (src, dst, message, specificity, isRxOk);
+    }
   if (isRxOk)
     {
 	  NS_LOG_FUNCTION (this << "message received correctly");
 	  Ptr<Packet> p = message->GetMessage ();
-	  //xxx forward to upper layer
+	  P1906EnergyLedger::GetLedger ()->NotifyDelivery (p->GetUid (), p->GetSize () * 8);
+	  GetP1906CommunicationInterface ()->HandleReception (p);
     }
   else
     {
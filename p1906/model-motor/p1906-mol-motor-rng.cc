@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+
+#include "ns3/p1906-mol-motor-rng.h"
+
+#include <map>
+#include <mutex>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("P1906MOL_MOTOR_Rng");
+
+//! the state of a stream: the key, the counter and the last block of random numbers
+struct philox_state_t
+{
+  uint32_t key[2];
+  //! (step low, step high, component, carrier)
+  uint32_t ctr[4];
+  uint32_t block[4];
+  //! next unused number of block, 4 when the block is used up
+  uint32_t idx;
+};
+
+//! the product of a and b split into high and low 32 bits
+static inline uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t * hi)
+{
+  uint64_t p = (uint64_t) a * b;
+  *hi = (uint32_t) (p >> 32);
+  return (uint32_t) p;
+}
+
+void P1906MOL_MOTOR_Rng::philox4x32(const uint32_t key[2], const uint32_t ctr[4], uint32_t out[4])
+{
+  uint32_t k0 = key[0], k1 = key[1];
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  
+  for (int round = 0; round < 10; round++)
+  {
+    uint32_t hi0, hi1;
+    uint32_t lo0 = mulhilo (0xD2511F53, c0, &hi0);
+    uint32_t lo1 = mulhilo (0xCD9E8D57, c2, &hi1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+    //! bump the key with the Weyl sequence
+    k0 += 0x9E3779B9;
+    k1 += 0xBB67AE85;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+//! the key depends on the ns-3 seed and run number only
+static void philoxKey(philox_state_t * s)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  s->key[0] = RngSeedManager::GetSeed ();
+  s->key[1] = (uint32_t) run ^ (uint32_t) (run >> 32);
+}
+
+static void philoxSet(void * vstate, unsigned long seed)
+{
+  philox_state_t * s = (philox_state_t *) vstate;
+  philoxKey (s);
+  s->ctr[0] = 0;
+  s->ctr[1] = 0;
+  s->ctr[2] = (uint32_t) ((uint64_t) seed >> 32);
+  s->ctr[3] = (uint32_t) seed;
+  s->idx = 4;
+}
+
+static unsigned long philoxGet(void * vstate)
+{
+  philox_state_t * s = (philox_state_t *) vstate;
+  if (s->idx == 4)
+  {
+    P1906MOL_MOTOR_Rng::philox4x32 (s->key, s->ctr, s->block);
+    //! next step
+    if (++s->ctr[0] == 0)
+      s->ctr[1]++;
+    s->idx = 0;
+  }
+  return s->block[s->idx++];
+}
+
+static double philoxGetDouble(void * vstate)
+{
+  return philoxGet (vstate) / 4294967296.0;
+}
+
+static const gsl_rng_type philoxType =
+{
+  "p1906-philox4x32-10",
+  0xffffffffUL,
+  0,
+  sizeof (philox_state_t),
+  &philoxSet,
+  &philoxGet,
+  &philoxGetDouble
+};
+
+//! the next carrier id of each component
+static map<uint32_t, uint32_t> carrierIds;
+static mutex carrierIdsLock;
+
+const gsl_rng_type * P1906MOL_MOTOR_Rng::philox()
+{
+  return &philoxType;
+}
+
+gsl_rng * P1906MOL_MOTOR_Rng::alloc(uint32_t c)
+{
+  uint32_t carrier;
+  {
+    lock_guard<mutex> guard (carrierIdsLock);
+    carrier = carrierIds[c]++;
+  }
+  
+  gsl_rng * r = gsl_rng_alloc (philox());
+  setStream (r, c, carrier);
+  NS_LOG_DEBUG ("stream [component,carrier] " << c << " " << carrier);
+  return r;
+}
+
+void P1906MOL_MOTOR_Rng::setStream(gsl_rng * r, uint32_t component, uint32_t carrier)
+{
+  gsl_rng_set (r, ((unsigned long) component << 32) | carrier);
+}
+
+void P1906MOL_MOTOR_Rng::setStep(gsl_rng * r, uint64_t step)
+{
+  if (r->type != philox())
+  {
+    NS_LOG_WARN ("setStep requires a " << philoxType.name << " stream");
+    return;
+  }
+  philox_state_t * s = (philox_state_t *) gsl_rng_state (r);
+  s->ctr[0] = (uint32_t) step;
+  s->ctr[1] = (uint32_t) (step >> 32);
+  s->idx = 4;
+}
+
+uint64_t P1906MOL_MOTOR_Rng::getStep(const gsl_rng * r)
+{
+  if (r->type != philox())
+    return 0;
+  const philox_state_t * s = (const philox_state_t *) gsl_rng_state (r);
+  uint64_t step = ((uint64_t) s->ctr[1] << 32) | s->ctr[0];
+  //! the current block belongs to the previous step until it is used up
+  return (s->idx < 4) ? step - 1 : step;
+}
+
+//! Box-Muller on pairs of uniforms in (0, 1], batch pairs at a time
+static void boxMuller(const double * u1, const double * u2, double sigma, double * out, size_t pairs)
+{
+  for (size_t i = 0; i < pairs; i++)
+  {
+    double radius = sigma * sqrt (-2.0 * log (u1[i]));
+    double theta = 2.0 * M_PI * u2[i];
+    out[2 * i] = radius * cos (theta);
+    out[2 * i + 1] = radius * sin (theta);
+  }
+}
+
+//! a uniform in (0, 1] from 64 random bits, with 53 bits of precision
+static inline double uniform53(uint32_t hi, uint32_t lo)
+{
+  return ((((uint64_t) hi << 32 | lo) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+void P1906MOL_MOTOR_Rng::gaussian(gsl_rng * r, double sigma, double * out, size_t n)
+{
+  const size_t batch = 64;
+  double u1[batch], u2[batch], z[2 * batch];
+  bool isPhilox = (r->type == philox());
+  philox_state_t * s = (philox_state_t *) gsl_rng_state (r);
+  
+  //! a partially used block is skipped, variates start at a step boundary
+  if (isPhilox)
+    s->idx = 4;
+  
+  for (size_t done = 0; done < n; )
+  {
+    size_t pairs = min (batch, (n - done + 1) / 2);
+    if (isPhilox)
+    {
+      //! one counter increment, i.e., one step, per pair
+      for (size_t i = 0; i < pairs; i++)
+      {
+        uint32_t block[4];
+        philox4x32 (s->key, s->ctr, block);
+        if (++s->ctr[0] == 0)
+          s->ctr[1]++;
+        u1[i] = uniform53 (block[0], block[1]);
+        u2[i] = uniform53 (block[2], block[3]);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < pairs; i++)
+      {
+        u1[i] = gsl_rng_uniform_pos (r);
+        u2[i] = gsl_rng_uniform (r);
+      }
+    }
+    boxMuller (u1, u2, sigma, z, pairs);
+    size_t m = min (2 * pairs, n - done);
+    for (size_t i = 0; i < m; i++)
+      out[done + i] = z[i];
+    done += m;
+  }
+}
+
+void P1906MOL_MOTOR_Rng::resetCarrierIds()
+{
+  lock_guard<mutex> guard (carrierIdsLock);
+  carrierIds.clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+
+#ifndef P1906_MOL_MOTOR_RNG
+#define P1906_MOL_MOTOR_RNG
+
+#include <gsl/gsl_rng.h>
+
+#include <stdint.h>
+#include <stddef.h>
+using namespace std;
+
+namespace ns3 {
+
+/**
+ * \ingroup IEEE P1906 framework
+ *
+ * \class P1906MOL_MOTOR_Rng
+ *
+ * \brief Counter-based random number streams for the stochastic P1906 components
+ *
+ * gsl_rng_philox is a GSL generator type implementing Philox4x32-10:
+ *   Salmon, J. K., Moraes, M. A., Dror, R. O., & Shaw, D. E. (2011). Parallel
+ *     Random Numbers: As Easy as 1, 2, 3. Proceedings of SC11, 1-12.
+ *     http://dx.doi.org/10.1145/2063384.2063405.
+ *
+ * Each random block is the encryption of the counter (step, component, carrier)
+ * under the key (seed, run) taken from ns-3's RngSeedManager, so a stream is
+ * fully identified by (run seed, component id, carrier id, step). Streams share
+ * no state, are independent of the order in which they are used and of the
+ * number of threads using them, and jump to any step in constant time.
+ *
+ * Since it is a gsl_rng, a stream is used with all the gsl_ran_* functions and
+ * with every method taking a gsl_rng * argument. gsl_rng_set (r, s) selects the
+ * stream with component id s >> 32 and carrier id s & 0xffffffff.
+ *
+ * gaussian fills whole arrays of normal variates, e.g., the displacements of an
+ * ensemble for one step, using Box-Muller on 64-bit uniforms: each Philox block
+ * gives two variates, and the transform runs as a branch-free loop over arrays
+ * which the compiler vectorizes with a vector math library.
+ */
+
+class P1906MOL_MOTOR_Rng
+{
+public:
+  //! the component ids of the P1906 objects drawing random numbers
+  enum component_t { Motor = 1, VolSurface, MicrotubulesField, Tube, ChannelQuery, Bacteria, Arrival, User = 1000 };
+  
+  //! the Philox4x32-10 generator type
+  static const gsl_rng_type * philox();
+  
+  //! allocate the stream of the next object of component c, i.e., carrier ids are assigned in creation order
+  static gsl_rng * alloc(uint32_t c);
+  //! select the stream (component, carrier) of r and restart it at step 0
+  static void setStream(gsl_rng * r, uint32_t component, uint32_t carrier);
+  //! jump to the first random number of step
+  static void setStep(gsl_rng * r, uint64_t step);
+  //! return the step of the next random number
+  static uint64_t getStep(const gsl_rng * r);
+  //! restart carrier id assignment, e.g., for a new run within the same process
+  static void resetCarrierIds();
+  
+  //! fill out with n independent Gaussian variates with zero mean and standard deviation sigma
+  static void gaussian(gsl_rng * r, double sigma, double * out, size_t n);
+  
+  //! the Philox4x32-10 bijection: encrypt counter ctr with key
+  static void philox4x32(const uint32_t key[2], const uint32_t ctr[4], uint32_t out[4]);
+};
+
+}
+
+#endif /* P1906_MOL_MOTOR_RNG */
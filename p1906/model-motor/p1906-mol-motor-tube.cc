@@ -51,6 +51,8 @@
 #include "ns3/p1906-mol-motor-tube.h"
 
 #include "ns3/p1906-mol-motor-tube-characteristics.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -81,13 +83,23 @@ P1906MOL_MOTOR_Tube::P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_
 	  
   */
   
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);  
-  gsl_rng_env_setup();
-  gsl_rng_set (r, rand());
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::Tube);
   
   //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
-  segMatrix = gsl_matrix_alloc (ts->segPerTube, 6);
+  segMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::TUBE, ts->segPerTube, 6);
+  
+  genTube(ts, r, segMatrix, startPt);
+}
+
+//! the constructor creates the tube from a given stream
+P1906MOL_MOTOR_Tube::P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_vector * startPt, gsl_rng * stream)
+{
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = stream;
+  
+  //! hold the values for a tube comprised of many segments: x_start y_start x_start x_end y_end z_end
+  segMatrix = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::TUBE, ts->segPerTube, 6);
   
   genTube(ts, r, segMatrix, startPt);
 }
@@ -141,8 +153,8 @@ int P1906MOL_MOTOR_Tube::genTube(struct tubeCharacteristcs_t * ts, gsl_rng *r, g
 	
   */
    
-  gsl_matrix * segAngleTheta = gsl_matrix_alloc (ts->numSegments, 1);
-  gsl_matrix * segAnglePsi = gsl_matrix_alloc (ts->numSegments, 1);
+  gsl_matrix * segAngleTheta = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::TUBE, ts->numSegments, 1);
+  gsl_matrix * segAnglePsi = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::TUBE, ts->numSegments, 1);
 
   //NS_LOG_DEBUG ("startX = " << gsl_vector_get (startPt, 0)
   //<< " startY = " << gsl_vector_get (startPt, 1)
@@ -228,11 +240,16 @@ double P1906MOL_MOTOR_Tube::genPersistenceLength(gsl_rng * r, gsl_matrix * segAn
 	sigma = DBL_MAX; //! maximum possible variance
 
   //NS_LOG_DEBUG ("sigma = " << sigma);
+  
+  //! draw the angles of all the segments as one block
+  vector<double> g (segAngle->size1);
+  if (!g.empty())
+    P1906MOL_MOTOR_Rng::gaussian (r, sigma, &g[0], g.size());
 	
   for(size_t i = 0; i < segAngle->size1; i++)
   {
     //! return a valid radian [0..2\pi]
-    angle = fmod(gsl_ran_gaussian (r, sigma), (2 * M_PI));
+    angle = fmod(g[i], (2 * M_PI));
 	if (!gsl_finite (angle))
 	  angle = gsl_ran_ugaussian (r) * (2 * M_PI); //! just pick a uniform random angle
     //NS_LOG_DEBUG ("radian(" << i << ") = " << angle);
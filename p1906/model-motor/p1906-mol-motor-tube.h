@@ -91,6 +91,8 @@ public:
    */  
   //! the constructor build a tube determined by tubeCharacteristcs_t
   P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_vector * startPt);
+  //! build the tube drawing from the stream r, e.g., a stream allocated in advance when tubes are built in parallel
+  P1906MOL_MOTOR_Tube (struct tubeCharacteristcs_t * ts, gsl_vector * startPt, gsl_rng * r);
   //! return the microtubule in segMatrix of a given persistence length starting at position startPt and its structural entropy in se
   int genTube(struct tubeCharacteristcs_t * ts, gsl_rng * r, gsl_matrix * segMatrix, gsl_vector * startPt);
 
@@ -54,6 +54,9 @@
 #include "ns3/p1906-mol-motor-field.h"
 #include "ns3/p1906-mol-motor-tube.h"
 #include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-profiler.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "ns3/p1906-memory-tracker.h"
 
 namespace ns3 {
 
@@ -92,9 +95,8 @@ P1906MOL_MOTOR_VolSurface::P1906MOL_MOTOR_VolSurface ()
 	  
   */
   
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);
-  gsl_rng_env_setup();  
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::VolSurface);
 }
 
 std::ostream& operator<<(std::ostream& out, const P1906MOL_MOTOR_VolSurface& vs)
@@ -163,14 +165,14 @@ P1906MOL_MOTOR_VolSurface::typeOfVolume P1906MOL_MOTOR_VolSurface::getType ()
 void P1906MOL_MOTOR_VolSurface::reflect(P1906MOL_MOTOR_Pos last_pos, P1906MOL_MOTOR_Pos & current_pos)
 {
   vector<P1906MOL_MOTOR_Pos> intersection;
-  gsl_vector * trajectory = gsl_vector_alloc (6);
-  gsl_vector * ext_traj = gsl_vector_alloc (6);
-  gsl_vector * int_traj = gsl_vector_alloc (6);
-  gsl_vector * vol_radius = gsl_vector_alloc (6);
-  gsl_vector * rad_vec = gsl_vector_alloc (3);
-  gsl_vector * lp = gsl_vector_alloc (3);
-  gsl_vector * ip = gsl_vector_alloc (3);
-  gsl_matrix * vectors = gsl_matrix_alloc (2, 6);
+  gsl_vector * trajectory = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 6);
+  gsl_vector * ext_traj = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 6);
+  gsl_vector * int_traj = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 6);
+  gsl_vector * vol_radius = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 6);
+  gsl_vector * rad_vec = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_vector * lp = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_vector * ip = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_matrix * vectors = P1906MemoryTracker::MatrixAlloc (P1906MemoryTracker::VOL_SURFACE, 2, 6);
 
   NS_LOG_DEBUG ("last_pos: " << last_pos << " current_pos: " << current_pos);
   
@@ -194,7 +196,17 @@ void P1906MOL_MOTOR_VolSurface::reflect(P1906MOL_MOTOR_Pos last_pos, P1906MOL_MO
   //LOG_DEBUG ("intersection size: " << intersection.size());
   if (intersection.size() == 0)
   {
+	  //! nothing to reflect: current_pos is unchanged
 	  NS_LOG_DEBUG ("motor did not pass through surface");
+	  P1906MemoryTracker::VectorFree (trajectory);
+	  P1906MemoryTracker::VectorFree (ext_traj);
+	  P1906MemoryTracker::VectorFree (int_traj);
+	  P1906MemoryTracker::VectorFree (vol_radius);
+	  P1906MemoryTracker::VectorFree (rad_vec);
+	  P1906MemoryTracker::VectorFree (lp);
+	  P1906MemoryTracker::VectorFree (ip);
+	  P1906MemoryTracker::MatrixFree (vectors);
+	  return;
   }
   
   //! segment CR is the radius of the volume
@@ -265,8 +277,8 @@ void P1906MOL_MOTOR_VolSurface::getRadiusLine(gsl_vector * v_radius, P1906MOL_MO
 //! return the angle between two vectors
 double P1906MOL_MOTOR_VolSurface::vectorAngle(gsl_vector * seg1, gsl_vector * seg2)
 {
-  gsl_vector * v1 = gsl_vector_alloc (3);
-  gsl_vector * v2 = gsl_vector_alloc (3);
+  gsl_vector * v1 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_vector * v2 = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
   
   //! take dot product, find magnitudes, and solve for cosθ = a.b / |a||b|
   //! see http://www.wikihow.com/Find-the-Angle-Between-Two-Vectors
@@ -323,7 +335,7 @@ double P1906MOL_MOTOR_VolSurface::fluxMeter(gsl_matrix * tubeMatrix)
   //! all intersection points
   vector<P1906MOL_MOTOR_Pos> ipts;
   //! the current segment
-  gsl_vector * segment = gsl_vector_alloc (6);
+  gsl_vector * segment = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 6);
   
   for (size_t s = 0; s < tubeMatrix->size1; s++)
   {
@@ -345,10 +357,11 @@ double P1906MOL_MOTOR_VolSurface::fluxMeter(gsl_matrix * tubeMatrix)
 //! return true if the point is inside the volume surface
 bool P1906MOL_MOTOR_VolSurface::isInsideVolSurf(P1906MOL_MOTOR_Pos pt)
 {
+  P1906ProfilerScope scope (P1906Profiler::SURFACE_CHECK);
   bool isInside = false;
   double norm = 0;
-  gsl_vector * C = gsl_vector_alloc (3);
-  gsl_vector * P = gsl_vector_alloc (3);
+  gsl_vector * C = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_vector * P = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
   
   //! simply check if distance from center is less than radius
   center.getPos (C);
@@ -370,9 +383,10 @@ bool P1906MOL_MOTOR_VolSurface::isInsideVolSurf(P1906MOL_MOTOR_Pos pt)
 //! (3)if two intersections, then ipt has two intersection points
 void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector<P1906MOL_MOTOR_Pos> & ipt)
 {
+  P1906ProfilerScope scope (P1906Profiler::SURFACE_CHECK);
   P1906MOL_MOTOR_Pos o, l, c;
   double d, r;
-  gsl_vector * lv = gsl_vector_alloc (3);
+  gsl_vector * lv = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
   
   //! find all the tube segments intersecting with the surface: equation for surface as function of x, y, z == equation for segment
   //! sphere = x^2 + y^2 + z^2 = r^2
@@ -418,8 +432,8 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
   //! B = l * (o - c), 4AC = |o - c|^2 + r^2, -B +/- sqrt(B^2 - 4AC)/2A
   double B;
   double AC;
-  gsl_vector * O = gsl_vector_alloc (3);
-  gsl_vector * C = gsl_vector_alloc (3);
+  gsl_vector * O = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
+  gsl_vector * C = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
   
   o.getPos (O);
   center.getPos (C);
@@ -432,26 +446,20 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
   //NS_LOG_DEBUG ("lv: << gsl_vector_get (lv, 0) << " " << gsl_vector_get (lv, 1) << " " << gsl_vector_get (lv, 2));
   //NS_LOG_DEBUG ("B = l . (o - c): " << B);
   
-  //! AC = |o - c|^2 + r^2
+  //! AC = B^2 - |o - c|^2 + r^2, the discriminant
   double norm = gsl_blas_dnrm2 (O);
-  //NS_LOG_DEBUG ("|o - c|^2: " << norm);
-  AC = norm + pow(r, 2);
-  //NS_LOG_DEBUG ("AC = |o - c|^2 + r^2: << AC);
+  //NS_LOG_DEBUG ("|o - c|: " << norm);
+  AC = pow(B, 2) - pow(norm, 2) + pow(r, 2);
+  //NS_LOG_DEBUG ("AC = B^2 - |o - c|^2 + r^2: << AC);
   
-  //! it looks like a pow(B, 2) term should be added to AC
-  
-  //! if B^2 - AC < 0, then no intersection
-  if (AC < 0)
-  {
-    ipt.clear();
-  }
+  //! if B^2 - AC < 0, then no intersection: nothing is added to ipt
 	
   //! if B^2 - 4AC == 0, then one intersection
   if (AC == 0)
   {
-    //! only do this if d is <= length of tube
+    //! only do this if 0 <= d <= length of tube, i.e., the point is on the segment
 	d = -B;
-	if (abs(d) <= segMag)
+	if (d >= 0 && d <= segMag)
 	{
 		//NS_LOG_DEBUG ("AC == 0 d: " << d << " segMag: " << segMag);
 		//NS_LOG_DEBUG ("l: " << l);
@@ -467,7 +475,7 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
   if (AC > 0)
   {
     P1906MOL_MOTOR_Pos tmp;
-	gsl_vector * v_tmp = gsl_vector_alloc (3);
+	gsl_vector * v_tmp = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::VOL_SURFACE, 3);
 	
 	//NS_LOG_DEBUG ("AC: " << AC);
 	
@@ -475,9 +483,9 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
 	o.getPos (v_tmp);
 	tmp.setPos (v_tmp);
 	
-	//! only do this if d is <= length of tube
+	//! only do this if 0 <= d <= length of tube
 	d = -B + sqrt(AC);
-    if (abs(d) <= segMag)
+    if (d >= 0 && d <= segMag)
 	{	
 		//NS_LOG_DEBUG ("AC > 0 and d = -B + sqrt(AC) d: " << d << " segMag: " << segMag);
 		//NS_LOG_DEBUG ("l: " << l);
@@ -487,9 +495,9 @@ void P1906MOL_MOTOR_VolSurface::sphereIntersections(gsl_vector * segment, vector
 		//NS_LOG_DEBUG (" o shifted: " << o);
 		ipt.insert(ipt.end(), o);
     }	
-	//! only do this if d is <= length of tube
+	//! only do this if 0 <= d <= length of tube
 	d = -B - sqrt(AC);
-	if (abs(d) <= segMag)
+	if (d >= 0 && d <= segMag)
 	{
 		//NS_LOG_DEBUG ("AC > 0 and d = -B - sqrt(AC) d: " << d << " segMag: " << segMag);
 		//NS_LOG_DEBUG ("l: " << l);
@@ -49,6 +49,10 @@
 #include "ns3/log.h"
 
 #include "ns3/p1906-mol-motor.h"
+#include "ns3/p1906-mol-motor-rng.h"
+#include "ns3/p1906-memory-tracker.h"
+
+#include <limits>
 
 namespace ns3 {
 
@@ -88,6 +92,13 @@ TypeId P1906MOL_Motor::GetTypeId (void)
 //! The motor constructor creates a motor, but no Receiver volume. This must be set using addVolumeSurface.
 //! Without a P1906MOL_MOTOR_VolSurface::Receiver volume, their is no destination and the motor will wander forever.
 P1906MOL_Motor::P1906MOL_Motor ()
+  : P1906MOL_Motor (P1906MOL_MOTOR_Rng::Motor)
+{
+}
+
+//! motors which are not transmitted, e.g., arrival copies and channel queries, draw from their own
+//! component so that the streams of the transmitted motors do not depend on them
+P1906MOL_Motor::P1906MOL_Motor (uint32_t c)
 {
   /** This class implements persistence length as described in:
 	  Bush, S. F., & Goel, S. (2013). Persistence Length as a Metric for Modeling and 
@@ -108,11 +119,20 @@ P1906MOL_Motor::P1906MOL_Motor ()
     
   //! start with an empty record of for tracking position
   pos_history.clear();
+
+  //! no energy consumed yet
+  initEnergy();
+  
+  //! the transmitted motor, shared by the journeys to every receiver
+  arrived = false;
   
   //! random number generation structures and initialization
-  T = gsl_rng_default;
-  r = gsl_rng_alloc (T);
-  gsl_rng_env_setup();
+  T = P1906MOL_MOTOR_Rng::philox();
+  r = P1906MOL_MOTOR_Rng::alloc (c);
+
+  //! the carrier base classes have reported their own size: report the motor's
+  if (P1906MemoryTracker::IsEnabled ())
+    P1906MemoryTracker::Allocate (P1906MemoryTracker::CARRIER, this, sizeof (P1906MOL_Motor));
 }
 
 std::ostream& operator<<(std::ostream& out, const P1906MOL_Motor& m)
@@ -125,6 +145,30 @@ std::istream& operator>>(std::istream& is, P1906MOL_Motor& m)
   return is >> m.t.time >> m.current_location;
 }
 
+//! the copy continues the random stream of the motor; the volume surfaces are immutable once added and are shared
+Ptr<P1906MOL_Motor> P1906MOL_Motor::arrival()
+{
+  Ptr<P1906MOL_Motor> a = CreateObject<P1906MOL_Motor> (P1906MOL_MOTOR_Rng::Arrival);
+  
+  a->SetMessage (GetMessage ());
+  a->SetDuration (GetDuration ());
+  a->SetPulseInterval (GetPulseInterval ());
+  a->SetStartTime (GetStartTime ());
+  a->SetMolecules (GetMolecules ());
+  
+  a->start_x = start_x;
+  a->start_y = start_y;
+  a->start_z = start_z;
+  a->current_location.setPos (current_location);
+  a->t = t;
+  a->energy = energy;
+  a->vsl = vsl;
+  gsl_rng_memcpy (a->r, r);
+  a->arrived = true;
+  
+  return a;
+}
+
 //! create and store a new volume surface of any type: FluxMeter, ReflectiveBarrier, Receiver
 void P1906MOL_Motor::addVolumeSurface(P1906MOL_MOTOR_Pos v_c, double v_radius, P1906MOL_MOTOR_VolSurface::typeOfVolume v_type)
 {
@@ -180,6 +224,32 @@ bool P1906MOL_Motor::inDestination()
   return inDest;
 }
 
+//! the binding score is the largest normalized depth of the motor inside a Receiver volume
+double P1906MOL_Motor::bindingScore()
+{
+  double score = -GSL_POSINF;
+  gsl_vector * C = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::CARRIER, 3);
+  gsl_vector * P = P1906MemoryTracker::VectorAlloc (P1906MemoryTracker::CARRIER, 3);
+  
+  current_location.getPos (P);
+  for (size_t i = 0; i < vsl.size(); i++)
+  {
+    if (vsl.at(i).getType() != P1906MOL_MOTOR_VolSurface::Receiver)
+      continue;
+	
+    vsl.at(i).center.getPos (C);
+    gsl_vector_sub (C, P);
+    double s = (vsl.at(i).radius - gsl_blas_dnrm2 (C)) / vsl.at(i).radius;
+    if (s > score)
+      score = s;
+  }
+  
+  P1906MemoryTracker::VectorFree (C);
+  P1906MemoryTracker::VectorFree (P);
+  
+  return score;
+}
+
 //! set the current motor location to pt
 void P1906MOL_Motor::setLocation(P1906MOL_MOTOR_Pos pt)
 {
@@ -229,6 +299,37 @@ double P1906MOL_Motor::propagationDelay()
   return getTime();
 }
 
+//! return the energy consumed since the last initialization
+double P1906MOL_Motor::getEnergy()
+{
+  return energy;
+}
+
+//! initialize the consumed energy
+void P1906MOL_Motor::initEnergy()
+{
+  energy = 0;
+}
+
+//! add the energy consumed by an event, for example, ATP hydrolysis during a motor step
+void P1906MOL_Motor::updateEnergy(double event_energy)
+{
+  energy += event_energy;
+}
+
+//! the propagation delay is in the time units of the motor model
+//! the transmitted motor journeys to every receiver in turn, so only an arrival copy holds the delay
+//! and energy of one destination: the transmitted motor reports NaN for both
+P1906MessageCarrier::CaptureMetadata P1906MOL_Motor::GetCaptureMetadata (void)
+{
+  CaptureMetadata m = P1906MOLMessageCarrier::GetCaptureMetadata ();
+  m.model = MOTOR_CARRIER;
+  m.nValues = 3;
+  m.values[1] = arrived ? propagationDelay() : std::numeric_limits<double>::quiet_NaN ();
+  m.values[2] = arrived ? energy : std::numeric_limits<double>::quiet_NaN ();
+  return m;
+}
+
 P1906MOL_Motor::~P1906MOL_Motor ()
 {
   NS_LOG_FUNCTION (this);
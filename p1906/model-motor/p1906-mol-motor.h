@@ -112,6 +112,24 @@ public:
   void updateTime(double event_time);
   //! return the elapsed time since the motor was created
   double propagationDelay();
+  //! return the molecules, the propagation delay and the energy of the motor for a P1906Capture
+  virtual CaptureMetadata GetCaptureMetadata (void);
+  
+  //! true for the copy delivered to one receiver, see arrival
+  bool arrived;
+
+  //! energy consumed by the motor (J), e.g., ATP hydrolysed while walking along tubes
+  double energy;
+
+  /*
+   * Methods related to energy consumption
+   */
+  //! return the energy consumed since the last initEnergy
+  double getEnergy();
+  //! reset the consumed energy
+  void initEnergy();
+  //! add the energy consumed by an event
+  void updateEnergy(double event_energy);
 
   //! randomness for the motor  
   const gsl_rng_type * T;
@@ -121,6 +139,13 @@ public:
   vector<P1906MOL_MOTOR_VolSurface> vsl;
   
   P1906MOL_Motor ();
+  //! a motor drawing its random numbers from the streams of component c, see P1906MOL_MOTOR_Rng
+  P1906MOL_Motor (uint32_t c);
+
+  //! return a copy of the motor as it arrived at one receiver: time, energy, location and volume
+  //! surfaces, without the position history. The medium delivers a copy to each receiver since the
+  //! motor itself moves on to the next one.
+  Ptr<P1906MOL_Motor> arrival();
 
   /*
    * Methods related to volume surfaces
@@ -141,6 +166,9 @@ public:
   void setLocation(double x, double y, double z);
   //! return true if motor is in the destination volume, false otherwise
   bool inDestination();
+  //! return the binding score with the closest Receiver volume: 1 at its center, 0 on its surface,
+  //! negative outside, i.e., (radius - distance from center) / radius
+  double bindingScore();
   //! this is where the motor starts, for example, location of the transmitter
   void setStartingPoint(gsl_vector * pt);
   
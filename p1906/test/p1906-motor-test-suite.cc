@@ -0,0 +1,687 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/*
+ * Description:
+ * correctness tests of the molecular motor model against analytic results
+ *
+ * These replace the unitTest_* methods of P1906MOL_MOTOR_MicrotubulesField, which are
+ * commented out in its constructor and plot their results to .mma files: each case here
+ * checks the same kernel against a closed-form value and writes no files.
+ */
+
+#include "ns3/test.h"
+#include "ns3/p1906-mol-motor-field.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-motor-motion.h"
+#include "ns3/p1906-mol-motor.h"
+#include "ns3/p1906-mol-motor-rng.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+static const double g_tolerance = 1e-9;
+
+/*
+ * P1906MOL_MOTOR_Field::distance: Euclidean distance to a point and
+ * perpendicular distance to the line through a segment
+ */
+class P1906MotorDistanceTestCase : public TestCase
+{
+public:
+  P1906MotorDistanceTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorDistanceTestCase::P1906MotorDistanceTestCase ()
+  : TestCase ("distance from a point to a point and to a line")
+{
+}
+
+void
+P1906MotorDistanceTestCase::DoRun (void)
+{
+  gsl_vector *pt = gsl_vector_alloc (3);
+  gsl_vector *pt1 = gsl_vector_alloc (3);
+  gsl_vector *pt2 = gsl_vector_alloc (3);
+  gsl_vector *segment = gsl_vector_alloc (6);
+
+  P1906MOL_MOTOR_Field::point (pt, 0, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt1, 3, 4, 0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (P1906MOL_MOTOR_Field::distance (pt, pt1), 5., g_tolerance, "point to point");
+
+  // the origin lies on the diagonal through (-1, -1, -1) and (2, 2, 2), as in unitTest_Distance
+  P1906MOL_MOTOR_Field::point (pt1, -1, -1, -1);
+  P1906MOL_MOTOR_Field::point (pt2, 2, 2, 2);
+  P1906MOL_MOTOR_Field::line (segment, pt1, pt2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (P1906MOL_MOTOR_Field::distance (pt, segment), 0., g_tolerance, "point on the line");
+
+  P1906MOL_MOTOR_Field::point (pt, 0, 1, 0);
+  P1906MOL_MOTOR_Field::point (pt1, -1, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 1, 0, 0);
+  P1906MOL_MOTOR_Field::line (segment, pt1, pt2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (P1906MOL_MOTOR_Field::distance (pt, segment), 1., g_tolerance, "point off an axis");
+
+  // a line at 45 degrees: the distance is 1/sqrt(2)
+  P1906MOL_MOTOR_Field::point (pt, 1, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt1, 0, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 1, 1, 0);
+  P1906MOL_MOTOR_Field::line (segment, pt1, pt2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (P1906MOL_MOTOR_Field::distance (pt, segment), 1. / sqrt (2.), g_tolerance, "point off a diagonal");
+
+  gsl_vector_free (pt);
+  gsl_vector_free (pt1);
+  gsl_vector_free (pt2);
+  gsl_vector_free (segment);
+}
+
+/*
+ * P1906MOL_MOTOR_Field::cross_product: right-handed unit vectors and anticommutativity
+ */
+class P1906MotorCrossProductTestCase : public TestCase
+{
+public:
+  P1906MotorCrossProductTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorCrossProductTestCase::P1906MotorCrossProductTestCase ()
+  : TestCase ("cross product")
+{
+}
+
+void
+P1906MotorCrossProductTestCase::DoRun (void)
+{
+  gsl_vector *u = gsl_vector_alloc (3);
+  gsl_vector *v = gsl_vector_alloc (3);
+  gsl_vector *w = gsl_vector_alloc (3);
+
+  P1906MOL_MOTOR_Field::point (u, 1, 0, 0);
+  P1906MOL_MOTOR_Field::point (v, 0, 1, 0);
+  P1906MOL_MOTOR_Field::cross_product (u, v, w);
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 0), 0., g_tolerance, "x cross y");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 1), 0., g_tolerance, "x cross y");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 2), 1., g_tolerance, "x cross y");
+
+  // (1, 2, 3) x (4, 5, 6) = (-3, 6, -3) and v x u = - u x v
+  P1906MOL_MOTOR_Field::point (u, 1, 2, 3);
+  P1906MOL_MOTOR_Field::point (v, 4, 5, 6);
+  P1906MOL_MOTOR_Field::cross_product (v, u, w);
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 0), 3., g_tolerance, "anticommutativity");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 1), -6., g_tolerance, "anticommutativity");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (w, 2), 3., g_tolerance, "anticommutativity");
+
+  gsl_vector_free (u);
+  gsl_vector_free (v);
+  gsl_vector_free (w);
+}
+
+/*
+ * P1906MOL_MOTOR_Field::getOverlap3D: crossing, disjoint and skew segments
+ */
+class P1906MotorOverlapTestCase : public TestCase
+{
+public:
+  P1906MotorOverlapTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorOverlapTestCase::P1906MotorOverlapTestCase ()
+  : TestCase ("overlap of segments")
+{
+}
+
+void
+P1906MotorOverlapTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_Field field;
+  gsl_vector *segment = gsl_vector_alloc (6);
+  gsl_matrix *tubeMatrix = gsl_matrix_alloc (3, 6);
+  gsl_matrix *pts = gsl_matrix_alloc (3, 3);
+  gsl_vector *tubeSegments = gsl_vector_alloc (3);
+  gsl_vector *pt1 = gsl_vector_alloc (3);
+  gsl_vector *pt2 = gsl_vector_alloc (3);
+
+  // the diagonals of a square cross at its center, as in unitTest_Overlap
+  P1906MOL_MOTOR_Field::point (pt1, 0, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 5, 5, 0);
+  P1906MOL_MOTOR_Field::line (segment, pt1, pt2);
+  // tube 0 crosses the segment, tube 1 lies on the same lines but beyond the segment end,
+  // tube 2 is the crossing tube lifted out of the plane, i.e., skew
+  P1906MOL_MOTOR_Field::point (pt1, 5, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 0, 5, 0);
+  field.line (tubeMatrix, 0, pt1, pt2);
+  P1906MOL_MOTOR_Field::point (pt1, 20, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 0, 20, 0);
+  field.line (tubeMatrix, 1, pt1, pt2);
+  P1906MOL_MOTOR_Field::point (pt1, 5, 0, 1);
+  P1906MOL_MOTOR_Field::point (pt2, 0, 5, 1);
+  field.line (tubeMatrix, 2, pt1, pt2);
+
+  int numPts = field.getOverlap3D (segment, tubeMatrix, pts, tubeSegments);
+  NS_TEST_ASSERT_MSG_EQ (numPts, 1, "only the crossing tube overlaps");
+  NS_TEST_ASSERT_MSG_EQ (gsl_vector_get (tubeSegments, 0), 0., "the crossing tube is tube 0");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (pts, 0, 0), 2.5, 1e-6, "overlap at the center");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (pts, 0, 1), 2.5, 1e-6, "overlap at the center");
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (pts, 0, 2), 0., 1e-6, "overlap at the center");
+
+  gsl_vector_free (segment);
+  gsl_matrix_free (tubeMatrix);
+  gsl_matrix_free (pts);
+  gsl_vector_free (tubeSegments);
+  gsl_vector_free (pt1);
+  gsl_vector_free (pt2);
+}
+
+/*
+ * P1906MOL_MOTOR_Field::tubes2VectorField, findClosestPoint and findNearestTube
+ */
+class P1906MotorVectorFieldTestCase : public TestCase
+{
+public:
+  P1906MotorVectorFieldTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorVectorFieldTestCase::P1906MotorVectorFieldTestCase ()
+  : TestCase ("vector field and nearest tube")
+{
+}
+
+void
+P1906MotorVectorFieldTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_Field field;
+  gsl_matrix *tubeMatrix = gsl_matrix_alloc (2, 6);
+  gsl_matrix *vf = gsl_matrix_alloc (2, 6);
+  gsl_vector *pt = gsl_vector_alloc (3);
+  gsl_vector *pt1 = gsl_vector_alloc (3);
+  gsl_vector *pt2 = gsl_vector_alloc (3);
+  gsl_vector *result = gsl_vector_alloc (6);
+
+  // two parallel tubes along x, at y = 0 and y = 10
+  P1906MOL_MOTOR_Field::point (pt1, 0, 0, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 4, 0, 0);
+  field.line (tubeMatrix, 0, pt1, pt2);
+  P1906MOL_MOTOR_Field::point (pt1, 0, 10, 0);
+  P1906MOL_MOTOR_Field::point (pt2, 4, 10, 3);
+  field.line (tubeMatrix, 1, pt1, pt2);
+
+  // each row is the start point followed by the direction of the segment
+  field.tubes2VectorField (tubeMatrix, vf);
+  double expected[6] = { 0, 10, 0, 4, 0, 3 };
+  for (int k = 0; k < 6; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (gsl_matrix_get (vf, 1, k), expected[k], g_tolerance, "vector field row " << k);
+    }
+
+  P1906MOL_MOTOR_Field::point (pt, 1, 9, 0);
+  P1906MOL_MOTOR_Field::findClosestPoint (pt, vf, result);
+  for (int k = 0; k < 6; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (gsl_vector_get (result, k), expected[k], g_tolerance, "closest vector " << k);
+    }
+
+  P1906MOL_MOTOR_Field::point (pt, 2, 1, 0);
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_Field::findNearestTube (pt, tubeMatrix, 5.), 0, "nearest tube");
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_Field::findNearestTube (pt, tubeMatrix, 0.5), (size_t) -1, "no tube within the radius");
+
+  gsl_matrix_free (tubeMatrix);
+  gsl_matrix_free (vf);
+  gsl_vector_free (pt);
+  gsl_vector_free (pt1);
+  gsl_vector_free (pt2);
+  gsl_vector_free (result);
+}
+
+/*
+ * P1906MOL_MOTOR_VolSurface: intersections of segments with a sphere, inside test and angles
+ */
+class P1906MotorVolSurfaceTestCase : public TestCase
+{
+public:
+  P1906MotorVolSurfaceTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorVolSurfaceTestCase::P1906MotorVolSurfaceTestCase ()
+  : TestCase ("volume surface intersections")
+{
+}
+
+void
+P1906MotorVolSurfaceTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_VolSurface vs;
+  P1906MOL_MOTOR_Pos c, p1, p2;
+  gsl_vector *segment = gsl_vector_alloc (6);
+  gsl_vector *segment2 = gsl_vector_alloc (6);
+  double x, y, z;
+
+  c.setPos (0, 0, 0);
+  vs.setVolume (c, 100);
+
+  // a segment leaving the sphere crosses it once, at 100 / sqrt(3) on the diagonal
+  vector<P1906MOL_MOTOR_Pos> ipt;
+  p1.setPos (40, 40, 40);
+  p2.setPos (110, 110, 110);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  vs.sphereIntersections (segment, ipt);
+  NS_TEST_ASSERT_MSG_EQ (ipt.size (), 1, "one intersection leaving the sphere");
+  ipt.front ().getPos (&x, &y, &z);
+  NS_TEST_ASSERT_MSG_EQ_TOL (x, 100. / sqrt (3.), 1e-6, "intersection on the surface");
+  NS_TEST_ASSERT_MSG_EQ_TOL (y, 100. / sqrt (3.), 1e-6, "intersection on the surface");
+  NS_TEST_ASSERT_MSG_EQ_TOL (z, 100. / sqrt (3.), 1e-6, "intersection on the surface");
+
+  // a chord through the sphere crosses it twice, at x = +/- 60 for y = 80
+  ipt.clear ();
+  p1.setPos (-200, 80, 0);
+  p2.setPos (200, 80, 0);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  vs.sphereIntersections (segment, ipt);
+  NS_TEST_ASSERT_MSG_EQ (ipt.size (), 2, "two intersections of a chord");
+  for (size_t i = 0; i < ipt.size (); i++)
+    {
+      ipt.at (i).getPos (&x, &y, &z);
+      NS_TEST_ASSERT_MSG_EQ_TOL (fabs (x), 60., 1e-6, "chord intersection");
+      NS_TEST_ASSERT_MSG_EQ_TOL (y, 80., 1e-6, "chord intersection");
+    }
+
+  // segments missing the sphere, fully outside and fully inside, do not cross it
+  ipt.clear ();
+  p1.setPos (-200, 150, 0);
+  p2.setPos (200, 150, 0);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  vs.sphereIntersections (segment, ipt);
+  p1.setPos (90, 90, 90);
+  p2.setPos (110, 110, 110);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  vs.sphereIntersections (segment, ipt);
+  p1.setPos (10, 10, 10);
+  p2.setPos (20, 20, 20);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  vs.sphereIntersections (segment, ipt);
+  NS_TEST_ASSERT_MSG_EQ (ipt.size (), 0, "no intersection");
+
+  p1.setPos (57, 57, 57);
+  NS_TEST_ASSERT_MSG_EQ (vs.isInsideVolSurf (p1), true, "inside");
+  p1.setPos (58, 58, 58);
+  NS_TEST_ASSERT_MSG_EQ (vs.isInsideVolSurf (p1), false, "outside");
+
+  p1.setPos (0, 0, 0);
+  p2.setPos (1, 0, 0);
+  P1906MOL_MOTOR_Field::line (segment, p1, p2);
+  p2.setPos (0, 1, 0);
+  P1906MOL_MOTOR_Field::line (segment2, p1, p2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (vs.vectorAngle (segment, segment2), 90., 1e-6, "orthogonal vectors");
+
+  gsl_vector_free (segment);
+  gsl_vector_free (segment2);
+}
+
+/*
+ * P1906MOL_MOTOR_VolSurface::reflect and Brownian motion within a reflective barrier
+ */
+class P1906MotorReflectiveBarrierTestCase : public TestCase
+{
+public:
+  P1906MotorReflectiveBarrierTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorReflectiveBarrierTestCase::P1906MotorReflectiveBarrierTestCase ()
+  : TestCase ("reflective barrier")
+{
+}
+
+void
+P1906MotorReflectiveBarrierTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_VolSurface vs;
+  P1906MOL_MOTOR_Pos c, last_pos, current_pos;
+  gsl_vector *segment = gsl_vector_alloc (6);
+  gsl_vector *lp = gsl_vector_alloc (3);
+  gsl_vector *cp = gsl_vector_alloc (3);
+  gsl_vector *ip = gsl_vector_alloc (3);
+  gsl_vector *n = gsl_vector_alloc (3);
+
+  c.setPos (0, 0, 0);
+  vs.setVolume (c, 100);
+  vs.setType (P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+
+  // the reflected position mirrors the last position about the radius through the
+  // intersection R: same distance from R and same component along the normal n
+  last_pos.setPos (20, 40, 20);
+  current_pos.setPos (120, 90, 90);
+  vector<P1906MOL_MOTOR_Pos> ipt;
+  P1906MOL_MOTOR_Field::line (segment, last_pos, current_pos);
+  vs.sphereIntersections (segment, ipt);
+  NS_TEST_ASSERT_MSG_EQ (ipt.size (), 1, "the step crosses the surface");
+  vs.reflect (last_pos, current_pos);
+
+  last_pos.getPos (lp);
+  current_pos.getPos (cp);
+  ipt.front ().getPos (ip);
+  gsl_vector_memcpy (n, ip);
+  gsl_vector_scale (n, 1. / gsl_blas_dnrm2 (n));
+  gsl_vector_sub (lp, ip);
+  gsl_vector_sub (cp, ip);
+  double lpn, cpn;
+  gsl_blas_ddot (lp, n, &lpn);
+  gsl_blas_ddot (cp, n, &cpn);
+  NS_TEST_ASSERT_MSG_EQ_TOL (gsl_blas_dnrm2 (cp), gsl_blas_dnrm2 (lp), 1e-6, "mirror distance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (cpn, lpn, 1e-6, "mirror normal component");
+  NS_TEST_ASSERT_MSG_EQ (vs.isInsideVolSurf (current_pos), true, "reflected inside");
+
+  // a motor diffusing from the center never leaves the barrier, as in unitTest_ReflectiveBarrier
+  gsl_rng *r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::User);
+  P1906MOL_MOTOR_Motion motion;
+  vector<P1906MOL_MOTOR_VolSurface> vsl;
+  vs.setVolume (c, 20);
+  vsl.push_back (vs);
+  gsl_vector *pos = gsl_vector_alloc (3);
+  gsl_vector *newPos = gsl_vector_alloc (3);
+  P1906MOL_MOTOR_Field::point (pos, 0, 0, 0);
+  bool inside = true;
+  for (int i = 0; i < 10000 && inside; i++)
+    {
+      motion.brownianMotion (r, pos, newPos, 1., 1., vsl);
+      gsl_vector_memcpy (pos, newPos);
+      inside = gsl_blas_dnrm2 (pos) < 20.;
+    }
+  NS_TEST_ASSERT_MSG_EQ (inside, true, "the motor stays within the barrier");
+
+  gsl_rng_free (r);
+  gsl_vector_free (segment);
+  gsl_vector_free (lp);
+  gsl_vector_free (cp);
+  gsl_vector_free (ip);
+  gsl_vector_free (n);
+  gsl_vector_free (pos);
+  gsl_vector_free (newPos);
+}
+
+/*
+ * P1906MOL_MOTOR_VolSurface::fluxMeter counts the tube crossings of the surface
+ */
+class P1906MotorFluxMeterTestCase : public TestCase
+{
+public:
+  P1906MotorFluxMeterTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorFluxMeterTestCase::P1906MotorFluxMeterTestCase ()
+  : TestCase ("flux meter")
+{
+}
+
+void
+P1906MotorFluxMeterTestCase::DoRun (void)
+{
+  P1906MOL_MOTOR_VolSurface vs;
+  P1906MOL_MOTOR_Pos c;
+  gsl_matrix *tubeMatrix = gsl_matrix_alloc (3, 6);
+  double tubes[3][6] = {
+    { 0, 0, 0, 200, 0, 0 },      // leaves the sphere: one crossing
+    { -200, 50, 0, 200, 50, 0 }, // a chord: two crossings
+    { 0, 150, 0, 10, 150, 0 }    // outside: none
+  };
+  for (int i = 0; i < 3; i++)
+    {
+      for (int k = 0; k < 6; k++)
+        {
+          gsl_matrix_set (tubeMatrix, i, k, tubes[i][k]);
+        }
+    }
+
+  c.setPos (0, 0, 0);
+  vs.setVolume (c, 100);
+  vs.setType (P1906MOL_MOTOR_VolSurface::FluxMeter);
+  NS_TEST_ASSERT_MSG_EQ_TOL (vs.fluxMeter (tubeMatrix), 3., g_tolerance, "tube crossings");
+
+  gsl_matrix_free (tubeMatrix);
+}
+
+/*
+ * P1906MOL_MOTOR_Motion::brownianMotion with displacements drawn in one
+ * block: the mean square displacement is 6 D t
+ */
+class P1906MotorBrownianTestCase : public TestCase
+{
+public:
+  P1906MotorBrownianTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorBrownianTestCase::P1906MotorBrownianTestCase ()
+  : TestCase ("Brownian mean square displacement")
+{
+}
+
+void
+P1906MotorBrownianTestCase::DoRun (void)
+{
+  const size_t n = 20000;
+  const double D = 0.5;
+  const double t = 2.;
+  gsl_rng *r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::User);
+  gsl_vector *origin = gsl_vector_calloc (3);
+  gsl_vector *pos = gsl_vector_alloc (3);
+  std::vector<double> z (3 * n);
+  std::vector<P1906MOL_MOTOR_VolSurface> vsl;
+  P1906MOL_MOTOR_Motion motion;
+
+  P1906MOL_MOTOR_Rng::gaussian (r, 1., &z[0], z.size ());
+  double msd = 0.;
+  double mean = 0.;
+  for (size_t i = 0; i < n; i++)
+    {
+      motion.brownianMotion (&z[3 * i], origin, pos, t, D, vsl);
+      for (int k = 0; k < 3; k++)
+        {
+          double d = gsl_vector_get (pos, k);
+          msd += d * d;
+          mean += d;
+        }
+    }
+  msd /= n;
+  mean /= 3 * n;
+
+  // the standard error of the mean square displacement is 6 D t sqrt(2 / (3 n)), i.e., below 1%
+  NS_TEST_ASSERT_MSG_EQ_TOL (msd, 6 * D * t, 0.05 * 6 * D * t, "mean square displacement");
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean, 0., 0.05, "zero mean displacement");
+
+  gsl_vector_free (origin);
+  gsl_vector_free (pos);
+  gsl_rng_free (r);
+}
+
+/*
+ * P1906MOL_MOTOR_Motion: the exit time of a sphere of radius rho has mean rho^2 / (6 D), and
+ * the closed form moves a motor within reach of a single Receiver once an accuracy target allows it
+ */
+class P1906MotorEngineTestCase : public TestCase
+{
+public:
+  P1906MotorEngineTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorEngineTestCase::P1906MotorEngineTestCase ()
+  : TestCase ("first-passage exit time and engine selection")
+{
+}
+
+void
+P1906MotorEngineTestCase::DoRun (void)
+{
+  const size_t n = 20000;
+  const double D = 2.;
+  const double rho = 3.;
+  gsl_rng *r = P1906MOL_MOTOR_Rng::alloc (P1906MOL_MOTOR_Rng::User);
+
+  double mean = 0.;
+  for (size_t i = 0; i < n; i++)
+    {
+      mean += P1906MOL_MOTOR_Motion::sphereExitTime (r, rho, D);
+    }
+  mean /= n;
+  // the exit time has a relative standard deviation below 0.7, i.e., a standard error below 0.5%
+  NS_TEST_ASSERT_MSG_EQ_TOL (mean, rho * rho / (6 * D), 0.02 * rho * rho / (6 * D), "mean exit time");
+
+  // start 0.5 away from a Receiver of radius 10: free diffusion reaches it with probability 20 / 21,
+  // the barrier brings back the motors which escape
+  Ptr<P1906MOL_Motor> motor = CreateObject<P1906MOL_Motor> ();
+  P1906MOL_MOTOR_Motion motion;
+  P1906MOL_MOTOR_Pos c;
+  gsl_vector *start = gsl_vector_alloc (3);
+  c.setPos (10.5, 0, 0);
+  motor->addVolumeSurface (c, 10, P1906MOL_MOTOR_VolSurface::Receiver);
+  c.setPos (5, 0, 0);
+  motor->addVolumeSurface (c, 30, P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+  P1906MOL_MOTOR_Field::point (start, 0, 0, 0);
+  motor->setStartingPoint (start);
+  motor->initTime ();
+  motion.SetDiffusionCoefficient (1.);
+  motion.setAccuracyTarget (0.5);
+  motion.float2Destination (motor, 0.01);
+  NS_TEST_ASSERT_MSG_EQ (motion.getLastEngine (), P1906MOL_MOTOR_Motion::ClosedForm, "closed form within the target");
+  NS_TEST_ASSERT_MSG_EQ (motor->inDestination (), true, "the motor lands in the Receiver");
+  NS_TEST_ASSERT_MSG_GT (motor->getTime (), 0., "positive delay");
+
+  // without a target every journey steps
+  motor->setStartingPoint (start);
+  motion.setAccuracyTarget (0.);
+  motion.float2Destination (motor, 0.1);
+  NS_TEST_ASSERT_MSG_EQ (motion.getLastEngine (), P1906MOL_MOTOR_Motion::FullStepping, "full stepping without a target");
+  NS_TEST_ASSERT_MSG_EQ (motion.getEngineJourneys (P1906MOL_MOTOR_Motion::ClosedForm), 1, "one closed form journey");
+
+  gsl_vector_free (start);
+  gsl_rng_free (r);
+}
+
+/*
+ * P1906MOL_MOTOR_Rng: Philox4x32-10 known answers and random access to the steps
+ */
+class P1906MotorRngTestCase : public TestCase
+{
+public:
+  P1906MotorRngTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+P1906MotorRngTestCase::P1906MotorRngTestCase ()
+  : TestCase ("counter-based random streams")
+{
+}
+
+void
+P1906MotorRngTestCase::DoRun (void)
+{
+  // the known answer vectors of Random123
+  uint32_t key0[2] = { 0, 0 };
+  uint32_t ctr0[4] = { 0, 0, 0, 0 };
+  uint32_t out0[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+  uint32_t key1[2] = { 0xa4093822, 0x299f31d0 };
+  uint32_t ctr1[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+  uint32_t out1[4] = { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 };
+  uint32_t out[4];
+
+  P1906MOL_MOTOR_Rng::philox4x32 (key0, ctr0, out);
+  for (int k = 0; k < 4; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (out[k], out0[k], "zero key and counter, word " << k);
+    }
+  P1906MOL_MOTOR_Rng::philox4x32 (key1, ctr1, out);
+  for (int k = 0; k < 4; k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (out[k], out1[k], "pi key and counter, word " << k);
+    }
+
+  // jumping to a step gives the numbers reached by drawing all the previous ones
+  gsl_rng *a = gsl_rng_alloc (P1906MOL_MOTOR_Rng::philox ());
+  gsl_rng *b = gsl_rng_alloc (P1906MOL_MOTOR_Rng::philox ());
+  P1906MOL_MOTOR_Rng::setStream (a, P1906MOL_MOTOR_Rng::User, 7);
+  P1906MOL_MOTOR_Rng::setStream (b, P1906MOL_MOTOR_Rng::User, 7);
+  for (int i = 0; i < 4 * 5; i++)
+    {
+      gsl_rng_get (a);
+    }
+  NS_TEST_ASSERT_MSG_EQ (P1906MOL_MOTOR_Rng::getStep (a), 5, "step after five blocks");
+  P1906MOL_MOTOR_Rng::setStep (b, 5);
+  for (int i = 0; i < 8; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (gsl_rng_get (a), gsl_rng_get (b), "number " << i << " of step 5");
+    }
+
+  // another carrier of the same component is another stream
+  P1906MOL_MOTOR_Rng::setStream (b, P1906MOL_MOTOR_Rng::User, 8);
+  P1906MOL_MOTOR_Rng::setStep (a, 0);
+  NS_TEST_ASSERT_MSG_NE (gsl_rng_get (a), gsl_rng_get (b), "distinct carriers");
+
+  gsl_rng_free (a);
+  gsl_rng_free (b);
+}
+
+class P1906MotorTestSuite : public TestSuite
+{
+public:
+  P1906MotorTestSuite ();
+};
+
+P1906MotorTestSuite::P1906MotorTestSuite ()
+  : TestSuite ("p1906-motor", UNIT)
+{
+  AddTestCase (new P1906MotorDistanceTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorCrossProductTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorOverlapTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorVectorFieldTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorVolSurfaceTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorReflectiveBarrierTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorFluxMeterTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorBrownianTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorEngineTestCase, TestCase::QUICK);
+  AddTestCase (new P1906MotorRngTestCase, TestCase::QUICK);
+}
+
+static P1906MotorTestSuite g_p1906MotorTestSuite;
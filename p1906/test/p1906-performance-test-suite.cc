@@ -0,0 +1,459 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *  Copyright � 2015 by IEEE.
+ *
+ *  This source file is an essential part of IEEE Std 1906.1,
+ *  Recommended Practice for Nanoscale and Molecular
+ *  Communication Framework.
+ *  Verbatim copies of this source file may be used and
+ *  distributed without restriction. Modifications to this source
+ *  file as permitted in IEEE Std 1906.1 may also be made and
+ *  distributed. All other uses require permission from the IEEE
+ *  Standards Department (stds-ipr@ieee.org). All other rights
+ *  reserved.
+ *
+ *  This source file is provided on an AS IS basis.
+ *  The IEEE disclaims ANY WARRANTY EXPRESS OR IMPLIED INCLUDING
+ *  ANY WARRANTY OF MERCHANTABILITY AND FITNESS FOR USE FOR A
+ *  PARTICULAR PURPOSE.
+ *  The user of the source file shall indemnify and hold
+ *  IEEE harmless from any damages or liability arising out of
+ *  the use thereof.
+ *
+ * Author: Stephen F Bush - GE Global Research
+ *                      bushsf@research.ge.com
+ *                      http://www.amazon.com/author/stephenbush
+ */
+
+
+/*
+ * Description:
+ * budgeted performance tests of the molecular motor geometry kernels
+ *
+ * Each kernel of p1906-bench is checked against p1906-performance-baseline.txt:
+ *  - its allocations, counted over one run with the P1906MemoryTracker enabled, must not exceed
+ *    their budget at all, since they do not depend on the machine
+ *  - its time, measured as in p1906-bench with the tracker disabled, must not exceed its budget by
+ *    more than P1906_PERF_TIME_TOLERANCE (default 0.5, i.e., 50%)
+ * Times are in units of the time of a GSL vector allocation and release measured in the same run,
+ * which the kernels are dominated by, so that the budgets carry over between machines.
+ * A "-" in the baseline leaves that budget unchecked. Running the suite with
+ * P1906_PERF_UPDATE_BASELINE=1 rewrites the baseline with the measured values, e.g., after
+ * an optimization or on the reference machine:
+ *
+ *   P1906_PERF_UPDATE_BASELINE=1 ./test.py -s p1906-performance
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/p1906-memory-tracker.h"
+#include "ns3/p1906-mol-motor-field.h"
+#include "ns3/p1906-mol-motor-pos.h"
+#include "ns3/p1906-mol-motor-vol-surface.h"
+#include "ns3/p1906-mol-motor-rng.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+using namespace ns3;
+
+/*
+ * The budget of a kernel: a negative value is not checked
+ */
+struct P1906PerformanceBudget
+{
+  double unitsPerOp;
+  double allocsPerOp;
+};
+
+typedef std::map<std::string, P1906PerformanceBudget> P1906PerformanceBaseline;
+
+static std::string
+BaselineKey (std::string kernel, uint64_t segments)
+{
+  std::ostringstream key;
+  key << kernel << " " << segments;
+  return key.str ();
+}
+
+static uint64_t
+TrackedAllocations (void)
+{
+  uint64_t allocations = 0;
+  for (int c = 0; c < P1906MemoryTracker::NUM_COMPONENTS; c++)
+    {
+      allocations += P1906MemoryTracker::GetAllocations ((P1906MemoryTracker::Component) c);
+    }
+  return allocations;
+}
+
+/*
+ * Time an operation, doubling the iterations until it runs for at least 0.1 s
+ */
+static double
+NsPerOp (const std::function<void ()> &op)
+{
+  const double minTime = 0.1;
+  uint64_t n = 1;
+  double seconds;
+  while (true)
+    {
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+      for (uint64_t i = 0; i < n; i++)
+        {
+          op ();
+        }
+      seconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - t0).count ();
+      if (seconds >= minTime || n >= (1ULL << 40))
+        {
+          break;
+        }
+      n *= 2;
+    }
+  return seconds * 1e9 / n;
+}
+
+/*
+ * Count the allocations of a kernel, time it, and check both against its budget
+ */
+class P1906PerformanceTestCase : public TestCase
+{
+public:
+  P1906PerformanceTestCase (std::string kernel, uint64_t segments, P1906PerformanceBaseline *baseline,
+                            const double *unitNs, std::function<void ()> op);
+private:
+  virtual void DoRun (void);
+
+  std::string m_kernel;
+  uint64_t m_segments;
+  P1906PerformanceBaseline *m_baseline;
+  const double *m_unitNs;
+  std::function<void ()> m_op;
+};
+
+P1906PerformanceTestCase::P1906PerformanceTestCase (std::string kernel, uint64_t segments, P1906PerformanceBaseline *baseline,
+                                                    const double *unitNs, std::function<void ()> op)
+  : TestCase ("budget of " + BaselineKey (kernel, segments)),
+    m_kernel (kernel),
+    m_segments (segments),
+    m_baseline (baseline),
+    m_unitNs (unitNs),
+    m_op (op)
+{
+}
+
+void
+P1906PerformanceTestCase::DoRun (void)
+{
+  const char *tolerance = getenv ("P1906_PERF_TIME_TOLERANCE");
+  double timeTolerance = tolerance ? atof (tolerance) : 0.5;
+
+  // warm up caches and lazily allocated structures
+  m_op ();
+
+  // the kernels do not depend on the iteration, so a single tracked run is enough and
+  // the tracker does not record the blocks of the timing loop
+  P1906MemoryTracker::Reset ();
+  P1906MemoryTracker::Enable ();
+  m_op ();
+  double allocsPerOp = TrackedAllocations ();
+  P1906MemoryTracker::Disable ();
+  P1906MemoryTracker::Reset ();
+
+  double nsPerOp = NsPerOp (m_op);
+  double unitsPerOp = nsPerOp / *m_unitNs;
+
+  std::string key = BaselineKey (m_kernel, m_segments);
+  if (getenv ("P1906_PERF_UPDATE_BASELINE"))
+    {
+      P1906PerformanceBudget &b = (*m_baseline)[key];
+      b.unitsPerOp = unitsPerOp;
+      b.allocsPerOp = allocsPerOp;
+      return;
+    }
+
+  P1906PerformanceBaseline::const_iterator it = m_baseline->find (key);
+  if (it == m_baseline->end ())
+    {
+      std::cout << "no baseline for " << key << ": " << unitsPerOp << " units/op ("
+                << nsPerOp << " ns/op) " << allocsPerOp << " allocs/op" << std::endl;
+      return;
+    }
+  if (it->second.allocsPerOp >= 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (allocsPerOp <= it->second.allocsPerOp, true,
+                             key << ": " << allocsPerOp << " allocs/op over the budget of " << it->second.allocsPerOp);
+    }
+  if (it->second.unitsPerOp >= 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (unitsPerOp <= it->second.unitsPerOp * (1 + timeTolerance), true,
+                             key << ": " << unitsPerOp << " units/op (" << nsPerOp << " ns/op) over the budget of "
+                             << it->second.unitsPerOp << " units/op + " << 100 * timeTolerance << "%");
+    }
+}
+
+/*
+ * The kernels of p1906-bench on fixed inputs: the tube networks are drawn from a
+ * dedicated random stream, so every run measures the same networks. The inputs are
+ * built in DoSetup, i.e., not while the test library is loaded.
+ */
+class P1906PerformanceTestSuite : public TestSuite
+{
+public:
+  P1906PerformanceTestSuite ();
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  void LoadBaseline (void);
+  void AddTubeKernels (size_t n);
+
+  P1906PerformanceBaseline m_baseline;
+  std::string m_baselineFile;
+  //! the time of a GSL vector allocation and release [ns], the unit of the time budgets
+  double m_unitNs;
+
+  //! the inputs of a tube network kernel
+  struct TubeInputs
+  {
+    gsl_matrix *tubes;
+    gsl_matrix *vf;
+    gsl_matrix *pts;
+    gsl_vector *tubeSegments;
+    gsl_vector *pt;
+    gsl_vector *segment;
+  };
+
+  gsl_rng *m_r;
+  gsl_vector *m_u, *m_v, *m_w, *m_pt, *m_segment, *m_trajectory, *m_result;
+  P1906MOL_MOTOR_VolSurface *m_vs;
+  P1906MOL_MOTOR_Pos *m_inside, *m_outside;
+  P1906MOL_MOTOR_Field *m_field;
+  std::vector<P1906MOL_MOTOR_Pos> m_ipt;
+  std::map<size_t, TubeInputs> m_tubes;
+};
+
+P1906PerformanceTestSuite::P1906PerformanceTestSuite ()
+  : TestSuite ("p1906-performance", PERFORMANCE),
+    m_unitNs (1.)
+{
+  SetDataDir (NS_TEST_SOURCEDIR);
+
+  AddTestCase (new P1906PerformanceTestCase ("cross_product", 0, &m_baseline, &m_unitNs,
+                                             [this] () { P1906MOL_MOTOR_Field::cross_product (m_u, m_v, m_w); }),
+               TestCase::QUICK);
+  AddTestCase (new P1906PerformanceTestCase ("distance", 0, &m_baseline, &m_unitNs,
+                                             [this] () { P1906MOL_MOTOR_Field::distance (m_pt, m_segment); }),
+               TestCase::QUICK);
+  AddTestCase (new P1906PerformanceTestCase ("sphereIntersections", 0, &m_baseline, &m_unitNs,
+                                             [this] () { m_ipt.clear (); m_vs->sphereIntersections (m_trajectory, m_ipt); }),
+               TestCase::QUICK);
+  AddTestCase (new P1906PerformanceTestCase ("reflect", 0, &m_baseline, &m_unitNs,
+                                             [this] () { P1906MOL_MOTOR_Pos p; p.setPos (*m_outside); m_vs->reflect (*m_inside, p); }),
+               TestCase::QUICK);
+  AddTubeKernels (1000);
+  AddTubeKernels (10000);
+}
+
+void
+P1906PerformanceTestSuite::AddTubeKernels (size_t n)
+{
+  AddTestCase (new P1906PerformanceTestCase ("findClosestPoint", n, &m_baseline, &m_unitNs,
+                                             [this, n] () {
+                                               TubeInputs &t = m_tubes[n];
+                                               P1906MOL_MOTOR_Field::findClosestPoint (t.pt, t.vf, m_result);
+                                             }),
+               TestCase::QUICK);
+  AddTestCase (new P1906PerformanceTestCase ("findNearestTube", n, &m_baseline, &m_unitNs,
+                                             [this, n] () {
+                                               TubeInputs &t = m_tubes[n];
+                                               P1906MOL_MOTOR_Field::findNearestTube (t.pt, t.tubes, 10.);
+                                             }),
+               TestCase::QUICK);
+  AddTestCase (new P1906PerformanceTestCase ("getOverlap3D", n, &m_baseline, &m_unitNs,
+                                             [this, n] () {
+                                               TubeInputs &t = m_tubes[n];
+                                               m_field->getOverlap3D (t.segment, t.tubes, t.pts, t.tubeSegments);
+                                             }),
+               TestCase::QUICK);
+  m_tubes[n] = TubeInputs ();
+}
+
+void
+P1906PerformanceTestSuite::DoSetup (void)
+{
+  m_baselineFile = CreateDataDirFilename ("p1906-performance-baseline.txt");
+  LoadBaseline ();
+
+  m_r = gsl_rng_alloc (P1906MOL_MOTOR_Rng::philox ());
+  P1906MOL_MOTOR_Rng::setStream (m_r, P1906MOL_MOTOR_Rng::User, 0);
+  m_u = gsl_vector_alloc (3);
+  m_v = gsl_vector_alloc (3);
+  m_w = gsl_vector_alloc (3);
+  m_pt = gsl_vector_alloc (3);
+  m_segment = gsl_vector_alloc (6);
+  m_trajectory = gsl_vector_alloc (6);
+  m_result = gsl_vector_alloc (6);
+  m_field = new P1906MOL_MOTOR_Field ();
+
+  m_unitNs = NsPerOp ([] () { gsl_vector_free (gsl_vector_alloc (3)); });
+
+  P1906MOL_MOTOR_Field::point (m_u, 1., 2., 3.);
+  P1906MOL_MOTOR_Field::point (m_v, -2., .5, 4.);
+  P1906MOL_MOTOR_Field::point (m_pt, 3., 1., -2.);
+  for (int k = 0; k < 6; k++)
+    {
+      gsl_vector_set (m_segment, k, 10. * gsl_rng_uniform (m_r));
+    }
+
+  // a unit sphere crossed by a trajectory from its center
+  P1906MOL_MOTOR_Pos center;
+  center.setPos (0., 0., 0.);
+  m_vs = new P1906MOL_MOTOR_VolSurface ();
+  m_vs->setVolume (center, 1.);
+  m_vs->setType (P1906MOL_MOTOR_VolSurface::ReflectiveBarrier);
+  m_inside = new P1906MOL_MOTOR_Pos ();
+  m_outside = new P1906MOL_MOTOR_Pos ();
+  m_inside->setPos (0.1, 0.2, 0.);
+  m_outside->setPos (1.5, 0.3, 0.2);
+  P1906MOL_MOTOR_Field::line (m_trajectory, *m_inside, *m_outside);
+
+  // random tube networks of n segments of length 10 in a cube keeping a constant segment density
+  std::map<size_t, TubeInputs>::iterator it;
+  for (it = m_tubes.begin (); it != m_tubes.end (); it++)
+    {
+      size_t n = it->first;
+      TubeInputs &t = it->second;
+      t.tubes = gsl_matrix_alloc (n, 6);
+      t.vf = gsl_matrix_alloc (n, 6);
+      t.pts = gsl_matrix_alloc (n, 3);
+      t.tubeSegments = gsl_vector_alloc (n);
+      t.pt = gsl_vector_alloc (3);
+      t.segment = gsl_vector_alloc (6);
+
+      double side = 10. * cbrt ((double) n);
+      for (size_t i = 0; i < n; i++)
+        {
+          double d[3];
+          P1906MOL_MOTOR_Rng::gaussian (m_r, 1., d, 3);
+          double norm = sqrt (d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+          double *s = gsl_matrix_ptr (t.tubes, i, 0);
+          for (int k = 0; k < 3; k++)
+            {
+              s[k] = side * gsl_rng_uniform (m_r);
+              s[k + 3] = s[k] + 10. * d[k] / norm;
+            }
+        }
+      m_field->tubes2VectorField (t.tubes, t.vf);
+      P1906MOL_MOTOR_Field::point (t.pt, side / 2, side / 2, side / 2);
+      P1906MOL_MOTOR_Field::line (t.segment, t.tubes, n / 2);
+    }
+}
+
+void
+P1906PerformanceTestSuite::DoTeardown (void)
+{
+  gsl_rng_free (m_r);
+  gsl_vector_free (m_u);
+  gsl_vector_free (m_v);
+  gsl_vector_free (m_w);
+  gsl_vector_free (m_pt);
+  gsl_vector_free (m_segment);
+  gsl_vector_free (m_trajectory);
+  gsl_vector_free (m_result);
+  delete m_field;
+  delete m_vs;
+  delete m_inside;
+  delete m_outside;
+  m_ipt.clear ();
+
+  std::map<size_t, TubeInputs>::iterator it;
+  for (it = m_tubes.begin (); it != m_tubes.end (); it++)
+    {
+      TubeInputs &t = it->second;
+      gsl_matrix_free (t.tubes);
+      gsl_matrix_free (t.vf);
+      gsl_matrix_free (t.pts);
+      gsl_vector_free (t.tubeSegments);
+      gsl_vector_free (t.pt);
+      gsl_vector_free (t.segment);
+    }
+
+  // Enable scheduled the tracker report: print it now rather than in a later suite
+  Simulator::Destroy ();
+}
+
+/*
+ * One budget per line: kernel segments units_per_op allocs_per_op, "-" for an unchecked budget
+ */
+void
+P1906PerformanceTestSuite::LoadBaseline (void)
+{
+  std::ifstream in (m_baselineFile.c_str ());
+  std::string line;
+  while (std::getline (in, line))
+    {
+      if (line.empty () || line[0] == '#')
+        {
+          continue;
+        }
+      std::istringstream fields (line);
+      std::string kernel, units, allocs;
+      uint64_t segments;
+      if (!(fields >> kernel >> segments >> units >> allocs))
+        {
+          continue;
+        }
+      P1906PerformanceBudget &b = m_baseline[BaselineKey (kernel, segments)];
+      b.unitsPerOp = units == "-" ? -1. : atof (units.c_str ());
+      b.allocsPerOp = allocs == "-" ? -1. : atof (allocs.c_str ());
+    }
+}
+
+/*
+ * Run after the test cases: rewrite the baseline when asked to
+ */
+void
+P1906PerformanceTestSuite::DoRun (void)
+{
+  if (!getenv ("P1906_PERF_UPDATE_BASELINE"))
+    {
+      return;
+    }
+  std::ofstream out (m_baselineFile.c_str ());
+  out << "# kernel segments units_per_op allocs_per_op (\"-\" leaves a budget unchecked)" << std::endl;
+  out << "# recorded with a unit of " << m_unitNs << " ns" << std::endl;
+  P1906PerformanceBaseline::const_iterator it;
+  for (it = m_baseline.begin (); it != m_baseline.end (); it++)
+    {
+      out << it->first << " ";
+      if (it->second.unitsPerOp >= 0)
+        {
+          out << it->second.unitsPerOp;
+        }
+      else
+        {
+          out << "-";
+        }
+      out << " ";
+      if (it->second.allocsPerOp >= 0)
+        {
+          out << it->second.allocsPerOp;
+        }
+      else
+        {
+          out << "-";
+        }
+      out << std::endl;
+    }
+}
+
+static P1906PerformanceTestSuite g_p1906PerformanceTestSuite;